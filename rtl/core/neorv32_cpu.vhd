@@ -65,6 +65,10 @@ entity neorv32_cpu is
     FAST_MUL_EN                : boolean; -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              : boolean; -- use barrel shifter for shift operations
     REGFILE_HW_RST             : boolean; -- implement full hardware reset for register file
+    CPU_BTB_EN                 : boolean; -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH              : natural range 2 to 16; -- instruction prefetch buffer depth, has to be a power of two
+    MULDIV_RADIX               : natural range 2 to 16; -- serial mul/div radix (2, 4 or 16)
+    MULDIV_EARLY_EN            : boolean; -- skip leading all-zero operand bytes in serial mul/div
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS            : natural range 0 to 16; -- number of regions (0..16)
     PMP_MIN_GRANULARITY        : natural; -- minimal region granularity in bytes, has to be a power of 2, min 4 bytes
@@ -87,6 +91,8 @@ entity neorv32_cpu is
     mti_i      : in  std_ulogic; -- risc-v machine timer interrupt
     firq_i     : in  std_ulogic_vector(15 downto 0); -- custom fast interrupts
     dbi_i      : in  std_ulogic; -- risc-v debug halt request interrupt
+    -- performance monitor events --
+    hpm_ev_i   : in  std_ulogic_vector(hpmcnt_event_size_c-1 downto 0); -- processor-level (CPU-external) HPM events
     -- instruction bus interface --
     ibus_req_o : out bus_req_t; -- request bus
     ibus_rsp_i : in  bus_rsp_t; -- response bus
@@ -161,11 +167,19 @@ begin
 
   -- CPU tuning options --
   assert false report "[NEORV32] CPU tuning options: " &
-    cond_sel_string_f(FAST_MUL_EN,    "fast_mul ",   "") &
-    cond_sel_string_f(FAST_SHIFT_EN,  "fast_shift ", "") &
-    cond_sel_string_f(REGFILE_HW_RST, "rf_hw_rst ",  "")
+    cond_sel_string_f(FAST_MUL_EN,     "fast_mul ",     "") &
+    cond_sel_string_f(FAST_SHIFT_EN,   "fast_shift ",   "") &
+    cond_sel_string_f(REGFILE_HW_RST,  "rf_hw_rst ",    "") &
+    cond_sel_string_f(CPU_BTB_EN,      "btb ",          "") &
+    cond_sel_string_f(MULDIV_EARLY_EN, "muldiv_early ", "") &
+    "muldiv_radix=" & natural'image(MULDIV_RADIX) & " " &
+    "ipb_depth=" & natural'image(CPU_IPB_DEPTH)
     severity note;
 
+  -- instruction prefetch buffer --
+  assert not (is_power_of_two_f(CPU_IPB_DEPTH) = false) report
+    "[NEORV32] CPU instruction prefetch buffer depth (CPU_IPB_DEPTH) has to be a power of two." severity error;
+
   -- simulation notifier --
   assert not (is_simulation_c = true) report "[NEORV32] Assuming this is a simulation." severity warning;
 
@@ -200,6 +214,8 @@ begin
     FAST_MUL_EN                => FAST_MUL_EN,                -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              => FAST_SHIFT_EN,              -- use barrel shifter for shift operations
     REGFILE_HW_RST             => REGFILE_HW_RST,             -- implement full hardware reset for register file
+    CPU_BTB_EN                 => CPU_BTB_EN,                 -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH              => CPU_IPB_DEPTH,              -- instruction prefetch buffer depth
     -- Hardware Performance Monitors (HPM) --
     HPM_NUM_CNTS               => HPM_NUM_CNTS,               -- number of implemented HPM counters (0..13)
     HPM_CNT_WIDTH              => HPM_CNT_WIDTH               -- total size of HPM counters
@@ -235,6 +251,8 @@ begin
     mei_i         => mei_i,          -- machine external interrupt
     mti_i         => mti_i,          -- machine timer interrupt
     firq_i        => firq_i,         -- fast interrupts
+    -- performance monitor events --
+    hpm_ev_i      => hpm_ev_i,       -- processor-level HPM events
     -- data access interface --
     lsu_wait_i    => lsu_wait,       -- wait for data bus
     mar_i         => mar,            -- memory address register
@@ -292,7 +310,9 @@ begin
     CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,  -- implement custom (instr.) functions unit?
     -- Tuning Options --
     FAST_MUL_EN                => FAST_MUL_EN,                -- use DSPs for M extension's multiplier
-    FAST_SHIFT_EN              => FAST_SHIFT_EN               -- use barrel shifter for shift operations
+    FAST_SHIFT_EN              => FAST_SHIFT_EN,              -- use barrel shifter for shift operations
+    MULDIV_RADIX               => MULDIV_RADIX,               -- serial mul/div radix (2, 4 or 16)
+    MULDIV_EARLY_EN            => MULDIV_EARLY_EN             -- skip leading all-zero operand bytes in serial mul/div
   )
   port map (
     -- global control --
@@ -324,7 +344,7 @@ begin
   -- -------------------------------------------------------------------------------------------
   neorv32_cpu_lsu_inst: entity neorv32.neorv32_cpu_lsu
   generic map (
-    AMO_LRSC_ENABLE => CPU_EXTENSION_RISCV_A -- enable atomic LR/SC operations
+    AMO_LRSC_ENABLE => CPU_EXTENSION_RISCV_A -- enable atomic LR/SC and AMO operations
   )
   port map (
     -- global control --
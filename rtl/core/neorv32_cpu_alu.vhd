@@ -51,7 +51,9 @@ entity neorv32_cpu_alu is
     CPU_EXTENSION_RISCV_Zxcfu  : boolean; -- implement custom (instr.) functions unit?
     -- Tuning Options --
     FAST_MUL_EN                : boolean; -- use DSPs for M extension's multiplier
-    FAST_SHIFT_EN              : boolean  -- use barrel shifter for shift operations
+    FAST_SHIFT_EN              : boolean; -- use barrel shifter for shift operations
+    MULDIV_RADIX               : natural; -- serial mul/div radix (2, 4 or 16)
+    MULDIV_EARLY_EN            : boolean  -- skip leading all-zero operand bytes in serial mul/div
   );
   port (
     -- global control --
@@ -208,8 +210,10 @@ begin
   if CPU_EXTENSION_RISCV_M or CPU_EXTENSION_RISCV_Zmmul generate
     neorv32_cpu_cp_muldiv_inst: entity neorv32.neorv32_cpu_cp_muldiv
     generic map (
-      FAST_MUL_EN => FAST_MUL_EN,          -- use DSPs for faster multiplication
-      DIVISION_EN => CPU_EXTENSION_RISCV_M -- implement divider hardware
+      FAST_MUL_EN => FAST_MUL_EN,           -- use DSPs for faster multiplication
+      DIVISION_EN => CPU_EXTENSION_RISCV_M, -- implement divider hardware
+      RADIX       => MULDIV_RADIX,          -- serial mul/div radix
+      EARLY_EN    => MULDIV_EARLY_EN        -- skip leading all-zero operand bytes
     )
     port map (
       -- global control --
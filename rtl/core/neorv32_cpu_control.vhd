@@ -77,6 +77,8 @@ entity neorv32_cpu_control is
     FAST_MUL_EN                : boolean; -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              : boolean; -- use barrel shifter for shift operations
     REGFILE_HW_RST             : boolean; -- implement full hardware reset for register file
+    CPU_BTB_EN                 : boolean; -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH              : natural; -- instruction prefetch buffer depth, has to be a power of two, min 2
     -- Hardware Performance Monitors (HPM) --
     HPM_NUM_CNTS               : natural range 0 to 13; -- number of implemented HPM counters (0..13)
     HPM_CNT_WIDTH              : natural range 0 to 64  -- total size of HPM counters (0..64)
@@ -112,6 +114,8 @@ entity neorv32_cpu_control is
     mei_i         : in  std_ulogic; -- machine external interrupt
     mti_i         : in  std_ulogic; -- machine timer interrupt
     firq_i        : in  std_ulogic_vector(15 downto 0); -- fast interrupts
+    -- performance monitor events --
+    hpm_ev_i      : in  std_ulogic_vector(hpmcnt_event_size_c-1 downto 0); -- processor-level (CPU-external) HPM events
     -- data access interface --
     lsu_wait_i    : in  std_ulogic; -- wait for data bus
     mar_i         : in  std_ulogic_vector(XLEN-1 downto 0); -- memory address register
@@ -141,8 +145,25 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
   end record;
   signal fetch_engine : fetch_engine_t;
 
+  -- branch target buffer (BTB) --
+  constant btb_entries_c : natural := 16; -- number of BTB entries, has to be a power of two
+  constant btb_idx_c     : natural := index_size_f(btb_entries_c);
+  type btb_tag_t is array (0 to btb_entries_c-1) of std_ulogic_vector(XLEN-1 downto btb_idx_c+2);
+  type btb_tgt_t is array (0 to btb_entries_c-1) of std_ulogic_vector(XLEN-1 downto 2);
+  type btb_cnt_t is array (0 to btb_entries_c-1) of std_ulogic_vector(1 downto 0);
+  type btb_t is record
+    valid  : std_ulogic_vector(btb_entries_c-1 downto 0);
+    tag    : btb_tag_t; -- branch address
+    target : btb_tgt_t; -- branch destination
+    cnt    : btb_cnt_t; -- bimodal 2-bit saturating counter, MSB = predict taken
+    hit    : std_ulogic; -- current fetch address is a predicted-taken branch
+    pred   : std_ulogic_vector(XLEN-1 downto 2); -- predicted branch destination
+    upd    : std_ulogic; -- executed branch can be tracked by the BTB
+  end record;
+  signal btb : btb_t;
+
   -- instruction prefetch buffer (FIFO) interface --
-  type ipb_data_t is array (0 to 1) of std_ulogic_vector(16 downto 0); -- bus_error & 16-bit instruction
+  type ipb_data_t is array (0 to 1) of std_ulogic_vector(17 downto 0); -- predicted_taken & bus_error & 16-bit instruction
   type ipb_t is record
     wdata, rdata : ipb_data_t;
     we,    re    : std_ulogic_vector(1 downto 0);
@@ -157,7 +178,7 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     align_clr : std_ulogic;
     ci_i16    : std_ulogic_vector(15 downto 0);
     ci_i32    : std_ulogic_vector(31 downto 0);
-    data      : std_ulogic_vector((2+32)-1 downto 0); -- is_compressed & bus_error & 32-bit instruction
+    data      : std_ulogic_vector((3+32)-1 downto 0); -- predicted_taken & is_compressed & bus_error & 32-bit instruction
     valid     : std_ulogic_vector(1 downto 0); -- data word is valid
     ack       : std_ulogic;
   end record;
@@ -168,7 +189,9 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     opcode    : std_ulogic_vector(6 downto 0);
     is_a_lr   : std_ulogic;
     is_a_sc   : std_ulogic;
+    is_a_amo  : std_ulogic;
     is_f_op   : std_ulogic;
+    is_f_fma  : std_ulogic;
     is_m_mul  : std_ulogic;
     is_m_div  : std_ulogic;
     is_b_imm  : std_ulogic;
@@ -190,6 +213,8 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     ir_nxt       : std_ulogic_vector(31 downto 0);
     is_ci        : std_ulogic; -- current instruction is de-compressed instruction
     is_ci_nxt    : std_ulogic;
+    pred         : std_ulogic; -- current instruction is a predicted-taken branch
+    pred_nxt     : std_ulogic;
     branch_taken : std_ulogic; -- branch condition fulfilled
     pc           : std_ulogic_vector(XLEN-1 downto 0); -- actual PC, corresponding to current executed instruction
     pc_we        : std_ulogic; -- PC update enabled
@@ -257,7 +282,8 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
     mie_mei        : std_ulogic; -- machine external interrupt enable
     mie_mti        : std_ulogic; -- machine timer interrupt enable
     mie_firq       : std_ulogic_vector(15 downto 0); -- fast interrupt enable
-    mip_firq_we    : std_ulogic; -- fast interrupt pending write enable
+    mie_lcofi      : std_ulogic; -- local counter overflow interrupt enable
+    mip_we         : std_ulogic; -- fast interrupt / counter overflow interrupt pending write enable
     --
     privilege      : std_ulogic; -- current privilege mode
     privilege_eff  : std_ulogic; -- current *effective* privilege mode
@@ -296,6 +322,13 @@ architecture neorv32_cpu_control_rtl of neorv32_cpu_control is
   signal hpmevent_rd  : hpmevent_rd_t;
   signal hpmevent_we  : std_ulogic_vector(15 downto 0);
 
+  -- hpm counter overflow (Sscofpmf) --
+  signal hpmeventh_rd : hpmevent_rd_t;
+  signal hpmeventh_we : std_ulogic_vector(15 downto 0);
+  signal hpm_of       : std_ulogic_vector(15 downto 0); -- mhpmeventh.OF: overflow flag
+  signal hpm_ovf      : std_ulogic_vector(15 downto 0); -- counter wraps around
+  signal hpm_lcofi    : std_ulogic; -- set local counter overflow interrupt pending
+
   -- counter CSRs --
   type cnt_dat_t is array (0 to 2+hpm_num_c) of std_ulogic_vector(XLEN-1 downto 0);
   type cnt_nxt_t is array (0 to 2+hpm_num_c) of std_ulogic_vector(XLEN downto 0);
@@ -377,8 +410,12 @@ begin
         when IF_PENDING => -- wait for bus response and write instruction data to prefetch buffer
         -- ------------------------------------------------------------
           if (fetch_engine.resp = '1') then -- wait for bus response
-            fetch_engine.pc    <= std_ulogic_vector(unsigned(fetch_engine.pc) + 4); -- next word
-            fetch_engine.pc(1) <= '0'; -- (re-)align to 32-bit
+            if (btb.hit = '1') then -- predicted-taken branch
+              fetch_engine.pc <= btb.pred & "00"; -- continue at predicted branch destination
+            else
+              fetch_engine.pc    <= std_ulogic_vector(unsigned(fetch_engine.pc) + 4); -- next word
+              fetch_engine.pc(1) <= '0'; -- (re-)align to 32-bit
+            end if;
             if (fetch_engine.restart = '1') or (fetch_engine.reset = '1') then -- restart request due to branch
               fetch_engine.state <= IF_RESTART;
             else -- request next linear instruction word
@@ -407,8 +444,8 @@ begin
   fetch_engine.resp <= bus_rsp_i.ack or bus_rsp_i.err;
 
   -- IPB instruction data and status --
-  ipb.wdata(0) <= (bus_rsp_i.err or i_pmp_fault_i) & bus_rsp_i.data(15 downto 00);
-  ipb.wdata(1) <= (bus_rsp_i.err or i_pmp_fault_i) & bus_rsp_i.data(31 downto 16);
+  ipb.wdata(0) <= btb.hit & (bus_rsp_i.err or i_pmp_fault_i) & bus_rsp_i.data(15 downto 00);
+  ipb.wdata(1) <= btb.hit & (bus_rsp_i.err or i_pmp_fault_i) & bus_rsp_i.data(31 downto 16);
 
   -- IPB write enable --
   ipb.we(0) <= '1' when (fetch_engine.state = IF_PENDING) and (fetch_engine.resp = '1') and
@@ -422,7 +459,79 @@ begin
   bus_req_o.rw    <= '0'; -- read-only
   bus_req_o.src   <= '1'; -- source = instruction fetch
   bus_req_o.rvso  <= '0'; -- cannot be a reservation set operation
+  bus_req_o.amo   <= '0'; -- cannot be an atomic read-modify-write operation
+  bus_req_o.amoop <= (others => '0');
   bus_req_o.fence <= ctrl.lsu_fence; -- fence(.i) operation, valid without STB being set
+  bus_req_o.burst <= '0'; -- number of linear fetches is not known in advance; bursts are left to the i-cache block refills
+
+
+  -- Branch Target Buffer (BTB) ------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  btb_enabled:
+  if CPU_BTB_EN generate
+
+    -- direct-mapped; only aligned 32-bit backward branches/jumps with aligned destination are tracked --
+    btb_update: process(rstn_i, clk_i)
+      variable idx_v : natural range 0 to btb_entries_c-1;
+    begin
+      if (rstn_i = '0') then
+        btb.valid  <= (others => '0');
+        btb.tag    <= (others => (others => '0'));
+        btb.target <= (others => (others => '0'));
+        btb.cnt    <= (others => (others => '0'));
+      elsif rising_edge(clk_i) then
+        idx_v := to_integer(unsigned(execute_engine.pc(btb_idx_c+1 downto 2)));
+        if (ctrl.lsu_fence = '1') then -- instruction stream might have been modified
+          btb.valid <= (others => '0');
+        elsif (execute_engine.state = BRANCH) and (btb.upd = '1') then
+          if (btb.valid(idx_v) = '1') and (btb.tag(idx_v) = execute_engine.pc(XLEN-1 downto btb_idx_c+2)) then -- entry hit: train counter
+            if (execute_engine.branch_taken = '1') and (btb.cnt(idx_v) /= "11") then
+              btb.cnt(idx_v) <= std_ulogic_vector(unsigned(btb.cnt(idx_v)) + 1);
+            elsif (execute_engine.branch_taken = '0') and (btb.cnt(idx_v) /= "00") then
+              btb.cnt(idx_v) <= std_ulogic_vector(unsigned(btb.cnt(idx_v)) - 1);
+            end if;
+          elsif (execute_engine.branch_taken = '1') then -- entry miss: allocate taken branches only
+            btb.valid(idx_v)  <= '1';
+            btb.tag(idx_v)    <= execute_engine.pc(XLEN-1 downto btb_idx_c+2);
+            btb.target(idx_v) <= alu_add_i(XLEN-1 downto 2);
+            btb.cnt(idx_v)    <= "10"; -- weakly taken
+          end if;
+        end if;
+      end if;
+    end process btb_update;
+
+    -- executed branch can be tracked --
+    btb.upd <= '1' when (trap_ctrl.exc_buf(exc_illegal_c) = '0') and -- valid instruction
+                        ((decode_aux.opcode = opcode_branch_c) or (decode_aux.opcode = opcode_jal_c)) and -- PC-relative destination
+                        (execute_engine.ir(31) = '1') and -- negative offset (backward)
+                        (execute_engine.is_ci = '0') and (execute_engine.pc(1) = '0') and (alu_add_i(1) = '0') else '0'; -- aligned
+
+    -- prediction for the current fetch address --
+    btb_lookup: process(btb.valid, btb.tag, btb.target, btb.cnt, fetch_engine.pc)
+      variable idx_v : natural range 0 to btb_entries_c-1;
+    begin
+      idx_v := to_integer(unsigned(fetch_engine.pc(btb_idx_c+1 downto 2)));
+      btb.pred <= btb.target(idx_v);
+      if (btb.valid(idx_v) = '1') and (btb.tag(idx_v) = fetch_engine.pc(XLEN-1 downto btb_idx_c+2)) and
+         (btb.cnt(idx_v)(1) = '1') and (fetch_engine.pc(1) = '0') then
+        btb.hit <= '1';
+      else
+        btb.hit <= '0';
+      end if;
+    end process btb_lookup;
+
+  end generate; -- /btb_enabled
+
+  btb_disabled:
+  if not CPU_BTB_EN generate
+    btb.valid  <= (others => '0');
+    btb.tag    <= (others => (others => '0'));
+    btb.target <= (others => (others => '0'));
+    btb.cnt    <= (others => (others => '0'));
+    btb.hit    <= '0';
+    btb.pred   <= (others => '0');
+    btb.upd    <= '0';
+  end generate; -- /btb_disabled
 
 
   -- Instruction Prefetch Buffer (FIFO) -----------------------------------------------------
@@ -431,7 +540,7 @@ begin
   for i in 0 to 1 generate -- low half-word + high half-word (incl. status bits)
     prefetch_buffer_inst: entity neorv32.neorv32_fifo
     generic map (
-      FIFO_DEPTH => 2,                   -- number of fifo entries; has to be a power of two, min 2
+      FIFO_DEPTH => CPU_IPB_DEPTH,       -- number of fifo entries; has to be a power of two, min 2
       FIFO_WIDTH => ipb.wdata(i)'length, -- size of data elements in fifo
       FIFO_RSYNC => false,               -- we NEED to read data asynchronously
       FIFO_SAFE  => false,               -- no safe access required (ensured by FIFO-external logic)
@@ -508,20 +617,20 @@ begin
         if (ipb.rdata(0)(1 downto 0) /= "11") then -- compressed, use IPB(0) entry
           issue_engine.align_set <= ipb.avail(0); -- start of next instruction word is NOT 32-bit-aligned
           issue_engine.valid(0)  <= ipb.avail(0);
-          issue_engine.data      <= '1' & ipb.rdata(0)(16) & issue_engine.ci_i32;
+          issue_engine.data      <= '0' & '1' & ipb.rdata(0)(16) & issue_engine.ci_i32;
         else -- aligned uncompressed; use IPB(0) status flags only
           issue_engine.valid <= (others => (ipb.avail(0) and ipb.avail(1)));
-          issue_engine.data  <= '0' & ipb.rdata(0)(16) & ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0);
+          issue_engine.data  <= ipb.rdata(0)(17) & '0' & ipb.rdata(0)(16) & ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0);
         end if;
       -- start with HIGH half-word --
       else
         if (ipb.rdata(1)(1 downto 0) /= "11") then -- compressed, use IPB(1) entry
           issue_engine.align_clr <= ipb.avail(1); -- start of next instruction word is 32-bit-aligned again
           issue_engine.valid(1)  <= ipb.avail(1);
-          issue_engine.data      <= '1' & ipb.rdata(1)(16) & issue_engine.ci_i32;
+          issue_engine.data      <= '0' & '1' & ipb.rdata(1)(16) & issue_engine.ci_i32;
         else -- unaligned uncompressed; use IPB(0) status flags only
           issue_engine.valid <= (others => (ipb.avail(0) and ipb.avail(1)));
-          issue_engine.data  <= '0' & ipb.rdata(0)(16) & ipb.rdata(0)(15 downto 0) & ipb.rdata(1)(15 downto 0);
+          issue_engine.data  <= '0' & '0' & ipb.rdata(0)(16) & ipb.rdata(0)(15 downto 0) & ipb.rdata(1)(15 downto 0);
         end if;
       end if;
     end process issue_engine_fsm_comb;
@@ -531,7 +640,7 @@ begin
   issue_engine_disabled: -- use IPB(0) status flags only
   if not CPU_EXTENSION_RISCV_C generate
     issue_engine.valid <= (others => ipb.avail(0));
-    issue_engine.data  <= '0' & ipb.rdata(0)(16) & (ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0));
+    issue_engine.data  <= ipb.rdata(0)(17) & '0' & ipb.rdata(0)(16) & (ipb.rdata(1)(15 downto 0) & ipb.rdata(0)(15 downto 0));
   end generate; -- /issue_engine_disabled
 
   -- update IPB FIFOs --
@@ -613,6 +722,7 @@ begin
       execute_engine.state   <= RESTART;
       execute_engine.ir      <= (others => '0');
       execute_engine.is_ci   <= '0';
+      execute_engine.pred    <= '0';
       execute_engine.pc      <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
       execute_engine.next_pc <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
       execute_engine.link_pc <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
@@ -624,6 +734,7 @@ begin
       execute_engine.state <= execute_engine.state_nxt;
       execute_engine.ir    <= execute_engine.ir_nxt;
       execute_engine.is_ci <= execute_engine.is_ci_nxt;
+      execute_engine.pred  <= execute_engine.pred_nxt;
 
       -- current PC: address of instruction being executed --
       if (execute_engine.pc_we = '1') then
@@ -693,8 +804,10 @@ begin
   begin
     -- defaults --
     decode_aux.is_f_op   <= '0';
+    decode_aux.is_f_fma  <= '0';
     decode_aux.is_a_lr   <= '0';
     decode_aux.is_a_sc   <= '0';
+    decode_aux.is_a_amo  <= '0';
     decode_aux.is_m_mul  <= '0';
     decode_aux.is_m_div  <= '0';
     decode_aux.is_b_imm  <= '0';
@@ -708,6 +821,16 @@ begin
       decode_aux.is_a_lr <= not execute_engine.ir(instr_funct7_lsb_c+2); -- LR.W
       decode_aux.is_a_sc <=     execute_engine.ir(instr_funct7_lsb_c+2); -- SC.W
     end if;
+    if (CPU_EXTENSION_RISCV_A = true) and -- implemented at all?
+       (execute_engine.ir(instr_funct3_msb_c downto instr_funct3_lsb_c) = "010") then
+      case execute_engine.ir(instr_funct7_msb_c downto instr_funct7_lsb_c+2) is
+        when "00000" | "00001" | "00100" | "01000" | "01100" | -- AMOADD.W, AMOSWAP.W, AMOXOR.W, AMOOR.W, AMOAND.W
+             "10000" | "10100" | "11000" | "11100" => -- AMOMIN.W, AMOMAX.W, AMOMINU.W, AMOMAXU.W
+          decode_aux.is_a_amo <= '1';
+        when others =>
+          decode_aux.is_a_amo <= '0';
+      end case;
+    end if;
 
     -- BITMANIP instruction --
     if (CPU_EXTENSION_RISCV_B = true) then -- implemented at all?
@@ -763,6 +886,10 @@ begin
           decode_aux.is_f_op <= '1';
         end if;
       end if;
+      -- F[N]MADD.S / F[N]MSUB.S --
+      if (execute_engine.ir(instr_funct7_lsb_c+1 downto instr_funct7_lsb_c) = float_single_c) then -- single-precision operations only
+        decode_aux.is_f_fma <= '1';
+      end if;
     end if;
 
     -- integer MUL (M/Zmmul) / DIV (M) instruction --
@@ -798,6 +925,7 @@ begin
     execute_engine.state_nxt <= execute_engine.state;
     execute_engine.ir_nxt    <= execute_engine.ir;
     execute_engine.is_ci_nxt <= execute_engine.is_ci;
+    execute_engine.pred_nxt  <= execute_engine.pred;
     execute_engine.pc_we     <= '0';
     --
     issue_engine.ack         <= '0';
@@ -840,8 +968,8 @@ begin
     end case;
 
     -- memory read/write access --
-    if (CPU_EXTENSION_RISCV_A = true) and (decode_aux.opcode(2) = opcode_amo_c(2)) then -- lr/sc
-      ctrl_nxt.lsu_rw <= execute_engine.ir(instr_funct7_lsb_c+2);
+    if (CPU_EXTENSION_RISCV_A = true) and (decode_aux.opcode(2) = opcode_amo_c(2)) then -- lr/sc/amo
+      ctrl_nxt.lsu_rw <= execute_engine.ir(instr_funct7_lsb_c+2) or decode_aux.is_a_amo; -- AMOs are store-type accesses
     else -- normal load/store
       ctrl_nxt.lsu_rw <= execute_engine.ir(5);
     end if;
@@ -861,6 +989,7 @@ begin
           issue_engine.ack         <= '1';
           trap_ctrl.instr_be       <= issue_engine.data(32); -- access fault during instruction fetch
           execute_engine.is_ci_nxt <= issue_engine.data(33); -- this is a de-compressed instruction
+          execute_engine.pred_nxt  <= issue_engine.data(34); -- this is a predicted-taken branch
           execute_engine.ir_nxt    <= issue_engine.data(31 downto 0); -- instruction word
           execute_engine.pc_we     <= '1'; -- pc <= next_pc
           execute_engine.state_nxt <= EXECUTE;
@@ -960,7 +1089,7 @@ begin
             execute_engine.state_nxt <= FENCE;
 
           -- FPU: floating-point operations --
-          when opcode_fop_c =>
+          when opcode_fop_c | opcode_fmadd_c | opcode_fmsub_c | opcode_fnmsub_c | opcode_fnmadd_c =>
             ctrl_nxt.alu_cp_trig(cp_sel_fpu_c) <= '1'; -- trigger FPU co-processor
             execute_engine.state_nxt           <= ALU_WAIT; -- will be aborted via monitor exception if FPU not implemented
 
@@ -997,7 +1126,9 @@ begin
       -- ------------------------------------------------------------
         ctrl_nxt.rf_mux   <= rf_mux_ret_c; -- return address = link PC
         ctrl_nxt.rf_wb_en <= execute_engine.ir(instr_opcode_lsb_c+2); -- save return address if link operation (will not happen if misaligned)
-        if (trap_ctrl.exc_buf(exc_illegal_c) = '0') and (execute_engine.branch_taken = '1') then -- valid taken branch
+        if (trap_ctrl.exc_buf(exc_illegal_c) = '0') and (execute_engine.branch_taken = '1') and (execute_engine.pred = '1') then -- correctly predicted
+          execute_engine.state_nxt <= DISPATCH; -- instruction fetch has already been redirected to the branch destination
+        elsif ((trap_ctrl.exc_buf(exc_illegal_c) = '0') and (execute_engine.branch_taken = '1')) or (execute_engine.pred = '1') then -- taken or mispredicted
           fetch_engine.reset       <= '1'; -- reset instruction fetch to restart at modified PC
           execute_engine.state_nxt <= BRANCHED; -- shortcut (faster than going to RESTART)
         else
@@ -1195,7 +1326,10 @@ begin
            csr_mhpmcounter13h_c | csr_mhpmcounter14h_c | csr_mhpmcounter15h_c | -- machine counters HIGH
            csr_mhpmevent3_c     | csr_mhpmevent4_c     | csr_mhpmevent5_c     | csr_mhpmevent6_c     | csr_mhpmevent7_c     |
            csr_mhpmevent8_c     | csr_mhpmevent9_c     | csr_mhpmevent10_c    | csr_mhpmevent11_c    | csr_mhpmevent12_c    |
-           csr_mhpmevent13_c    | csr_mhpmevent14_c    | csr_mhpmevent15_c => -- machine event configuration
+           csr_mhpmevent13_c    | csr_mhpmevent14_c    | csr_mhpmevent15_c    | -- machine event configuration
+           csr_mhpmevent3h_c    | csr_mhpmevent4h_c    | csr_mhpmevent5h_c    | csr_mhpmevent6h_c    | csr_mhpmevent7h_c    |
+           csr_mhpmevent8h_c    | csr_mhpmevent9h_c    | csr_mhpmevent10h_c   | csr_mhpmevent11h_c   | csr_mhpmevent12h_c   |
+           csr_mhpmevent13h_c   | csr_mhpmevent14h_c   | csr_mhpmevent15h_c => -- machine event configuration HIGH (Sscofpmf)
         csr_reg_valid <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zihpm); -- available if Zihpm implemented
 
       -- counter and timer CSRs --
@@ -1288,7 +1422,7 @@ begin
         end case;
 
       when opcode_amo_c =>
-        if (CPU_EXTENSION_RISCV_A = true) and ((decode_aux.is_a_lr = '1') or (decode_aux.is_a_sc = '1')) then -- LR.W/SC.W
+        if (CPU_EXTENSION_RISCV_A = true) and ((decode_aux.is_a_lr = '1') or (decode_aux.is_a_sc = '1') or (decode_aux.is_a_amo = '1')) then -- LR.W/SC.W/AMO*.W
           illegal_cmd <= '0';
         else
           illegal_cmd <= '1';
@@ -1359,6 +1493,9 @@ begin
       when opcode_fop_c =>
         illegal_cmd <= (not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zfinx)) or (not decode_aux.is_f_op);
 
+      when opcode_fmadd_c | opcode_fmsub_c | opcode_fnmsub_c | opcode_fnmadd_c =>
+        illegal_cmd <= (not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zfinx)) or (not decode_aux.is_f_fma);
+
       when opcode_cust0_c | opcode_cust1_c | opcode_cust2_c | opcode_cust3_c =>
         illegal_cmd <= not bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zxcfu); -- all encodings valid if CFU enable
 
@@ -1456,11 +1593,18 @@ begin
       for i in 0 to 15 loop
         if (firq_i(i) = '1') then -- new incoming FIRQs have priority
           trap_ctrl.irq_pnd(irq_firq_0_c+i) <= '1';
-        elsif (csr.mip_firq_we = '1') and (csr.wmask(16+i) = '0') then -- clear-only
+        elsif (csr.mip_we = '1') and (csr.wmask(16+i) = '0') then -- clear-only
           trap_ctrl.irq_pnd(irq_firq_0_c+i) <= '0';
         end if;
       end loop;
 
+      -- RISC-V local counter overflow interrupt (set on mhpmeventh.OF 0-to-1 transition) --
+      if (hpm_lcofi = '1') then -- new overflows have priority
+        trap_ctrl.irq_pnd(irq_lcofi_c) <= '1';
+      elsif (csr.mip_we = '1') and (csr.wmask(13) = '0') then -- clear-only
+        trap_ctrl.irq_pnd(irq_lcofi_c) <= '0';
+      end if;
+
       -- debug-mode entry --
       trap_ctrl.irq_pnd(irq_db_halt_c) <= '0'; -- unused
       trap_ctrl.irq_pnd(irq_db_step_c) <= '0'; -- unused
@@ -1475,6 +1619,7 @@ begin
       trap_ctrl.irq_buf(irq_msi_irq_c) <= (trap_ctrl.irq_pnd(irq_msi_irq_c) and csr.mie_msi) or (trap_ctrl.env_pending and trap_ctrl.irq_buf(irq_msi_irq_c));
       trap_ctrl.irq_buf(irq_mei_irq_c) <= (trap_ctrl.irq_pnd(irq_mei_irq_c) and csr.mie_mei) or (trap_ctrl.env_pending and trap_ctrl.irq_buf(irq_mei_irq_c));
       trap_ctrl.irq_buf(irq_mti_irq_c) <= (trap_ctrl.irq_pnd(irq_mti_irq_c) and csr.mie_mti) or (trap_ctrl.env_pending and trap_ctrl.irq_buf(irq_mti_irq_c));
+      trap_ctrl.irq_buf(irq_lcofi_c)   <= (trap_ctrl.irq_pnd(irq_lcofi_c)   and csr.mie_lcofi) or (trap_ctrl.env_pending and trap_ctrl.irq_buf(irq_lcofi_c));
 
       -- NEORV32-specific fast interrupts --
       for i in 0 to 15 loop
@@ -1536,6 +1681,7 @@ begin
       elsif (trap_ctrl.irq_buf(irq_mei_irq_c)  = '1') then trap_ctrl.cause <= trap_mei_c; -- machine external interrupt (MEI)
       elsif (trap_ctrl.irq_buf(irq_msi_irq_c)  = '1') then trap_ctrl.cause <= trap_msi_c; -- machine software interrupt (MSI)
       elsif (trap_ctrl.irq_buf(irq_mti_irq_c)  = '1') then trap_ctrl.cause <= trap_mti_c; -- machine timer interrupt (MTI)
+      elsif (trap_ctrl.irq_buf(irq_lcofi_c)    = '1') then trap_ctrl.cause <= trap_lcofi_c; -- local counter overflow interrupt (LCOFI)
       --
       else trap_ctrl.cause <= trap_mti_c; end if; -- don't care
     end if;
@@ -1569,7 +1715,7 @@ begin
   -- any interrupt? --
   trap_ctrl.irq_fire <= '1' when
     (
-     (or_reduce_f(trap_ctrl.irq_buf(irq_firq_15_c downto irq_msi_irq_c)) = '1') and -- pending IRQ
+     (or_reduce_f(trap_ctrl.irq_buf(irq_lcofi_c downto irq_msi_irq_c)) = '1') and -- pending IRQ
      ((csr.mstatus_mie = '1') or (csr.privilege = priv_mode_u_c)) and -- take IRQ when in M-mode and MIE=1 OR when in U-mode
      (debug_ctrl.running = '0') and (csr.dcsr_step = '0') -- no IRQs when in debug-mode or during debug single-stepping
     ) or
@@ -1645,6 +1791,7 @@ begin
       csr.mie_mei        <= '0';
       csr.mie_mti        <= '0';
       csr.mie_firq       <= (others => '0');
+      csr.mie_lcofi      <= '0';
       csr.mtvec          <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
       csr.mscratch       <= x"19880704";
       csr.mepc           <= CPU_BOOT_ADDR(XLEN-1 downto 2) & "00"; -- 32-bit aligned boot address
@@ -1692,6 +1839,9 @@ begin
             csr.mie_mti  <= csr.wdata(07);
             csr.mie_mei  <= csr.wdata(11);
             csr.mie_firq <= csr.wdata(31 downto 16);
+            if (CPU_EXTENSION_RISCV_Zihpm = true) then
+              csr.mie_lcofi <= csr.wdata(13);
+            end if;
 
           when csr_mtvec_c => -- machine trap-handler base address
             if (csr.wdata(1 downto 0) = "01") then
@@ -1921,7 +2071,7 @@ begin
   end process csr_write_access;
 
   -- out-of-process CSR write access --
-  csr.mip_firq_we   <= '1' when (csr.we = '1') and (csr.cmd(0) = '1') and (csr.addr = csr_mip_c)    else '0'; -- mip.firq: write/clear only
+  csr.mip_we        <= '1' when (csr.we = '1') and (csr.cmd(0) = '1') and (csr.addr = csr_mip_c)    else '0'; -- mip.firq/lcofi: write/clear only
   csr.tdata1_hit_we <= '1' when (csr.we = '1') and (csr.cmd(0) = '1') and (csr.addr = csr_tdata1_c) else '0'; -- tdata1.hit: write/clear only
 
   -- effective privilege mode is MACHINE when in debug mode --
@@ -1930,7 +2080,7 @@ begin
 
   -- CSR Read Access ------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  csr_read_access: process(csr, trap_ctrl.irq_pnd, hpmevent_rd, cnt_lo_rd, cnt_hi_rd)
+  csr_read_access: process(csr, trap_ctrl.irq_pnd, hpmevent_rd, hpmeventh_rd, cnt_lo_rd, cnt_hi_rd)
   begin
     csr_rdata <= (others => '0'); -- default
     case csr.raddr is
@@ -1962,6 +2112,7 @@ begin
         csr_rdata(03) <= csr.mie_msi;
         csr_rdata(07) <= csr.mie_mti;
         csr_rdata(11) <= csr.mie_mei;
+        csr_rdata(13) <= csr.mie_lcofi;
         csr_rdata(31 downto 16) <= csr.mie_firq;
 
       when csr_mtvec_c => -- machine trap-handler base address
@@ -2004,6 +2155,7 @@ begin
         csr_rdata(03)           <= trap_ctrl.irq_pnd(irq_msi_irq_c);
         csr_rdata(07)           <= trap_ctrl.irq_pnd(irq_mti_irq_c);
         csr_rdata(11)           <= trap_ctrl.irq_pnd(irq_mei_irq_c);
+        csr_rdata(13)           <= trap_ctrl.irq_pnd(irq_lcofi_c);
         csr_rdata(31 downto 16) <= trap_ctrl.irq_pnd(irq_firq_15_c downto irq_firq_0_c);
 
       when csr_mtinst_c => -- machine trap instruction
@@ -2038,6 +2190,21 @@ begin
       when csr_mhpmevent14_c => if (hpm_num_c > 11) then csr_rdata <= hpmevent_rd(14); end if;
       when csr_mhpmevent15_c => if (hpm_num_c > 12) then csr_rdata <= hpmevent_rd(15); end if;
 
+      -- HPM event configuration, high words (Sscofpmf) --
+      when csr_mhpmevent3h_c  => if (hpm_num_c > 00) then csr_rdata <= hpmeventh_rd(03); end if;
+      when csr_mhpmevent4h_c  => if (hpm_num_c > 01) then csr_rdata <= hpmeventh_rd(04); end if;
+      when csr_mhpmevent5h_c  => if (hpm_num_c > 02) then csr_rdata <= hpmeventh_rd(05); end if;
+      when csr_mhpmevent6h_c  => if (hpm_num_c > 03) then csr_rdata <= hpmeventh_rd(06); end if;
+      when csr_mhpmevent7h_c  => if (hpm_num_c > 04) then csr_rdata <= hpmeventh_rd(07); end if;
+      when csr_mhpmevent8h_c  => if (hpm_num_c > 05) then csr_rdata <= hpmeventh_rd(08); end if;
+      when csr_mhpmevent9h_c  => if (hpm_num_c > 06) then csr_rdata <= hpmeventh_rd(09); end if;
+      when csr_mhpmevent10h_c => if (hpm_num_c > 07) then csr_rdata <= hpmeventh_rd(10); end if;
+      when csr_mhpmevent11h_c => if (hpm_num_c > 08) then csr_rdata <= hpmeventh_rd(11); end if;
+      when csr_mhpmevent12h_c => if (hpm_num_c > 09) then csr_rdata <= hpmeventh_rd(12); end if;
+      when csr_mhpmevent13h_c => if (hpm_num_c > 10) then csr_rdata <= hpmeventh_rd(13); end if;
+      when csr_mhpmevent14h_c => if (hpm_num_c > 11) then csr_rdata <= hpmeventh_rd(14); end if;
+      when csr_mhpmevent15h_c => if (hpm_num_c > 12) then csr_rdata <= hpmeventh_rd(15); end if;
+
       -- --------------------------------------------------------------------
       -- counters and timers --
       -- --------------------------------------------------------------------
@@ -2121,9 +2288,11 @@ begin
         csr_rdata(09) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zihpm);  -- Zihpm: hardware performance monitors
         csr_rdata(10) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Sdext);  -- Sdext: RISC-V (external) debug mode
         csr_rdata(11) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Sdtrig); -- Sdtrig: trigger module
+        csr_rdata(12) <= bool_to_ulogic_f(CPU_EXTENSION_RISCV_Zihpm);  -- Sscofpmf: counter overflow interrupts
         -- misc --
         csr_rdata(20) <= bool_to_ulogic_f(is_simulation_c);            -- is this a simulation?
         -- tuning options --
+        csr_rdata(28) <= bool_to_ulogic_f(CPU_BTB_EN);                 -- branch target buffer
         csr_rdata(29) <= bool_to_ulogic_f(REGFILE_HW_RST);             -- full hardware reset of register file
         csr_rdata(30) <= bool_to_ulogic_f(FAST_MUL_EN);                -- DSP-based multiplication (M extensions only)
         csr_rdata(31) <= bool_to_ulogic_f(FAST_SHIFT_EN);              -- parallel logic for shifts (barrel shifters)
@@ -2281,6 +2450,54 @@ begin
       hpmevent_rd(i)  <= (others => '0');
     end generate;
 
+    -- overflow detection: enabled event while the (constrained) counter is all-ones --
+    hpm_overflow: process(cnt)
+    begin
+      hpm_ovf <= (others => '0');
+      if (hpm_cnt_lo_width_c > 0) then
+        for i in 3 to (hpm_num_c+3)-1 loop
+          hpm_ovf(i) <= cnt.inc(i) and (not cnt.we_lo(i)) and (not cnt.we_hi(i)) and
+                        and_reduce_f(cnt.lo(i)(hpm_cnt_lo_width_c-1 downto 0)) and
+                        and_reduce_f(cnt.hi(i)(hpm_cnt_hi_width_c-1 downto 0)); -- [NOTE] null range (= 1) if width <= 32
+        end loop;
+      end if;
+    end process hpm_overflow;
+
+    -- write enable decoder (mhpmevent*h) --
+    hpmeventh_write: process(csr)
+    begin
+      hpmeventh_we <= (others => '0');
+      if (csr.addr(11 downto 4) = csr_mhpmevent3h_c(11 downto 4)) and (csr.we = '1') then
+        hpmeventh_we(to_integer(unsigned(csr.addr(3 downto 0)))) <= '1';
+      end if;
+    end process hpmeventh_write;
+
+    -- overflow flags (mhpmevent*h.OF) --
+    hpm_of_reg: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        hpm_of <= (others => '0');
+      elsif rising_edge(clk_i) then
+        for i in 3 to (hpm_num_c+3)-1 loop
+          if (hpmeventh_we(i) = '1') then
+            hpm_of(i) <= csr.wdata(31);
+          elsif (hpm_ovf(i) = '1') then
+            hpm_of(i) <= '1';
+          end if;
+        end loop;
+      end if;
+    end process hpm_of_reg;
+
+    -- raise LCOFI only if the according overflow flag was not already set --
+    hpm_lcofi <= or_reduce_f(hpm_ovf and (not hpm_of));
+
+    -- read-back --
+    hpmeventh_gen:
+    for i in 3 to 15 generate
+      hpmeventh_rd(i)(XLEN-1)          <= hpm_of(i);
+      hpmeventh_rd(i)(XLEN-2 downto 0) <= (others => '0');
+    end generate;
+
   end generate;
 
 
@@ -2289,6 +2506,10 @@ begin
   if (not CPU_EXTENSION_RISCV_Zihpm) or (hpm_num_c = 0) generate
     hpmevent_cfg <= (others => (others => '0'));
     hpmevent_rd  <= (others => (others => '0'));
+    hpmeventh_rd <= (others => (others => '0'));
+    hpm_ovf      <= (others => '0');
+    hpm_of       <= (others => '0');
+    hpm_lcofi    <= '0';
   end generate;
 
 
@@ -2325,7 +2546,7 @@ begin
   cnt_event(hpmcnt_event_wait_alu_c) <= '1' when (execute_engine.state = ALU_WAIT)                                   else '0'; -- multi-cycle ALU co-processor wait cycle
 
   cnt_event(hpmcnt_event_branch_c)   <= '1' when (execute_engine.state = BRANCH)   else '0'; -- executed branch instruction
-  cnt_event(hpmcnt_event_branched_c) <= '1' when (execute_engine.state = BRANCHED) else '0'; -- control flow transfer
+  cnt_event(hpmcnt_event_branched_c) <= '1' when (execute_engine.state = BRANCHED) or (cnt_event(hpmcnt_event_bp_hit_c) = '1') else '0'; -- control flow transfer
 
   cnt_event(hpmcnt_event_load_c)     <= '1' when (ctrl.lsu_req = '1') and (ctrl.lsu_rw = '0')               else '0'; -- executed load operation
   cnt_event(hpmcnt_event_store_c)    <= '1' when (ctrl.lsu_req = '1') and (ctrl.lsu_rw = '1')               else '0'; -- executed store operation
@@ -2333,6 +2554,27 @@ begin
 
   cnt_event(hpmcnt_event_trap_c)     <= '1' when (trap_ctrl.env_enter = '1') else '0'; -- entered trap
 
+  cnt_event(hpmcnt_event_bp_hit_c)   <= '1' when (execute_engine.state = BRANCH) and (execute_engine.pred = '1') and -- correctly predicted taken branch
+                                                 (trap_ctrl.exc_buf(exc_illegal_c) = '0') and (execute_engine.branch_taken = '1') else '0';
+  cnt_event(hpmcnt_event_bp_miss_c)  <= '1' when (execute_engine.state = BRANCH) and (execute_engine.pred /= -- mispredicted branch (including taken-but-not-predicted)
+                                                 ((not trap_ctrl.exc_buf(exc_illegal_c)) and execute_engine.branch_taken)) else '0';
+
+  -- processor-specific counter events (for HPM counters only) --
+  cnt_event(hpmcnt_event_ic_pf_c)    <= hpm_ev_i(hpmcnt_event_ic_pf_c);    -- i-cache prefetch issued
+  cnt_event(hpmcnt_event_ic_pfhit_c) <= hpm_ev_i(hpmcnt_event_ic_pfhit_c); -- i-cache prefetch useful
+  cnt_event(hpmcnt_event_ic_hit_c)   <= hpm_ev_i(hpmcnt_event_ic_hit_c);   -- i-cache hit
+  cnt_event(hpmcnt_event_ic_miss_c)  <= hpm_ev_i(hpmcnt_event_ic_miss_c);  -- i-cache miss
+  cnt_event(hpmcnt_event_dc_hit_c)   <= hpm_ev_i(hpmcnt_event_dc_hit_c);   -- d-cache hit
+  cnt_event(hpmcnt_event_dc_miss_c)  <= hpm_ev_i(hpmcnt_event_dc_miss_c);  -- d-cache miss
+  cnt_event(hpmcnt_event_xip_miss_c) <= hpm_ev_i(hpmcnt_event_xip_miss_c); -- XIP cache miss
+  cnt_event(hpmcnt_event_bus_wait_c) <= hpm_ev_i(hpmcnt_event_bus_wait_c); -- bus switch arbitration stall cycle
+  cnt_event(hpmcnt_event_dma_busy_c) <= hpm_ev_i(hpmcnt_event_dma_busy_c); -- DMA bus access in progress
+  cnt_event(hpmcnt_event_xb_wait_c)  <= hpm_ev_i(hpmcnt_event_xb_wait_c);  -- crossbar section port arbitration stall cycle
+  cnt_event(hpmcnt_event_xb_para_c)  <= hpm_ev_i(hpmcnt_event_xb_para_c);  -- crossbar parallel section port accesses
+
+  -- interrupt latency: enabled interrupt is pending but the trap has not been entered yet --
+  cnt_event(hpmcnt_event_irq_wait_c) <= '1' when (trap_ctrl.irq_fire = '1') and (trap_ctrl.env_enter = '0') else '0';
+
 
 -- ****************************************************************************************************************************
 -- CPU Debug Mode (Part of the On-Chip Debugger)
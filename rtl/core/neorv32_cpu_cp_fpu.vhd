@@ -11,8 +11,10 @@
 -- # * Multiplication (FMUL instruction) will infer DSP blocks (if available).                     #
 -- # * Subnormal numbers are not supported yet - they are "flushed to zero" before entering the    #
 -- #   actual FPU core.                                                                            #
--- # * Division and square root operations (FDIV, FSQRT) and fused multiply-accumulate operations  #
--- #   (F[N]MADD) are not supported yet - they will raise an illegal instruction exception.        #
+-- # * Fused multiply-add operations (F[N]MADD, F[N]MSUB) re-use the multiplier's full-precision   #
+-- #   product and an extra-wide adder so the result is rounded only once.                         #
+-- # * Division and square root operations (FDIV, FSQRT) are not supported yet - they will raise   #
+-- #   an illegal instruction exception.                                                           #
 -- # * Rounding mode <100> ("round to nearest, ties to max magnitude") is not supported yet.       #
 -- # * Signaling NaNs (sNaN) will not be generated by the hardware at all. However, if inserted by #
 -- #   the programmer they are handled correctly.                                                  #
@@ -84,14 +86,15 @@ end neorv32_cpu_cp_fpu;
 architecture neorv32_cpu_cp_fpu_rtl of neorv32_cpu_cp_fpu is
 
   -- FPU core functions --
-  constant op_class_c  : std_ulogic_vector(2 downto 0) := "000";
-  constant op_comp_c   : std_ulogic_vector(2 downto 0) := "001";
-  constant op_i2f_c    : std_ulogic_vector(2 downto 0) := "010";
-  constant op_f2i_c    : std_ulogic_vector(2 downto 0) := "011";
-  constant op_sgnj_c   : std_ulogic_vector(2 downto 0) := "100";
-  constant op_minmax_c : std_ulogic_vector(2 downto 0) := "101";
-  constant op_addsub_c : std_ulogic_vector(2 downto 0) := "110";
-  constant op_mul_c    : std_ulogic_vector(2 downto 0) := "111";
+  constant op_class_c  : std_ulogic_vector(3 downto 0) := "0000";
+  constant op_comp_c   : std_ulogic_vector(3 downto 0) := "0001";
+  constant op_i2f_c    : std_ulogic_vector(3 downto 0) := "0010";
+  constant op_f2i_c    : std_ulogic_vector(3 downto 0) := "0011";
+  constant op_sgnj_c   : std_ulogic_vector(3 downto 0) := "0100";
+  constant op_minmax_c : std_ulogic_vector(3 downto 0) := "0101";
+  constant op_addsub_c : std_ulogic_vector(3 downto 0) := "0110";
+  constant op_mul_c    : std_ulogic_vector(3 downto 0) := "0111";
+  constant op_fma_c    : std_ulogic_vector(3 downto 0) := "1000";
 
   -- FPU CSRs --
   signal csr_frm    : std_ulogic_vector(2 downto 0); -- FPU rounding mode
@@ -162,10 +165,11 @@ architecture neorv32_cpu_cp_fpu_rtl of neorv32_cpu_cp_fpu is
     instr_minmax : std_ulogic;
     instr_addsub : std_ulogic;
     instr_mul    : std_ulogic;
-    funct        : std_ulogic_vector(2 downto 0);
+    instr_fma    : std_ulogic;
+    funct        : std_ulogic_vector(3 downto 0);
   end record;
   signal cmd : cmd_t;
-  signal funct_ff : std_ulogic_vector(2 downto 0);
+  signal funct_ff : std_ulogic_vector(3 downto 0);
 
   -- co-processor control engine --
   type ctrl_state_t is (S_IDLE, S_BUSY);
@@ -177,13 +181,15 @@ architecture neorv32_cpu_cp_fpu_rtl of neorv32_cpu_cp_fpu is
   signal ctrl_engine : ctrl_engine_t;
 
   -- floating-point operands --
-  type op_data_t  is array (0 to 1) of std_ulogic_vector(31 downto 0);
-  type op_class_t is array (0 to 1) of std_ulogic_vector(09 downto 0);
+  type op_data_t  is array (0 to 2) of std_ulogic_vector(31 downto 0);
+  type op_class_t is array (0 to 2) of std_ulogic_vector(09 downto 0);
   type fpu_operands_t is record
     rs1       : std_ulogic_vector(31 downto 0); -- operand 1
     rs1_class : std_ulogic_vector(09 downto 0); -- operand 1 number class
     rs2       : std_ulogic_vector(31 downto 0); -- operand 2
     rs2_class : std_ulogic_vector(09 downto 0); -- operand 2 number class
+    rs3       : std_ulogic_vector(31 downto 0); -- operand 3 (fused multiply-add only)
+    rs3_class : std_ulogic_vector(09 downto 0); -- operand 3 number class
     frm       : std_ulogic_vector(02 downto 0); -- rounding mode
   end record;
   signal op_data      : op_data_t;
@@ -209,6 +215,7 @@ architecture neorv32_cpu_cp_fpu_rtl of neorv32_cpu_cp_fpu is
   signal fu_conv_f2i    : fu_interface_t;
   signal fu_addsub      : fu_interface_t;
   signal fu_mul         : fu_interface_t;
+  signal fu_fma         : fu_interface_t;
   signal fu_core_done   : std_ulogic; -- FU operation completed
 
   -- integer-to-float --
@@ -270,6 +277,25 @@ architecture neorv32_cpu_cp_fpu_rtl of neorv32_cpu_cp_fpu is
   end record;
   signal addsub : addsub_t;
 
+  -- fused multiply-add unit --
+  type fma_state_t is (S_IDLE, S_MUL, S_ALIGN, S_ADD, S_NORM);
+  type fma_t is record
+    state     : fma_state_t;
+    p_sign    : std_ulogic; -- effective product sign
+    c_sign    : std_ulogic; -- effective addend sign
+    swap      : std_ulogic; -- 0: product is larger, 1: addend is larger
+    dist      : unsigned(09 downto 0); -- exponent difference (alignment shift)
+    exp       : signed(10 downto 0); -- result exponent (biased, incl. overflow/underflow)
+    man_l     : std_ulogic_vector(47 downto 0); -- larger operand (2 integer bits + 46 fractional bits)
+    man_s     : std_ulogic_vector(50 downto 0); -- smaller operand (2 integer bits + 46 fractional bits) + GRS
+    sum       : std_ulogic_vector(51 downto 0); -- result (3 integer bits + 46 fractional bits) + GRS
+    res_sign  : std_ulogic;
+    res_class : std_ulogic_vector(09 downto 0);
+    flags     : std_ulogic_vector(04 downto 0); -- exception flags
+    done      : std_ulogic;
+  end record;
+  signal fma : fma_t;
+
   -- normalizer interface (normalization & rounding and int-to-float) --
   type normalizer_t is record
     start     : std_ulogic;
@@ -342,18 +368,20 @@ begin
 
   -- Instruction Decoding -------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  -- one-hot re-encoding --
-  cmd.instr_class  <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "11100") else '0';
-  cmd.instr_comp   <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "10100") else '0';
-  cmd.instr_i2f    <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "11010") else '0';
-  cmd.instr_f2i    <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "11000") else '0';
-  cmd.instr_sgnj   <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "00100") else '0';
-  cmd.instr_minmax <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "00101") else '0';
-  cmd.instr_addsub <= '1' when (ctrl_i.ir_funct12(11 downto 8) = "0000" ) else '0';
-  cmd.instr_mul    <= '1' when (ctrl_i.ir_funct12(11 downto 7) = "00010") else '0';
+  -- one-hot re-encoding (opcode bit 4 is cleared for the R4-type fused multiply-add instructions) --
+  cmd.instr_class  <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "11100") else '0';
+  cmd.instr_comp   <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "10100") else '0';
+  cmd.instr_i2f    <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "11010") else '0';
+  cmd.instr_f2i    <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "11000") else '0';
+  cmd.instr_sgnj   <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "00100") else '0';
+  cmd.instr_minmax <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "00101") else '0';
+  cmd.instr_addsub <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 8) = "0000" ) else '0';
+  cmd.instr_mul    <= '1' when (ctrl_i.ir_opcode(4) = '1') and (ctrl_i.ir_funct12(11 downto 7) = "00010") else '0';
+  cmd.instr_fma    <= not ctrl_i.ir_opcode(4);
 
   -- binary re-encoding --
-  cmd.funct <= op_mul_c     when (cmd.instr_mul    = '1') else
+  cmd.funct <= op_fma_c     when (cmd.instr_fma    = '1') else
+               op_mul_c     when (cmd.instr_mul    = '1') else
                op_addsub_c  when (cmd.instr_addsub = '1') else
                op_minmax_c  when (cmd.instr_minmax = '1') else
                op_sgnj_c    when (cmd.instr_sgnj   = '1') else
@@ -374,15 +402,19 @@ begin
   op_data(1)(31)           <= rs2_i(31);
   op_data(1)(30 downto 23) <= rs2_i(30 downto 23);
   op_data(1)(22 downto 00) <= (others => '0') when (rs2_i(30 downto 23) = "00000000") else rs2_i(22 downto 0); -- flush mantissa to zero if subnormal
+  -- rs3 --
+  op_data(2)(31)           <= rs3_i(31);
+  op_data(2)(30 downto 23) <= rs3_i(30 downto 23);
+  op_data(2)(22 downto 00) <= (others => '0') when (rs3_i(30 downto 23) = "00000000") else rs3_i(22 downto 0); -- flush mantissa to zero if subnormal
 
 
   -- O Classifier ----------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  number_classifier: process(op_data, rs1_i, rs2_i)
+  number_classifier: process(op_data, rs1_i, rs2_i, rs3_i)
     variable op_m_all_zero_v, op_e_all_zero_v, op_e_all_one_v       : std_ulogic;
     variable op_is_zero_v, op_is_inf_v, op_is_denorm_v, op_is_nan_v : std_ulogic;
   begin
-    for i in 0 to 1 loop -- for rs1 and rs2 inputs
+    for i in 0 to 2 loop -- for rs1, rs2 and rs3 inputs
       -- check for all-zero/all-one --
       op_m_all_zero_v := not or_reduce_f(op_data(i)(22 downto 00));
       op_e_all_zero_v := not or_reduce_f(op_data(i)(30 downto 23));
@@ -399,10 +431,9 @@ begin
       if (i = 1) then
         op_is_denorm_v := or_reduce_f(rs2_i(22 downto 0)) and op_e_all_zero_v; -- set the number to subnormal
       end if;
-      -- Placeholder for rs3_i support, as i cannot be 3.
-      --if (i = 2) then
-      --  op_is_denorm_v := or_reduce_f(rs3_i(22 downto 0)) and op_e_all_zero_v; -- set the number to subnormal
-      --end if;
+      if (i = 2) then
+        op_is_denorm_v := or_reduce_f(rs3_i(22 downto 0)) and op_e_all_zero_v; -- set the number to subnormal
+      end if;
       op_is_nan_v    := op_e_all_one_v  and (not op_m_all_zero_v); -- NaN
 
       -- actual attributes --
@@ -433,6 +464,8 @@ begin
       fpu_operands.rs1_class <= (others => '0');
       fpu_operands.rs2       <= (others => '0');
       fpu_operands.rs2_class <= (others => '0');
+      fpu_operands.rs3       <= (others => '0');
+      fpu_operands.rs3_class <= (others => '0');
       funct_ff               <= (others => '0');
       cmp_ff                 <= (others => '0');
     elsif rising_edge(clk_i) then
@@ -461,6 +494,8 @@ begin
             fpu_operands.rs1_class <= op_class(0);
             fpu_operands.rs2       <= op_data(1);
             fpu_operands.rs2_class <= op_class(1);
+            fpu_operands.rs3       <= op_data(2);
+            fpu_operands.rs3_class <= op_class(2);
             -- execute! --
             ctrl_engine.start <= '1';
             ctrl_engine.state <= S_BUSY;
@@ -495,6 +530,7 @@ begin
   fu_conv_f2i.start    <= ctrl_engine.start and cmd.instr_f2i;
   fu_addsub.start      <= ctrl_engine.start and cmd.instr_addsub;
   fu_mul.start         <= ctrl_engine.start and cmd.instr_mul;
+  fu_fma.start         <= ctrl_engine.start and cmd.instr_fma;
 
 
 -- ****************************************************************************************************************************
@@ -882,7 +918,7 @@ begin
   multiplier.exp_sum <= std_ulogic_vector(unsigned('0' & fpu_operands.rs1(30 downto 23)) + unsigned('0' & fpu_operands.rs2(30 downto 23)));
 
   -- latency --
-  multiplier.start <= fu_mul.start;
+  multiplier.start <= fu_mul.start or fu_fma.start; -- fused multiply-add starts with a multiplication
   multiplier.done  <= multiplier.latency(multiplier.latency'left);
   fu_mul.done      <= multiplier.done;
 
@@ -1439,13 +1475,215 @@ begin
   fu_addsub.flags  <= (others => '0');
 
 
+  -- Fused Multiply-Add Core (FMADD, FMSUB, FNMSUB, FNMADD) ---------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- The full-precision (unrounded) product from the multiplier core is added to the (aligned)
+  -- addend using a 48-bit datapath + GRS bits. The result is pre-normalized so that the
+  -- normalizer & rounding unit only has to round once.
+  fused_mul_add_core: process(rstn_i, clk_i)
+    variable p_zero_v, p_inf_v, c_zero_v, c_inf_v, nan_v, zero_sign_v : std_ulogic;
+    variable sign_l_v, sign_s_v : std_ulogic;
+    variable ep_v, ec_v         : signed(10 downto 0);
+    variable sum_v              : unsigned(51 downto 0);
+  begin
+    if (rstn_i = '0') then
+      fma.state     <= S_IDLE;
+      fma.p_sign    <= '0';
+      fma.c_sign    <= '0';
+      fma.swap      <= '0';
+      fma.dist      <= (others => '0');
+      fma.exp       <= (others => '0');
+      fma.man_l     <= (others => '0');
+      fma.man_s     <= (others => '0');
+      fma.sum       <= (others => '0');
+      fma.res_sign  <= '0';
+      fma.res_class <= (others => '0');
+      fma.flags     <= (others => '0');
+      fma.done      <= '0';
+    elsif rising_edge(clk_i) then
+      -- defaults --
+      fma.done <= '0';
+
+      -- fsm --
+      case fma.state is
+
+        when S_IDLE => -- wait for operation trigger
+        -- ------------------------------------------------------------
+          -- effective signs: opcode bit 3 negates the product, opcode bit 2 negates the addend --
+          fma.p_sign <= fpu_operands.rs1(31) xor fpu_operands.rs2(31) xor ctrl_i.ir_opcode(3);
+          fma.c_sign <= fpu_operands.rs3(31) xor ctrl_i.ir_opcode(2);
+          if (fu_fma.start = '1') then
+            fma.state <= S_MUL;
+          end if;
+
+        when S_MUL => -- wait for full-precision product; check special cases and find larger operand
+        -- ------------------------------------------------------------
+          if (multiplier.done = '1') then
+            -- the multiplier clears the product if any factor is zero (or subnormal) --
+            p_zero_v := not or_reduce_f(multiplier.product);
+            p_inf_v  := multiplier.res_class(fp_class_pos_inf_c) or multiplier.res_class(fp_class_neg_inf_c);
+            c_zero_v := fpu_operands.rs3_class(fp_class_pos_zero_c)   or fpu_operands.rs3_class(fp_class_neg_zero_c) or
+                        fpu_operands.rs3_class(fp_class_pos_denorm_c) or fpu_operands.rs3_class(fp_class_neg_denorm_c); -- subnormals are flushed to zero
+            c_inf_v  := fpu_operands.rs3_class(fp_class_pos_inf_c) or fpu_operands.rs3_class(fp_class_neg_inf_c);
+            nan_v    := multiplier.res_class(fp_class_qnan_c) or -- any factor is NaN or inf * zero
+                        fpu_operands.rs3_class(fp_class_snan_c) or fpu_operands.rs3_class(fp_class_qnan_c) or -- addend is NaN
+                        (p_inf_v and c_inf_v and (fma.p_sign xor fma.c_sign)); -- inf - inf
+
+            -- sign of an exact zero sum: -0 only if both are negative or if rounding towards -infinity --
+            if (fma.p_sign = fma.c_sign) then
+              zero_sign_v := fma.p_sign;
+            elsif (fpu_operands.frm = "010") then
+              zero_sign_v := '1';
+            else
+              zero_sign_v := '0';
+            end if;
+
+            -- result class (special cases only) --
+            fma.res_class <= (others => '0');
+            fma.res_class(fp_class_snan_c)     <= multiplier.res_class(fp_class_snan_c) or fpu_operands.rs3_class(fp_class_snan_c);
+            fma.res_class(fp_class_qnan_c)     <= nan_v;
+            fma.res_class(fp_class_pos_inf_c)  <= (not nan_v) and ((p_inf_v and (not fma.p_sign)) or (c_inf_v and (not fma.c_sign)));
+            fma.res_class(fp_class_neg_inf_c)  <= (not nan_v) and ((p_inf_v and fma.p_sign) or (c_inf_v and fma.c_sign));
+            fma.res_class(fp_class_pos_zero_c) <= p_zero_v and c_zero_v and (not zero_sign_v);
+            fma.res_class(fp_class_neg_zero_c) <= p_zero_v and c_zero_v and zero_sign_v;
+            if (p_inf_v = '1') then
+              fma.res_sign <= fma.p_sign;
+            else
+              fma.res_sign <= fma.c_sign;
+            end if;
+
+            -- exception flags (overflow/underflow are checked after pre-normalization) --
+            fma.flags <= (others => '0');
+            fma.flags(fp_exc_nv_c) <= multiplier.flags(fp_exc_nv_c) or (p_inf_v and c_inf_v and (fma.p_sign xor fma.c_sign)); -- inf * zero, inf - inf
+
+            -- keep the larger operand, the smaller one will be aligned --
+            ep_v := resize(signed(multiplier.exp_res), 11);
+            ec_v := signed("000" & fpu_operands.rs3(30 downto 23));
+            if (c_zero_v = '1') or ((p_zero_v = '0') and (ep_v >= ec_v)) then -- product is larger
+              fma.swap  <= '0';
+              fma.exp   <= ep_v;
+              fma.man_l <= multiplier.product;
+              fma.man_s <= "01" & fpu_operands.rs3(22 downto 0) & "00" & x"000000"; -- append hidden one and GRS
+              fma.dist  <= unsigned(resize(ep_v - ec_v, 10));
+              if (c_zero_v = '1') then
+                fma.man_s <= (others => '0');
+                fma.dist  <= (others => '0');
+              end if;
+            else -- addend is larger
+              fma.swap  <= '1';
+              fma.exp   <= ec_v;
+              fma.man_l <= "01" & fpu_operands.rs3(22 downto 0) & "000" & x"00000"; -- append hidden one
+              fma.man_s <= multiplier.product & "000"; -- append GRS
+              fma.dist  <= unsigned(resize(ec_v - ep_v, 10));
+              if (p_zero_v = '1') then
+                fma.man_s <= (others => '0');
+                fma.dist  <= (others => '0');
+              end if;
+            end if;
+
+            -- special cases do not need the datapath --
+            fma.sum <= (others => '0');
+            if ((nan_v or p_inf_v or c_inf_v or (p_zero_v and c_zero_v)) = '1') then
+              fma.state <= S_NORM;
+            else
+              fma.state <= S_ALIGN;
+            end if;
+          end if;
+
+        when S_ALIGN => -- shift right smaller operand until radix points are aligned
+        -- ------------------------------------------------------------
+          if (fma.dist = 0) then
+            fma.state <= S_ADD;
+          elsif (fma.dist > 50) then -- everything will be shifted into the sticky bit
+            fma.man_s    <= (others => '0');
+            fma.man_s(0) <= or_reduce_f(fma.man_s);
+            fma.dist     <= (others => '0');
+          else
+            fma.man_s <= '0' & fma.man_s(50 downto 2) & (fma.man_s(1) or fma.man_s(0)); -- keep sticky bit
+            fma.dist  <= fma.dist - 1;
+          end if;
+
+        when S_ADD => -- actual addition/subtraction
+        -- ------------------------------------------------------------
+          if (fma.swap = '0') then
+            sign_l_v := fma.p_sign;
+            sign_s_v := fma.c_sign;
+          else
+            sign_l_v := fma.c_sign;
+            sign_s_v := fma.p_sign;
+          end if;
+          if (sign_l_v = sign_s_v) then -- effective addition
+            sum_v := unsigned('0' & fma.man_l & "000") + unsigned('0' & fma.man_s);
+            fma.res_sign <= sign_l_v;
+          else -- effective subtraction
+            sum_v := unsigned('0' & fma.man_l & "000") - unsigned('0' & fma.man_s);
+            if (sum_v(sum_v'left) = '1') then -- "smaller" operand has larger magnitude (exponents differ by less than 2)
+              sum_v := 0 - sum_v;
+              fma.res_sign <= sign_s_v;
+            elsif (or_reduce_f(std_ulogic_vector(sum_v)) = '0') then -- exact zero
+              if (fpu_operands.frm = "010") then -- round down (towards -infinity)
+                fma.res_sign <= '1';
+              else
+                fma.res_sign <= '0';
+              end if;
+            else
+              fma.res_sign <= sign_l_v;
+            end if;
+          end if;
+          fma.sum   <= std_ulogic_vector(sum_v);
+          fma.state <= S_NORM;
+
+        when S_NORM => -- pre-normalization: move leading one to bit 49 (= hidden one for the normalizer)
+        -- ------------------------------------------------------------
+          if (or_reduce_f(fma.sum) = '0') then -- zero or special case
+            fma.done  <= '1';
+            fma.state <= S_IDLE;
+          elsif (fma.sum(51 downto 50) /= "00") then -- shift right
+            fma.sum <= '0' & fma.sum(51 downto 2) & (fma.sum(1) or fma.sum(0)); -- keep sticky bit
+            fma.exp <= fma.exp + 1;
+          elsif (fma.sum(49) = '0') then -- shift left
+            fma.sum <= fma.sum(50 downto 0) & fma.sum(0); -- keep sticky bit
+            fma.exp <= fma.exp - 1;
+          else -- normalized; check exponent range
+            if (fma.exp <= 0) then -- underflow
+              fma.flags(fp_exc_uf_c) <= '1';
+              fma.flags(fp_exc_nx_c) <= '1';
+            elsif (fma.exp >= 255) then -- overflow
+              fma.flags(fp_exc_of_c) <= '1';
+              fma.flags(fp_exc_nx_c) <= '1';
+            end if;
+            fma.done  <= '1';
+            fma.state <= S_IDLE;
+          end if;
+
+        when others => -- undefined
+        -- ------------------------------------------------------------
+          fma.state <= S_IDLE;
+
+      end case;
+
+      -- abort ("hacky reset") --
+      if (ctrl_engine.state = S_IDLE) then
+        fma.state <= S_IDLE;
+      end if;
+    end if;
+  end process fused_mul_add_core;
+
+  -- latency --
+  fu_fma.done <= fma.done;
+
+  -- unused --
+  fu_fma.result <= (others => '0');
+  fu_fma.flags  <= (others => '0');
+
+
 -- ****************************************************************************************************************************
 -- FPU Core - Normalize & Round
 -- ****************************************************************************************************************************
 
   -- Normalizer Input -----------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  normalizer_input_select: process(funct_ff, addsub, multiplier, fu_conv_i2f)
+  normalizer_input_select: process(funct_ff, addsub, multiplier, fma, fu_conv_i2f)
   begin
     case funct_ff is
       when op_addsub_c => -- addition/subtraction
@@ -1468,6 +1706,14 @@ begin
         normalizer.class     <= multiplier.res_class;
         normalizer.flags_in  <= multiplier.flags;
         normalizer.start     <= multiplier.done;
+      when op_fma_c => -- fused multiply-add
+        normalizer.mode      <= '0'; -- normalization
+        normalizer.sign      <= fma.res_sign;
+        normalizer.xexp      <= '0' & std_ulogic_vector(fma.exp(7 downto 0));
+        normalizer.xmantissa <= fma.sum(50 downto 4) & or_reduce_f(fma.sum(3 downto 0)); -- GRS bits are merged into the sticky bit
+        normalizer.class     <= fma.res_class;
+        normalizer.flags_in  <= fma.flags;
+        normalizer.start     <= fma.done;
       when others => -- op_i2f_c
         normalizer.mode      <= '1'; -- int_to_float
         normalizer.sign      <= fu_conv_i2f.sign;
@@ -4,6 +4,10 @@
 -- # Multiplier core (signed/unsigned) uses serial add-and-shift algorithm. Multiplications can be #
 -- # mapped to DSP blocks (faster!) when FAST_MUL_EN = true. Divider core (unsigned-only; pre and  #
 -- # post sign-compensation logic) uses serial restoring serial algorithm.                         #
+-- #                                                                                               #
+-- # The serial cores process log2(RADIX) bits per cycle (RADIX = 2, 4 or 16). If EARLY_EN = true, #
+-- # leading all-zero bytes of the (absolute) multiplier/dividend are skipped, so the number of    #
+-- # cycles depends on the operand data.                                                           #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -45,7 +49,9 @@ use neorv32.neorv32_package.all;
 entity neorv32_cpu_cp_muldiv is
   generic (
     FAST_MUL_EN : boolean; -- use DSPs for faster multiplication
-    DIVISION_EN : boolean  -- implement divider hardware
+    DIVISION_EN : boolean; -- implement divider hardware
+    RADIX       : natural; -- serial mul/div radix: 2, 4 or 16
+    EARLY_EN    : boolean  -- skip leading all-zero operand bytes
   );
   port (
     -- global control --
@@ -64,6 +70,9 @@ end neorv32_cpu_cp_muldiv;
 
 architecture neorv32_cpu_cp_muldiv_rtl of neorv32_cpu_cp_muldiv is
 
+  -- bits per serial iteration --
+  constant step_c : natural := cond_sel_natural_f(boolean(RADIX = 16), 4, cond_sel_natural_f(boolean(RADIX = 4), 2, 1));
+
   -- operations --
   constant op_mul_c    : std_ulogic_vector(2 downto 0) := "000"; -- mul
   constant op_mulh_c   : std_ulogic_vector(2 downto 0) := "001"; -- mulh
@@ -83,6 +92,8 @@ architecture neorv32_cpu_cp_muldiv_rtl of neorv32_cpu_cp_muldiv is
     rs2_is_signed : std_ulogic;
     out_en        : std_ulogic;
     rs2_abs       : std_ulogic_vector(XLEN-1 downto 0);
+    lzb           : std_ulogic_vector(1 downto 0); -- number of leading all-zero operand bytes (that can be skipped)
+    skip          : std_ulogic_vector(1 downto 0); -- skipped bytes of current operation
   end record;
   signal ctrl : ctrl_t;
 
@@ -92,7 +103,8 @@ architecture neorv32_cpu_cp_muldiv_rtl of neorv32_cpu_cp_muldiv is
     sign_mod  : std_ulogic; -- result sign correction
     remainder : std_ulogic_vector(XLEN-1 downto 0);
     quotient  : std_ulogic_vector(XLEN-1 downto 0);
-    sub       : std_ulogic_vector(XLEN   downto 0); -- try subtraction (and restore if underflow)
+    rem_nxt   : std_ulogic_vector(XLEN-1 downto 0); -- remainder after next iteration
+    quo_nxt   : std_ulogic_vector(XLEN-1 downto 0); -- quotient after next iteration
     res_u     : std_ulogic_vector(XLEN-1 downto 0); -- unsigned result
     res       : std_ulogic_vector(XLEN-1 downto 0);
   end record;
@@ -102,8 +114,8 @@ architecture neorv32_cpu_cp_muldiv_rtl of neorv32_cpu_cp_muldiv is
   type mul_t is record
     start  : std_ulogic; -- start new multiplication
     prod   : std_ulogic_vector((2*XLEN)-1 downto 0); -- product
-    add    : std_ulogic_vector(XLEN downto 0); -- addition step
-    p_sext : std_ulogic; -- product sign-extension
+    nxt    : std_ulogic_vector((2*XLEN)-1 downto 0); -- product after next iteration
+    res    : std_ulogic_vector((2*XLEN)-1 downto 0); -- final (re-aligned) product
     dsp_x  : signed(XLEN downto 0); -- input for using DSPs
     dsp_y  : signed(XLEN downto 0); -- input for using DSPs
     dsp_z  : signed(2*XLEN+1 downto 0);
@@ -112,6 +124,12 @@ architecture neorv32_cpu_cp_muldiv_rtl of neorv32_cpu_cp_muldiv is
 
 begin
 
+  -- Sanity Checks --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  assert not ((RADIX /= 2) and (RADIX /= 4) and (RADIX /= 16)) report
+    "[NEORV32] Invalid serial MUL/DIV radix (MULDIV_RADIX); has to be 2, 4 or 16. Falling back to radix 2." severity warning;
+
+
   -- Co-Processor Controller ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   control: process(rstn_i, clk_i)
@@ -121,6 +139,7 @@ begin
       ctrl.rs2_abs <= (others => '0');
       ctrl.cnt     <= (others => '0');
       ctrl.out_en  <= '0';
+      ctrl.skip    <= (others => '0');
       div.sign_mod <= '0';
     elsif rising_edge(clk_i) then
       -- defaults --
@@ -130,7 +149,11 @@ begin
       case ctrl.state is
 
         when S_IDLE => -- wait for start signal
-          ctrl.cnt <= std_ulogic_vector(to_unsigned(XLEN-2, index_size_f(XLEN))); -- iterative cycle counter
+          ctrl.cnt  <= std_ulogic_vector(to_unsigned((XLEN/step_c)-2, index_size_f(XLEN))); -- iterative cycle counter
+          ctrl.skip <= ctrl.lzb;
+          if (EARLY_EN = true) then -- skip iterations of leading all-zero bytes
+            ctrl.cnt <= std_ulogic_vector(to_unsigned((XLEN/step_c)-2, index_size_f(XLEN)) - resize(unsigned(ctrl.lzb) * to_unsigned(8/step_c, 4), index_size_f(XLEN)));
+          end if;
           if (start_i = '1') then -- trigger new operation
             if (DIVISION_EN = true) then
               -- DIV: check relevant input signs for result sign compensation --
@@ -182,6 +205,36 @@ begin
   ctrl.rs2_is_signed <= '1' when (ctrl_i.ir_funct3 = op_mulh_c) or
                                  (ctrl_i.ir_funct3 = op_div_c)  or (ctrl_i.ir_funct3 = op_rem_c) else '0';
 
+  -- early termination: number of leading all-zero bytes of the multiplier or the (absolute) dividend --
+  early_term_enabled:
+  if EARLY_EN generate
+    leading_zeros: process(ctrl_i.ir_funct3, ctrl.rs1_is_signed, rs1_i, rs2_i)
+      variable op_v : std_ulogic_vector(XLEN-1 downto 0);
+    begin
+      if (ctrl_i.ir_funct3(2) = '1') and ((rs1_i(rs1_i'left) and ctrl.rs1_is_signed) = '1') then -- signed division
+        op_v := std_ulogic_vector(0 - unsigned(rs1_i));
+      else -- a negative signed multiplier has no leading zeros
+        op_v := rs1_i;
+      end if;
+      if (ctrl_i.ir_funct3(2) = '1') and (or_reduce_f(rs2_i) = '0') then -- division by zero: do all iterations
+        ctrl.lzb <= "00";
+      elsif (or_reduce_f(op_v(31 downto 8)) = '0') then
+        ctrl.lzb <= "11";
+      elsif (or_reduce_f(op_v(31 downto 16)) = '0') then
+        ctrl.lzb <= "10";
+      elsif (or_reduce_f(op_v(31 downto 24)) = '0') then
+        ctrl.lzb <= "01";
+      else
+        ctrl.lzb <= "00";
+      end if;
+    end process leading_zeros;
+  end generate;
+
+  early_term_disabled:
+  if not EARLY_EN generate
+    ctrl.lzb <= "00";
+  end generate;
+
   -- start operation (do it fast!) --
   mul.start <= '1' when (start_i = '1') and (ctrl_i.ir_funct3(2) = '0') else '0';
   div.start <= '1' when (start_i = '1') and (ctrl_i.ir_funct3(2) = '1') else '0';
@@ -210,6 +263,7 @@ begin
 
     -- actual multiplication --
     mul.dsp_z <= mul.dsp_x * mul.dsp_y;
+    mul.res   <= mul.prod;
 
   end generate; --/multiplier_core_parallel
 
@@ -237,36 +291,53 @@ begin
           mul.prod(63 downto 32) <= (others => '0');
           mul.prod(31 downto 00) <= rs1_i;
         elsif (ctrl.state = S_BUSY) or (ctrl.state = S_DONE) then -- processing step or sign-finalization step
-          mul.prod(63 downto 31) <= mul.add(32 downto 0);
-          mul.prod(30 downto 00) <= mul.prod(31 downto 1);
+          mul.prod <= mul.nxt;
         end if;
       end if;
     end process multiplier_core;
 
-    -- multiply with 0/1 via addition --
-    mul_update: process(mul, ctrl, rs2_i)
+    -- multiply with 0/1 via addition; step_c bits per iteration --
+    mul_update: process(mul.prod, ctrl, rs2_i)
+      variable prod_v : std_ulogic_vector((2*XLEN)-1 downto 0);
+      variable add_v  : std_ulogic_vector(XLEN downto 0);
+      variable sext_v : std_ulogic;
     begin
-      if (mul.prod(0) = '1') then -- multiply with 1
-        if (ctrl.state = S_DONE) and (ctrl.rs1_is_signed = '1') then -- for signed operations only: take care of negative weighted MSB -> multiply with -1
-          mul.add <= std_ulogic_vector(unsigned(mul.p_sext & mul.prod(63 downto 32)) - unsigned((rs2_i(rs2_i'left) and ctrl.rs2_is_signed) & rs2_i));
-        else -- multiply with +1
-          mul.add <= std_ulogic_vector(unsigned(mul.p_sext & mul.prod(63 downto 32)) + unsigned((rs2_i(rs2_i'left) and ctrl.rs2_is_signed) & rs2_i));
+      prod_v := mul.prod;
+      for i in 0 to step_c-1 loop
+        sext_v := prod_v(prod_v'left) and ctrl.rs2_is_signed; -- product sign extension bit
+        if (prod_v(0) = '1') then -- multiply with 1
+          if (ctrl.state = S_DONE) and (i = step_c-1) and (ctrl.rs1_is_signed = '1') and (ctrl.skip = "00") then -- for signed operations only: take care of negative weighted MSB -> multiply with -1
+            add_v := std_ulogic_vector(unsigned(sext_v & prod_v(63 downto 32)) - unsigned((rs2_i(rs2_i'left) and ctrl.rs2_is_signed) & rs2_i));
+          else -- multiply with +1
+            add_v := std_ulogic_vector(unsigned(sext_v & prod_v(63 downto 32)) + unsigned((rs2_i(rs2_i'left) and ctrl.rs2_is_signed) & rs2_i));
+          end if;
+        else -- multiply with 0
+          add_v := sext_v & prod_v(63 downto 32);
         end if;
-      else -- multiply with 0
-        mul.add <= mul.p_sext & mul.prod(63 downto 32);
-      end if;
+        prod_v := add_v & prod_v(31 downto 1);
+      end loop;
+      mul.nxt <= prod_v;
     end process mul_update;
 
-    -- product sign extension bit --
-    mul.p_sext <= mul.prod(mul.prod'left) and ctrl.rs2_is_signed;
+    -- re-align product if leading multiplier bytes have been skipped (remaining iterations would only shift) --
+    mul_align: process(mul.prod, ctrl)
+      variable sext_v : std_ulogic_vector(XLEN-1 downto 0);
+    begin
+      sext_v := (others => (mul.prod(mul.prod'left) and ctrl.rs2_is_signed));
+      case ctrl.skip is
+        when "01"   => mul.res <= sext_v(07 downto 0) & mul.prod(63 downto 08);
+        when "10"   => mul.res <= sext_v(15 downto 0) & mul.prod(63 downto 16);
+        when "11"   => mul.res <= sext_v(23 downto 0) & mul.prod(63 downto 24);
+        when others => mul.res <= mul.prod;
+      end case;
+    end process mul_align;
 
   end generate; -- /multiplier_core_serial
 
   -- no serial multiplier --
   multiplier_core_serial_none:
   if FAST_MUL_EN generate
-    mul.add    <= (others => '0');
-    mul.p_sext <= '0';
+    mul.nxt <= (others => '0');
   end generate;
 
 
@@ -277,6 +348,7 @@ begin
 
     -- restoring division algorithm --
     divider_core: process(rstn_i, clk_i)
+      variable dividend_v : std_ulogic_vector(XLEN-1 downto 0);
     begin
       if (rstn_i = '0') then
         div.quotient  <= (others => '0');
@@ -284,24 +356,43 @@ begin
       elsif rising_edge(clk_i) then
         if (div.start = '1') then -- start new division
           if ((rs1_i(rs1_i'left) and ctrl.rs1_is_signed) = '1') then -- signed division?
-            div.quotient <= std_ulogic_vector(0 - unsigned(rs1_i)); -- make positive
+            dividend_v := std_ulogic_vector(0 - unsigned(rs1_i)); -- make positive
           else
-            div.quotient <= rs1_i;
+            dividend_v := rs1_i;
           end if;
+          case ctrl.lzb is -- skip leading all-zero bytes
+            when "01"   => div.quotient <= dividend_v(23 downto 0) & x"00";
+            when "10"   => div.quotient <= dividend_v(15 downto 0) & x"0000";
+            when "11"   => div.quotient <= dividend_v(07 downto 0) & x"000000";
+            when others => div.quotient <= dividend_v;
+          end case;
           div.remainder <= (others => '0');
         elsif (ctrl.state = S_BUSY) or (ctrl.state = S_DONE) then -- running?
-          div.quotient <= div.quotient(30 downto 0) & (not div.sub(32));
-          if (div.sub(32) = '0') then -- implicit shift
-            div.remainder <= div.sub(31 downto 0);
-          else -- underflow: restore and explicit shift
-            div.remainder <= div.remainder(30 downto 0) & div.quotient(31);
-          end if;
+          div.quotient  <= div.quo_nxt;
+          div.remainder <= div.rem_nxt;
         end if;
       end if;
     end process divider_core;
 
-    -- try another subtraction (and shift) --
-    div.sub <= std_ulogic_vector(unsigned('0' & div.remainder(30 downto 0) & div.quotient(31)) - unsigned('0' & ctrl.rs2_abs));
+    -- try another subtraction (and restore if underflow); step_c bits per iteration --
+    div_update: process(div.remainder, div.quotient, ctrl.rs2_abs)
+      variable rem_v, quo_v : std_ulogic_vector(XLEN-1 downto 0);
+      variable sub_v        : std_ulogic_vector(XLEN downto 0);
+    begin
+      rem_v := div.remainder;
+      quo_v := div.quotient;
+      for i in 0 to step_c-1 loop
+        sub_v := std_ulogic_vector(unsigned('0' & rem_v(30 downto 0) & quo_v(31)) - unsigned('0' & ctrl.rs2_abs));
+        if (sub_v(32) = '0') then -- implicit shift
+          rem_v := sub_v(31 downto 0);
+        else -- underflow: restore and explicit shift
+          rem_v := rem_v(30 downto 0) & quo_v(31);
+        end if;
+        quo_v := quo_v(30 downto 0) & (not sub_v(32));
+      end loop;
+      div.rem_nxt <= rem_v;
+      div.quo_nxt <= quo_v;
+    end process div_update;
 
     -- result and sign compensation --
     div.res_u <= div.quotient when (ctrl_i.ir_funct3 = op_div_c) or (ctrl_i.ir_funct3 = op_divu_c) else div.remainder;
@@ -314,7 +405,8 @@ begin
   if not DIVISION_EN generate
     div.remainder <= (others => '0');
     div.quotient  <= (others => '0');
-    div.sub       <= (others => '0');
+    div.rem_nxt   <= (others => '0');
+    div.quo_nxt   <= (others => '0');
     div.res_u     <= (others => '0');
     div.res       <= (others => '0');
   end generate;
@@ -322,15 +414,15 @@ begin
 
   -- Data Output ----------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  operation_result: process(ctrl, ctrl_i.ir_funct3, mul.prod, div.res)
+  operation_result: process(ctrl, ctrl_i.ir_funct3, mul.res, div.res)
   begin
     res_o <= (others => '0'); -- default
     if (ctrl.out_en = '1') then
       case ctrl_i.ir_funct3 is
         when op_mul_c =>
-          res_o <= mul.prod(31 downto 00);
+          res_o <= mul.res(31 downto 00);
         when op_mulh_c | op_mulhsu_c | op_mulhu_c =>
-          res_o <= mul.prod(63 downto 32);
+          res_o <= mul.res(63 downto 32);
         when others => -- op_div_c | op_rem_c | op_divu_c | op_remu_c
           res_o <= div.res;
       end case;
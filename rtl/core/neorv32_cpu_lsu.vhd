@@ -40,7 +40,7 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_cpu_lsu is
   generic (
-    AMO_LRSC_ENABLE : boolean -- enable atomic LR/SC operations
+    AMO_LRSC_ENABLE : boolean -- enable atomic LR/SC and AMO (read-modify-write) operations
   );
   port (
     -- global control --
@@ -102,20 +102,27 @@ begin
   mem_type_reg: process(rstn_i, clk_i)
   begin
     if (rstn_i = '0') then
-      bus_req_o.rw   <= '0';
-      bus_req_o.priv <= '0';
-      bus_req_o.rvso <= '0';
+      bus_req_o.rw    <= '0';
+      bus_req_o.priv  <= '0';
+      bus_req_o.rvso  <= '0';
+      bus_req_o.amo   <= '0';
+      bus_req_o.amoop <= (others => '0');
     elsif rising_edge(clk_i) then
       if (ctrl_i.lsu_mo_we = '1') then
         -- read/write --
         bus_req_o.rw <= ctrl_i.lsu_rw;
         -- privilege level --
         bus_req_o.priv <= ctrl_i.lsu_priv;
-        -- reservation set operation --
+        -- atomic operation: reservation set operation (LR/SC) or read-modify-write (AMO) --
+        bus_req_o.rvso  <= '0';
+        bus_req_o.amo   <= '0';
+        bus_req_o.amoop <= ctrl_i.ir_funct12(11 downto 9) & ctrl_i.ir_funct12(7); -- funct5(4:2) & funct5(0)
         if (AMO_LRSC_ENABLE = true) and (ctrl_i.ir_opcode(2) = opcode_amo_c(2)) then
-          bus_req_o.rvso <= '1';
-        else
-          bus_req_o.rvso <= '0';
+          if (ctrl_i.ir_funct12(8) = '1') then -- LR.W/SC.W
+            bus_req_o.rvso <= '1';
+          else -- AMO*.W
+            bus_req_o.amo <= '1';
+          end if;
         end if;
       end if;
     end if;
@@ -126,6 +133,7 @@ begin
 
   -- data/instruction fence(.i)
   bus_req_o.fence <= ctrl_i.lsu_fence; -- this is valid even without STB being set
+  bus_req_o.burst <= '0'; -- single-word accesses only
 
 
   -- Data Output - Alignment and Byte Enable ------------------------------------------------
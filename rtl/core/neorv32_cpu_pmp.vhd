@@ -347,7 +347,12 @@ begin
 
     -- compute region permissions --
     perm_gen: process(csr.cfg, ctrl_i)
+      variable amo_v : std_ulogic; -- atomic read-modify-write operation
     begin
+      amo_v := '0';
+      if (ctrl_i.ir_opcode(2) = opcode_amo_c(2)) and (ctrl_i.ir_funct12(8) = '0') then -- AMO*.W, not LR.W/SC.W
+        amo_v := '1';
+      end if;
       -- execute (X) --
       if (ctrl_i.cpu_priv = priv_mode_m_c) then -- M mode: always allow if lock bit
         region.perm_ex(r) <= csr.cfg(r)(cfg_x_c) or (not csr.cfg(r)(cfg_l_c));
@@ -361,12 +366,12 @@ begin
         else -- U mode: check actual permission
           region.perm_rw(r) <= csr.cfg(r)(cfg_r_c);
         end if;
-      -- write (W) --
+      -- write (W); AMOs also require read (R) permission --
       else
         if (ctrl_i.lsu_priv = priv_mode_m_c) then -- M mode: always allow if lock bit
-          region.perm_rw(r) <= csr.cfg(r)(cfg_w_c) or (not csr.cfg(r)(cfg_l_c));
+          region.perm_rw(r) <= (csr.cfg(r)(cfg_w_c) and (csr.cfg(r)(cfg_r_c) or (not amo_v))) or (not csr.cfg(r)(cfg_l_c));
         else -- U mode: check actual permission
-          region.perm_rw(r) <= csr.cfg(r)(cfg_w_c);
+          region.perm_rw(r) <= csr.cfg(r)(cfg_w_c) and (csr.cfg(r)(cfg_r_c) or (not amo_v));
         end if;
       end if;
     end process perm_gen;
@@ -1,8 +1,9 @@
 -- #################################################################################################
 -- # << NEORV32 - Processor-Internal Data Cache >>                                                 #
 -- # ********************************************************************************************* #
--- # Configurable number of cache blocks (cache lines) and block size.                             #
--- # Cache is direct mapped (single set) and uses "write through" write strategy.                  #
+-- # Configurable number of cache blocks (cache lines), block size and associativity (1, 2 or 4    #
+-- # sets; pseudo-LRU replacement). Cache uses either "write through" or "write-back" (with         #
+-- # write-allocate and per-block dirty flags) write strategy.                                     #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -43,9 +44,11 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_dcache is
   generic (
-    DCACHE_NUM_BLOCKS : natural range 1 to 256; -- number of blocks (min 1), has to be a power of 2
-    DCACHE_BLOCK_SIZE : natural range 4 to 2**16; -- block size in bytes (min 4), has to be a power of 2
-    DCACHE_UC_PBEGIN  : std_ulogic_vector(3 downto 0) -- begin of uncached address space (page number)
+    DCACHE_NUM_BLOCKS   : natural range 1 to 256; -- number of blocks (min 1), has to be a power of 2
+    DCACHE_BLOCK_SIZE   : natural range 4 to 2**16; -- block size in bytes (min 4), has to be a power of 2
+    DCACHE_NUM_SETS     : natural range 1 to 4; -- associativity / number of sets; 1=direct-mapped, 2=2-way, 4=4-way set-associative
+    DCACHE_WRITE_POLICY : natural range 0 to 1; -- write policy: 0 = write-through, 1 = write-back
+    DCACHE_UC_PBEGIN    : std_ulogic_vector(3 downto 0) -- begin of uncached address space (page number)
   );
   port (
     clk_i     : in  std_ulogic; -- global clock, rising edge
@@ -53,7 +56,9 @@ entity neorv32_dcache is
     cpu_req_i : in  bus_req_t;  -- request bus
     cpu_rsp_o : out bus_rsp_t;  -- response bus
     bus_req_o : out bus_req_t;  -- request bus
-    bus_rsp_i : in  bus_rsp_t   -- response bus
+    bus_rsp_i : in  bus_rsp_t;  -- response bus
+    hit_o     : out std_ulogic; -- cache hit (HPM event)
+    miss_o    : out std_ulogic  -- cache miss (HPM event)
   );
 end neorv32_dcache;
 
@@ -68,14 +73,20 @@ architecture neorv32_dcache_rtl of neorv32_dcache is
   constant block_size_pow2_c  : natural := 2**index_size_f(DCACHE_BLOCK_SIZE);
   constant block_size_c       : natural := cond_sel_natural_f(block_size_valid_c, DCACHE_BLOCK_SIZE, block_size_pow2_c);
 
+  -- write policy --
+  constant write_back_c : boolean := boolean(DCACHE_WRITE_POLICY = 1);
+
   -- cache layout --
   constant cache_offset_size_c : natural := index_size_f(block_size_c/4); -- offset addresses full 32-bit words
+  constant cache_index_size_c  : natural := index_size_f(nblocks_c);
+  constant cache_tag_size_c    : natural := 32 - (cache_offset_size_c + cache_index_size_c + 2); -- 2 additional bits for byte offset
 
   -- cache memory --
   component neorv32_dcache_memory
   generic (
     DCACHE_NUM_BLOCKS : natural; -- number of blocks (min 1), has to be a power of 2
-    DCACHE_BLOCK_SIZE : natural  -- block size in bytes (min 4), has to be a power of 2
+    DCACHE_BLOCK_SIZE : natural; -- block size in bytes (min 4), has to be a power of 2
+    DCACHE_NUM_SETS   : natural  -- associativity; 1=direct-mapped, 2=2-way set-associative, 4=4-way set-associative
   );
   port (
     -- global control --
@@ -83,16 +94,24 @@ architecture neorv32_dcache_rtl of neorv32_dcache is
     clk_i        : in  std_ulogic; -- global clock, rising edge
     clear_i      : in  std_ulogic; -- invalidate whole cache
     hit_o        : out std_ulogic; -- hit access
+    set_o        : out std_ulogic_vector(01 downto 0); -- hit set (on hit) or least recently used set (on miss)
+    dirty_o      : out std_ulogic; -- accessed block is valid and dirty
+    base_o       : out std_ulogic_vector(31 downto 0); -- base address of accessed block
     -- host cache access (read-only) --
+    host_chk_i   : in  std_ulogic; -- host access is being checked (update access history on hit)
     host_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
     host_rdata_o : out std_ulogic_vector(31 downto 0); -- read data
     host_rstat_o : out std_ulogic; -- access status
     -- ctrl cache access --
+    ctrl_en_i    : in  std_ulogic; -- control access enable
+    ctrl_set_i   : in  std_ulogic_vector(01 downto 0); -- set select
     ctrl_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
     ctrl_we_i    : in  std_ulogic; -- write enable (full-word)
     ctrl_ben_i   : in  std_ulogic_vector(03 downto 0); -- byte enable
     ctrl_wdata_i : in  std_ulogic_vector(31 downto 0); -- write data (full word)
     ctrl_wstat_i : in  std_ulogic; -- access status
+    ctrl_dirty_i : in  std_ulogic; -- block dirty flag (updated on write access)
+    ctrl_inval_i : in  std_ulogic; -- invalidate block
     ctrl_rdata_o : out std_ulogic_vector(31 downto 0)  -- read data
   );
   end component;
@@ -101,29 +120,47 @@ architecture neorv32_dcache_rtl of neorv32_dcache is
   type cache_if_t is record
     host_rdata : std_ulogic_vector(31 downto 0); -- host read data
     host_rstat : std_ulogic; -- access error
+    host_chk   : std_ulogic; -- host access check
+    ctrl_en    : std_ulogic; -- control access enable
+    ctrl_set   : std_ulogic_vector(01 downto 0); -- set select
     ctrl_addr  : std_ulogic_vector(31 downto 0); -- access address
     ctrl_we    : std_ulogic; -- write enable
     ctrl_ben   : std_ulogic_vector(03 downto 0); -- byte-enable
     ctrl_rdata : std_ulogic_vector(31 downto 0); -- read data
     ctrl_wdata : std_ulogic_vector(31 downto 0); -- write data
     ctrl_wstat : std_ulogic; -- access error
+    ctrl_dirty : std_ulogic; -- mark block as dirty
+    ctrl_inval : std_ulogic; -- invalidate block
     hit        : std_ulogic; -- hit access
+    set        : std_ulogic_vector(01 downto 0); -- hit set or set to be replaced
+    dirty      : std_ulogic; -- accessed block is dirty
+    base       : std_ulogic_vector(31 downto 0); -- base address of accessed block
     clear      : std_ulogic; -- invalidate cache
   end record;
   signal cache : cache_if_t;
 
   -- control engine --
   type ctrl_engine_state_t is (S_IDLE, S_CHECK, S_DOWNLOAD_REQ, S_DOWNLOAD_WAIT, S_DIRECT_REQ,
-                               S_DIRECT_WAIT, S_RESYNC, S_RESYNC_READ, S_RESYNC_WRITE, S_RESYNC_WAIT, S_CLEAR);
+                               S_DIRECT_WAIT, S_RESYNC, S_RESYNC_READ, S_RESYNC_WRITE, S_RESYNC_WAIT,
+                               S_UPLOAD_READ, S_UPLOAD_REQ, S_UPLOAD_WAIT, S_FLUSH_READ, S_FLUSH_CHECK,
+                               S_FLUSH_NEXT, S_INVAL_CHECK, S_INVAL, S_CLEAR);
   type ctrl_t is record
     state         : ctrl_engine_state_t; -- current state
     state_nxt     : ctrl_engine_state_t; -- next state
-    addr_reg      : std_ulogic_vector(31 downto 0); -- address register for block download
+    addr_reg      : std_ulogic_vector(31 downto 0); -- address register for block download/upload
     addr_reg_nxt  : std_ulogic_vector(31 downto 0);
     req_buf       : std_ulogic; -- request
     req_buf_nxt   : std_ulogic;
     clear_buf     : std_ulogic; -- clear request
     clear_buf_nxt : std_ulogic;
+    flush         : std_ulogic; -- flush (write-back all dirty blocks) in progress
+    flush_nxt     : std_ulogic;
+    upl_err       : std_ulogic; -- bus error during block upload (write-back)
+    upl_err_nxt   : std_ulogic;
+    set           : std_ulogic_vector(01 downto 0); -- set of current block
+    set_nxt       : std_ulogic_vector(01 downto 0);
+    refill        : std_ulogic; -- re-checking an access after a miss (do not count as hit)
+    refill_nxt    : std_ulogic;
   end record;
   signal ctrl : ctrl_t;
 
@@ -134,6 +171,9 @@ begin
   assert not ((nblocks_valid_c = false) or (block_size_valid_c = false)) report
     "[NEORV32] Auto-adjusting invalid d-cache size configuration(s)." severity warning;
 
+  assert not (DCACHE_NUM_SETS = 3) report
+    "[NEORV32] Invalid d-cache associativity configuration (has to be 1, 2 or 4)." severity failure;
+
 
   -- Control Engine FSM Sync ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -144,11 +184,19 @@ begin
       ctrl.addr_reg  <= (others => '0');
       ctrl.req_buf   <= '0';
       ctrl.clear_buf <= '0';
+      ctrl.flush     <= '0';
+      ctrl.upl_err   <= '0';
+      ctrl.set       <= (others => '0');
+      ctrl.refill    <= '0';
     elsif rising_edge(clk_i) then
       ctrl.state     <= ctrl.state_nxt;
       ctrl.addr_reg  <= ctrl.addr_reg_nxt;
       ctrl.req_buf   <= ctrl.req_buf_nxt;
       ctrl.clear_buf <= ctrl.clear_buf_nxt;
+      ctrl.flush     <= ctrl.flush_nxt;
+      ctrl.upl_err   <= ctrl.upl_err_nxt;
+      ctrl.set       <= ctrl.set_nxt;
+      ctrl.refill    <= ctrl.refill_nxt;
     end if;
   end process ctrl_engine_sync;
 
@@ -160,6 +208,10 @@ begin
     -- control defaults --
     ctrl.state_nxt     <= ctrl.state;
     ctrl.addr_reg_nxt  <= ctrl.addr_reg;
+    ctrl.flush_nxt     <= ctrl.flush;
+    ctrl.upl_err_nxt   <= ctrl.upl_err;
+    ctrl.set_nxt       <= ctrl.set;
+    ctrl.refill_nxt    <= ctrl.refill;
 
     -- request buffer --
     ctrl.req_buf_nxt   <= ctrl.req_buf or cpu_req_i.stb;
@@ -167,17 +219,26 @@ begin
 
     -- cache defaults --
     cache.clear        <= '0';
+    cache.host_chk     <= '0';
+    cache.ctrl_en      <= '0';
+    cache.ctrl_set     <= ctrl.set;
     cache.ctrl_addr    <= ctrl.addr_reg;
     cache.ctrl_we      <= '0';
     cache.ctrl_ben     <= "1111";
     cache.ctrl_wdata   <= bus_rsp_i.data;
     cache.ctrl_wstat   <= bus_rsp_i.err;
+    cache.ctrl_dirty   <= '0';
+    cache.ctrl_inval   <= '0';
 
     -- host interface defaults --
     cpu_rsp_o.data     <= cache.host_rdata;
     cpu_rsp_o.ack      <= '0';
     cpu_rsp_o.err      <= '0';
 
+    -- HPM event defaults --
+    hit_o              <= '0';
+    miss_o             <= '0';
+
     -- peripheral bus interface defaults --
     bus_req_o.addr     <= ctrl.addr_reg;
     bus_req_o.data     <= cpu_req_i.data;
@@ -186,8 +247,11 @@ begin
     bus_req_o.src      <= cpu_req_i.src;
     bus_req_o.priv     <= cpu_req_i.priv;
     bus_req_o.rvso     <= cpu_req_i.rvso;
+    bus_req_o.amo      <= cpu_req_i.amo;
+    bus_req_o.amoop    <= cpu_req_i.amoop;
     bus_req_o.stb      <= '0';
     bus_req_o.fence    <= cpu_req_i.fence;
+    bus_req_o.burst    <= '0';
 
     -- fsm --
     case ctrl.state is
@@ -196,10 +260,19 @@ begin
       -- ------------------------------------------------------------
         ctrl.addr_reg_nxt <= cpu_req_i.addr;
         if (ctrl.clear_buf = '1') then -- invalidate cache
-          ctrl.state_nxt <= S_CLEAR;
+          if write_back_c then -- write-back all dirty blocks first
+            ctrl.addr_reg_nxt <= (others => '0'); -- start with first block
+            ctrl.set_nxt      <= (others => '0'); -- start with first set
+            ctrl.flush_nxt    <= '1';
+            ctrl.state_nxt    <= S_FLUSH_READ;
+          else
+            ctrl.state_nxt <= S_CLEAR;
+          end if;
         elsif (cpu_req_i.stb = '1') or (ctrl.req_buf = '1') then
-          if (unsigned(cpu_req_i.addr(31 downto 28)) >= unsigned(DCACHE_UC_PBEGIN)) or (cpu_req_i.rvso = '1') then -- uncached access -> direct access
+          if (unsigned(cpu_req_i.addr(31 downto 28)) >= unsigned(DCACHE_UC_PBEGIN)) then -- uncached access -> direct access
             ctrl.state_nxt <= S_DIRECT_REQ;
+          elsif (cpu_req_i.rvso = '1') or (cpu_req_i.amo = '1') then -- atomic access -> evict cached copy, then direct access
+            ctrl.state_nxt <= S_INVAL_CHECK;
           else -- cached access
             ctrl.state_nxt <= S_CHECK;
           end if;
@@ -208,39 +281,64 @@ begin
       when S_CHECK => -- check if cache hit
       -- ------------------------------------------------------------
         ctrl.req_buf_nxt <= '0';
-        if (cpu_req_i.rw = '0') then -- read access
-          -- calculate block base address (in case we need to download it) --
-          ctrl.addr_reg_nxt((cache_offset_size_c+2)-1 downto 2) <= (others => '0'); -- block-aligned
-          ctrl.addr_reg_nxt(1 downto 0) <= "00"; -- word-aligned
-          --
-          if (cache.hit = '1') then -- HIT -> done
-            if (cache.host_rstat = '1') then -- erroneous read access?
-              cpu_rsp_o.err <= '1';
-            else
-              cpu_rsp_o.ack <= '1';
+        ctrl.refill_nxt  <= '0';
+        cache.host_chk   <= '1'; -- update access history
+        cache.ctrl_set   <= cache.set; -- hit set or set to be replaced
+        ctrl.set_nxt     <= cache.set;
+        -- calculate block base address (in case we need to download it) --
+        ctrl.addr_reg_nxt((cache_offset_size_c+2)-1 downto 2) <= (others => '0'); -- block-aligned
+        ctrl.addr_reg_nxt(1 downto 0) <= "00"; -- word-aligned
+        --
+        if write_back_c and (ctrl.upl_err = '1') then -- previous block write-back failed
+          ctrl.upl_err_nxt <= '0';
+          cpu_rsp_o.err    <= '1';
+          ctrl.state_nxt   <= S_IDLE;
+        elsif (cache.hit = '1') then -- HIT
+          hit_o <= not ctrl.refill;
+          if (cpu_req_i.rw = '0') or write_back_c then -- read access or write access to write-back cache
+            if (cache.host_rstat = '1') then -- erroneous cache word?
+              cpu_rsp_o.err  <= '1';
+              ctrl.state_nxt <= S_IDLE;
+            elsif (cpu_req_i.rw = '0') then -- read access -> done
+              cpu_rsp_o.ack  <= '1';
+              ctrl.state_nxt <= S_IDLE;
+            else -- write access -> update cache only
+              ctrl.state_nxt <= S_RESYNC_WRITE;
             end if;
-            ctrl.state_nxt <= S_IDLE;
-          else -- cache MISS -> download block
-            ctrl.state_nxt <= S_DOWNLOAD_REQ;
+          else -- write access to write-through cache -> also write to cache
+            ctrl.addr_reg_nxt <= cpu_req_i.addr; -- keep original access address
+            ctrl.state_nxt    <= S_RESYNC_WRITE;
           end if;
-        else -- write access
-          if (cache.hit = '1') then -- data word in cache -> also write to cache
-            ctrl.state_nxt <= S_RESYNC_WRITE;
+        else -- MISS
+          miss_o <= '1';
+          if (cpu_req_i.rw = '0') or write_back_c then -- read access or write access to write-back cache (write-allocate)
+            ctrl.refill_nxt <= '1'; -- access is checked again after the block has been loaded
+            if write_back_c and (cache.dirty = '1') then -- upload (write-back) dirty block before replacing it
+              ctrl.addr_reg_nxt <= cache.base;
+              ctrl.state_nxt    <= S_UPLOAD_READ;
+            else -- download new block
+              ctrl.state_nxt <= S_DOWNLOAD_REQ;
+            end if;
           else -- write-through
-            ctrl.state_nxt <= S_DIRECT_REQ;
+            ctrl.addr_reg_nxt <= cpu_req_i.addr; -- keep original access address
+            ctrl.state_nxt    <= S_DIRECT_REQ;
           end if;
         end if;
 
 
       when S_DOWNLOAD_REQ => -- download new cache block: request new word
       -- ------------------------------------------------------------
-        bus_req_o.rw   <= '0'; -- read access
-        bus_req_o.stb  <= '1'; -- request new transfer
-        ctrl.state_nxt <= S_DOWNLOAD_WAIT;
+        cache.ctrl_en   <= '1'; -- control access to cache
+        bus_req_o.rw    <= '0'; -- read access
+        bus_req_o.burst <= not and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)); -- not the last word of the block
+        bus_req_o.stb   <= '1'; -- request new transfer
+        ctrl.state_nxt  <= S_DOWNLOAD_WAIT;
 
       when S_DOWNLOAD_WAIT => -- download new cache block: wait for bus response
       -- ------------------------------------------------------------
-        bus_req_o.rw <= '0'; -- read access
+        cache.ctrl_en   <= '1'; -- control access to cache
+        bus_req_o.rw    <= '0'; -- read access
+        bus_req_o.burst <= not and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)); -- not the last word of the block
         if (bus_rsp_i.ack = '1') or (bus_rsp_i.err = '1') then -- ACK or ERROR -> write to cache and get next word (store ERROR flag in cache)
           cache.ctrl_we     <= '1'; -- write to cache
           ctrl.addr_reg_nxt <= std_ulogic_vector(unsigned(ctrl.addr_reg) + 4);
@@ -252,6 +350,50 @@ begin
         end if;
 
 
+      when S_UPLOAD_READ => -- upload (write-back) dirty cache block: read word from cache
+      -- ------------------------------------------------------------
+        cache.ctrl_en  <= '1'; -- control access to cache
+        ctrl.state_nxt <= S_UPLOAD_REQ;
+
+      when S_UPLOAD_REQ => -- upload (write-back) dirty cache block: request new word
+      -- ------------------------------------------------------------
+        cache.ctrl_en  <= '1'; -- control access to cache, keep cache read data stable
+        bus_req_o.data <= cache.ctrl_rdata;
+        bus_req_o.ben  <= (others => '1'); -- full-word access
+        bus_req_o.rw   <= '1'; -- write access
+        bus_req_o.rvso  <= '0'; -- no reservation set operation
+        bus_req_o.amo   <= '0'; -- no atomic read-modify-write operation
+        bus_req_o.burst <= not and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)); -- not the last word of the block
+        bus_req_o.stb   <= '1'; -- request new transfer
+        ctrl.state_nxt  <= S_UPLOAD_WAIT;
+
+      when S_UPLOAD_WAIT => -- upload (write-back) dirty cache block: wait for bus response
+      -- ------------------------------------------------------------
+        cache.ctrl_en  <= '1'; -- control access to cache, keep cache read data stable
+        bus_req_o.data <= cache.ctrl_rdata;
+        bus_req_o.ben  <= (others => '1'); -- full-word access
+        bus_req_o.rw   <= '1'; -- write access
+        bus_req_o.rvso  <= '0'; -- no reservation set operation
+        bus_req_o.amo   <= '0'; -- no atomic read-modify-write operation
+        bus_req_o.burst <= not and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)); -- not the last word of the block
+        if (bus_rsp_i.ack = '1') or (bus_rsp_i.err = '1') then
+          ctrl.upl_err_nxt <= ctrl.upl_err or bus_rsp_i.err; -- report error with next cached access
+          if (and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) = '1') then -- block complete?
+            if (ctrl.flush = '1') then -- flush in progress: check next block
+              ctrl.state_nxt <= S_FLUSH_NEXT;
+            elsif (cpu_req_i.rvso = '1') or (cpu_req_i.amo = '1') then -- atomic access: invalidate block, then direct access
+              ctrl.state_nxt <= S_INVAL;
+            else -- replace block: download new block
+              ctrl.addr_reg_nxt <= cpu_req_i.addr(31 downto (cache_offset_size_c+2)) & std_ulogic_vector(to_unsigned(0, cache_offset_size_c+2));
+              ctrl.state_nxt    <= S_DOWNLOAD_REQ;
+            end if;
+          else -- upload next word
+            ctrl.addr_reg_nxt <= std_ulogic_vector(unsigned(ctrl.addr_reg) + 4);
+            ctrl.state_nxt    <= S_UPLOAD_READ;
+          end if;
+        end if;
+
+
       when S_DIRECT_REQ => -- direct uncached access: request access
       -- ------------------------------------------------------------
         bus_req_o.stb    <= '1';
@@ -273,22 +415,25 @@ begin
       when S_RESYNC => -- re-sync host/cache access
       -- ------------------------------------------------------------
         ctrl.addr_reg_nxt <= cpu_req_i.addr; -- restore original access address
-        if (cpu_req_i.rw = '1') then -- write access
-          ctrl.state_nxt <= S_RESYNC_WRITE;
-        else -- read access
-          ctrl.state_nxt <= S_CHECK; -- should HIT now
-        end if;
+        ctrl.state_nxt    <= S_CHECK; -- should HIT now
 
       when S_RESYNC_WRITE => -- finalize cached write access
       -- ------------------------------------------------------------
-        bus_req_o.rw     <= '1'; -- write access
-        bus_req_o.stb    <= '1'; -- request new transfer
+        cache.ctrl_en    <= '1'; -- control access to cache
         cache.ctrl_we    <= '1'; -- write to cache
         cache.ctrl_ben   <= cpu_req_i.ben;
         cache.ctrl_addr  <= cpu_req_i.addr;
         cache.ctrl_wdata <= cpu_req_i.data;
         cache.ctrl_wstat <= '0'; -- no error possible here
-        ctrl.state_nxt   <= S_DIRECT_WAIT;
+        if write_back_c then -- write-back: just mark block as dirty, no bus access
+          cache.ctrl_dirty <= '1';
+          cpu_rsp_o.ack    <= '1';
+          ctrl.state_nxt   <= S_IDLE;
+        else -- write-through: also write to main memory
+          bus_req_o.rw   <= '1'; -- write access
+          bus_req_o.stb  <= '1'; -- request new transfer
+          ctrl.state_nxt <= S_DIRECT_WAIT;
+        end if;
 
       when S_RESYNC_WAIT => -- wait for bus response
       -- ------------------------------------------------------------
@@ -302,6 +447,64 @@ begin
         end if;
 
 
+      when S_FLUSH_READ => -- flush cache: read status of current block
+      -- ------------------------------------------------------------
+        cache.ctrl_en  <= '1'; -- control access to cache
+        ctrl.state_nxt <= S_FLUSH_CHECK;
+
+      when S_FLUSH_CHECK => -- flush cache: upload block if dirty
+      -- ------------------------------------------------------------
+        cache.ctrl_en <= '1'; -- control access to cache
+        if (cache.dirty = '1') then
+          ctrl.addr_reg_nxt <= cache.base;
+          ctrl.state_nxt    <= S_UPLOAD_READ;
+        else
+          ctrl.state_nxt <= S_FLUSH_NEXT;
+        end if;
+
+      when S_FLUSH_NEXT => -- flush cache: go to next set / next block
+      -- ------------------------------------------------------------
+        ctrl.addr_reg_nxt((cache_offset_size_c+2)-1 downto 0) <= (others => '0');
+        if (to_integer(unsigned(ctrl.set)) = DCACHE_NUM_SETS-1) then -- last set of this block index
+          ctrl.set_nxt <= (others => '0');
+          ctrl.addr_reg_nxt(31 downto 31-(cache_tag_size_c-1)) <= (others => '0');
+          ctrl.addr_reg_nxt(31-cache_tag_size_c downto 2+cache_offset_size_c) <= std_ulogic_vector(unsigned(ctrl.addr_reg(31-cache_tag_size_c downto 2+cache_offset_size_c)) + 1);
+          if (and_reduce_f(ctrl.addr_reg(31-cache_tag_size_c downto 2+cache_offset_size_c)) = '1') then -- all blocks done?
+            ctrl.flush_nxt <= '0';
+            ctrl.state_nxt <= S_CLEAR;
+          else
+            ctrl.state_nxt <= S_FLUSH_READ;
+          end if;
+        else
+          ctrl.set_nxt   <= std_ulogic_vector(unsigned(ctrl.set) + 1);
+          ctrl.state_nxt <= S_FLUSH_READ;
+        end if;
+
+
+      when S_INVAL_CHECK => -- atomic access: check if the accessed block is cached
+      -- ------------------------------------------------------------
+        cache.ctrl_set <= cache.set; -- hit set
+        ctrl.set_nxt   <= cache.set;
+        if (cache.hit = '1') then -- block has to be evicted so the atomic bus access sees/updates the current data
+          if write_back_c and (cache.dirty = '1') then -- upload (write-back) dirty block before invalidating it
+            ctrl.addr_reg_nxt <= cache.base;
+            ctrl.state_nxt    <= S_UPLOAD_READ;
+          else
+            ctrl.state_nxt <= S_INVAL;
+          end if;
+        else -- not cached
+          ctrl.state_nxt <= S_DIRECT_REQ;
+        end if;
+
+      when S_INVAL => -- atomic access: invalidate accessed block
+      -- ------------------------------------------------------------
+        cache.ctrl_en     <= '1'; -- control access to cache
+        cache.ctrl_addr   <= cpu_req_i.addr;
+        cache.ctrl_inval  <= '1';
+        ctrl.addr_reg_nxt <= cpu_req_i.addr; -- restore original access address
+        ctrl.state_nxt    <= S_DIRECT_REQ;
+
+
       when S_CLEAR => -- invalidate all cache entries
       -- ------------------------------------------------------------
         ctrl.clear_buf_nxt <= '0';
@@ -321,7 +524,8 @@ begin
   neorv32_dcache_memory_inst: neorv32_dcache_memory
   generic map (
     DCACHE_NUM_BLOCKS => nblocks_c,
-    DCACHE_BLOCK_SIZE => block_size_c
+    DCACHE_BLOCK_SIZE => block_size_c,
+    DCACHE_NUM_SETS   => DCACHE_NUM_SETS
   )
   port map (
     -- global control --
@@ -329,16 +533,24 @@ begin
     clk_i        => clk_i,
     clear_i      => cache.clear,
     hit_o        => cache.hit,
+    set_o        => cache.set,
+    dirty_o      => cache.dirty,
+    base_o       => cache.base,
     -- host cache access --
+    host_chk_i   => cache.host_chk,
     host_addr_i  => cpu_req_i.addr,
     host_rdata_o => cache.host_rdata,
     host_rstat_o => cache.host_rstat,
     -- ctrl cache access --
+    ctrl_en_i    => cache.ctrl_en,
+    ctrl_set_i   => cache.ctrl_set,
     ctrl_addr_i  => cache.ctrl_addr,
     ctrl_we_i    => cache.ctrl_we,
     ctrl_ben_i   => cache.ctrl_ben,
     ctrl_wdata_i => cache.ctrl_wdata,
     ctrl_wstat_i => cache.ctrl_wstat,
+    ctrl_dirty_i => cache.ctrl_dirty,
+    ctrl_inval_i => cache.ctrl_inval,
     ctrl_rdata_o => cache.ctrl_rdata
   );
 
@@ -393,24 +605,33 @@ use neorv32.neorv32_package.all;
 entity neorv32_dcache_memory is
   generic (
     DCACHE_NUM_BLOCKS : natural; -- number of blocks (min 1), has to be a power of 2
-    DCACHE_BLOCK_SIZE : natural  -- block size in bytes (min 4), has to be a power of 2
+    DCACHE_BLOCK_SIZE : natural; -- block size in bytes (min 4), has to be a power of 2
+    DCACHE_NUM_SETS   : natural  -- associativity; 1=direct-mapped, 2=2-way set-associative, 4=4-way set-associative
   );
   port (
     -- global control --
     rstn_i       : in  std_ulogic; -- global reset, async, low-active
     clk_i        : in  std_ulogic; -- global clock, rising edge
     clear_i      : in  std_ulogic; -- invalidate whole cache
-    hit_o        : out std_ulogic;  -- hit access
+    hit_o        : out std_ulogic; -- hit access
+    set_o        : out std_ulogic_vector(01 downto 0); -- hit set (on hit) or least recently used set (on miss)
+    dirty_o      : out std_ulogic; -- accessed block is valid and dirty
+    base_o       : out std_ulogic_vector(31 downto 0); -- base address of accessed block
     -- host cache access (read-only) --
+    host_chk_i   : in  std_ulogic; -- host access is being checked (update access history on hit)
     host_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
     host_rdata_o : out std_ulogic_vector(31 downto 0); -- read data
     host_rstat_o : out std_ulogic; -- access status
     -- ctrl cache access --
+    ctrl_en_i    : in  std_ulogic; -- control access enable
+    ctrl_set_i   : in  std_ulogic_vector(01 downto 0); -- set select
     ctrl_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
     ctrl_we_i    : in  std_ulogic; -- write enable
     ctrl_ben_i   : in  std_ulogic_vector(03 downto 0); -- byte enable
     ctrl_wdata_i : in  std_ulogic_vector(31 downto 0); -- write data (full word)
     ctrl_wstat_i : in  std_ulogic; -- access status
+    ctrl_dirty_i : in  std_ulogic; -- block dirty flag (updated on write access)
+    ctrl_inval_i : in  std_ulogic; -- invalidate block
     ctrl_rdata_o : out std_ulogic_vector(31 downto 0)  -- read data
   );
 end neorv32_dcache_memory;
@@ -423,15 +644,6 @@ architecture neorv32_dcache_memory_rtl of neorv32_dcache_memory is
   constant cache_tag_size_c    : natural := 32 - (cache_offset_size_c + cache_index_size_c + 2); -- 2 additional bits for byte offset
   constant cache_entries_c     : natural := DCACHE_NUM_BLOCKS * (DCACHE_BLOCK_SIZE/4); -- number of 32-bit entries (per set)
 
-  -- status flag memory --
-  signal valid_flag : std_ulogic_vector(DCACHE_NUM_BLOCKS-1 downto 0);
-  signal valid      : std_ulogic;
-
-  -- tag memory --
-  type tag_mem_t is array (0 to DCACHE_NUM_BLOCKS-1) of std_ulogic_vector(cache_tag_size_c-1 downto 0);
-  signal tag_mem : tag_mem_t;
-  signal tag     : std_ulogic_vector(cache_tag_size_c-1 downto 0);
-
   -- access address decomposition --
   type acc_addr_t is record
     tag    : std_ulogic_vector(cache_tag_size_c-1 downto 0);
@@ -440,23 +652,73 @@ architecture neorv32_dcache_memory_rtl of neorv32_dcache_memory is
   end record;
   signal host_acc_addr, ctrl_acc_addr : acc_addr_t;
 
-  -- cache data memory --
-  type cache_mem_t is array (0 to cache_entries_c-1) of std_ulogic_vector(7 downto 0);
-  signal cache_data_memory_b0 : cache_mem_t; -- byte 0
-  signal cache_data_memory_b1 : cache_mem_t; -- byte 1
-  signal cache_data_memory_b2 : cache_mem_t; -- byte 2
-  signal cache_data_memory_b3 : cache_mem_t; -- byte 3
-  signal cache_err_memory     : std_ulogic_vector(cache_entries_c-1 downto 0); -- access error flag
-
   -- cache data memory access --
-  signal cache_rdata  : std_ulogic_vector(32 downto 0);
   signal cache_index  : std_ulogic_vector(cache_index_size_c-1 downto 0);
   signal cache_offset : std_ulogic_vector(cache_offset_size_c-1 downto 0);
   signal cache_addr   : std_ulogic_vector((cache_index_size_c+cache_offset_size_c)-1 downto 0); -- index & offset
+  signal tag_index    : std_ulogic_vector(cache_index_size_c-1 downto 0);
+
+  -- per-set read data --
+  type tag_rd_t   is array (0 to DCACHE_NUM_SETS-1) of std_ulogic_vector(cache_tag_size_c-1 downto 0);
+  type cache_rd_t is array (0 to DCACHE_NUM_SETS-1) of std_ulogic_vector(32 downto 0); -- 32-bit data + 1-bit status
+  signal tag        : tag_rd_t;
+  signal cache_rd   : cache_rd_t;
+  signal valid      : std_ulogic_vector(DCACHE_NUM_SETS-1 downto 0);
+  signal dirty      : std_ulogic_vector(DCACHE_NUM_SETS-1 downto 0);
+  signal hit        : std_ulogic_vector(DCACHE_NUM_SETS-1 downto 0);
+  signal set_we     : std_ulogic_vector(DCACHE_NUM_SETS-1 downto 0);
+  signal hit_set    : natural range 0 to DCACHE_NUM_SETS-1;
+  signal ctrl_set   : natural range 0 to DCACHE_NUM_SETS-1;
+
+  -- access history (tree-based pseudo-LRU) --
+  type history_mem_t is array (0 to DCACHE_NUM_BLOCKS-1) of std_ulogic_vector(2 downto 0);
+  type history_t is record
+    mem      : history_mem_t;
+    rd       : std_ulogic_vector(2 downto 0); -- history of accessed index
+    lru_set  : natural range 0 to DCACHE_NUM_SETS-1; -- set to be replaced
+  end record;
+  signal history : history_t;
+
+  -- pseudo-LRU: get set to be replaced --
+  -- plru(0): '0' = LRU set is in sets 0/1, '1' = LRU set is in sets 2/3 (4-way) or LRU set (2-way)
+  -- plru(1): LRU set within sets 0/1; plru(2): LRU set within sets 2/3 (4-way only)
+  function plru_victim_f(plru : std_ulogic_vector(2 downto 0)) return natural is
+  begin
+    if (DCACHE_NUM_SETS = 4) then
+      if (plru(0) = '0') then
+        if (plru(1) = '0') then return 0; else return 1; end if;
+      else
+        if (plru(2) = '0') then return 2; else return 3; end if;
+      end if;
+    elsif (DCACHE_NUM_SETS = 2) then
+      if (plru(0) = '0') then return 0; else return 1; end if;
+    else
+      return 0;
+    end if;
+  end function plru_victim_f;
+
+  -- pseudo-LRU: mark set as most recently used (let all tree nodes point away from it) --
+  function plru_update_f(plru : std_ulogic_vector(2 downto 0); set : natural) return std_ulogic_vector is
+    variable tmp_v : std_ulogic_vector(2 downto 0);
+  begin
+    tmp_v := plru;
+    if (DCACHE_NUM_SETS = 4) then
+      if (set < 2) then
+        tmp_v(0) := '1';
+        if (set = 0) then tmp_v(1) := '1'; else tmp_v(1) := '0'; end if;
+      else
+        tmp_v(0) := '0';
+        if (set = 2) then tmp_v(2) := '1'; else tmp_v(2) := '0'; end if;
+      end if;
+    elsif (DCACHE_NUM_SETS = 2) then
+      if (set = 0) then tmp_v(0) := '1'; else tmp_v(0) := '0'; end if;
+    end if;
+    return tmp_v;
+  end function plru_update_f;
 
 begin
 
-	-- Access Address Decomposition -----------------------------------------------------------
+  -- Access Address Decomposition -----------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   host_acc_addr.tag    <= host_addr_i(31 downto 31-(cache_tag_size_c-1));
   host_acc_addr.index  <= host_addr_i(31-cache_tag_size_c downto 2+cache_offset_size_c);
@@ -467,84 +729,183 @@ begin
   ctrl_acc_addr.offset <= ctrl_addr_i(2+(cache_offset_size_c-1) downto 2); -- discard byte offset
 
 
-	-- Status Flag Memory ---------------------------------------------------------------------
+  -- Cache Access History -------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  status_memory: process(rstn_i, clk_i)
+  access_history: process(rstn_i, clk_i)
   begin
     if (rstn_i = '0') then
-      valid_flag <= (others => '0');
-      valid      <= '0';
+      history.mem <= (others => (others => '0'));
+      history.rd  <= (others => '0');
     elsif rising_edge(clk_i) then
-      -- write access --
-      if (clear_i = '1') then -- invalidate entire cache
-        valid_flag <= (others => '0');
-      elsif (ctrl_we_i = '1') then -- control write access: make current block valid
-        valid_flag(to_integer(unsigned(cache_index))) <= '1';
+      if (clear_i = '1') then -- invalidate cache
+        history.mem <= (others => (others => '0'));
+      elsif (host_chk_i = '1') and (or_reduce_f(hit) = '1') then -- make hit set the most recently used one
+        history.mem(to_integer(unsigned(host_acc_addr.index))) <= plru_update_f(history.rd, hit_set);
       end if;
-      -- sync read access --
-      valid <= valid_flag(to_integer(unsigned(cache_index)));
+      history.rd <= history.mem(to_integer(unsigned(cache_index)));
     end if;
-  end process status_memory;
+  end process access_history;
+
+  -- which set is going to be replaced? -> (pseudo) least recently used set --
+  history.lru_set <= plru_victim_f(history.rd);
 
 
-	-- Tag Memory -----------------------------------------------------------------------------
+  -- Cache Sets -----------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  tag_memory: process(clk_i)
-  begin
-    if rising_edge(clk_i) then -- no reset to allow inferring of blockRAM
-      if (ctrl_we_i = '1') then -- write access
-        tag_mem(to_integer(unsigned(cache_index))) <= ctrl_acc_addr.tag;
-      else -- read access
-        tag <= tag_mem(to_integer(unsigned(cache_index)));
-      end if;
-    end if;
-  end process tag_memory;
+  cache_sets:
+  for i in 0 to DCACHE_NUM_SETS-1 generate
 
-  -- hit? --
-  hit_o <= '1' when (host_acc_addr.tag = tag) and (valid = '1') else '0';
+    -- status flag memory --
+    signal valid_flag : std_ulogic_vector(DCACHE_NUM_BLOCKS-1 downto 0);
+    signal dirty_flag : std_ulogic_vector(DCACHE_NUM_BLOCKS-1 downto 0);
 
+    -- tag memory --
+    type tag_mem_t is array (0 to DCACHE_NUM_BLOCKS-1) of std_ulogic_vector(cache_tag_size_c-1 downto 0);
+    signal tag_mem : tag_mem_t;
+
+    -- cache data memory --
+    type cache_mem_t is array (0 to cache_entries_c-1) of std_ulogic_vector(7 downto 0);
+    signal cache_data_memory_b0 : cache_mem_t; -- byte 0
+    signal cache_data_memory_b1 : cache_mem_t; -- byte 1
+    signal cache_data_memory_b2 : cache_mem_t; -- byte 2
+    signal cache_data_memory_b3 : cache_mem_t; -- byte 3
+    signal cache_err_memory     : std_ulogic_vector(cache_entries_c-1 downto 0); -- access error flag
 
-	-- Cache Data Memory ----------------------------------------------------------------------
-  -- -------------------------------------------------------------------------------------------
-  cache_mem_access: process(clk_i)
   begin
-    if rising_edge(clk_i) then -- no reset to allow inferring of blockRAM
-      -- write access --
-      if (ctrl_we_i = '1') and (ctrl_ben_i(0) = '1') then
-        cache_data_memory_b0(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(07 downto 00);
-      end if;
-      if (ctrl_we_i = '1') and (ctrl_ben_i(1) = '1') then
-        cache_data_memory_b1(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(15 downto 08);
+
+    -- Status Flag Memory --
+    status_memory: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        valid_flag <= (others => '0');
+        dirty_flag <= (others => '0');
+        valid(i)   <= '0';
+        dirty(i)   <= '0';
+      elsif rising_edge(clk_i) then
+        -- write access --
+        if (clear_i = '1') then -- invalidate entire cache
+          valid_flag <= (others => '0');
+          dirty_flag <= (others => '0');
+        elsif (set_we(i) = '1') then -- control write access: make current block valid, update dirty flag
+          valid_flag(to_integer(unsigned(cache_index))) <= '1';
+          dirty_flag(to_integer(unsigned(cache_index))) <= ctrl_dirty_i;
+        elsif (ctrl_inval_i = '1') and (ctrl_set = i) then -- control invalidate access: make current block invalid
+          valid_flag(to_integer(unsigned(cache_index))) <= '0';
+          dirty_flag(to_integer(unsigned(cache_index))) <= '0';
+        end if;
+        -- sync read access --
+        valid(i) <= valid_flag(to_integer(unsigned(cache_index)));
+        dirty(i) <= dirty_flag(to_integer(unsigned(cache_index)));
       end if;
-      if (ctrl_we_i = '1') and (ctrl_ben_i(2) = '1') then
-        cache_data_memory_b2(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(23 downto 16);
+    end process status_memory;
+
+    -- Tag Memory --
+    tag_memory: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to allow inferring of blockRAM
+        if (set_we(i) = '1') then -- write access
+          tag_mem(to_integer(unsigned(cache_index))) <= ctrl_acc_addr.tag;
+        end if;
+        tag(i) <= tag_mem(to_integer(unsigned(cache_index)));
       end if;
-      if (ctrl_we_i = '1') and (ctrl_ben_i(3) = '1') then
-        cache_data_memory_b3(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(31 downto 24);
+    end process tag_memory;
+
+    -- Cache Data Memory --
+    cache_mem_access: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to allow inferring of blockRAM
+        -- write access --
+        if (set_we(i) = '1') and (ctrl_ben_i(0) = '1') then
+          cache_data_memory_b0(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(07 downto 00);
+        end if;
+        if (set_we(i) = '1') and (ctrl_ben_i(1) = '1') then
+          cache_data_memory_b1(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(15 downto 08);
+        end if;
+        if (set_we(i) = '1') and (ctrl_ben_i(2) = '1') then
+          cache_data_memory_b2(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(23 downto 16);
+        end if;
+        if (set_we(i) = '1') and (ctrl_ben_i(3) = '1') then
+          cache_data_memory_b3(to_integer(unsigned(cache_addr))) <= ctrl_wdata_i(31 downto 24);
+        end if;
+        if (set_we(i) = '1') then
+          cache_err_memory(to_integer(unsigned(cache_addr))) <= ctrl_wstat_i;
+        end if;
+        -- read access --
+        cache_rd(i)(07 downto 00) <= cache_data_memory_b0(to_integer(unsigned(cache_addr)));
+        cache_rd(i)(15 downto 08) <= cache_data_memory_b1(to_integer(unsigned(cache_addr)));
+        cache_rd(i)(23 downto 16) <= cache_data_memory_b2(to_integer(unsigned(cache_addr)));
+        cache_rd(i)(31 downto 24) <= cache_data_memory_b3(to_integer(unsigned(cache_addr)));
+        cache_rd(i)(32)           <=     cache_err_memory(to_integer(unsigned(cache_addr)));
       end if;
-      if (ctrl_we_i = '1') then
-        cache_err_memory(to_integer(unsigned(cache_addr))) <= ctrl_wstat_i;
+    end process cache_mem_access;
+
+    -- set write enable --
+    set_we(i) <= '1' when (ctrl_we_i = '1') and (ctrl_set = i) else '0';
+
+    -- comparator --
+    hit(i) <= '1' when (host_acc_addr.tag = tag(i)) and (valid(i) = '1') else '0';
+
+  end generate;
+
+
+  -- Cache Status ---------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- hit set encoder --
+  hit_encoder: process(hit)
+  begin
+    hit_set <= 0;
+    for i in 0 to DCACHE_NUM_SETS-1 loop
+      if (hit(i) = '1') then
+        hit_set <= i;
       end if;
-      -- read access --
-      cache_rdata(07 downto 00) <= cache_data_memory_b0(to_integer(unsigned(cache_addr)));
-      cache_rdata(15 downto 08) <= cache_data_memory_b1(to_integer(unsigned(cache_addr)));
-      cache_rdata(23 downto 16) <= cache_data_memory_b2(to_integer(unsigned(cache_addr)));
-      cache_rdata(31 downto 24) <= cache_data_memory_b3(to_integer(unsigned(cache_addr)));
-      cache_rdata(32)           <=     cache_err_memory(to_integer(unsigned(cache_addr)));
+    end loop; -- i
+  end process hit_encoder;
+
+  -- global hit --
+  hit_o <= or_reduce_f(hit);
+
+  -- hit set or replacement candidate --
+  set_o <= std_ulogic_vector(to_unsigned(hit_set, 2)) when (or_reduce_f(hit) = '1') else std_ulogic_vector(to_unsigned(history.lru_set, 2));
+
+  -- selected set (control access) --
+  ctrl_set_multi:
+  if (DCACHE_NUM_SETS > 1) generate
+    ctrl_set <= to_integer(unsigned(ctrl_set_i(index_size_f(DCACHE_NUM_SETS)-1 downto 0)));
+  end generate;
+
+  ctrl_set_single:
+  if (DCACHE_NUM_SETS = 1) generate
+    ctrl_set <= 0; -- direct-mapped: there is only one set
+  end generate;
+
+  -- dirty block? --
+  dirty_o <= dirty(ctrl_set) and valid(ctrl_set);
+
+  -- base address of accessed block (for write-back) --
+  tag_idx_reg: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      tag_index <= cache_index;
     end if;
-  end process cache_mem_access;
+  end process tag_idx_reg;
+
+  base_o(31 downto 31-(cache_tag_size_c-1)) <= tag(ctrl_set);
+  base_o(31-cache_tag_size_c downto 2+cache_offset_size_c) <= tag_index;
+  base_o((cache_offset_size_c+2)-1 downto 0) <= (others => '0');
 
-  -- data output --
-  host_rdata_o <= cache_rdata(31 downto 0);
-  ctrl_rdata_o <= cache_rdata(31 downto 0);
-  host_rstat_o <= cache_rdata(32) and valid;
+
+  -- Cache Data Output ----------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  host_rdata_o <= cache_rd(hit_set)(31 downto 0);
+  host_rstat_o <= cache_rd(hit_set)(32);
+  ctrl_rdata_o <= cache_rd(ctrl_set)(31 downto 0);
 
   -- cache block ram access address --
   cache_addr <= cache_index & cache_offset;
 
   -- cache access select --
-  cache_index  <= host_acc_addr.index  when (ctrl_we_i = '0') else ctrl_acc_addr.index;
-  cache_offset <= host_acc_addr.offset when (ctrl_we_i = '0') else ctrl_acc_addr.offset;
+  cache_index  <= host_acc_addr.index  when (ctrl_en_i = '0') else ctrl_acc_addr.index;
+  cache_offset <= host_acc_addr.offset when (ctrl_en_i = '0') else ctrl_acc_addr.offset;
 
 
 end neorv32_dcache_memory_rtl;
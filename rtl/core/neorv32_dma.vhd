@@ -1,8 +1,10 @@
 -- #################################################################################################
--- # << NEORV32 - Direct Memory Access (DMA) Controller >>                                         #
+-- # << NEORV32 - Direct Memory Access (DMA) Controller: Channel >>                                #
 -- # ********************************************************************************************* #
--- # Simple single-channel scatter/gather DMA controller that is also capable of transforming data #
--- # while moving it from source to destination.                                                   #
+-- # Single scatter/gather DMA channel that is also capable of transforming data while moving      #
+-- # it from source to destination. Transfers can also be fetched from a linked list of            #
+-- # descriptors in memory and executed back-to-back (descriptor chain mode). Accesses are         #
+-- # buffered in a small FIFO; aligned byte-to-byte transfers are packed into word accesses.       #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -41,7 +43,10 @@ use ieee.numeric_std.all;
 library neorv32;
 use neorv32.neorv32_package.all;
 
-entity neorv32_dma is
+entity neorv32_dma_channel is
+  generic (
+    NUM_CH : natural range 1 to 8 -- number of implemented channels
+  );
   port (
     clk_i     : in  std_ulogic; -- global clock line
     rstn_i    : in  std_ulogic; -- global reset line, low-active, async
@@ -52,13 +57,14 @@ entity neorv32_dma is
     firq_i    : in  std_ulogic_vector(15 downto 0); -- CPU FIRQ channels
     irq_o     : out std_ulogic  -- transfer done interrupt
   );
-end neorv32_dma;
+end neorv32_dma_channel;
 
-architecture neorv32_dma_rtl of neorv32_dma is
+architecture neorv32_dma_channel_rtl of neorv32_dma_channel is
 
   -- transfer type register bits --
   constant type_num_lo_c  : natural :=  0; -- r/w: Number of elements to transfer, LSB
   constant type_num_hi_c  : natural := 23; -- r/w: Number of elements to transfer, MSB
+  constant type_dirq_c    : natural := 24; -- -/w: Descriptor done interrupt (descriptor chain mode only)
   --
   constant type_qsel_lo_c : natural := 27; -- r/w: Data quantity select, LSB, see below
   constant type_qsel_hi_c : natural := 28; -- r/w: Data quantity select, MSB, see below
@@ -69,12 +75,17 @@ architecture neorv32_dma_rtl of neorv32_dma is
   -- control and status register bits --
   constant ctrl_en_c            : natural :=  0; -- r/w: DMA enable
   constant ctrl_auto_c          : natural :=  1; -- r/w: enable FIRQ-triggered transfer
-  constant ctrl_fence_c         : natural :=  3; -- r/w: issue FENCE operation when DMA is done
+  constant ctrl_fence_c         : natural :=  2; -- r/w: issue FENCE operation when DMA is done
+  constant ctrl_oneshot_c       : natural :=  3; -- r/w: clear AUTO when a transfer is done (one-shot automatic trigger)
+  constant ctrl_num_ch_lsb_c    : natural :=  4; -- r/-: number of implemented channels LSB
+  constant ctrl_num_ch_msb_c    : natural :=  7; -- r/-: number of implemented channels MSB
   --
   constant ctrl_error_rd_c      : natural :=  8; -- r/-: error during read transfer
   constant ctrl_error_wr_c      : natural :=  9; -- r/-: error during write transfer
   constant ctrl_busy_c          : natural := 10; -- r/-: DMA transfer in progress
   constant ctrl_done_c          : natural := 11; -- r/c: a DMA transfer was executed/attempted
+  constant ctrl_ddone_c         : natural := 12; -- r/c: a descriptor with enabled interrupt was completed
+  constant ctrl_chain_c         : natural := 13; -- r/-: descriptor chain in progress
   --
   constant ctrl_firq_mask_lsb_c : natural := 16; -- r/w: FIRQ trigger mask LSB
   constant ctrl_firq_mask_msb_c : natural := 31; -- r/w: FIRQ trigger mask MSB
@@ -90,6 +101,7 @@ architecture neorv32_dma_rtl of neorv32_dma is
     enable    : std_ulogic; -- DMA enabled when set
     auto      : std_ulogic; -- FIRQ-driven auto transfer
     fence     : std_ulogic; -- issue FENCE operation when DMA is done
+    oneshot   : std_ulogic; -- clear auto-trigger mode when transfer is done
     firq_mask : std_ulogic_vector(15 downto 0); -- FIRQ trigger mask
     src_base  : std_ulogic_vector(31 downto 0); -- source base address
     dst_base  : std_ulogic_vector(31 downto 0); -- destination base address
@@ -100,28 +112,64 @@ architecture neorv32_dma_rtl of neorv32_dma is
     endian    : std_ulogic; -- convert endianness when set
     start     : std_ulogic; -- transfer start trigger
     done      : std_ulogic; -- transfer was executed (but might have failed)
+    desc      : std_ulogic_vector(31 downto 0); -- descriptor chain base address
+    dstart    : std_ulogic; -- descriptor chain start trigger
+    ddone     : std_ulogic; -- descriptor with enabled interrupt was completed
   end record;
   signal config : config_t;
 
+  -- data buffer (FIFO) --
+  constant fifo_depth_c : natural := 4; -- number of entries, has to be a power of two, max 4
+  type fifo_data_t is array (0 to fifo_depth_c-1) of std_ulogic_vector(31 downto 0);
+  type fifo_cnt_t  is array (0 to fifo_depth_c-1) of unsigned(2 downto 0);
+  signal fifo_data : fifo_data_t; -- transformed data word
+  signal fifo_cnt  : fifo_cnt_t;  -- number of elements in data word
+
   -- bus access engine --
-  type state_t is (S_IDLE, S_READ, S_WRITE, S_NEXT);
+  type state_t is (S_IDLE, S_DESC, S_READ, S_WRITE, S_NEXT);
   type engine_t is record
     state    : state_t;
     src_addr : std_ulogic_vector(31 downto 0);
     dst_addr : std_ulogic_vector(31 downto 0);
-    num      : std_ulogic_vector(23 downto 0);
+    num      : std_ulogic_vector(23 downto 0); -- remaining elements to write
+    rnum     : std_ulogic_vector(23 downto 0); -- remaining elements to read
+    qsel     : std_ulogic_vector(01 downto 0); -- active transfer type
+    src_inc  : std_ulogic;
+    dst_inc  : std_ulogic;
+    endian   : std_ulogic;
+    pack     : std_ulogic; -- byte-packing mode: move up to four bytes per access
+    chain    : std_ulogic; -- descriptor chain mode
+    desc     : std_ulogic_vector(31 downto 0); -- current descriptor address
+    dcnt     : std_ulogic_vector(01 downto 0); -- descriptor word select
+    dnext    : std_ulogic_vector(31 downto 0); -- next descriptor address
+    dirq_en  : std_ulogic; -- interrupt when current descriptor is done
+    dirq     : std_ulogic; -- descriptor done interrupt
+    wp       : unsigned(2 downto 0); -- FIFO write pointer / fill level
+    rp       : unsigned(2 downto 0); -- FIFO read pointer
     err_rd   : std_ulogic;
     err_wr   : std_ulogic;
-    src_add  : unsigned(31 downto 0);
-    dst_add  : unsigned(31 downto 0);
     busy     : std_ulogic;
     done     : std_ulogic;
   end record;
   signal engine : engine_t;
 
+  -- byte-packing mode check --
+  signal pack_cfg, pack_desc : std_ulogic;
+
+  -- read/write access control --
+  signal rd_cnt   : unsigned(2 downto 0); -- elements moved by current read access
+  signal rd_step  : unsigned(2 downto 0); -- source address increment
+  signal rd_nxt   : std_ulogic_vector(23 downto 0); -- remaining elements to read after current access
+  signal rd_ben   : std_ulogic_vector(03 downto 0);
+  signal rd_burst : std_ulogic;
+  signal wr_step  : unsigned(2 downto 0); -- destination address increment
+  signal wr_nxt   : std_ulogic_vector(23 downto 0); -- remaining elements to write after current access
+  signal wr_ben   : std_ulogic_vector(03 downto 0);
+  signal wr_burst : std_ulogic;
+
   -- data alignment --
-  signal align_buf : std_ulogic_vector(31 downto 0);
   signal align_end : std_ulogic_vector(31 downto 0);
+  signal align_src : std_ulogic_vector(31 downto 0);
 
   -- FIRQ trigger --
   signal firq_buf : std_ulogic_vector(15 downto 0);
@@ -142,6 +190,7 @@ begin
       config.enable    <= '0';
       config.auto      <= '0';
       config.fence     <= '0';
+      config.oneshot   <= '0';
       config.firq_mask <= (others => '0');
       config.src_base  <= (others => '0');
       config.dst_base  <= (others => '0');
@@ -152,6 +201,9 @@ begin
       config.endian    <= '0';
       config.start     <= '0';
       config.done      <= '0';
+      config.desc      <= (others => '0');
+      config.dstart    <= '0';
+      config.ddone     <= '0';
     elsif rising_edge(clk_i) then
       -- bus handshake --
       bus_rsp_o.ack  <= bus_req_i.stb;
@@ -159,27 +211,38 @@ begin
       bus_rsp_o.data <= (others => '0');
 
       -- defaults --
-      config.start <= '0'; -- default
-      config.done  <= config.enable and (config.done or engine.done); -- set if enabled and transfer done
+      config.start  <= '0'; -- default
+      config.dstart <= '0'; -- default
+      config.done   <= config.enable and (config.done or engine.done); -- set if enabled and transfer done
+      config.ddone  <= config.enable and (config.ddone or engine.dirq); -- set if enabled and descriptor done
+      if (config.oneshot = '1') and (engine.done = '1') then -- one-shot: ignore further FIRQ triggers until re-armed
+        config.auto <= '0';
+      end if;
 
       if (bus_req_i.stb = '1') then
 
         -- write access --
         if (bus_req_i.rw = '1') then
-          if (bus_req_i.addr(3 downto 2) = "00") then -- control and status register
+          if (bus_req_i.addr(4 downto 2) = "000") then -- control and status register
             config.enable    <= bus_req_i.data(ctrl_en_c);
             config.auto      <= bus_req_i.data(ctrl_auto_c);
             config.fence     <= bus_req_i.data(ctrl_fence_c);
+            config.oneshot   <= bus_req_i.data(ctrl_oneshot_c);
             config.done      <= '0'; -- clear on write access
+            config.ddone     <= '0'; -- clear on write access
             config.firq_mask <= bus_req_i.data(ctrl_firq_mask_msb_c downto ctrl_firq_mask_lsb_c);
           end if;
-          if (bus_req_i.addr(3 downto 2) = "01") then -- source base address
+          if (bus_req_i.addr(4 downto 2) = "001") then -- source base address
             config.src_base <= bus_req_i.data;
           end if;
-          if (bus_req_i.addr(3 downto 2) = "10") then -- destination base address
+          if (bus_req_i.addr(4 downto 2) = "010") then -- destination base address
             config.dst_base <= bus_req_i.data;
           end if;
-          if (bus_req_i.addr(3 downto 2) = "11") then -- transfer type register
+          if (bus_req_i.addr(4 downto 2) = "100") then -- descriptor chain base address
+            config.desc   <= bus_req_i.data(31 downto 4) & "0000"; -- 16-byte aligned
+            config.dstart <= '1'; -- trigger descriptor chain
+          end if;
+          if (bus_req_i.addr(4 downto 2) = "011") then -- transfer type register
             config.num     <= bus_req_i.data(type_num_hi_c downto type_num_lo_c);
             config.qsel    <= bus_req_i.data(type_qsel_hi_c downto type_qsel_lo_c);
             config.src_inc <= bus_req_i.data(type_src_inc_c);
@@ -190,26 +253,34 @@ begin
 
         -- read access --
         else
-          case bus_req_i.addr(3 downto 2) is
-            when "00" => -- control and status register
+          case bus_req_i.addr(4 downto 2) is
+            when "000" => -- control and status register
               bus_rsp_o.data(ctrl_en_c)       <= config.enable;
               bus_rsp_o.data(ctrl_auto_c)     <= config.auto;
               bus_rsp_o.data(ctrl_fence_c)    <= config.fence;
+              bus_rsp_o.data(ctrl_oneshot_c)  <= config.oneshot;
+              bus_rsp_o.data(ctrl_num_ch_msb_c downto ctrl_num_ch_lsb_c) <= std_ulogic_vector(to_unsigned(NUM_CH, 4));
               bus_rsp_o.data(ctrl_error_rd_c) <= engine.err_rd;
               bus_rsp_o.data(ctrl_error_wr_c) <= engine.err_wr;
               bus_rsp_o.data(ctrl_busy_c)     <= engine.busy;
               bus_rsp_o.data(ctrl_done_c)     <= config.done;
+              bus_rsp_o.data(ctrl_ddone_c)    <= config.ddone;
+              bus_rsp_o.data(ctrl_chain_c)    <= engine.chain;
               bus_rsp_o.data(ctrl_firq_mask_msb_c downto ctrl_firq_mask_lsb_c) <= config.firq_mask;
-            when "01" => -- address of last read access
+            when "001" => -- address of last read access
               bus_rsp_o.data <= engine.src_addr;
-            when "10" => -- address of last write access
+            when "010" => -- address of last write access
               bus_rsp_o.data <= engine.dst_addr;
-            when others => -- transfer type register
+            when "011" => -- transfer type register
               bus_rsp_o.data(type_num_hi_c downto type_num_lo_c)   <= engine.num;
-              bus_rsp_o.data(type_qsel_hi_c downto type_qsel_lo_c) <= config.qsel;
-              bus_rsp_o.data(type_src_inc_c)                       <= config.src_inc;
-              bus_rsp_o.data(type_dst_inc_c)                       <= config.dst_inc;
-              bus_rsp_o.data(type_endian_c)                        <= config.endian;
+              bus_rsp_o.data(type_qsel_hi_c downto type_qsel_lo_c) <= engine.qsel;
+              bus_rsp_o.data(type_src_inc_c)                       <= engine.src_inc;
+              bus_rsp_o.data(type_dst_inc_c)                       <= engine.dst_inc;
+              bus_rsp_o.data(type_endian_c)                        <= engine.endian;
+            when "100" => -- address of current descriptor
+              bus_rsp_o.data <= engine.desc;
+            when others => -- reserved
+              bus_rsp_o.data <= (others => '0');
           end case;
         end if;
 
@@ -246,6 +317,20 @@ begin
       engine.src_addr <= (others => '0');
       engine.dst_addr <= (others => '0');
       engine.num      <= (others => '0');
+      engine.rnum     <= (others => '0');
+      engine.qsel     <= (others => '0');
+      engine.src_inc  <= '0';
+      engine.dst_inc  <= '0';
+      engine.endian   <= '0';
+      engine.pack     <= '0';
+      engine.chain    <= '0';
+      engine.desc     <= (others => '0');
+      engine.dcnt     <= (others => '0');
+      engine.dnext    <= (others => '0');
+      engine.dirq_en  <= '0';
+      engine.dirq     <= '0';
+      engine.wp       <= (others => '0');
+      engine.rp       <= (others => '0');
       engine.err_rd   <= '0';
       engine.err_wr   <= '0';
       engine.done     <= '0';
@@ -254,6 +339,7 @@ begin
     elsif rising_edge(clk_i) then
       -- defaults --
       engine.done   <= '0';
+      engine.dirq   <= '0';
       dma_req_o.stb <= '0';
 
       -- state machine --
@@ -264,7 +350,26 @@ begin
           engine.src_addr <= config.src_base;
           engine.dst_addr <= config.dst_base;
           engine.num      <= config.num;
-          if (config.enable = '1') and
+          engine.rnum     <= config.num;
+          engine.qsel     <= config.qsel;
+          engine.src_inc  <= config.src_inc;
+          engine.dst_inc  <= config.dst_inc;
+          engine.endian   <= config.endian;
+          engine.pack     <= pack_cfg;
+          engine.chain    <= '0';
+          engine.desc     <= config.desc;
+          engine.dcnt     <= (others => '0');
+          engine.dirq_en  <= '0';
+          engine.wp       <= (others => '0');
+          engine.rp       <= (others => '0');
+          if (config.enable = '1') and (config.auto = '0') and (config.dstart = '1') then -- descriptor chain trigger
+            engine.err_rd <= '0';
+            engine.err_wr <= '0';
+            engine.chain  <= '1';
+            dma_req_o.rw  <= '0'; -- read
+            dma_req_o.stb <= '1'; -- issue descriptor read request
+            engine.state  <= S_DESC;
+          elsif (config.enable = '1') and
              (((config.auto = '0') and (config.start = '1')) or -- manual trigger
               ((config.auto = '1') and (atrigger = '1'))) then -- automatic trigger
             engine.err_rd <= '0';
@@ -274,41 +379,108 @@ begin
             engine.state  <= S_READ;
           end if;
 
-        when S_READ => -- pending read access
+        when S_DESC => -- pending descriptor read access
         -- ------------------------------------------------------------
+          engine.pack <= pack_desc; -- valid after the descriptor has been fetched completely
+          engine.wp   <= (others => '0');
+          engine.rp   <= (others => '0');
           if (dma_rsp_i.err = '1') then
             engine.done   <= '1';
             engine.err_rd <= '1';
             engine.state  <= S_IDLE;
           elsif (dma_rsp_i.ack = '1') then
-            dma_req_o.rw  <= '1'; -- write
-            dma_req_o.stb <= '1'; -- issue write request
-            engine.state  <= S_WRITE;
+            case engine.dcnt is
+              when "00" => -- source base address
+                engine.src_addr <= dma_rsp_i.data;
+              when "01" => -- destination base address
+                engine.dst_addr <= dma_rsp_i.data;
+              when "10" => -- transfer type
+                engine.num     <= dma_rsp_i.data(type_num_hi_c downto type_num_lo_c);
+                engine.rnum    <= dma_rsp_i.data(type_num_hi_c downto type_num_lo_c);
+                engine.qsel    <= dma_rsp_i.data(type_qsel_hi_c downto type_qsel_lo_c);
+                engine.src_inc <= dma_rsp_i.data(type_src_inc_c);
+                engine.dst_inc <= dma_rsp_i.data(type_dst_inc_c);
+                engine.endian  <= dma_rsp_i.data(type_endian_c);
+                engine.dirq_en <= dma_rsp_i.data(type_dirq_c);
+              when others => -- next descriptor address
+                engine.dnext <= dma_rsp_i.data(31 downto 4) & "0000"; -- 16-byte aligned
+            end case;
+            engine.dcnt   <= std_ulogic_vector(unsigned(engine.dcnt) + 1);
+            dma_req_o.rw  <= '0'; -- read
+            dma_req_o.stb <= '1'; -- issue next descriptor read request or first data read request
+            if (engine.dcnt = "11") then -- descriptor complete
+              engine.state <= S_READ;
+            end if;
           end if;
 
-        when S_WRITE => -- pending write access
+        when S_READ => -- pending read access; fill FIFO
+        -- ------------------------------------------------------------
+          if (dma_rsp_i.err = '1') then
+            engine.err_rd <= '1';
+            if (engine.wp = 0) then -- nothing left to write
+              engine.done  <= '1';
+              engine.state <= S_IDLE;
+            else -- write already-fetched data first
+              dma_req_o.rw  <= '1'; -- write
+              dma_req_o.stb <= '1'; -- issue write request
+              engine.state  <= S_WRITE;
+            end if;
+          elsif (dma_rsp_i.ack = '1') then
+            engine.rnum <= rd_nxt;
+            engine.wp   <= engine.wp + 1;
+            if (engine.src_inc = '1') and (or_reduce_f(rd_nxt) = '1') then -- incrementing source address
+              engine.src_addr <= std_ulogic_vector(unsigned(engine.src_addr) + rd_step);
+            end if;
+            -- FIFO not full yet; an announced burst beat is always issued even if the transfer is being aborted --
+            if (or_reduce_f(rd_nxt) = '1') and (engine.wp /= (fifo_depth_c-1)) and ((config.enable = '1') or (rd_burst = '1')) then
+              dma_req_o.rw  <= '0'; -- read
+              dma_req_o.stb <= '1'; -- issue next read request
+            else
+              dma_req_o.rw  <= '1'; -- write
+              dma_req_o.stb <= '1'; -- issue write request
+              engine.state  <= S_WRITE;
+            end if;
+          end if;
+
+        when S_WRITE => -- pending write access; drain FIFO
         -- ------------------------------------------------------------
           if (dma_rsp_i.err = '1') then
             engine.done   <= '1';
             engine.err_wr <= '1';
             engine.state  <= S_IDLE;
           elsif (dma_rsp_i.ack = '1') then
-            engine.num   <= std_ulogic_vector(unsigned(engine.num) - 1);
-            engine.state <= S_NEXT;
+            engine.num <= wr_nxt;
+            engine.rp  <= engine.rp + 1;
+            if (engine.dst_inc = '1') and (or_reduce_f(wr_nxt) = '1') then -- incrementing destination address
+              engine.dst_addr <= std_ulogic_vector(unsigned(engine.dst_addr) + wr_step);
+            end if;
+            if ((engine.rp + 1) = engine.wp) then -- FIFO empty
+              engine.state <= S_NEXT;
+            else
+              dma_req_o.rw  <= '1'; -- write
+              dma_req_o.stb <= '1'; -- issue next write request
+            end if;
           end if;
 
         when S_NEXT => -- check if done; prepare next access
         -- ------------------------------------------------------------
-          if (or_reduce_f(engine.num) = '0') or (config.enable = '0') then -- transfer done or aborted?
+          engine.wp <= (others => '0');
+          engine.rp <= (others => '0');
+          if (engine.err_rd = '1') then -- terminated by read error
             engine.done  <= '1';
             engine.state <= S_IDLE;
-          else
-            if (config.src_inc = '1') then -- incrementing source address
-              engine.src_addr <= std_ulogic_vector(unsigned(engine.src_addr) + engine.src_add);
-            end if;
-            if (config.dst_inc = '1') then -- incrementing destination address
-              engine.dst_addr <= std_ulogic_vector(unsigned(engine.dst_addr) + engine.dst_add);
+          elsif (or_reduce_f(engine.num) = '0') or (config.enable = '0') then -- transfer done or aborted?
+            engine.dirq <= engine.chain and engine.dirq_en and config.enable;
+            if (engine.chain = '1') and (config.enable = '1') and (or_reduce_f(engine.dnext) = '1') then -- fetch next descriptor
+              engine.desc   <= engine.dnext;
+              dma_req_o.rw  <= '0'; -- read
+              dma_req_o.stb <= '1'; -- issue descriptor read request
+              engine.state  <= S_DESC;
+            else
+              engine.done  <= '1';
+              engine.state <= S_IDLE;
             end if;
+          else
             dma_req_o.rw  <= '0'; -- read
             dma_req_o.stb <= '1'; -- issue read request
             engine.state  <= S_READ;
@@ -326,76 +498,351 @@ begin
   engine.busy <= '0' when (engine.state = S_IDLE) else '1';
 
   -- transfer-done interrupt --
-  irq_o <= engine.done and config.enable; -- no interrupt if transfer was aborted
+  irq_o <= (engine.done or engine.dirq) and config.enable; -- no interrupt if transfer was aborted
 
   -- bus output --
   dma_req_o.priv  <= priv_mode_m_c; -- privileged access
   dma_req_o.src   <= '0'; -- source = data access
-  dma_req_o.addr  <= engine.src_addr when (engine.state = S_READ) else engine.dst_addr;
+  dma_req_o.addr  <= engine.src_addr when (engine.state = S_READ) else
+                     engine.desc(31 downto 4) & engine.dcnt & "00" when (engine.state = S_DESC) else engine.dst_addr;
+  dma_req_o.data  <= fifo_data(to_integer(engine.rp(1 downto 0)));
+  dma_req_o.ben   <= rd_ben when (engine.state = S_READ) else wr_ben when (engine.state = S_WRITE) else (others => '1');
   dma_req_o.rvso  <= '0'; -- no reservation set operation possible
+  dma_req_o.amo   <= '0'; -- no atomic read-modify-write operation possible
+  dma_req_o.amoop <= (others => '0');
+  dma_req_o.burst <= rd_burst when (engine.state = S_READ) else wr_burst when (engine.state = S_WRITE) else '0';
   dma_req_o.fence <= config.enable and config.fence and engine.done; -- issue FENCE operation when transfer is done
 
-  -- address increment --
-  address_inc: process(config.qsel)
+
+  -- Access Control -------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+
+  -- byte-packing mode: incrementing byte-to-byte transfer with identical address alignment and without endianness conversion --
+  pack_cfg  <= '1' when (config.qsel = qsel_b2b_c) and (config.src_inc = '1') and (config.dst_inc = '1') and (config.endian = '0') and
+                        (config.src_base(1 downto 0) = config.dst_base(1 downto 0)) else '0';
+  pack_desc <= '1' when (engine.qsel = qsel_b2b_c) and (engine.src_inc = '1') and (engine.dst_inc = '1') and (engine.endian = '0') and
+                        (engine.src_addr(1 downto 0) = engine.dst_addr(1 downto 0)) else '0';
+
+  -- read access: number of elements --
+  read_size: process(engine)
+    variable avail_v : unsigned(2 downto 0);
   begin
-    case config.qsel is
-      when qsel_b2b_c => engine.src_add <= to_unsigned(1, 32); engine.dst_add <= to_unsigned(1, 32); -- byte -> byte
-      when qsel_w2w_c => engine.src_add <= to_unsigned(4, 32); engine.dst_add <= to_unsigned(4, 32); -- word -> word
-      when others     => engine.src_add <= to_unsigned(1, 32); engine.dst_add <= to_unsigned(4, 32); -- byte -> word
-    end case;
-  end process address_inc;
+    if (engine.pack = '1') then -- all bytes up to the next word boundary
+      avail_v := to_unsigned(4, 3) - unsigned('0' & engine.src_addr(1 downto 0));
+      if (unsigned(engine.rnum) < avail_v) then
+        rd_cnt <= unsigned(engine.rnum(2 downto 0));
+      else
+        rd_cnt <= avail_v;
+      end if;
+    else -- single element
+      rd_cnt <= to_unsigned(1, 3);
+    end if;
+  end process read_size;
+
+  rd_nxt  <= std_ulogic_vector(unsigned(engine.rnum) - rd_cnt);
+  rd_step <= to_unsigned(4, 3) when (engine.qsel = qsel_w2w_c) else rd_cnt;
+
+  -- write access: number of elements --
+  wr_nxt  <= std_ulogic_vector(unsigned(engine.num) - fifo_cnt(to_integer(engine.rp(1 downto 0))));
+  wr_step <= fifo_cnt(to_integer(engine.rp(1 downto 0))) when (engine.qsel = qsel_b2b_c) else to_unsigned(4, 3);
+
+  -- byte enables --
+  byte_enable: process(engine, rd_cnt, fifo_cnt)
+    variable src_v, dst_v, cnt_v : natural range 0 to 7;
+  begin
+    src_v := to_integer(unsigned(engine.src_addr(1 downto 0)));
+    dst_v := to_integer(unsigned(engine.dst_addr(1 downto 0)));
+    cnt_v := to_integer(fifo_cnt(to_integer(engine.rp(1 downto 0))));
+    for i in 0 to 3 loop
+      if (engine.qsel = qsel_w2w_c) or ((i >= src_v) and (i < (src_v + to_integer(rd_cnt)))) then
+        rd_ben(i) <= '1';
+      else
+        rd_ben(i) <= '0';
+      end if;
+      if (engine.qsel /= qsel_b2b_c) or ((i >= dst_v) and (i < (dst_v + cnt_v))) then
+        wr_ben(i) <= '1';
+      else
+        wr_ben(i) <= '0';
+      end if;
+    end loop;
+  end process byte_enable;
+
+  -- sequential accesses (burst): incrementing word addresses and more accesses of the same type will follow --
+  rd_burst <= '1' when (engine.src_inc = '1') and ((engine.qsel = qsel_w2w_c) or (engine.pack = '1')) and
+                       (or_reduce_f(rd_nxt) = '1') and (engine.wp /= (fifo_depth_c-1)) else '0';
+  wr_burst <= '1' when (engine.dst_inc = '1') and ((engine.qsel /= qsel_b2b_c) or (engine.pack = '1')) and
+                       ((engine.rp + 1) /= engine.wp) else '0';
 
 
   -- Data Transformer -----------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
 
   -- endianness conversion --
-  align_end <= dma_rsp_i.data when (config.endian = '0') else bswap32_f(dma_rsp_i.data);
+  align_end <= dma_rsp_i.data when (engine.endian = '0') else bswap32_f(dma_rsp_i.data);
 
   -- source data alignment --
-  src_align: process(rstn_i, clk_i)
+  src_align: process(engine.qsel, engine.pack, engine.src_addr, align_end)
+    variable byte_v : std_ulogic_vector(7 downto 0);
+  begin
+    case engine.src_addr(1 downto 0) is
+      when "00"   => byte_v := align_end(07 downto 00);
+      when "01"   => byte_v := align_end(15 downto 08);
+      when "10"   => byte_v := align_end(23 downto 16);
+      when others => byte_v := align_end(31 downto 24);
+    end case;
+    if (engine.qsel = qsel_w2w_c) or (engine.pack = '1') then -- word / packed bytes: keep byte lanes
+      align_src <= align_end;
+    elsif (engine.qsel = qsel_b2b_c) then -- single byte: replicate to all byte lanes
+      align_src <= byte_v & byte_v & byte_v & byte_v;
+    else -- byte to word: zero/sign extension
+      align_src(07 downto 0) <= byte_v;
+      align_src(31 downto 8) <= (others => (engine.qsel(1) and byte_v(7)));
+    end if;
+  end process src_align;
+
+  -- data buffer (FIFO) --
+  fifo_write: process(rstn_i, clk_i)
   begin
     if (rstn_i = '0') then
-      align_buf <= (others => '0');
+      fifo_data <= (others => (others => '0'));
+      fifo_cnt  <= (others => (others => '0'));
     elsif rising_edge(clk_i) then
-      if (engine.state = S_READ) then
-        if (config.qsel = qsel_w2w_c) then -- word
-          align_buf <= align_end;
-        else -- byte
-          case engine.src_addr(1 downto 0) is
-            when "00" => -- byte 0
-              align_buf(07 downto 0) <= align_end(07 downto 00);
-              align_buf(31 downto 8) <= (others => (config.qsel(1) and align_end(07))); -- sign extension
-            when "01" => -- byte 1
-              align_buf(07 downto 0) <= align_end(15 downto 08);
-              align_buf(31 downto 8) <= (others => (config.qsel(1) and align_end(15))); -- sign extension
-            when "10" => -- byte 2
-              align_buf(07 downto 0) <= align_end(23 downto 16);
-              align_buf(31 downto 8) <= (others => (config.qsel(1) and align_end(23))); -- sign extension
-            when others => -- byte 3
-              align_buf(07 downto 0) <= align_end(31 downto 24);
-              align_buf(31 downto 8) <= (others => (config.qsel(1) and align_end(31))); -- sign extension
-          end case;
-        end if;
+      if (engine.state = S_READ) and (dma_rsp_i.ack = '1') then
+        fifo_data(to_integer(engine.wp(1 downto 0))) <= align_src;
+        fifo_cnt(to_integer(engine.wp(1 downto 0)))  <= rd_cnt;
       end if;
     end if;
-  end process src_align;
+  end process fifo_write;
+
+
+end neorv32_dma_channel_rtl;
 
-  -- destination data alignment --
-  dst_align: process(config.qsel, align_buf, engine.dst_addr)
+
+-- ############################################################################################################################
+-- ############################################################################################################################
+
+
+-- #################################################################################################
+-- # << NEORV32 - Direct Memory Access (DMA) Controller >>                                         #
+-- # ********************************************************************************************* #
+-- # Multi-channel DMA controller. Each channel provides its own register set (32 bytes per        #
+-- # channel) and FIRQ trigger mask. The bus accesses of all channels are arbitrated in a fair     #
+-- # round-robin fashion.                                                                          #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # The NEORV32 RISC-V Processor, https://github.com/stnolting/neorv32                            #
+-- # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_dma is
+  generic (
+    NUM_CH : natural range 1 to 8 -- number of implemented channels
+  );
+  port (
+    clk_i     : in  std_ulogic; -- global clock line
+    rstn_i    : in  std_ulogic; -- global reset line, low-active, async
+    bus_req_i : in  bus_req_t;  -- bus request
+    bus_rsp_o : out bus_rsp_t;  -- bus response
+    dma_req_o : out bus_req_t;  -- DMA request
+    dma_rsp_i : in  bus_rsp_t;  -- DMA response
+    firq_i    : in  std_ulogic_vector(15 downto 0); -- CPU FIRQ channels
+    irq_o     : out std_ulogic; -- transfer done interrupt (any channel)
+    busy_o    : out std_ulogic  -- bus access in progress (HPM event)
+  );
+end neorv32_dma;
+
+architecture neorv32_dma_rtl of neorv32_dma is
+
+  -- channel interface --
+  type req_arr_t is array (0 to NUM_CH-1) of bus_req_t;
+  type rsp_arr_t is array (0 to NUM_CH-1) of bus_rsp_t;
+  signal reg_req : req_arr_t;
+  signal reg_rsp : rsp_arr_t;
+  signal ch_req  : req_arr_t;
+  signal ch_rsp  : rsp_arr_t;
+  signal ch_irq  : std_ulogic_vector(NUM_CH-1 downto 0);
+
+  -- round-robin bus arbiter --
+  type arbiter_t is record
+    busy : std_ulogic; -- bus access in progress
+    stb  : std_ulogic; -- access request strobe for granted channel
+    sel  : natural range 0 to NUM_CH-1; -- currently/last granted channel
+    pend : std_ulogic_vector(NUM_CH-1 downto 0); -- pending access requests
+  end record;
+  signal arbiter : arbiter_t;
+
+begin
+
+  -- DMA Channels ---------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  channel_gen:
+  for i in 0 to NUM_CH-1 generate
+
+    -- register window select --
+    register_select: process(bus_req_i)
+    begin
+      reg_req(i) <= bus_req_i;
+      if (to_integer(unsigned(bus_req_i.addr(7 downto 5))) /= i) then
+        reg_req(i).stb <= '0';
+      end if;
+    end process register_select;
+
+    neorv32_dma_channel_inst: entity neorv32.neorv32_dma_channel
+    generic map (
+      NUM_CH => NUM_CH
+    )
+    port map (
+      clk_i     => clk_i,
+      rstn_i    => rstn_i,
+      bus_req_i => reg_req(i),
+      bus_rsp_o => reg_rsp(i),
+      dma_req_o => ch_req(i),
+      dma_rsp_i => ch_rsp(i),
+      firq_i    => firq_i,
+      irq_o     => ch_irq(i)
+    );
+
+  end generate;
+
+  -- register read-back --
+  bus_response: process(reg_rsp)
+    variable tmp_v : bus_rsp_t;
   begin
-    dma_req_o.ben <= (others => '0'); -- default
-    if (config.qsel = qsel_b2b_c) then -- byte
-      dma_req_o.data(07 downto 00) <= align_buf(7 downto 0);
-      dma_req_o.data(15 downto 08) <= align_buf(7 downto 0);
-      dma_req_o.data(23 downto 16) <= align_buf(7 downto 0);
-      dma_req_o.data(31 downto 24) <= align_buf(7 downto 0);
-      dma_req_o.ben(to_integer(unsigned(engine.dst_addr(1 downto 0)))) <= '1';
-    else -- word
-      dma_req_o.data <= align_buf;
-      dma_req_o.ben  <= "1111";
-    end if;
-  end process dst_align;
+    tmp_v := rsp_terminate_c;
+    for i in 0 to NUM_CH-1 loop -- OR all responses; only the accessed channel responds
+      tmp_v.data := tmp_v.data or reg_rsp(i).data;
+      tmp_v.ack  := tmp_v.ack  or reg_rsp(i).ack;
+      tmp_v.err  := tmp_v.err  or reg_rsp(i).err;
+    end loop;
+    bus_rsp_o <= tmp_v;
+  end process bus_response;
+
+  -- transfer-done interrupt (any channel) --
+  irq_o <= or_reduce_f(ch_irq);
+
+
+  -- Bus Arbiter ----------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  arbiter_single:
+  if (NUM_CH = 1) generate
+
+    -- bus access monitor --
+    access_monitor: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        arbiter.busy <= '0';
+      elsif rising_edge(clk_i) then
+        if (dma_rsp_i.ack = '1') or (dma_rsp_i.err = '1') then -- access completed
+          arbiter.busy <= '0';
+        elsif (ch_req(0).stb = '1') then
+          arbiter.busy <= '1';
+        end if;
+      end if;
+    end process access_monitor;
+
+    -- unused --
+    arbiter.stb  <= '0';
+    arbiter.sel  <= 0;
+    arbiter.pend <= (others => '0');
+
+    dma_req_o <= ch_req(0);
+    ch_rsp(0) <= dma_rsp_i;
+  end generate;
+
+  arbiter_multi:
+  if (NUM_CH > 1) generate
+
+    arbiter_fsm: process(rstn_i, clk_i)
+      variable idx_v : natural range 0 to NUM_CH-1;
+    begin
+      if (rstn_i = '0') then
+        arbiter.busy <= '0';
+        arbiter.stb  <= '0';
+        arbiter.sel  <= 0;
+        arbiter.pend <= (others => '0');
+      elsif rising_edge(clk_i) then
+        arbiter.stb <= '0'; -- default
+        -- buffer new requests (channel request signals remain stable until the access is completed) --
+        for i in 0 to NUM_CH-1 loop
+          if (ch_req(i).stb = '1') then
+            arbiter.pend(i) <= '1';
+          end if;
+        end loop;
+        -- arbitration --
+        if (arbiter.busy = '0') then -- bus idle: grant next pending channel (round-robin)
+          for i in 1 to NUM_CH loop
+            idx_v := (arbiter.sel + i) mod NUM_CH;
+            if (arbiter.pend(idx_v) = '1') then
+              arbiter.sel  <= idx_v;
+              arbiter.busy <= '1';
+              arbiter.stb  <= '1';
+              exit;
+            end if;
+          end loop;
+        elsif (dma_rsp_i.ack = '1') or (dma_rsp_i.err = '1') then -- access completed
+          arbiter.pend(arbiter.sel) <= '0';
+          arbiter.busy <= '0';
+        end if;
+      end if;
+    end process arbiter_fsm;
+
+    -- request switch --
+    request_switch: process(ch_req, arbiter)
+      variable fence_v : std_ulogic;
+    begin
+      fence_v := '0';
+      for i in 0 to NUM_CH-1 loop -- propagate fence requests from any channel
+        fence_v := fence_v or ch_req(i).fence;
+      end loop;
+      dma_req_o       <= ch_req(arbiter.sel);
+      dma_req_o.stb   <= arbiter.stb;
+      dma_req_o.fence <= fence_v;
+    end process request_switch;
+
+    -- response switch --
+    response_switch:
+    for i in 0 to NUM_CH-1 generate
+      ch_rsp(i).data <= dma_rsp_i.data;
+      ch_rsp(i).ack  <= dma_rsp_i.ack when (arbiter.busy = '1') and (arbiter.sel = i) else '0';
+      ch_rsp(i).err  <= dma_rsp_i.err when (arbiter.busy = '1') and (arbiter.sel = i) else '0';
+    end generate;
+
+  end generate;
+
+  -- bus occupancy --
+  busy_o <= arbiter.busy;
 
 
 end neorv32_dma_rtl;
@@ -3,6 +3,8 @@
 -- # ********************************************************************************************* #
 -- # Direct mapped (ICACHE_NUM_SETS = 1) or 2-way set-associative (ICACHE_NUM_SETS = 2).           #
 -- # Least recently used replacement policy (if ICACHE_NUM_SETS > 1).                              #
+-- # Critical-word-first (wrapping) block download with early restart.                             #
+-- # Optional sequential next-block prefetcher (ICACHE_PREFETCH_EN = true).                        #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -43,18 +45,23 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_icache is
   generic (
-    ICACHE_NUM_BLOCKS : natural range 1 to 256; -- number of blocks (min 1), has to be a power of 2
-    ICACHE_BLOCK_SIZE : natural range 1 to 2**16; -- block size in bytes (min 4), has to be a power of 2
-    ICACHE_NUM_SETS   : natural range 1 to 2; -- associativity / number of sets; 1=direct-mapped, 2=2-way set-associative
-    ICACHE_UC_PBEGIN  : std_ulogic_vector(3 downto 0) -- begin of uncached address space (page number)
+    ICACHE_NUM_BLOCKS  : natural range 1 to 256; -- number of blocks (min 1), has to be a power of 2
+    ICACHE_BLOCK_SIZE  : natural range 1 to 2**16; -- block size in bytes (min 4), has to be a power of 2
+    ICACHE_NUM_SETS    : natural range 1 to 2; -- associativity / number of sets; 1=direct-mapped, 2=2-way set-associative
+    ICACHE_PREFETCH_EN : boolean; -- implement sequential next-block prefetcher
+    ICACHE_UC_PBEGIN   : std_ulogic_vector(3 downto 0) -- begin of uncached address space (page number)
   );
   port (
-    clk_i     : in  std_ulogic; -- global clock, rising edge
-    rstn_i    : in  std_ulogic; -- global reset, low-active, async
-    cpu_req_i : in  bus_req_t;  -- request bus
-    cpu_rsp_o : out bus_rsp_t;  -- response bus
-    bus_req_o : out bus_req_t;  -- request bus
-    bus_rsp_i : in  bus_rsp_t   -- response bus
+    clk_i      : in  std_ulogic; -- global clock, rising edge
+    rstn_i     : in  std_ulogic; -- global reset, low-active, async
+    cpu_req_i  : in  bus_req_t;  -- request bus
+    cpu_rsp_o  : out bus_rsp_t;  -- response bus
+    bus_req_o  : out bus_req_t;  -- request bus
+    bus_rsp_i  : in  bus_rsp_t;  -- response bus
+    pf_issue_o : out std_ulogic; -- prefetch issued (HPM event)
+    pf_hit_o   : out std_ulogic; -- prefetched block used (HPM event)
+    hit_o      : out std_ulogic; -- cache hit (HPM event)
+    miss_o     : out std_ulogic  -- cache miss (HPM event)
   );
 end neorv32_icache;
 
@@ -90,6 +97,9 @@ architecture neorv32_icache_rtl of neorv32_icache is
     host_re_i    : in  std_ulogic; -- read enable
     host_rdata_o : out std_ulogic_vector(31 downto 0); -- read data
     host_rstat_o : out std_ulogic; -- read status
+    -- prefetch lookup (tag check only) --
+    pf_addr_i    : in  std_ulogic_vector(31 downto 0); -- lookup address
+    pf_hit_o     : out std_ulogic; -- block at lookup address is cached (one cycle latency)
     -- ctrl cache access (write-only) --
     ctrl_en_i    : in  std_ulogic; -- control interface enable
     ctrl_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
@@ -107,6 +117,7 @@ architecture neorv32_icache_rtl of neorv32_icache is
     host_rdata : std_ulogic_vector(31 downto 0); -- cpu read data
     host_rstat : std_ulogic; -- cpu read status
     hit        : std_ulogic; -- hit access
+    pf_hit     : std_ulogic; -- prefetch candidate block is cached
     ctrl_en    : std_ulogic; -- control access enable
     ctrl_addr  : std_ulogic_vector(31 downto 0); -- control access address
     ctrl_we    : std_ulogic; -- control write enable
@@ -116,19 +127,52 @@ architecture neorv32_icache_rtl of neorv32_icache is
   signal cache : cache_if_t;
 
   -- control engine --
-  type ctrl_engine_state_t is (S_IDLE, S_CLEAR, S_CHECK, S_DOWNLOAD_REQ, S_DOWNLOAD_GET, S_DIRECT_REQ, S_DIRECT_GET, S_RESYNC);
+  type ctrl_engine_state_t is (S_IDLE, S_CLEAR, S_CHECK, S_DOWNLOAD_REQ, S_DOWNLOAD_GET, S_DIRECT_REQ, S_DIRECT_GET);
   type ctrl_t is record
     state         : ctrl_engine_state_t; -- current state
     state_nxt     : ctrl_engine_state_t; -- next state
     addr_reg      : std_ulogic_vector(31 downto 0); -- address register for block download
     addr_reg_nxt  : std_ulogic_vector(31 downto 0);
+    crit_ofs      : std_ulogic_vector(cache_offset_size_c-1 downto 0); -- critical word offset (first word of block download)
+    crit_ofs_nxt  : std_ulogic_vector(cache_offset_size_c-1 downto 0);
     req_buf       : std_ulogic; -- request buffer
     req_buf_nxt   : std_ulogic;
     clear_buf     : std_ulogic; -- clear request buffer
     clear_buf_nxt : std_ulogic;
+    pf_addr       : std_ulogic_vector(31 downto 0); -- base address of last prefetch candidate block
+    pf_addr_nxt   : std_ulogic_vector(31 downto 0);
+    pf_src        : std_ulogic; -- block download is served by the prefetch buffer
+    pf_src_nxt    : std_ulogic;
+    pf_chk        : std_ulogic; -- prefetch candidate lookup result is available
+    pf_chk_nxt    : std_ulogic;
   end record;
   signal ctrl : ctrl_t;
 
+  -- next-block prefetcher --
+  type pf_state_t is (PF_IDLE, PF_REQ, PF_GET);
+  type pf_buf_t is array (0 to (2**cache_offset_size_c)-1) of std_ulogic_vector(32 downto 0); -- bus error & data
+  type pf_t is record
+    state  : pf_state_t; -- prefetch engine state
+    addr   : std_ulogic_vector(31 downto 0); -- download address
+    valid  : std_ulogic; -- buffer is assigned to the block at addr
+    kill   : std_ulogic; -- abort download after current bus transfer
+    avail  : std_ulogic_vector((2**cache_offset_size_c)-1 downto 0); -- word available in buffer
+    buf    : pf_buf_t; -- block buffer
+    start  : std_ulogic; -- start prefetching block at ctrl.pf_addr
+    inval  : std_ulogic; -- invalidate buffer / abort download
+    busy   : std_ulogic; -- prefetch engine is using the bus
+    hit    : std_ulogic; -- currently accessed block is in prefetch buffer
+    rdata  : std_ulogic_vector(32 downto 0); -- currently addressed buffer word
+    ravail : std_ulogic; -- currently addressed buffer word is available
+  end record;
+  signal pf : pf_t;
+
+  -- block download data source (bus or prefetch buffer) --
+  signal dl_ack, dl_err : std_ulogic;
+  signal dl_burst       : std_ulogic;
+  signal dl_data        : std_ulogic_vector(31 downto 0);
+  signal pf_next        : std_ulogic_vector(31 downto 0); -- base address of next block
+
 begin
 
   -- Sanity Checks --------------------------------------------------------------------------
@@ -146,24 +190,45 @@ begin
       ctrl.req_buf   <= '0';
       ctrl.clear_buf <= '0';
       ctrl.addr_reg  <= (others => '0');
+      ctrl.crit_ofs  <= (others => '0');
+      ctrl.pf_addr   <= (others => '1');
+      ctrl.pf_src    <= '0';
+      ctrl.pf_chk    <= '0';
     elsif rising_edge(clk_i) then
       ctrl.state     <= ctrl.state_nxt;
       ctrl.req_buf   <= ctrl.req_buf_nxt;
       ctrl.clear_buf <= ctrl.clear_buf_nxt;
       ctrl.addr_reg  <= ctrl.addr_reg_nxt;
+      ctrl.crit_ofs  <= ctrl.crit_ofs_nxt;
+      ctrl.pf_addr   <= ctrl.pf_addr_nxt;
+      ctrl.pf_src    <= ctrl.pf_src_nxt;
+      ctrl.pf_chk    <= ctrl.pf_chk_nxt;
     end if;
   end process ctrl_engine_fsm_sync;
 
 
   -- Control Engine FSM Comb ----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  ctrl_engine_fsm_comb: process(ctrl, cache, cpu_req_i, bus_rsp_i)
+  ctrl_engine_fsm_comb: process(ctrl, cache, cpu_req_i, bus_rsp_i, pf, pf_next, dl_ack, dl_err, dl_data, dl_burst)
   begin
     -- control defaults --
     ctrl.state_nxt     <= ctrl.state;
     ctrl.addr_reg_nxt  <= ctrl.addr_reg;
+    ctrl.crit_ofs_nxt  <= ctrl.crit_ofs;
     ctrl.req_buf_nxt   <= ctrl.req_buf or cpu_req_i.stb;
     ctrl.clear_buf_nxt <= ctrl.clear_buf or cpu_req_i.fence;
+    ctrl.pf_addr_nxt   <= ctrl.pf_addr;
+    ctrl.pf_src_nxt    <= ctrl.pf_src;
+    ctrl.pf_chk_nxt    <= '0';
+
+    -- prefetcher defaults --
+    pf.start           <= '0';
+    pf.inval           <= '0';
+    pf_hit_o           <= '0';
+
+    -- HPM event defaults --
+    hit_o              <= '0';
+    miss_o             <= '0';
 
     -- cache defaults --
     cache.clear        <= '0';
@@ -172,8 +237,8 @@ begin
     cache.ctrl_en      <= '0';
     cache.ctrl_addr    <= ctrl.addr_reg;
     cache.ctrl_we      <= '0';
-    cache.ctrl_wdata   <= bus_rsp_i.data;
-    cache.ctrl_wstat   <= bus_rsp_i.err;
+    cache.ctrl_wdata   <= dl_data;
+    cache.ctrl_wstat   <= dl_err;
 
     -- host interface defaults --
     cpu_rsp_o.ack      <= '0';
@@ -189,7 +254,18 @@ begin
     bus_req_o.rw       <= '0'; -- read-only
     bus_req_o.stb      <= '0';
     bus_req_o.rvso     <= cpu_req_i.rvso;
+    bus_req_o.amo      <= cpu_req_i.amo;
+    bus_req_o.amoop    <= cpu_req_i.amoop;
     bus_req_o.fence    <= cpu_req_i.fence;
+    bus_req_o.burst    <= '0';
+
+    -- prefetch engine bus access --
+    if (pf.busy = '1') then -- single-beat accesses only as a prefetch can be aborted after any word
+      bus_req_o.addr <= pf.addr;
+      if (pf.state = PF_REQ) then
+        bus_req_o.stb <= '1';
+      end if;
+    end if;
 
     -- fsm --
     case ctrl.state is
@@ -197,6 +273,10 @@ begin
       when S_IDLE => -- wait for host access request or cache control operation
       -- ------------------------------------------------------------
         ctrl.addr_reg_nxt <= cpu_req_i.addr;
+        -- start prefetch if the lookup of the previous cache hit reported that the next block is not cached yet --
+        if (ctrl.pf_chk = '1') and (cache.pf_hit = '0') and (pf.busy = '0') and (ctrl.clear_buf = '0') then
+          pf.start <= '1';
+        end if;
         if (ctrl.clear_buf = '1') then -- cache control operation?
           ctrl.state_nxt <= S_CLEAR;
         elsif (cpu_req_i.stb = '1') or (ctrl.req_buf = '1') then
@@ -209,44 +289,83 @@ begin
 
       when S_CHECK => -- finalize host access if cache hit
       -- ------------------------------------------------------------
-        -- calculate block base address - in case we need to download it --
-        ctrl.addr_reg_nxt((cache_offset_size_c+2)-1 downto 2) <= (others => '0'); -- block-aligned
+        -- block download starts with the requested (critical) word - in case we need to download it --
         ctrl.addr_reg_nxt(1 downto 0) <= "00"; -- word-aligned
+        ctrl.crit_ofs_nxt <= ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2);
         --
         ctrl.req_buf_nxt <= '0';
         if (cache.hit = '1') then -- cache HIT
+          hit_o <= '1';
           if (cache.host_rstat = '1') then -- data word from cache marked as faulty?
             cpu_rsp_o.err <= '1';
           else
             cpu_rsp_o.ack <= '1';
           end if;
+          -- check if next block has to be prefetched (only once per block); the according cache
+          -- lookup is done in parallel (pf_next) and evaluated in the next cycle (S_IDLE) --
+          if (ICACHE_PREFETCH_EN = true) and (ctrl.pf_addr /= pf_next) and
+             (unsigned(pf_next(31 downto 28)) < unsigned(ICACHE_UC_PBEGIN)) then
+            ctrl.pf_addr_nxt <= pf_next;
+            ctrl.pf_chk_nxt  <= '1';
+          end if;
           ctrl.state_nxt <= S_IDLE;
         else -- cache MISS
+          miss_o           <= '1';
+          ctrl.req_buf_nxt <= '1'; -- host request is still pending
+          if (pf.hit = '1') then -- block is already in the prefetch buffer
+            ctrl.pf_src_nxt <= '1';
+            pf_hit_o        <= '1';
+          end if;
           ctrl.state_nxt <= S_DOWNLOAD_REQ;
         end if;
 
       when S_DOWNLOAD_REQ => -- download new cache block: request new word
       -- ------------------------------------------------------------
-        bus_req_o.stb  <= '1'; -- request new read transfer
-        ctrl.state_nxt <= S_DOWNLOAD_GET;
+        cache.ctrl_en <= '1'; -- keep cache addressing stable (host address might change after early restart)
+        if (ctrl.pf_src = '1') then -- copy from prefetch buffer
+          ctrl.state_nxt <= S_DOWNLOAD_GET;
+        elsif (pf.busy = '1') then -- abort prefetch and wait for the bus to become available
+          pf.inval <= '1';
+        else
+          bus_req_o.burst <= dl_burst;
+          bus_req_o.stb   <= '1'; -- request new read transfer
+          ctrl.state_nxt  <= S_DOWNLOAD_GET;
+        end if;
 
-      when S_DOWNLOAD_GET => -- download new cache block: wait for bus response
+      when S_DOWNLOAD_GET => -- download new cache block: wait for bus response / prefetch buffer
       -- ------------------------------------------------------------
-        cache.ctrl_en <= '1'; -- cache update operation
-        if (bus_rsp_i.ack = '1') or (bus_rsp_i.err = '1') then -- ACK or ERROR = write to cache and get next word (store ERROR flag in cache)
+        cache.ctrl_en   <= '1'; -- cache update operation
+        cpu_rsp_o.data  <= dl_data;
+        bus_req_o.burst <= dl_burst;
+        if (dl_ack = '1') then -- ACK or ERROR = write to cache and get next word (store ERROR flag in cache)
           cache.ctrl_we <= '1'; -- write to cache
-          if (and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) = '1') then -- block complete?
-            ctrl.state_nxt <= S_RESYNC;
-          else -- get next word
-            ctrl.addr_reg_nxt <= std_ulogic_vector(unsigned(ctrl.addr_reg) + 4);
-            ctrl.state_nxt    <= S_DOWNLOAD_REQ;
+          -- early restart: forward word to host if it is the one that is currently requested --
+          if (ctrl.req_buf = '1') and (cpu_req_i.addr(31 downto 2) = ctrl.addr_reg(31 downto 2)) then
+            cpu_rsp_o.ack    <= not dl_err;
+            cpu_rsp_o.err    <= dl_err;
+            ctrl.req_buf_nxt <= '0';
+          end if;
+          -- wrap-around within the current block --
+          ctrl.addr_reg_nxt((cache_offset_size_c+2)-1 downto 2) <= std_ulogic_vector(unsigned(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) + 1);
+          if (std_ulogic_vector(unsigned(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) + 1) = ctrl.crit_ofs) then -- block complete?
+            if (ctrl.pf_src = '1') then -- block has been moved to the cache
+              pf.inval <= '1';
+            end if;
+            ctrl.pf_src_nxt <= '0';
+            ctrl.state_nxt  <= S_IDLE; -- pending host request (if any) is processed by a normal cache lookup
+          elsif (ctrl.pf_src = '0') then -- get next word from bus
+            ctrl.state_nxt <= S_DOWNLOAD_REQ;
           end if;
         end if;
 
       when S_DIRECT_REQ => -- direct access: request new word
       -- ------------------------------------------------------------
-        bus_req_o.stb  <= '1'; -- request new read transfer
-        ctrl.state_nxt <= S_DIRECT_GET;
+        if (pf.busy = '1') then -- abort prefetch and wait for the bus to become available
+          pf.inval <= '1';
+        else
+          bus_req_o.stb  <= '1'; -- request new read transfer
+          ctrl.state_nxt <= S_DIRECT_GET;
+        end if;
 
       when S_DIRECT_GET => -- direct access: wait for bus response
       -- ------------------------------------------------------------
@@ -260,14 +379,12 @@ begin
           ctrl.state_nxt <= S_IDLE;
         end if;
 
-      when S_RESYNC => -- re-sync host/cache access: cache read-latency
-      -- ------------------------------------------------------------
-        ctrl.state_nxt <= S_CHECK;
-
       when S_CLEAR => -- invalidate all cache entries
       -- ------------------------------------------------------------
         ctrl.clear_buf_nxt <= '0';
         cache.clear        <= '1';
+        pf.inval           <= '1';
+        ctrl.pf_addr_nxt   <= (others => '1');
         ctrl.state_nxt     <= S_IDLE;
 
       when others => -- undefined
@@ -277,6 +394,109 @@ begin
     end case;
   end process ctrl_engine_fsm_comb;
 
+  -- burst transfer: continue unless this is the last word of the block download or the wrap-around point --
+  dl_burst <= '1' when (ctrl.pf_src = '0') and (and_reduce_f(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) = '0') and
+                       (std_ulogic_vector(unsigned(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2)) + 1) /= ctrl.crit_ofs) else '0';
+
+  -- block download data source --
+  dl_ack  <= pf.ravail              when (ctrl.pf_src = '1') else (bus_rsp_i.ack or bus_rsp_i.err);
+  dl_err  <= pf.rdata(32)           when (ctrl.pf_src = '1') else bus_rsp_i.err;
+  dl_data <= pf.rdata(31 downto 0) when (ctrl.pf_src = '1') else bus_rsp_i.data;
+
+
+  -- Next-Block Prefetcher ------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  prefetch_enabled:
+  if ICACHE_PREFETCH_EN generate
+
+    -- base address of the block following the currently accessed one --
+    pf_next((cache_offset_size_c+2)-1 downto 0) <= (others => '0');
+    pf_next(31 downto cache_offset_size_c+2)    <= std_ulogic_vector(unsigned(ctrl.addr_reg(31 downto cache_offset_size_c+2)) + 1);
+
+    -- prefetch engine: download block into the prefetch buffer while the CPU keeps running from the cache --
+    pf_engine: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        pf.state <= PF_IDLE;
+        pf.addr  <= (others => '0');
+        pf.valid <= '0';
+        pf.kill  <= '0';
+        pf.avail <= (others => '0');
+      elsif rising_edge(clk_i) then
+        case pf.state is
+
+          when PF_IDLE => -- wait for prefetch request
+            if (pf.start = '1') then
+              pf.addr  <= ctrl.pf_addr;
+              pf.valid <= '1';
+              pf.kill  <= '0';
+              pf.avail <= (others => '0');
+              pf.state <= PF_REQ;
+            end if;
+
+          when PF_REQ => -- request new word
+            pf.state <= PF_GET;
+
+          when PF_GET => -- wait for bus response
+            if (bus_rsp_i.ack = '1') or (bus_rsp_i.err = '1') then
+              pf.avail(to_integer(unsigned(pf.addr((cache_offset_size_c+2)-1 downto 2)))) <= '1';
+              pf.addr((cache_offset_size_c+2)-1 downto 2) <= std_ulogic_vector(unsigned(pf.addr((cache_offset_size_c+2)-1 downto 2)) + 1);
+              if (and_reduce_f(pf.addr((cache_offset_size_c+2)-1 downto 2)) = '1') or (pf.kill = '1') then -- block complete or aborted?
+                pf.state <= PF_IDLE;
+              else
+                pf.state <= PF_REQ;
+              end if;
+            end if;
+
+          when others => -- undefined
+            pf.state <= PF_IDLE;
+
+        end case;
+        -- invalidate buffer --
+        if (pf.inval = '1') then
+          pf.valid <= '0';
+          pf.kill  <= '1';
+        end if;
+      end if;
+    end process pf_engine;
+
+    -- prefetch buffer --
+    pf_buffer: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to allow inferring of LUTRAM
+        if (pf.state = PF_GET) and ((bus_rsp_i.ack = '1') or (bus_rsp_i.err = '1')) then
+          pf.buf(to_integer(unsigned(pf.addr((cache_offset_size_c+2)-1 downto 2)))) <= bus_rsp_i.err & bus_rsp_i.data;
+        end if;
+      end if;
+    end process pf_buffer;
+
+    -- status --
+    pf.busy   <= '0' when (pf.state = PF_IDLE) else '1';
+    pf.hit    <= pf.valid when (pf.addr(31 downto cache_offset_size_c+2) = ctrl.addr_reg(31 downto cache_offset_size_c+2)) else '0';
+    pf.rdata  <= pf.buf(to_integer(unsigned(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2))));
+    pf.ravail <= pf.avail(to_integer(unsigned(ctrl.addr_reg((cache_offset_size_c+2)-1 downto 2))));
+
+    -- HPM event --
+    pf_issue_o <= pf.start;
+
+  end generate;
+
+  prefetch_disabled:
+  if not ICACHE_PREFETCH_EN generate
+    pf_next    <= (others => '0');
+    pf.state   <= PF_IDLE;
+    pf.addr    <= (others => '0');
+    pf.valid   <= '0';
+    pf.kill    <= '0';
+    pf.avail   <= (others => '0');
+    pf.buf     <= (others => (others => '0'));
+    pf.busy    <= '0';
+    pf.hit     <= '0';
+    pf.rdata   <= (others => '0');
+    pf.ravail  <= '0';
+    pf_issue_o <= '0';
+  end generate;
+
 
   -- Cache Memory ---------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -297,6 +517,9 @@ begin
     host_re_i    => cache.host_re,
     host_rdata_o => cache.host_rdata,
     host_rstat_o => cache.host_rstat,
+    -- prefetch lookup (tag check only) --
+    pf_addr_i    => pf_next,
+    pf_hit_o     => cache.pf_hit,
     -- ctrl cache access (write-only) --
     ctrl_en_i    => cache.ctrl_en,
     ctrl_addr_i  => cache.ctrl_addr,
@@ -373,6 +596,9 @@ entity neorv32_icache_memory is
     host_re_i    : in  std_ulogic; -- read enable
     host_rdata_o : out std_ulogic_vector(31 downto 0); -- read data
     host_rstat_o : out std_ulogic; -- read status
+    -- prefetch lookup (tag check only) --
+    pf_addr_i    : in  std_ulogic_vector(31 downto 0); -- lookup address
+    pf_hit_o     : out std_ulogic; -- block at lookup address is cached (one cycle latency)
     -- ctrl cache access (write-only) --
     ctrl_en_i    : in  std_ulogic; -- control interface enable
     ctrl_addr_i  : in  std_ulogic_vector(31 downto 0); -- access address
@@ -394,12 +620,14 @@ architecture neorv32_icache_memory_rtl of neorv32_icache_memory is
   signal valid_flag_s0 : std_ulogic_vector(ICACHE_NUM_BLOCKS-1 downto 0);
   signal valid_flag_s1 : std_ulogic_vector(ICACHE_NUM_BLOCKS-1 downto 0);
   signal valid         : std_ulogic_vector(1 downto 0); -- valid flag read data
+  signal pf_valid      : std_ulogic_vector(1 downto 0); -- valid flag read data (prefetch lookup)
 
   -- tag memory --
   type tag_mem_t is array (0 to ICACHE_NUM_BLOCKS-1) of std_ulogic_vector(cache_tag_size_c-1 downto 0);
   signal tag_mem_s0, tag_mem_s1 : tag_mem_t;
   type tag_rd_t is array (0 to 1) of std_ulogic_vector(cache_tag_size_c-1 downto 0);
-  signal tag : tag_rd_t; -- tag read data
+  signal tag    : tag_rd_t; -- tag read data
+  signal pf_tag : tag_rd_t; -- tag read data (prefetch lookup)
 
   -- access status --
   signal hit : std_ulogic_vector(1 downto 0);
@@ -410,7 +638,8 @@ architecture neorv32_icache_memory_rtl of neorv32_icache_memory is
     index  : std_ulogic_vector(cache_index_size_c-1 downto 0);
     offset : std_ulogic_vector(cache_offset_size_c-1 downto 0);
   end record;
-  signal host_acc_addr, ctrl_acc_addr : acc_addr_t;
+  signal host_acc_addr, ctrl_acc_addr, pf_acc_addr : acc_addr_t;
+  signal pf_acc_tag : std_ulogic_vector(cache_tag_size_c-1 downto 0); -- tag of last prefetch lookup
 
   -- cache data memory (32-bit data + 1-bit status) --
   type cache_mem_t is array (0 to cache_entries_c-1) of std_ulogic_vector(31+1 downto 0);
@@ -445,6 +674,10 @@ begin
   ctrl_acc_addr.index  <= ctrl_addr_i(31-cache_tag_size_c downto 2+cache_offset_size_c);
   ctrl_acc_addr.offset <= ctrl_addr_i(2+(cache_offset_size_c-1) downto 2); -- discard byte offset
 
+  pf_acc_addr.tag      <= pf_addr_i(31 downto 31-(cache_tag_size_c-1));
+  pf_acc_addr.index    <= pf_addr_i(31-cache_tag_size_c downto 2+cache_offset_size_c);
+  pf_acc_addr.offset   <= (others => '0'); -- unused
+
 
   -- Cache Access History -------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -477,6 +710,7 @@ begin
       valid_flag_s0 <= (others => '0');
       valid_flag_s1 <= (others => '0');
       valid         <= (others => '0');
+      pf_valid      <= (others => '0');
     elsif rising_edge(clk_i) then
       -- write access --
       if (clear_i = '1') then -- invalidate cache
@@ -492,6 +726,9 @@ begin
       -- sync read access --
       valid(0) <= valid_flag_s0(to_integer(unsigned(cache_index)));
       valid(1) <= valid_flag_s1(to_integer(unsigned(cache_index)));
+      -- sync read access (prefetch lookup) --
+      pf_valid(0) <= valid_flag_s0(to_integer(unsigned(pf_acc_addr.index)));
+      pf_valid(1) <= valid_flag_s1(to_integer(unsigned(pf_acc_addr.index)));
     end if;
   end process status_memory;
 
@@ -510,6 +747,10 @@ begin
       end if;
       tag(0) <= tag_mem_s0(to_integer(unsigned(cache_index)));
       tag(1) <= tag_mem_s1(to_integer(unsigned(cache_index)));
+      -- second read port for the prefetch lookup --
+      pf_tag(0)  <= tag_mem_s0(to_integer(unsigned(pf_acc_addr.index)));
+      pf_tag(1)  <= tag_mem_s1(to_integer(unsigned(pf_acc_addr.index)));
+      pf_acc_tag <= pf_acc_addr.tag;
     end if;
   end process tag_memory;
 
@@ -527,6 +768,17 @@ begin
   -- global hit --
   hit_o <= '1' when (or_reduce_f(hit) = '1') else '0';
 
+  -- prefetch lookup comparator --
+  pf_comparator: process(pf_acc_tag, pf_tag, pf_valid)
+  begin
+    pf_hit_o <= '0';
+    for i in 0 to ICACHE_NUM_SETS-1 loop
+      if (pf_acc_tag = pf_tag(i)) and (pf_valid(i) = '1') then
+        pf_hit_o <= '1';
+      end if;
+    end loop; -- i
+  end process pf_comparator;
+
 
   -- Cache Data Memory ----------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -2,7 +2,9 @@
 -- # << NEORV32 - Processor Bus Infrastructure: 2-to-1 Bus Switch >>                               #
 -- # ********************************************************************************************* #
 -- # Allows to access a single device bus X by two controller ports A and B.                       #
--- # Controller port A has priority over controller port B.                                        #
+-- # Controller port A has priority over controller port B unless round-robin arbitration is       #
+-- # enabled (ROUND_ROBIN_EN); in this case the port that was not served last wins a tie.          #
+-- # The beats of a burst transfer are never interrupted by the other port.                        #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -44,7 +46,8 @@ use neorv32.neorv32_package.all;
 entity neorv32_bus_switch is
   generic (
     PORT_A_READ_ONLY : boolean; -- set if port A is read-only
-    PORT_B_READ_ONLY : boolean  -- set if port B is read-only
+    PORT_B_READ_ONLY : boolean; -- set if port B is read-only
+    ROUND_ROBIN_EN   : boolean  -- fair arbitration instead of fixed port A priority
   );
   port (
     clk_i   : in  std_ulogic; -- global clock, rising edge
@@ -54,7 +57,9 @@ entity neorv32_bus_switch is
     b_req_i : in  bus_req_t;  -- host port B: request bus
     b_rsp_o : out bus_rsp_t;  -- host port B: response bus
     x_req_o : out bus_req_t;  -- device port request bus
-    x_rsp_i : in  bus_rsp_t   -- device port response bus
+    x_rsp_i : in  bus_rsp_t;  -- device port response bus
+    stall_o : out std_ulogic; -- a host port is waiting for the other one (HPM event)
+    sel_o   : out std_ulogic  -- currently selected host port ('0' = A, '1' = B)
   );
 end neorv32_bus_switch;
 
@@ -65,6 +70,8 @@ architecture neorv32_bus_switch_rtl of neorv32_bus_switch is
     state, state_nxt : std_ulogic_vector(1 downto 0);
     a_req, b_req     : std_ulogic;
     sel,   stb       : std_ulogic;
+    last             : std_ulogic; -- port that was served last ('0' = A, '1' = B)
+    lock, lock_nxt   : std_ulogic; -- burst in progress: keep switch reserved for the port that was served last
   end record;
   signal arbiter : arbiter_t;
 
@@ -83,8 +90,16 @@ begin
       arbiter.state <= IDLE;
       arbiter.a_req <= '0';
       arbiter.b_req <= '0';
+      arbiter.last  <= '0';
+      arbiter.lock  <= '0';
     elsif rising_edge(clk_i) then
       arbiter.state <= arbiter.state_nxt;
+      arbiter.lock  <= arbiter.lock_nxt;
+      if (arbiter.state = BUSY_A) then
+        arbiter.last <= '0';
+      elsif (arbiter.state = BUSY_B) then
+        arbiter.last <= '1';
+      end if;
       arbiter.a_req <= (arbiter.a_req or a_req_i.stb) and (not arbiter.state(0)); -- clear STB buffer in BUSY_A
       arbiter.b_req <= (arbiter.b_req or b_req_i.stb) and (not arbiter.state(1)); -- clear STB buffer in BUSY_B
     end if;
@@ -95,6 +110,7 @@ begin
   begin
     -- defaults --
     arbiter.state_nxt <= arbiter.state;
+    arbiter.lock_nxt  <= arbiter.lock;
     arbiter.sel       <= '0';
     arbiter.stb       <= '0';
 
@@ -105,6 +121,7 @@ begin
       -- ------------------------------------------------------------
         arbiter.sel <= '0';
         if (x_rsp_i.err = '1') or (x_rsp_i.ack = '1') then
+          arbiter.lock_nxt  <= x_rsp_i.ack and a_req_i.burst; -- next beat of the burst has to follow without interruption
           arbiter.state_nxt <= IDLE;
         end if;
 
@@ -112,12 +129,25 @@ begin
       -- ------------------------------------------------------------
         arbiter.sel <= '1';
         if (x_rsp_i.err = '1') or (x_rsp_i.ack = '1') then
+          arbiter.lock_nxt  <= x_rsp_i.ack and b_req_i.burst; -- next beat of the burst has to follow without interruption
           arbiter.state_nxt <= IDLE;
         end if;
 
       when others => -- IDLE: wait for requests
       -- ------------------------------------------------------------
-        if (a_req_i.stb = '1') or (arbiter.a_req = '1') then -- request from port A (prioritized)?
+        if (arbiter.lock = '1') then -- burst in progress: wait for the next beat of the port that was served last
+          arbiter.sel <= arbiter.last;
+          if (arbiter.last = '0') and ((a_req_i.stb = '1') or (arbiter.a_req = '1')) then
+            arbiter.stb       <= '1';
+            arbiter.lock_nxt  <= '0';
+            arbiter.state_nxt <= BUSY_A;
+          elsif (arbiter.last = '1') and ((b_req_i.stb = '1') or (arbiter.b_req = '1')) then
+            arbiter.stb       <= '1';
+            arbiter.lock_nxt  <= '0';
+            arbiter.state_nxt <= BUSY_B;
+          end if;
+        elsif ((a_req_i.stb = '1') or (arbiter.a_req = '1')) and -- request from port A (prioritized)?
+           ((not ROUND_ROBIN_EN) or (arbiter.last = '1') or ((b_req_i.stb = '0') and (arbiter.b_req = '0'))) then
           arbiter.sel       <= '0';
           arbiter.stb       <= '1';
           arbiter.state_nxt <= BUSY_A;
@@ -135,10 +165,13 @@ begin
   -- -------------------------------------------------------------------------------------------
   x_req_o.addr  <= a_req_i.addr when (arbiter.sel = '0') else b_req_i.addr;
   x_req_o.rvso  <= a_req_i.rvso when (arbiter.sel = '0') else b_req_i.rvso;
+  x_req_o.amo   <= a_req_i.amo  when (arbiter.sel = '0') else b_req_i.amo;
+  x_req_o.amoop <= a_req_i.amoop when (arbiter.sel = '0') else b_req_i.amoop;
   x_req_o.priv  <= a_req_i.priv when (arbiter.sel = '0') else b_req_i.priv;
   x_req_o.src   <= a_req_i.src  when (arbiter.sel = '0') else b_req_i.src;
   x_req_o.rw    <= a_req_i.rw   when (arbiter.sel = '0') else b_req_i.rw;
   x_req_o.fence <= a_req_i.fence or b_req_i.fence; -- propagate any fence operations
+  x_req_o.burst <= a_req_i.burst when (arbiter.sel = '0') else b_req_i.burst;
 
   x_req_o.data  <= b_req_i.data when PORT_A_READ_ONLY    else
                    a_req_i.data when PORT_B_READ_ONLY    else
@@ -149,6 +182,7 @@ begin
                    a_req_i.ben when (arbiter.sel = '0')  else b_req_i.ben;
                 
   x_req_o.stb   <= arbiter.stb;
+  sel_o         <= arbiter.sel;
 
 
   -- Response Switch ------------------------------------------------------------------------
@@ -162,6 +196,14 @@ begin
   b_rsp_o.err  <= x_rsp_i.err when (arbiter.sel = '1') else '0';
 
 
+  -- Arbitration Stall Monitor --------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  stall_o <= '1' when ((arbiter.state = BUSY_A) and ((b_req_i.stb = '1') or (arbiter.b_req = '1'))) or -- B waits for A
+                      ((arbiter.state = BUSY_B) and ((a_req_i.stb = '1') or (arbiter.a_req = '1'))) or -- A waits for B
+                      ((arbiter.state = IDLE) and ((a_req_i.stb = '1') or (arbiter.a_req = '1')) and
+                                                  ((b_req_i.stb = '1') or (arbiter.b_req = '1'))) else '0'; -- B loses arbitration
+
+
 end neorv32_bus_switch_rtl;
 
 
@@ -270,9 +312,26 @@ end neorv32_bus_gateway;
 
 architecture neorv32_bus_gateway_rtl of neorv32_bus_gateway is
 
+  -- smallest enabled section; all section boundaries are aligned to this size --
+  function min_section_size_f return natural is
+    variable tmp_v : natural;
+  begin
+    tmp_v := 2**30;
+    if IMEM_ENABLE and (IMEM_SIZE < tmp_v) then tmp_v := IMEM_SIZE; end if;
+    if DMEM_ENABLE and (DMEM_SIZE < tmp_v) then tmp_v := DMEM_SIZE; end if;
+    if XIP_ENABLE  and (XIP_SIZE  < tmp_v) then tmp_v := XIP_SIZE;  end if;
+    if BOOT_ENABLE and (BOOT_SIZE < tmp_v) then tmp_v := BOOT_SIZE; end if;
+    if IO_ENABLE   and (IO_SIZE   < tmp_v) then tmp_v := IO_SIZE;   end if;
+    return tmp_v;
+  end function min_section_size_f;
+  constant bound_c : natural := index_size_f(min_section_size_f);
+
   -- port select --
   signal port_sel : std_ulogic_vector(5 downto 0);
 
+  -- burst: next sequential word might be located in another section --
+  signal burst_end : std_ulogic;
+
   -- list of enabled gateway ports --
   type port_en_list_t is array (0 to 5) of boolean;
   constant port_en_list_c : port_en_list_t := (IMEM_ENABLE, DMEM_ENABLE, XIP_ENABLE, BOOT_ENABLE, IO_ENABLE, EXT_ENABLE);
@@ -318,14 +377,18 @@ begin
   io_req_o   <= port_req(4); port_rsp(4) <= io_rsp_i;
   ext_req_o  <= port_req(5); port_rsp(5) <= ext_rsp_i;
 
+  -- a burst must not continue into another section, so it is ended at every possible section boundary --
+  burst_end <= and_reduce_f(main_req_i.addr(bound_c-1 downto 2));
+
   -- bus request --
-  request: process(main_req_i, port_sel)
+  request: process(main_req_i, port_sel, burst_end)
   begin
     for i in 0 to 5 loop
       port_req(i) <= req_terminate_c;
       if port_en_list_c(i) then
-        port_req(i)     <= main_req_i;
-        port_req(i).stb <= main_req_i.stb and port_sel(i);
+        port_req(i)       <= main_req_i;
+        port_req(i).stb   <= main_req_i.stb and port_sel(i);
+        port_req(i).burst <= main_req_i.burst and (not burst_end);
       end if;
     end loop;
   end process request;
@@ -613,7 +676,7 @@ end neorv32_bus_io_switch_rtl;
 -- # << NEORV32 - Processor Bus Infrastructure: Reservation Set Control >>                         #
 -- # ********************************************************************************************* #
 -- # Reservation set controller for the A (atomic) ISA extension's LR.W (load-reservate) and SC.W  #
--- # (store-conditional) instructions. Only a single reservation set is supported.                 #
+-- # (store-conditional) instructions. One reservation set is supported per hart (NUM_HARTS).      #
 -- # The reservation set's granularity can be configured via the GRANULARITY generic.              #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
@@ -655,7 +718,8 @@ use neorv32.neorv32_package.all;
 
 entity neorv32_bus_reservation_set is
   generic (
-    GRANULARITY : natural range 4 to natural'high -- reservation set granularity in bytes; has to be power of 2, min 4
+    GRANULARITY : natural range 4 to natural'high; -- reservation set granularity in bytes; has to be power of 2, min 4
+    NUM_HARTS   : natural range 1 to 2             -- number of harts sharing the bus (one reservation set per hart)
   );
   port (
     -- global control --
@@ -666,6 +730,7 @@ entity neorv32_bus_reservation_set is
     rvs_valid_o : out std_ulogic;
     rvs_clear_i : in  std_ulogic;
     -- core/cpu port --
+    hart_i      : in  std_ulogic; -- index of the hart issuing the current request (NUM_HARTS > 1 only)
     core_req_i  : in  bus_req_t;
     core_rsp_o  : out bus_rsp_t;
     -- system ports --
@@ -683,15 +748,20 @@ architecture neorv32_bus_reservation_set_rtl of neorv32_bus_reservation_set is
   -- reservation set granularity address boundary bit --
   constant abb_c : natural := index_size_f(granularity_c);
 
-  -- reservation set --
+  -- reservation sets (one per hart) --
+  type rsvs_state_t is array (0 to NUM_HARTS-1) of std_ulogic_vector(01 downto 0);
+  type rsvs_addr_t  is array (0 to NUM_HARTS-1) of std_ulogic_vector(31 downto abb_c);
   type rsvs_t is record
-    state : std_ulogic_vector(01 downto 0);
-    addr  : std_ulogic_vector(31 downto abb_c);
-    valid : std_ulogic;
-    match : std_ulogic;
+    state : rsvs_state_t;
+    addr  : rsvs_addr_t;
+    valid : std_ulogic_vector(NUM_HARTS-1 downto 0);
+    match : std_ulogic_vector(NUM_HARTS-1 downto 0);
   end record;
   signal rsvs : rsvs_t;
 
+  -- hart of the current request --
+  signal hart : natural range 0 to NUM_HARTS-1;
+
   -- ACK override for failed SC.W --
   signal ack_local : std_ulogic;
 
@@ -708,60 +778,66 @@ begin
   rvs_control: process(rstn_i, clk_i)
   begin
     if (rstn_i = '0') then
-      rsvs.state <= "00";
-      rsvs.addr  <= (others => '0');
+      rsvs.state <= (others => "00");
+      rsvs.addr  <= (others => (others => '0'));
     elsif rising_edge(clk_i) then
-      case rsvs.state is
+      for h in 0 to NUM_HARTS-1 loop
+        case rsvs.state(h) is
 
-        when "10" => -- active reservation: wait for condition to invalidate reservation
-        -- --------------------------------------------------------------------
-          if (core_req_i.stb = '1') and (core_req_i.rw = '0') and (core_req_i.rvso = '1') then -- another LR instruction overriding the current reservation
-            rsvs.addr <= core_req_i.addr(31 downto abb_c);
-          end if;
-          --
-          if (rvs_clear_i = '1') then -- external clear request (highest priority)
-            rsvs.state <= "00"; -- invalidate reservation
-          elsif (core_req_i.stb = '1') and (core_req_i.rw = '1') then -- write access
-
-            if (core_req_i.rvso = '1') then -- this is a SC operation
-              if (rsvs.match = '1') then -- SC to reservated address
-                rsvs.state <= "11"; -- execute SC instruction (reservation still valid)
-              else -- SC to any other address
-                rsvs.state <= "00"; -- invalidate reservation
+          when "10" => -- active reservation: wait for condition to invalidate reservation
+          -- --------------------------------------------------------------------
+            if (core_req_i.stb = '1') and (core_req_i.rw = '0') and (core_req_i.rvso = '1') and (hart = h) then -- another LR instruction overriding the current reservation
+              rsvs.addr(h) <= core_req_i.addr(31 downto abb_c);
+            end if;
+            --
+            if (rvs_clear_i = '1') then -- external clear request (highest priority)
+              rsvs.state(h) <= "00"; -- invalidate reservation
+            elsif (core_req_i.stb = '1') and (core_req_i.rw = '1') then -- write access
+
+              if (core_req_i.rvso = '1') and (hart = h) then -- this is a SC operation of this hart
+                if (rsvs.match(h) = '1') then -- SC to reservated address
+                  rsvs.state(h) <= "11"; -- execute SC instruction (reservation still valid)
+                else -- SC to any other address
+                  rsvs.state(h) <= "00"; -- invalidate reservation
+                end if;
+
+              elsif (rsvs.match(h) = '1') and ((core_req_i.rvso = '0') or (rsvs.valid(hart) = '1')) then -- actual write to reservated address
+                rsvs.state(h) <= "00"; -- invalidate reservation (normal write or successful SC of another hart)
               end if;
 
-            elsif (rsvs.match = '1') then -- normal write to reservated address
-              rsvs.state <= "00"; -- invalidate reservation
             end if;
 
-          end if;
-
-        when "11" => -- active reservation: invalidate reservation at the end of bus access
-        -- --------------------------------------------------------------------
-          if (sys_rsp_i.ack = '1') or (sys_rsp_i.err = '1') then
-            rsvs.state <= "00";
-          end if;
+          when "11" => -- active reservation: invalidate reservation at the end of bus access
+          -- --------------------------------------------------------------------
+            if (sys_rsp_i.ack = '1') or (sys_rsp_i.err = '1') then
+              rsvs.state(h) <= "00";
+            end if;
 
-        when others => -- "0-" no active reservation: wait for new registration request
-        -- --------------------------------------------------------------------
-          if (core_req_i.stb = '1') and (core_req_i.rw = '0') and (core_req_i.rvso = '1') then -- load-reservate instruction
-            rsvs.addr  <= core_req_i.addr(31 downto abb_c);
-            rsvs.state <= "10";
-          end if;
+          when others => -- "0-" no active reservation: wait for new registration request
+          -- --------------------------------------------------------------------
+            if (core_req_i.stb = '1') and (core_req_i.rw = '0') and (core_req_i.rvso = '1') and (hart = h) then -- load-reservate instruction
+              rsvs.addr(h)  <= core_req_i.addr(31 downto abb_c);
+              rsvs.state(h) <= "10";
+            end if;
 
-      end case;
+        end case;
+      end loop;
     end if;
   end process rvs_control;
 
-  -- address match? --
-  rsvs.match <= '1' when (core_req_i.addr(31 downto abb_c) = rsvs.addr) else '0';
+  -- hart of the current request --
+  hart <= 1 when (NUM_HARTS > 1) and (hart_i = '1') else 0;
 
-  -- reservation valid? --
-  rsvs.valid <= rsvs.state(1);
+  -- address match? reservation valid? --
+  rsvs_status:
+  for h in 0 to NUM_HARTS-1 generate
+    rsvs.match(h) <= '1' when (core_req_i.addr(31 downto abb_c) = rsvs.addr(h)) else '0';
+    rsvs.valid(h) <= rsvs.state(h)(1);
+  end generate;
 
-  -- status for external system --
-  rvs_valid_o                  <= rsvs.valid;
-  rvs_addr_o(31 downto abb_c)  <= rsvs.addr;
+  -- status for external system (hart 0) --
+  rvs_valid_o                  <= rsvs.valid(0);
+  rvs_addr_o(31 downto abb_c)  <= rsvs.addr(0);
   rvs_addr_o(abb_c-1 downto 0) <= (others => '0');
 
 
@@ -769,11 +845,11 @@ begin
   -- -------------------------------------------------------------------------------------------
 
   -- gated request --
-  bus_request: process(core_req_i, rsvs.valid)
+  bus_request: process(core_req_i, rsvs.valid, hart)
   begin
     sys_req_o <= core_req_i;
     if (core_req_i.rvso = '1') and (core_req_i.rw = '1') then -- SC operation
-      sys_req_o.stb <= core_req_i.stb and rsvs.valid; -- write allowed if reservation still valid
+      sys_req_o.stb <= core_req_i.stb and rsvs.valid(hart); -- write allowed if reservation still valid
     else -- normal memory request or LR
       sys_req_o.stb <= core_req_i.stb;
     end if;
@@ -786,7 +862,7 @@ begin
     if (rstn_i = '0') then
       ack_local <= '0';
     elsif rising_edge(clk_i) then
-      ack_local <= core_req_i.rvso and core_req_i.stb and core_req_i.rw and (not rsvs.valid);
+      ack_local <= core_req_i.rvso and core_req_i.stb and core_req_i.rw and (not rsvs.valid(hart));
     end if;
   end process ack_override;
 
@@ -795,7 +871,545 @@ begin
   core_rsp_o.ack <= sys_rsp_i.ack or ack_local; -- generate local ACK if SC fails
   -- inject 1 into read data's LSB if SC fails --
   core_rsp_o.data(31 downto 1) <= sys_rsp_i.data(31 downto 1);
-  core_rsp_o.data(0) <= sys_rsp_i.data(0) or (core_req_i.rvso and core_req_i.rw and (not rsvs.valid));
+  core_rsp_o.data(0) <= sys_rsp_i.data(0) or (core_req_i.rvso and core_req_i.rw and (not rsvs.valid(hart)));
 
 
 end neorv32_bus_reservation_set_rtl;
+
+
+-- ############################################################################################################################
+-- ############################################################################################################################
+
+
+-- #################################################################################################
+-- # << NEORV32 - Processor Bus Infrastructure: Atomic Memory Operations Controller >>             #
+-- # ********************************************************************************************* #
+-- # Executes atomic read-modify-write operations (AMO*.W) as an uninterruptible sequence of a     #
+-- # read access followed by a write access. The original memory data is returned to the host when #
+-- # the write access has completed. All other accesses are passed through. The upstream bus       #
+-- # switches stay locked to the requesting host until the host response has been sent.            #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # The NEORV32 RISC-V Processor, https://github.com/stnolting/neorv32                            #
+-- # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_bus_amo_ctrl is
+  port (
+    -- global control --
+    clk_i      : in  std_ulogic; -- global clock, rising edge
+    rstn_i     : in  std_ulogic; -- global reset, low-active, async
+    -- core/cpu port --
+    core_req_i : in  bus_req_t;
+    core_rsp_o : out bus_rsp_t;
+    -- system port --
+    sys_req_o  : out bus_req_t;
+    sys_rsp_i  : in  bus_rsp_t
+  );
+end neorv32_bus_amo_ctrl;
+
+architecture neorv32_bus_amo_ctrl_rtl of neorv32_bus_amo_ctrl is
+
+  -- controller --
+  type state_t is (S_IDLE, S_READ_WAIT, S_WRITE_REQ, S_WRITE_WAIT);
+  type ctrl_t is record
+    state : state_t;
+    rdata : std_ulogic_vector(31 downto 0); -- original memory data
+  end record;
+  signal ctrl : ctrl_t;
+
+  -- read-modify-write ALU --
+  signal cmp_opa, cmp_opb : std_ulogic_vector(32 downto 0); -- sign-extended comparator operands
+  signal cmp_lt           : std_ulogic; -- memory data is less than operand
+  signal alu_res          : std_ulogic_vector(31 downto 0);
+
+begin
+
+  -- Control Engine -------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  control: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      ctrl.state <= S_IDLE;
+      ctrl.rdata <= (others => '0');
+    elsif rising_edge(clk_i) then
+      case ctrl.state is
+
+        when S_IDLE => -- wait for AMO request; all other accesses are passed through
+        -- ------------------------------------------------------------
+          if (core_req_i.stb = '1') and (core_req_i.amo = '1') then
+            ctrl.state <= S_READ_WAIT;
+          end if;
+
+        when S_READ_WAIT => -- wait for read access to complete
+        -- ------------------------------------------------------------
+          ctrl.rdata <= sys_rsp_i.data;
+          if (sys_rsp_i.err = '1') then -- abort operation
+            ctrl.state <= S_IDLE;
+          elsif (sys_rsp_i.ack = '1') then
+            ctrl.state <= S_WRITE_REQ;
+          end if;
+
+        when S_WRITE_REQ => -- request write access of the operation result
+        -- ------------------------------------------------------------
+          ctrl.state <= S_WRITE_WAIT;
+
+        when others => -- S_WRITE_WAIT: wait for write access to complete
+        -- ------------------------------------------------------------
+          if (sys_rsp_i.ack = '1') or (sys_rsp_i.err = '1') then
+            ctrl.state <= S_IDLE;
+          end if;
+
+      end case;
+    end if;
+  end process control;
+
+
+  -- Read-Modify-Write ALU ------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- amoop = funct5(4:2) & funct5(0); sign-extend comparator operands for signed MIN/MAX only --
+  cmp_opa <= (ctrl.rdata(31)      and (not core_req_i.amoop(2))) & ctrl.rdata;
+  cmp_opb <= (core_req_i.data(31) and (not core_req_i.amoop(2))) & core_req_i.data;
+  cmp_lt  <= '1' when (signed(cmp_opa) < signed(cmp_opb)) else '0';
+
+  alu: process(core_req_i, ctrl.rdata, cmp_lt)
+  begin
+    case core_req_i.amoop is
+      when "0001" => -- AMOSWAP.W
+        alu_res <= core_req_i.data;
+      when "0010" => -- AMOXOR.W
+        alu_res <= ctrl.rdata xor core_req_i.data;
+      when "0100" => -- AMOOR.W
+        alu_res <= ctrl.rdata or core_req_i.data;
+      when "0110" => -- AMOAND.W
+        alu_res <= ctrl.rdata and core_req_i.data;
+      when "1000" | "1100" => -- AMOMIN[U].W
+        if (cmp_lt = '1') then
+          alu_res <= ctrl.rdata;
+        else
+          alu_res <= core_req_i.data;
+        end if;
+      when "1010" | "1110" => -- AMOMAX[U].W
+        if (cmp_lt = '1') then
+          alu_res <= core_req_i.data;
+        else
+          alu_res <= ctrl.rdata;
+        end if;
+      when others => -- AMOADD.W
+        alu_res <= std_ulogic_vector(unsigned(ctrl.rdata) + unsigned(core_req_i.data));
+    end case;
+  end process alu;
+
+
+  -- System Bus Interface -------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  bus_request: process(core_req_i, ctrl.state, alu_res)
+  begin
+    sys_req_o <= core_req_i; -- pass-through by default
+    if (core_req_i.amo = '1') then
+      if (ctrl.state = S_WRITE_REQ) or (ctrl.state = S_WRITE_WAIT) then -- write phase
+        sys_req_o.data <= alu_res;
+        sys_req_o.rw   <= '1';
+        sys_req_o.stb  <= '0';
+        if (ctrl.state = S_WRITE_REQ) then
+          sys_req_o.stb <= '1';
+        end if;
+      else -- read phase
+        sys_req_o.rw <= '0';
+      end if;
+    end if;
+  end process bus_request;
+
+  -- response --
+  bus_response: process(ctrl, sys_rsp_i)
+  begin
+    core_rsp_o <= rsp_terminate_c; -- default
+    case ctrl.state is
+      when S_IDLE => -- pass-through
+        core_rsp_o <= sys_rsp_i;
+      when S_READ_WAIT => -- read phase: forward error only
+        core_rsp_o.err <= sys_rsp_i.err;
+      when S_WRITE_WAIT => -- write phase: return original memory data
+        core_rsp_o.ack <= sys_rsp_i.ack;
+        core_rsp_o.err <= sys_rsp_i.err;
+        if (sys_rsp_i.ack = '1') then
+          core_rsp_o.data <= ctrl.rdata;
+        end if;
+      when others =>
+        NULL;
+    end case;
+  end process bus_response;
+
+
+end neorv32_bus_amo_ctrl_rtl;
+
+
+-- ############################################################################################################################
+-- ############################################################################################################################
+
+
+-- #################################################################################################
+-- # << NEORV32 - Processor Bus Infrastructure: Multi-Layer Crossbar >>                            #
+-- # ********************************************************************************************* #
+-- # Optional replacement for the shared bus switches and the section gateway. Each host port      #
+-- # (A = CPU data, B = CPU instruction fetch, C = DMA) has its own section gateway (including bus #
+-- # monitor) and each section port (IMEM, DMEM, XIP, BOOT, IO, EXT) has its own round-robin       #
+-- # arbiter. Hence, accesses of different hosts to different sections are processed in parallel.  #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # The NEORV32 RISC-V Processor, https://github.com/stnolting/neorv32                            #
+-- # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_bus_crossbar is
+  generic (
+    TIMEOUT     : natural; -- internal bus timeout cycles
+    -- IMEM port --
+    IMEM_ENABLE : boolean;
+    IMEM_BASE   : std_ulogic_vector(31 downto 0);
+    IMEM_SIZE   : natural;
+    -- DMEM port --
+    DMEM_ENABLE : boolean;
+    DMEM_BASE   : std_ulogic_vector(31 downto 0);
+    DMEM_SIZE   : natural;
+    -- XIP port --
+    XIP_ENABLE  : boolean;
+    XIP_BASE    : std_ulogic_vector(31 downto 0);
+    XIP_SIZE    : natural;
+    -- BOOT ROM port --
+    BOOT_ENABLE : boolean;
+    BOOT_BASE   : std_ulogic_vector(31 downto 0);
+    BOOT_SIZE   : natural;
+    -- IO port --
+    IO_ENABLE   : boolean;
+    IO_BASE     : std_ulogic_vector(31 downto 0);
+    IO_SIZE     : natural;
+    -- EXTERNAL port --
+    EXT_ENABLE  : boolean
+  );
+  port (
+    -- global control --
+    clk_i      : in  std_ulogic; -- global clock, rising edge
+    rstn_i     : in  std_ulogic; -- global reset, low-active, async
+    -- host ports --
+    a_req_i    : in  bus_req_t;  -- host port A (CPU data): request bus
+    a_rsp_o    : out bus_rsp_t;  -- host port A (CPU data): response bus
+    b_req_i    : in  bus_req_t;  -- host port B (CPU instruction fetch): request bus
+    b_rsp_o    : out bus_rsp_t;  -- host port B (CPU instruction fetch): response bus
+    c_req_i    : in  bus_req_t;  -- host port C (DMA): request bus
+    c_rsp_o    : out bus_rsp_t;  -- host port C (DMA): response bus
+    -- section ports --
+    imem_req_o : out bus_req_t;
+    imem_rsp_i : in  bus_rsp_t;
+    dmem_req_o : out bus_req_t;
+    dmem_rsp_i : in  bus_rsp_t;
+    xip_req_o  : out bus_req_t;
+    xip_rsp_i  : in  bus_rsp_t;
+    boot_req_o : out bus_req_t;
+    boot_rsp_i : in  bus_rsp_t;
+    io_req_o   : out bus_req_t;
+    io_rsp_i   : in  bus_rsp_t;
+    ext_req_o  : out bus_req_t;
+    ext_rsp_i  : in  bus_rsp_t;
+    -- status (HPM events) --
+    stall_o    : out std_ulogic; -- a host port is waiting for a section port that is used by another host
+    para_o     : out std_ulogic  -- at least two section ports are busy at the same time
+  );
+end neorv32_bus_crossbar;
+
+architecture neorv32_bus_crossbar_rtl of neorv32_bus_crossbar is
+
+  -- list of enabled section ports --
+  type port_en_list_t is array (0 to 5) of boolean;
+  constant port_en_list_c : port_en_list_t := (IMEM_ENABLE, DMEM_ENABLE, XIP_ENABLE, BOOT_ENABLE, IO_ENABLE, EXT_ENABLE);
+
+  -- host ports combined as arrays --
+  type host_req_t is array (0 to 2) of bus_req_t;
+  type host_rsp_t is array (0 to 2) of bus_rsp_t;
+  signal host_req : host_req_t;
+  signal host_rsp : host_rsp_t;
+
+  -- section ports combined as arrays --
+  type port_req_t is array (0 to 5) of bus_req_t;
+  type port_rsp_t is array (0 to 5) of bus_rsp_t;
+  signal port_req : port_req_t;
+  signal port_rsp : port_rsp_t;
+
+  -- crossbar matrix: section port requests/responses of each host --
+  type matrix_req_t is array (0 to 2) of port_req_t;
+  type matrix_rsp_t is array (0 to 2) of port_rsp_t;
+  signal mtx_req : matrix_req_t;
+  signal mtx_rsp : matrix_rsp_t;
+
+  -- bus monitor (timeout) errors of each host --
+  signal host_err : std_ulogic_vector(2 downto 0);
+
+  -- arbiter status --
+  signal port_busy  : std_ulogic_vector(5 downto 0);
+  signal port_stall : std_ulogic_vector(5 downto 0);
+
+begin
+
+  -- Host Ports -----------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  host_req(0) <= a_req_i; a_rsp_o <= host_rsp(0);
+  host_req(1) <= b_req_i; b_rsp_o <= host_rsp(1);
+  host_req(2) <= c_req_i; c_rsp_o <= host_rsp(2);
+
+  host_err(0) <= host_rsp(0).err;
+  host_err(1) <= host_rsp(1).err;
+  host_err(2) <= host_rsp(2).err;
+
+
+  -- Section Gateways (one per host) --------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  gateway_gen:
+  for h in 0 to 2 generate
+    neorv32_bus_gateway_inst: entity neorv32.neorv32_bus_gateway
+    generic map (
+      TIMEOUT     => 3*TIMEOUT, -- worst case: wait for one access of each other host
+      IMEM_ENABLE => IMEM_ENABLE,
+      IMEM_BASE   => IMEM_BASE,
+      IMEM_SIZE   => IMEM_SIZE,
+      DMEM_ENABLE => DMEM_ENABLE,
+      DMEM_BASE   => DMEM_BASE,
+      DMEM_SIZE   => DMEM_SIZE,
+      XIP_ENABLE  => XIP_ENABLE,
+      XIP_BASE    => XIP_BASE,
+      XIP_SIZE    => XIP_SIZE,
+      BOOT_ENABLE => BOOT_ENABLE,
+      BOOT_BASE   => BOOT_BASE,
+      BOOT_SIZE   => BOOT_SIZE,
+      IO_ENABLE   => IO_ENABLE,
+      IO_BASE     => IO_BASE,
+      IO_SIZE     => IO_SIZE,
+      EXT_ENABLE  => EXT_ENABLE
+    )
+    port map (
+      clk_i      => clk_i,
+      rstn_i     => rstn_i,
+      main_req_i => host_req(h),
+      main_rsp_o => host_rsp(h),
+      imem_req_o => mtx_req(h)(0),
+      imem_rsp_i => mtx_rsp(h)(0),
+      dmem_req_o => mtx_req(h)(1),
+      dmem_rsp_i => mtx_rsp(h)(1),
+      xip_req_o  => mtx_req(h)(2),
+      xip_rsp_i  => mtx_rsp(h)(2),
+      boot_req_o => mtx_req(h)(3),
+      boot_rsp_i => mtx_rsp(h)(3),
+      io_req_o   => mtx_req(h)(4),
+      io_rsp_i   => mtx_rsp(h)(4),
+      ext_req_o  => mtx_req(h)(5),
+      ext_rsp_i  => mtx_rsp(h)(5)
+    );
+  end generate;
+
+
+  -- Section Port Arbiters ------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  arbiter_gen:
+  for p in 0 to 5 generate
+
+    arbiter_gen_enabled:
+    if port_en_list_c(p) generate
+
+      -- access arbiter --
+      type arbiter_t is record
+        busy, busy_nxt : std_ulogic; -- access in progress
+        lock, lock_nxt : std_ulogic; -- keep port reserved for the current host (read phase of an AMO or burst beat completed)
+        sel,  sel_nxt  : natural range 0 to 2; -- current/last host
+        pend, buf      : std_ulogic_vector(2 downto 0); -- pending requests, STB buffer
+        stb            : std_ulogic;
+      end record;
+      signal arbiter : arbiter_t;
+
+    begin
+
+      arbiter_sync: process(rstn_i, clk_i)
+      begin
+        if (rstn_i = '0') then
+          arbiter.busy <= '0';
+          arbiter.lock <= '0';
+          arbiter.sel  <= 0;
+          arbiter.buf  <= (others => '0');
+        elsif rising_edge(clk_i) then
+          arbiter.busy <= arbiter.busy_nxt;
+          arbiter.lock <= arbiter.lock_nxt;
+          arbiter.sel  <= arbiter.sel_nxt;
+          for h in 0 to 2 loop -- clear STB buffer while the according host is being served or if it has been aborted
+            if ((arbiter.busy = '1') and (arbiter.sel = h)) or (host_err(h) = '1') then
+              arbiter.buf(h) <= '0';
+            else
+              arbiter.buf(h) <= arbiter.pend(h);
+            end if;
+          end loop;
+        end if;
+      end process arbiter_sync;
+
+      -- pending requests --
+      pending: process(mtx_req, arbiter.buf)
+      begin
+        for h in 0 to 2 loop
+          arbiter.pend(h) <= mtx_req(h)(p).stb or arbiter.buf(h);
+        end loop;
+      end process pending;
+
+      -- round-robin: start searching right after the host that was served last --
+      arbiter_comb: process(arbiter, mtx_req, port_rsp, host_err)
+        variable h_v : natural range 0 to 2;
+      begin
+        -- defaults --
+        arbiter.busy_nxt <= arbiter.busy;
+        arbiter.lock_nxt <= arbiter.lock and (not host_err(arbiter.sel));
+        arbiter.sel_nxt  <= arbiter.sel;
+        arbiter.stb      <= '0';
+        if (arbiter.busy = '1') then -- access in progress
+          if (port_rsp(p).ack = '1') or (port_rsp(p).err = '1') or (host_err(arbiter.sel) = '1') then -- done or bus monitor timeout
+            arbiter.busy_nxt <= '0';
+            -- the write access of an atomic read-modify-write operation and the next beat of a burst have to follow without interruption --
+            arbiter.lock_nxt <= port_rsp(p).ack and ((mtx_req(arbiter.sel)(p).amo and (not mtx_req(arbiter.sel)(p).rw)) or mtx_req(arbiter.sel)(p).burst);
+          end if;
+        elsif (arbiter.lock = '1') then -- locked: wait for the current host only
+          if (arbiter.pend(arbiter.sel) = '1') then
+            arbiter.stb      <= '1';
+            arbiter.busy_nxt <= '1';
+            arbiter.lock_nxt <= '0';
+          end if;
+        else -- idle: wait for requests
+          for i in 1 to 3 loop
+            h_v := (arbiter.sel + i) mod 3;
+            if (arbiter.pend(h_v) = '1') then
+              arbiter.sel_nxt  <= h_v;
+              arbiter.stb      <= '1';
+              arbiter.busy_nxt <= '1';
+              exit;
+            end if;
+          end loop;
+        end if;
+      end process arbiter_comb;
+
+      -- request switch --
+      request: process(mtx_req, arbiter.sel_nxt, arbiter.stb)
+      begin
+        port_req(p)       <= mtx_req(arbiter.sel_nxt)(p);
+        port_req(p).stb   <= arbiter.stb;
+        port_req(p).fence <= mtx_req(0)(p).fence or mtx_req(1)(p).fence or mtx_req(2)(p).fence; -- propagate any fence operations
+      end process request;
+
+      -- response switch --
+      mtx_rsp(0)(p) <= port_rsp(p) when (arbiter.busy = '1') and (arbiter.sel = 0) else rsp_terminate_c;
+      mtx_rsp(1)(p) <= port_rsp(p) when (arbiter.busy = '1') and (arbiter.sel = 1) else rsp_terminate_c;
+      mtx_rsp(2)(p) <= port_rsp(p) when (arbiter.busy = '1') and (arbiter.sel = 2) else rsp_terminate_c;
+
+      -- arbitration stall monitor: any host is waiting for another one --
+      stall_monitor: process(arbiter)
+        variable other_v : std_ulogic_vector(2 downto 0);
+      begin
+        other_v := arbiter.pend;
+        other_v(arbiter.sel) := '0';
+        if (arbiter.busy = '1') then -- pending request of another host
+          port_stall(p) <= or_reduce_f(other_v);
+        else -- more than one pending request
+          port_stall(p) <= or_reduce_f(arbiter.pend and std_ulogic_vector(unsigned(arbiter.pend) - 1));
+        end if;
+      end process stall_monitor;
+
+      port_busy(p) <= arbiter.busy;
+
+    end generate;
+
+    arbiter_gen_disabled:
+    if not port_en_list_c(p) generate
+      port_req(p)   <= req_terminate_c;
+      port_busy(p)  <= '0';
+      port_stall(p) <= '0';
+      mtx_rsp(0)(p) <= rsp_terminate_c;
+      mtx_rsp(1)(p) <= rsp_terminate_c;
+      mtx_rsp(2)(p) <= rsp_terminate_c;
+    end generate;
+
+  end generate;
+
+
+  -- Section Ports --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  imem_req_o <= port_req(0); port_rsp(0) <= imem_rsp_i;
+  dmem_req_o <= port_req(1); port_rsp(1) <= dmem_rsp_i;
+  xip_req_o  <= port_req(2); port_rsp(2) <= xip_rsp_i;
+  boot_req_o <= port_req(3); port_rsp(3) <= boot_rsp_i;
+  io_req_o   <= port_req(4); port_rsp(4) <= io_rsp_i;
+  ext_req_o  <= port_req(5); port_rsp(5) <= ext_rsp_i;
+
+
+  -- Crossbar Monitor -----------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  stall_o <= or_reduce_f(port_stall);
+  para_o  <= or_reduce_f(port_busy and std_ulogic_vector(unsigned(port_busy) - 1)); -- more than one busy section port
+
+
+end neorv32_bus_crossbar_rtl;
@@ -3,6 +3,7 @@
 -- # ********************************************************************************************* #
 -- # Compatible to RISC-V spec's 64-bit MACHINE system timer including "mtime[h]" & "mtimecmp[h]". #
 -- # Note: The 64-bit counter and compare systems are de-coupled into two 32-bit systems.          #
+-- # CLINT-style extension: one "mtimecmp" and one MSIP (software interrupt) register per hart.    #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -42,13 +43,17 @@ library neorv32;
 use neorv32.neorv32_package.all;
 
 entity neorv32_mtime is
+  generic (
+    NUM_HARTS : natural range 1 to 2 -- number of harts (one compare and one software interrupt register each)
+  );
   port (
     clk_i     : in  std_ulogic; -- global clock line
     rstn_i    : in  std_ulogic; -- global reset line, low-active, async
     bus_req_i : in  bus_req_t;  -- bus request
     bus_rsp_o : out bus_rsp_t;  -- bus response
     time_o    : out std_ulogic_vector(63 downto 0); -- current system time
-    irq_o     : out std_ulogic  -- interrupt request
+    irq_o     : out std_ulogic_vector(1 downto 0);  -- timer interrupt request per hart
+    msi_o     : out std_ulogic_vector(1 downto 0)   -- software (inter-processor) interrupt request per hart
   );
 end neorv32_mtime;
 
@@ -58,15 +63,17 @@ architecture neorv32_mtime_rtl of neorv32_mtime is
   signal mtime_we : std_ulogic_vector(1 downto 0);
 
   -- accessible regs --
-  signal mtimecmp_lo  : std_ulogic_vector(31 downto 0);
-  signal mtimecmp_hi  : std_ulogic_vector(31 downto 0);
+  type cmp_t is array (0 to 1) of std_ulogic_vector(31 downto 0);
+  signal mtimecmp_lo  : cmp_t; -- per hart
+  signal mtimecmp_hi  : cmp_t; -- per hart
   signal mtime_lo     : std_ulogic_vector(31 downto 0);
   signal mtime_lo_nxt : std_ulogic_vector(32 downto 0);
   signal mtime_lo_cry : std_ulogic_vector(00 downto 0);
   signal mtime_hi     : std_ulogic_vector(31 downto 0);
+  signal msip         : std_ulogic_vector(1 downto 0); -- per hart
 
   -- comparators --
-  signal cmp_lo_ge, cmp_lo_ge_ff, cmp_hi_eq, cmp_hi_gt : std_ulogic;
+  signal cmp_lo_ge, cmp_lo_ge_ff, cmp_hi_eq, cmp_hi_gt : std_ulogic_vector(1 downto 0);
 
 begin
 
@@ -75,8 +82,9 @@ begin
   bus_access: process(rstn_i, clk_i)
   begin
     if (rstn_i = '0') then
-      mtimecmp_lo    <= (others => '0');
-      mtimecmp_hi    <= (others => '0');
+      mtimecmp_lo    <= (others => (others => '0'));
+      mtimecmp_hi    <= (others => (others => '0'));
+      msip           <= (others => '0');
       mtime_we       <= (others => '0');
       mtime_lo       <= (others => '0');
       mtime_lo_cry   <= (others => '0');
@@ -86,18 +94,27 @@ begin
       bus_rsp_o.err  <= '0';
       bus_rsp_o.data <= (others => '0');
     elsif rising_edge(clk_i) then
-      -- mtimecmp --
-      if (bus_req_i.stb = '1') and (bus_req_i.rw = '1') and (bus_req_i.addr(3) = '1') then
-        if (bus_req_i.addr(2) = '0') then
-          mtimecmp_lo <= bus_req_i.data;
-        else
-          mtimecmp_hi <= bus_req_i.data;
-        end if;
+      -- mtimecmp & msip --
+      if (bus_req_i.stb = '1') and (bus_req_i.rw = '1') then
+        case bus_req_i.addr(4 downto 2) is
+          when "010"  => mtimecmp_lo(0) <= bus_req_i.data;
+          when "011"  => mtimecmp_hi(0) <= bus_req_i.data;
+          when "100"  => mtimecmp_lo(1) <= bus_req_i.data;
+          when "101"  => mtimecmp_hi(1) <= bus_req_i.data;
+          when "110"  => msip(0)        <= bus_req_i.data(0);
+          when "111"  => msip(1)        <= bus_req_i.data(0);
+          when others => NULL;
+        end case;
+      end if;
+      if (NUM_HARTS = 1) then -- second hart not implemented
+        mtimecmp_lo(1) <= (others => '0');
+        mtimecmp_hi(1) <= (others => '0');
+        msip(1)        <= '0';
       end if;
 
       -- mtime write access buffer --
-      mtime_we(0) <= bus_req_i.stb and bus_req_i.rw and (not bus_req_i.addr(3)) and (not bus_req_i.addr(2));
-      mtime_we(1) <= bus_req_i.stb and bus_req_i.rw and (not bus_req_i.addr(3)) and (    bus_req_i.addr(2));
+      mtime_we(0) <= bus_req_i.stb and bus_req_i.rw and bool_to_ulogic_f(bus_req_i.addr(4 downto 2) = "000");
+      mtime_we(1) <= bus_req_i.stb and bus_req_i.rw and bool_to_ulogic_f(bus_req_i.addr(4 downto 2) = "001");
 
       -- mtime.low --
       if (mtime_we(0) = '1') then -- write access
@@ -121,11 +138,15 @@ begin
       bus_rsp_o.err  <= '0'; -- no access errors
       bus_rsp_o.data <= (others => '0'); -- default
       if (bus_req_i.stb = '1') and (bus_req_i.rw = '0') then
-        case bus_req_i.addr(3 downto 2) is
-          when "00"   => bus_rsp_o.data <= mtime_lo;
-          when "01"   => bus_rsp_o.data <= mtime_hi;
-          when "10"   => bus_rsp_o.data <= mtimecmp_lo;
-          when others => bus_rsp_o.data <= mtimecmp_hi;
+        case bus_req_i.addr(4 downto 2) is
+          when "000"  => bus_rsp_o.data <= mtime_lo;
+          when "001"  => bus_rsp_o.data <= mtime_hi;
+          when "010"  => bus_rsp_o.data <= mtimecmp_lo(0);
+          when "011"  => bus_rsp_o.data <= mtimecmp_hi(0);
+          when "100"  => bus_rsp_o.data <= mtimecmp_lo(1);
+          when "101"  => bus_rsp_o.data <= mtimecmp_hi(1);
+          when "110"  => bus_rsp_o.data(0) <= msip(0);
+          when others => bus_rsp_o.data(0) <= msip(1);
         end case;
       end if;
     end if;
@@ -137,24 +158,32 @@ begin
   -- system time output --
   time_o <= mtime_hi & mtime_lo; -- NOTE: low and high words are not synchronized here!
 
+  -- software interrupts --
+  msi_o <= msip;
 
-  -- Comparator -----------------------------------------------------------------------------
+
+  -- Comparators ----------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  cmp_sync: process(rstn_i, clk_i)
-  begin
-    if (rstn_i = '0') then
-      cmp_lo_ge_ff <= '0';
-      irq_o        <= '0';
-    elsif rising_edge(clk_i) then
-      cmp_lo_ge_ff <= cmp_lo_ge; -- there is one cycle delay between low (earlier) and high (later) word
-      irq_o        <= cmp_hi_gt or (cmp_hi_eq and cmp_lo_ge_ff);
-    end if;
-  end process cmp_sync;
+  comparator_gen:
+  for h in 0 to 1 generate
+
+    cmp_sync: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        cmp_lo_ge_ff(h) <= '0';
+        irq_o(h)        <= '0';
+      elsif rising_edge(clk_i) then
+        cmp_lo_ge_ff(h) <= cmp_lo_ge(h); -- there is one cycle delay between low (earlier) and high (later) word
+        irq_o(h)        <= (cmp_hi_gt(h) or (cmp_hi_eq(h) and cmp_lo_ge_ff(h))) and bool_to_ulogic_f(h < NUM_HARTS);
+      end if;
+    end process cmp_sync;
+
+    -- sub-word comparators --
+    cmp_lo_ge(h) <= '1' when (unsigned(mtime_lo) >= unsigned(mtimecmp_lo(h))) else '0'; -- low-word: greater than or equal
+    cmp_hi_eq(h) <= '1' when (unsigned(mtime_hi) =  unsigned(mtimecmp_hi(h))) else '0'; -- high-word: equal
+    cmp_hi_gt(h) <= '1' when (unsigned(mtime_hi) >  unsigned(mtimecmp_hi(h))) else '0'; -- high-word: greater than
 
-  -- sub-word comparators --
-  cmp_lo_ge <= '1' when (unsigned(mtime_lo) >= unsigned(mtimecmp_lo)) else '0'; -- low-word: greater than or equal
-  cmp_hi_eq <= '1' when (unsigned(mtime_hi) =  unsigned(mtimecmp_hi)) else '0'; -- high-word: equal
-  cmp_hi_gt <= '1' when (unsigned(mtime_hi) >  unsigned(mtimecmp_hi)) else '0'; -- high-word: greater than
+  end generate;
 
 
 end neorv32_mtime_rtl;
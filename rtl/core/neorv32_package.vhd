@@ -53,7 +53,7 @@ package neorv32_package is
 
   -- Architecture Constants -----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  constant hw_version_c : std_ulogic_vector(31 downto 0) := x"01090509"; -- hardware version
+  constant hw_version_c : std_ulogic_vector(31 downto 0) := x"01090534"; -- hardware version
   constant archid_c     : natural := 19; -- official RISC-V architecture ID
   constant XLEN         : natural := 32; -- native data path width
 
@@ -76,6 +76,8 @@ package neorv32_package is
   -- Main Address Regions ---
   constant mem_imem_base_c : std_ulogic_vector(31 downto 0) := x"00000000"; -- IMEM size via generic
   constant mem_dmem_base_c : std_ulogic_vector(31 downto 0) := x"80000000"; -- DMEM size via generic
+  constant mem_itcm_base_c : std_ulogic_vector(31 downto 0) := x"10000000"; -- ITCM size via generic
+  constant mem_dtcm_base_c : std_ulogic_vector(31 downto 0) := x"90000000"; -- DTCM size via generic
   constant mem_xip_base_c  : std_ulogic_vector(31 downto 0) := x"e0000000"; -- page (4MSBs) only!
   constant mem_xip_size_c  : natural := 256*1024*1024;
   constant mem_boot_base_c : std_ulogic_vector(31 downto 0) := x"ffffc000";
@@ -157,7 +159,10 @@ package neorv32_package is
     src   : std_ulogic; -- access source (1=instruction fetch, 0=data access)
     priv  : std_ulogic; -- set if privileged (machine-mode) access
     rvso  : std_ulogic; -- set if reservation set operation (atomic LR/SC)
+    amo   : std_ulogic; -- set if atomic read-modify-write operation (AMO)
+    amoop : std_ulogic_vector(03 downto 0); -- AMO operation type (funct5(4:2) & funct5(0))
     fence : std_ulogic; -- fence(.i) operation, independent of STB
+    burst : std_ulogic; -- burst transfer: next access will target the next sequential word
   end record;
 
   -- bus response --
@@ -177,7 +182,10 @@ package neorv32_package is
     src   => '0',
     priv  => '0',
     rvso  => '0',
-    fence => '0'
+    amo   => '0',
+    amoop => (others => '0'),
+    fence => '0',
+    burst => '0'
   );
 
   -- endpoint (response) termination --
@@ -256,6 +264,10 @@ package neorv32_package is
   constant opcode_system_c : std_ulogic_vector(6 downto 0) := "1110011"; -- system/csr access
   -- floating point operations --
   constant opcode_fop_c    : std_ulogic_vector(6 downto 0) := "1010011"; -- dual/single operand instruction
+  constant opcode_fmadd_c  : std_ulogic_vector(6 downto 0) := "1000011"; -- fused multiply-add
+  constant opcode_fmsub_c  : std_ulogic_vector(6 downto 0) := "1000111"; -- fused multiply-sub
+  constant opcode_fnmsub_c : std_ulogic_vector(6 downto 0) := "1001011"; -- fused negated multiply-sub
+  constant opcode_fnmadd_c : std_ulogic_vector(6 downto 0) := "1001111"; -- fused negated multiply-add
   -- official custom RISC-V opcodes - free for custom instructions --
   constant opcode_cust0_c  : std_ulogic_vector(6 downto 0) := "0001011"; -- custom-0
   constant opcode_cust1_c  : std_ulogic_vector(6 downto 0) := "0101011"; -- custom-1
@@ -407,6 +419,20 @@ package neorv32_package is
   constant csr_pmpaddr13_c      : std_ulogic_vector(11 downto 0) := x"3bd";
   constant csr_pmpaddr14_c      : std_ulogic_vector(11 downto 0) := x"3be";
   constant csr_pmpaddr15_c      : std_ulogic_vector(11 downto 0) := x"3bf";
+  -- machine counter setup, high words (Sscofpmf) --
+  constant csr_mhpmevent3h_c    : std_ulogic_vector(11 downto 0) := x"723";
+  constant csr_mhpmevent4h_c    : std_ulogic_vector(11 downto 0) := x"724";
+  constant csr_mhpmevent5h_c    : std_ulogic_vector(11 downto 0) := x"725";
+  constant csr_mhpmevent6h_c    : std_ulogic_vector(11 downto 0) := x"726";
+  constant csr_mhpmevent7h_c    : std_ulogic_vector(11 downto 0) := x"727";
+  constant csr_mhpmevent8h_c    : std_ulogic_vector(11 downto 0) := x"728";
+  constant csr_mhpmevent9h_c    : std_ulogic_vector(11 downto 0) := x"729";
+  constant csr_mhpmevent10h_c   : std_ulogic_vector(11 downto 0) := x"72a";
+  constant csr_mhpmevent11h_c   : std_ulogic_vector(11 downto 0) := x"72b";
+  constant csr_mhpmevent12h_c   : std_ulogic_vector(11 downto 0) := x"72c";
+  constant csr_mhpmevent13h_c   : std_ulogic_vector(11 downto 0) := x"72d";
+  constant csr_mhpmevent14h_c   : std_ulogic_vector(11 downto 0) := x"72e";
+  constant csr_mhpmevent15h_c   : std_ulogic_vector(11 downto 0) := x"72f";
   -- trigger module registers --
   constant csr_tselect_c        : std_ulogic_vector(11 downto 0) := x"7a0";
   constant csr_tdata1_c         : std_ulogic_vector(11 downto 0) := x"7a1";
@@ -614,6 +640,7 @@ package neorv32_package is
   constant trap_msi_c      : std_ulogic_vector(6 downto 0) := "1" & "0" & "00011"; -- 3:  machine software interrupt
   constant trap_mti_c      : std_ulogic_vector(6 downto 0) := "1" & "0" & "00111"; -- 7:  machine timer interrupt
   constant trap_mei_c      : std_ulogic_vector(6 downto 0) := "1" & "0" & "01011"; -- 11: machine external interrupt
+  constant trap_lcofi_c    : std_ulogic_vector(6 downto 0) := "1" & "0" & "01101"; -- 13: local counter overflow interrupt
   -- NEORV32-specific (RISC-V custom) asynchronous exceptions (interrupts) --
   constant trap_firq0_c    : std_ulogic_vector(6 downto 0) := "1" & "0" & "10000"; -- 16: fast interrupt 0
   constant trap_firq1_c    : std_ulogic_vector(6 downto 0) := "1" & "0" & "10001"; -- 17: fast interrupt 1
@@ -673,10 +700,11 @@ package neorv32_package is
   constant irq_firq_13_c  : natural := 16; -- fast interrupt channel 13
   constant irq_firq_14_c  : natural := 17; -- fast interrupt channel 14
   constant irq_firq_15_c  : natural := 18; -- fast interrupt channel 15
-  constant irq_db_halt_c  : natural := 19; -- enter debug mode via external halt request
-  constant irq_db_step_c  : natural := 20; -- enter debug mode via single-stepping
+  constant irq_lcofi_c    : natural := 19; -- local counter overflow interrupt
+  constant irq_db_halt_c  : natural := 20; -- enter debug mode via external halt request
+  constant irq_db_step_c  : natural := 21; -- enter debug mode via single-stepping
   --
-  constant irq_width_c    : natural := 21; -- length of this list in bits
+  constant irq_width_c    : natural := 22; -- length of this list in bits
 
   -- Privilege Modes ------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -699,8 +727,27 @@ package neorv32_package is
   constant hpmcnt_event_store_c    : natural := 9;  -- store operation
   constant hpmcnt_event_wait_lsu_c : natural := 10; -- load-store unit memory wait cycle
   constant hpmcnt_event_trap_c     : natural := 11; -- entered trap
+  -- processor-specific (CPU-external) --
+  constant hpmcnt_event_ic_pf_c    : natural := 12; -- i-cache prefetch issued
+  constant hpmcnt_event_ic_pfhit_c : natural := 13; -- i-cache prefetch useful
+  -- NEORV32-specific (CPU-internal) --
+  constant hpmcnt_event_bp_hit_c   : natural := 14; -- correctly predicted taken branch
+  constant hpmcnt_event_bp_miss_c  : natural := 15; -- mispredicted branch
+  -- processor-specific (CPU-external) --
+  constant hpmcnt_event_ic_hit_c   : natural := 16; -- i-cache hit
+  constant hpmcnt_event_ic_miss_c  : natural := 17; -- i-cache miss
+  constant hpmcnt_event_dc_hit_c   : natural := 18; -- d-cache hit
+  constant hpmcnt_event_dc_miss_c  : natural := 19; -- d-cache miss
+  constant hpmcnt_event_xip_miss_c : natural := 20; -- XIP cache miss
+  constant hpmcnt_event_bus_wait_c : natural := 21; -- bus switch arbitration stall cycle
+  constant hpmcnt_event_dma_busy_c : natural := 22; -- DMA bus access in progress
+  -- NEORV32-specific (CPU-internal) --
+  constant hpmcnt_event_irq_wait_c : natural := 23; -- interrupt latency cycle (enabled IRQ pending but not taken yet)
+  -- processor-specific (CPU-external) --
+  constant hpmcnt_event_xb_wait_c  : natural := 24; -- crossbar section port arbitration stall cycle
+  constant hpmcnt_event_xb_para_c  : natural := 25; -- crossbar parallel section port accesses
   --
-  constant hpmcnt_event_size_c     : natural := 12; -- length of this list
+  constant hpmcnt_event_size_c     : natural := 26; -- length of this list
 
 -- ****************************************************************************************************************************
 -- Helper Functions
@@ -737,6 +784,7 @@ package neorv32_package is
       CLOCK_FREQUENCY            : natural;
       CLOCK_GATING_EN            : boolean                        := false;
       HART_ID                    : std_ulogic_vector(31 downto 0) := x"00000000";
+      DUAL_CORE_EN               : boolean                        := false;
       VENDOR_ID                  : std_ulogic_vector(31 downto 0) := x"00000000";
       INT_BOOTLOADER_EN          : boolean                        := false;
       -- On-Chip Debugger (OCD) --
@@ -759,6 +807,10 @@ package neorv32_package is
       FAST_MUL_EN                : boolean                        := false;
       FAST_SHIFT_EN              : boolean                        := false;
       REGFILE_HW_RST             : boolean                        := false;
+      CPU_BTB_EN                 : boolean                        := false;
+      CPU_IPB_DEPTH              : natural range 2 to 16          := 2;
+      MULDIV_RADIX               : natural range 2 to 16          := 2;
+      MULDIV_EARLY_EN            : boolean                        := false;
       -- Physical Memory Protection (PMP) --
       PMP_NUM_REGIONS            : natural range 0 to 16          := 0;
       PMP_MIN_GRANULARITY        : natural                        := 4;
@@ -769,21 +821,31 @@ package neorv32_package is
       HPM_CNT_WIDTH              : natural range 0 to 64          := 40;
       -- Atomic Memory Access - Reservation Set Granularity --
       AMO_RVS_GRANULARITY        : natural                        := 4;
+      -- Processor-Internal Bus Interconnect --
+      BUS_XBAR_EN                : boolean                        := false;
       -- Internal Instruction memory (IMEM) --
       MEM_INT_IMEM_EN            : boolean                        := false;
       MEM_INT_IMEM_SIZE          : natural                        := 16*1024;
       -- Internal Data memory (DMEM) --
       MEM_INT_DMEM_EN            : boolean                        := false;
       MEM_INT_DMEM_SIZE          : natural                        := 8*1024;
+      -- Tightly-Coupled Memories (TCM) --
+      MEM_INT_ITCM_EN            : boolean                        := false;
+      MEM_INT_ITCM_SIZE          : natural range 4 to 2**15       := 4*1024;
+      MEM_INT_DTCM_EN            : boolean                        := false;
+      MEM_INT_DTCM_SIZE          : natural range 4 to 2**15       := 4*1024;
       -- Internal Instruction Cache (iCACHE) --
       ICACHE_EN                  : boolean                        := false;
       ICACHE_NUM_BLOCKS          : natural range 1 to 256         := 4;
       ICACHE_BLOCK_SIZE          : natural range 4 to 2**16       := 64;
       ICACHE_ASSOCIATIVITY       : natural range 1 to 2           := 1;
+      ICACHE_PREFETCH_EN         : boolean                        := false;
       -- Internal Data Cache (dCACHE) --
       DCACHE_EN                  : boolean                        := false;
       DCACHE_NUM_BLOCKS          : natural range 1 to 256         := 4;
       DCACHE_BLOCK_SIZE          : natural range 4 to 2**16       := 64;
+      DCACHE_ASSOCIATIVITY       : natural range 1 to 4           := 1;
+      DCACHE_WRITE_POLICY        : natural range 0 to 1           := 0;
       -- External memory interface (WISHBONE) --
       MEM_EXT_EN                 : boolean                        := false;
       MEM_EXT_TIMEOUT            : natural                        := 255;
@@ -791,6 +853,7 @@ package neorv32_package is
       MEM_EXT_BIG_ENDIAN         : boolean                        := false;
       MEM_EXT_ASYNC_RX           : boolean                        := false;
       MEM_EXT_ASYNC_TX           : boolean                        := false;
+      MEM_EXT_BURST_EN           : boolean                        := false;
       -- Execute in-place module (XIP) --
       XIP_EN                     : boolean                        := false;
       XIP_CACHE_EN               : boolean                        := false;
@@ -827,6 +890,7 @@ package neorv32_package is
       IO_GPTMR_EN                : boolean                        := false;
       IO_ONEWIRE_EN              : boolean                        := false;
       IO_DMA_EN                  : boolean                        := false;
+      IO_DMA_NUM_CH              : natural range 1 to 8           := 1;
       IO_SLINK_EN                : boolean                        := false;
       IO_SLINK_RX_FIFO           : natural range 1 to 2**15       := 1;
       IO_SLINK_TX_FIFO           : natural range 1 to 2**15       := 1;
@@ -844,6 +908,8 @@ package neorv32_package is
       jtag_tms_i     : in  std_ulogic := 'L';
       -- Wishbone bus interface (available if MEM_EXT_EN = true) --
       wb_tag_o       : out std_ulogic_vector(02 downto 0);
+      wb_cti_o       : out std_ulogic_vector(02 downto 0);
+      wb_bte_o       : out std_ulogic_vector(01 downto 0);
       wb_adr_o       : out std_ulogic_vector(31 downto 0);
       wb_dat_i       : in  std_ulogic_vector(31 downto 0) := (others => 'L');
       wb_dat_o       : out std_ulogic_vector(31 downto 0);
@@ -865,8 +931,9 @@ package neorv32_package is
       -- XIP (execute in-place via SPI) signals (available if XIP_EN = true) --
       xip_csn_o      : out std_ulogic;
       xip_clk_o      : out std_ulogic;
-      xip_dat_i      : in  std_ulogic := 'L';
-      xip_dat_o      : out std_ulogic;
+      xip_dat_i      : in  std_ulogic_vector(3 downto 0) := (others => 'L');
+      xip_dat_o      : out std_ulogic_vector(3 downto 0);
+      xip_dat_oe_o   : out std_ulogic_vector(3 downto 0);
       -- GPIO (available if IO_GPIO_NUM > 0) --
       gpio_o         : out std_ulogic_vector(63 downto 0);
       gpio_i         : in  std_ulogic_vector(63 downto 0) := (others => 'L');
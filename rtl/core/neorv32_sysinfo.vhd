@@ -53,17 +53,28 @@ entity neorv32_sysinfo is
     -- Internal data memory --
     MEM_INT_DMEM_EN      : boolean; -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE    : natural; -- size of processor-internal data memory in bytes
+    -- Tightly-coupled memories --
+    MEM_INT_ITCM_EN      : boolean; -- implement instruction TCM
+    MEM_INT_ITCM_SIZE    : natural; -- size of instruction TCM in bytes
+    MEM_INT_DTCM_EN      : boolean; -- implement data TCM
+    MEM_INT_DTCM_SIZE    : natural; -- size of data TCM in bytes
     -- Reservation Set Granularity --
     AMO_RVS_GRANULARITY  : natural; -- size in bytes, has to be a power of 2, min 4
+    -- Bus interconnect --
+    DUAL_CORE_EN         : boolean; -- implement second CPU core (SMP)
+    BUS_XBAR_EN          : boolean; -- implement multi-layer crossbar
     -- Instruction cache --
     ICACHE_EN            : boolean; -- implement instruction cache
     ICACHE_NUM_BLOCKS    : natural; -- i-cache: number of blocks (min 2), has to be a power of 2
     ICACHE_BLOCK_SIZE    : natural; -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY : natural; -- i-cache: associativity (min 1), has to be a power 2
+    ICACHE_PREFETCH_EN   : boolean; -- i-cache: implement sequential next-block prefetcher
     -- Data cache --
     DCACHE_EN            : boolean; -- implement data cache
     DCACHE_NUM_BLOCKS    : natural; -- d-cache: number of blocks (min 2), has to be a power of 2
     DCACHE_BLOCK_SIZE    : natural; -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY : natural; -- d-cache: associativity (min 1), has to be a power 2
+    DCACHE_WRITE_POLICY  : natural; -- d-cache: write policy (0=write-through, 1=write-back)
     -- External memory interface --
     MEM_EXT_EN           : boolean; -- implement external memory bus interface?
     MEM_EXT_BIG_ENDIAN   : boolean; -- byte order: true=big-endian, false=little-endian
@@ -118,7 +129,8 @@ begin
   -- SYSINFO(1): Internal Memory Configuration (sizes)
   sysinfo(1)(07 downto 00) <= std_ulogic_vector(to_unsigned(index_size_f(MEM_INT_IMEM_SIZE), 8)); -- log2(IMEM size)
   sysinfo(1)(15 downto 08) <= std_ulogic_vector(to_unsigned(index_size_f(MEM_INT_DMEM_SIZE), 8)); -- log2(DMEM size)
-  sysinfo(1)(23 downto 16) <= (others => '0'); -- reserved
+  sysinfo(1)(19 downto 16) <= std_ulogic_vector(to_unsigned(index_size_f(MEM_INT_ITCM_SIZE), 4)) when MEM_INT_ITCM_EN else (others => '0'); -- log2(ITCM size)
+  sysinfo(1)(23 downto 20) <= std_ulogic_vector(to_unsigned(index_size_f(MEM_INT_DTCM_SIZE), 4)) when MEM_INT_DTCM_EN else (others => '0'); -- log2(DTCM size)
   sysinfo(1)(31 downto 24) <= std_ulogic_vector(to_unsigned(index_size_f(AMO_RVS_GRANULARITY), 8)); -- log2(reservation set granularity)
 
   -- SYSINFO(2): SoC Configuration --
@@ -130,10 +142,10 @@ begin
   sysinfo(2)(05) <= '1' when ICACHE_EN           else '0'; -- processor-internal instruction cache implemented?
   sysinfo(2)(06) <= '1' when DCACHE_EN           else '0'; -- processor-internal data cache implemented?
   sysinfo(2)(07) <= '1' when CLOCK_GATING_EN     else '0'; -- enable clock gating when in sleep mode
-  sysinfo(2)(08) <= '0'; -- reserved
-  sysinfo(2)(09) <= '0'; -- reserved
-  sysinfo(2)(10) <= '0'; -- reserved
-  sysinfo(2)(11) <= '0'; -- reserved
+  sysinfo(2)(08) <= '1' when DCACHE_EN and (DCACHE_WRITE_POLICY = 1) else '0'; -- data cache uses write-back policy?
+  sysinfo(2)(09) <= '1' when ICACHE_EN and ICACHE_PREFETCH_EN else '0'; -- instruction cache implements next-block prefetcher?
+  sysinfo(2)(10) <= '1' when BUS_XBAR_EN         else '0'; -- multi-layer bus crossbar implemented?
+  sysinfo(2)(11) <= '1' when DUAL_CORE_EN        else '0'; -- dual-core (SMP) configuration implemented?
   sysinfo(2)(12) <= '1' when IO_CRC_EN           else '0'; -- cyclic redundancy check unit (CRC) implemented?
   sysinfo(2)(13) <= '1' when IO_SLINK_EN         else '0'; -- stream link interface (SLINK) implemented?
   sysinfo(2)(14) <= '1' when IO_DMA_EN           else '0'; -- direct memory access controller (DMA) implemented?
@@ -163,8 +175,8 @@ begin
   --
   sysinfo(3)(19 downto 16) <= std_ulogic_vector(to_unsigned(index_size_f(DCACHE_BLOCK_SIZE), 4)) when DCACHE_EN else (others => '0'); -- d-cache: log2(block_size)
   sysinfo(3)(23 downto 20) <= std_ulogic_vector(to_unsigned(index_size_f(DCACHE_NUM_BLOCKS), 4)) when DCACHE_EN else (others => '0'); -- d-cache: log2(num_blocks)
-  sysinfo(3)(27 downto 24) <= (others => '0'); -- d-cache: log2(associativity)
-  sysinfo(3)(31 downto 28) <= (others => '0'); -- d-cache: replacement strategy
+  sysinfo(3)(27 downto 24) <= std_ulogic_vector(to_unsigned(index_size_f(DCACHE_ASSOCIATIVITY), 4)) when DCACHE_EN else (others => '0'); -- d-cache: log2(associativity)
+  sysinfo(3)(31 downto 28) <= "0010" when (DCACHE_ASSOCIATIVITY > 1) and DCACHE_EN else (others => '0'); -- d-cache: replacement strategy (pseudo-LRU)
 
 
   -- Bus Access -----------------------------------------------------------------------------
@@ -0,0 +1,272 @@
+-- #################################################################################################
+-- # << NEORV32 - Tightly-Coupled Memories (ITCM/DTCM) >>                                          #
+-- # ********************************************************************************************* #
+-- # Optional instruction (ITCM) and data (DTCM) scratchpad memories that are coupled directly     #
+-- # to the CPU's instruction fetch and data access interfaces. TCM accesses bypass the caches and #
+-- # the processor-internal bus system and are always acknowledged in the next cycle. All other    #
+-- # accesses are passed through. The ITCM can also be accessed (read/write) via the data port.    #
+-- # Atomic accesses to the TCMs are not supported and will raise a bus error.                     #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # The NEORV32 RISC-V Processor, https://github.com/stnolting/neorv32                            #
+-- # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neorv32;
+use neorv32.neorv32_package.all;
+
+entity neorv32_tcm is
+  generic (
+    ITCM_EN   : boolean; -- implement instruction TCM
+    ITCM_SIZE : natural; -- instruction TCM size in bytes, has to be a power of 2, min 4
+    DTCM_EN   : boolean; -- implement data TCM
+    DTCM_SIZE : natural  -- data TCM size in bytes, has to be a power of 2, min 4
+  );
+  port (
+    -- global control --
+    clk_i       : in  std_ulogic; -- global clock, rising edge
+    rstn_i      : in  std_ulogic; -- global reset, low-active, async
+    -- CPU ports --
+    cpu_i_req_i : in  bus_req_t; -- instruction fetch request
+    cpu_i_rsp_o : out bus_rsp_t; -- instruction fetch response
+    cpu_d_req_i : in  bus_req_t; -- data access request
+    cpu_d_rsp_o : out bus_rsp_t; -- data access response
+    -- system bus ports (all non-TCM accesses) --
+    bus_i_req_o : out bus_req_t; -- instruction fetch request
+    bus_i_rsp_i : in  bus_rsp_t; -- instruction fetch response
+    bus_d_req_o : out bus_req_t; -- data access request
+    bus_d_rsp_i : in  bus_rsp_t  -- data access response
+  );
+end neorv32_tcm;
+
+architecture neorv32_tcm_rtl of neorv32_tcm is
+
+  -- address decoding --
+  constant itcm_abits_c : natural := index_size_f(ITCM_SIZE); -- byte address width
+  constant dtcm_abits_c : natural := index_size_f(DTCM_SIZE); -- byte address width
+  signal i_hit_itcm, d_hit_itcm, d_hit_dtcm : std_ulogic;
+
+  -- atomic accesses are not supported --
+  signal d_atomic, d_err : std_ulogic;
+
+  -- local responses --
+  signal itcm_i_rsp, itcm_d_rsp, dtcm_d_rsp : bus_rsp_t;
+
+begin
+
+  -- Address Decoding -----------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  i_hit_itcm <= '1' when ITCM_EN and (cpu_i_req_i.addr(31 downto itcm_abits_c) = mem_itcm_base_c(31 downto itcm_abits_c)) else '0';
+  d_hit_itcm <= '1' when ITCM_EN and (cpu_d_req_i.addr(31 downto itcm_abits_c) = mem_itcm_base_c(31 downto itcm_abits_c)) else '0';
+  d_hit_dtcm <= '1' when DTCM_EN and (cpu_d_req_i.addr(31 downto dtcm_abits_c) = mem_dtcm_base_c(31 downto dtcm_abits_c)) else '0';
+
+  -- TCMs are private to the CPU and are not connected to the reservation set / AMO controller --
+  d_atomic <= cpu_d_req_i.amo or cpu_d_req_i.rvso;
+
+
+  -- System Bus Interface -------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  bus_request: process(cpu_i_req_i, cpu_d_req_i, i_hit_itcm, d_hit_itcm, d_hit_dtcm)
+  begin
+    bus_i_req_o     <= cpu_i_req_i;
+    bus_i_req_o.stb <= cpu_i_req_i.stb and (not i_hit_itcm);
+    bus_d_req_o     <= cpu_d_req_i;
+    bus_d_req_o.stb <= cpu_d_req_i.stb and (not (d_hit_itcm or d_hit_dtcm));
+  end process bus_request;
+
+  -- response: wired-OR of all sources (data is zero if not acknowledged) --
+  cpu_i_rsp_o.data <= bus_i_rsp_i.data or itcm_i_rsp.data;
+  cpu_i_rsp_o.ack  <= bus_i_rsp_i.ack  or itcm_i_rsp.ack;
+  cpu_i_rsp_o.err  <= bus_i_rsp_i.err;
+
+  cpu_d_rsp_o.data <= bus_d_rsp_i.data or itcm_d_rsp.data or dtcm_d_rsp.data;
+  cpu_d_rsp_o.ack  <= bus_d_rsp_i.ack  or itcm_d_rsp.ack  or dtcm_d_rsp.ack;
+  cpu_d_rsp_o.err  <= bus_d_rsp_i.err  or d_err;
+
+  -- atomic access to a TCM: respond with bus error --
+  error_response: process(rstn_i, clk_i)
+  begin
+    if (rstn_i = '0') then
+      d_err <= '0';
+    elsif rising_edge(clk_i) then
+      d_err <= cpu_d_req_i.stb and (d_hit_itcm or d_hit_dtcm) and d_atomic;
+    end if;
+  end process error_response;
+
+
+  -- Instruction TCM ------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  itcm_enabled:
+  if ITCM_EN generate
+
+    signal d_go, i_go, i_req, i_pend, i_ack, d_ack, d_rden : std_ulogic;
+    signal addr  : std_ulogic_vector(itcm_abits_c-1 downto 2);
+    signal rdata : std_ulogic_vector(31 downto 0);
+
+    -- The memory is built from 4 individual byte-wide memories (see neorv32_dmem.default.vhd).
+    -- It is single-ported: data accesses (e.g. from the start-up code's copy loop) are prioritized
+    -- and stall a concurrent instruction fetch for one cycle.
+    signal mem_ram_b0, mem_ram_b1, mem_ram_b2, mem_ram_b3 : mem8_t(0 to ITCM_SIZE/4-1);
+
+  begin
+
+    -- port arbitration --
+    d_go  <= cpu_d_req_i.stb and d_hit_itcm and (not d_atomic);
+    i_req <= (cpu_i_req_i.stb and i_hit_itcm) or i_pend;
+    i_go  <= i_req and (not d_go);
+    addr  <= cpu_d_req_i.addr(itcm_abits_c-1 downto 2) when (d_go = '1') else cpu_i_req_i.addr(itcm_abits_c-1 downto 2);
+
+    -- memory core --
+    mem_access: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to infer block RAM
+        if (d_go = '1') and (cpu_d_req_i.rw = '1') then
+          if (cpu_d_req_i.ben(0) = '1') then -- byte 0
+            mem_ram_b0(to_integer(unsigned(addr))) <= cpu_d_req_i.data(07 downto 00);
+          end if;
+          if (cpu_d_req_i.ben(1) = '1') then -- byte 1
+            mem_ram_b1(to_integer(unsigned(addr))) <= cpu_d_req_i.data(15 downto 08);
+          end if;
+          if (cpu_d_req_i.ben(2) = '1') then -- byte 2
+            mem_ram_b2(to_integer(unsigned(addr))) <= cpu_d_req_i.data(23 downto 16);
+          end if;
+          if (cpu_d_req_i.ben(3) = '1') then -- byte 3
+            mem_ram_b3(to_integer(unsigned(addr))) <= cpu_d_req_i.data(31 downto 24);
+          end if;
+        end if;
+        rdata(07 downto 00) <= mem_ram_b0(to_integer(unsigned(addr)));
+        rdata(15 downto 08) <= mem_ram_b1(to_integer(unsigned(addr)));
+        rdata(23 downto 16) <= mem_ram_b2(to_integer(unsigned(addr)));
+        rdata(31 downto 24) <= mem_ram_b3(to_integer(unsigned(addr)));
+      end if;
+    end process mem_access;
+
+    -- bus feedback --
+    bus_feedback: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        i_pend <= '0';
+        i_ack  <= '0';
+        d_ack  <= '0';
+        d_rden <= '0';
+      elsif rising_edge(clk_i) then
+        i_pend <= i_req and d_go; -- fetch has been stalled by a data access
+        i_ack  <= i_go;
+        d_ack  <= d_go;
+        d_rden <= d_go and (not cpu_d_req_i.rw);
+      end if;
+    end process bus_feedback;
+
+    itcm_i_rsp.data <= rdata when (i_ack = '1') else (others => '0'); -- output gate
+    itcm_i_rsp.ack  <= i_ack;
+    itcm_i_rsp.err  <= '0';
+
+    itcm_d_rsp.data <= rdata when (d_rden = '1') else (others => '0'); -- output gate
+    itcm_d_rsp.ack  <= d_ack;
+    itcm_d_rsp.err  <= '0';
+
+  end generate;
+
+  itcm_disabled:
+  if not ITCM_EN generate
+    itcm_i_rsp <= rsp_terminate_c;
+    itcm_d_rsp <= rsp_terminate_c;
+  end generate;
+
+
+  -- Data TCM -------------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  dtcm_enabled:
+  if DTCM_EN generate
+
+    signal go, ack, rden : std_ulogic;
+    signal addr  : std_ulogic_vector(dtcm_abits_c-1 downto 2);
+    signal rdata : std_ulogic_vector(31 downto 0);
+
+    -- memory (see neorv32_dmem.default.vhd) --
+    signal mem_ram_b0, mem_ram_b1, mem_ram_b2, mem_ram_b3 : mem8_t(0 to DTCM_SIZE/4-1);
+
+  begin
+
+    go   <= cpu_d_req_i.stb and d_hit_dtcm and (not d_atomic);
+    addr <= cpu_d_req_i.addr(dtcm_abits_c-1 downto 2);
+
+    -- memory core --
+    mem_access: process(clk_i)
+    begin
+      if rising_edge(clk_i) then -- no reset to infer block RAM
+        if (go = '1') and (cpu_d_req_i.rw = '1') then
+          if (cpu_d_req_i.ben(0) = '1') then -- byte 0
+            mem_ram_b0(to_integer(unsigned(addr))) <= cpu_d_req_i.data(07 downto 00);
+          end if;
+          if (cpu_d_req_i.ben(1) = '1') then -- byte 1
+            mem_ram_b1(to_integer(unsigned(addr))) <= cpu_d_req_i.data(15 downto 08);
+          end if;
+          if (cpu_d_req_i.ben(2) = '1') then -- byte 2
+            mem_ram_b2(to_integer(unsigned(addr))) <= cpu_d_req_i.data(23 downto 16);
+          end if;
+          if (cpu_d_req_i.ben(3) = '1') then -- byte 3
+            mem_ram_b3(to_integer(unsigned(addr))) <= cpu_d_req_i.data(31 downto 24);
+          end if;
+        end if;
+        rdata(07 downto 00) <= mem_ram_b0(to_integer(unsigned(addr)));
+        rdata(15 downto 08) <= mem_ram_b1(to_integer(unsigned(addr)));
+        rdata(23 downto 16) <= mem_ram_b2(to_integer(unsigned(addr)));
+        rdata(31 downto 24) <= mem_ram_b3(to_integer(unsigned(addr)));
+      end if;
+    end process mem_access;
+
+    -- bus feedback --
+    bus_feedback: process(rstn_i, clk_i)
+    begin
+      if (rstn_i = '0') then
+        ack  <= '0';
+        rden <= '0';
+      elsif rising_edge(clk_i) then
+        ack  <= go;
+        rden <= go and (not cpu_d_req_i.rw);
+      end if;
+    end process bus_feedback;
+
+    dtcm_d_rsp.data <= rdata when (rden = '1') else (others => '0'); -- output gate
+    dtcm_d_rsp.ack  <= ack;
+    dtcm_d_rsp.err  <= '0';
+
+  end generate;
+
+  dtcm_disabled:
+  if not DTCM_EN generate
+    dtcm_d_rsp <= rsp_terminate_c;
+  end generate;
+
+
+end neorv32_tcm_rtl;
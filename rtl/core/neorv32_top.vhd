@@ -49,6 +49,7 @@ entity neorv32_top is
     CLOCK_FREQUENCY            : natural;                                       -- clock frequency of clk_i in Hz
     CLOCK_GATING_EN            : boolean                        := false;       -- enable clock gating when in sleep mode
     HART_ID                    : std_ulogic_vector(31 downto 0) := x"00000000"; -- hardware thread ID
+    DUAL_CORE_EN               : boolean                        := false;       -- implement a second CPU core (SMP dual-core cluster)
     VENDOR_ID                  : std_ulogic_vector(31 downto 0) := x"00000000"; -- vendor's JEDEC ID
     INT_BOOTLOADER_EN          : boolean                        := false;       -- boot configuration: true = boot explicit bootloader; false = boot from int/ext (I)MEM
 
@@ -74,6 +75,10 @@ entity neorv32_top is
     FAST_MUL_EN                : boolean                        := false;       -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN              : boolean                        := false;       -- use barrel shifter for shift operations
     REGFILE_HW_RST             : boolean                        := false;       -- implement full hardware reset for register file
+    CPU_BTB_EN                 : boolean                        := false;       -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH              : natural range 2 to 16          := 2;           -- instruction prefetch buffer depth, has to be a power of two
+    MULDIV_RADIX               : natural range 2 to 16          := 2;           -- serial mul/div radix: 2, 4 or 16 (1, 2 or 4 bits per cycle)
+    MULDIV_EARLY_EN            : boolean                        := false;       -- skip leading all-zero operand bytes in serial mul/div
 
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS            : natural range 0 to 16          := 0;           -- number of regions (0..16)
@@ -88,6 +93,9 @@ entity neorv32_top is
     -- Atomic Memory Access - Reservation Set Granularity --
     AMO_RVS_GRANULARITY        : natural                        := 4;           -- size in bytes, has to be a power of 2, min 4
 
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN                : boolean                        := false;       -- implement multi-layer crossbar instead of the shared bus
+
     -- Internal Instruction memory (IMEM) --
     MEM_INT_IMEM_EN            : boolean                        := false;       -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE          : natural                        := 16*1024;     -- size of processor-internal instruction memory in bytes (use a power of 2)
@@ -96,16 +104,25 @@ entity neorv32_top is
     MEM_INT_DMEM_EN            : boolean                        := false;       -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE          : natural                        := 8*1024;      -- size of processor-internal data memory in bytes (use a power of 2)
 
+    -- Tightly-Coupled Memories (TCM) --
+    MEM_INT_ITCM_EN            : boolean                        := false;       -- implement instruction TCM (hart 0 only)
+    MEM_INT_ITCM_SIZE          : natural range 4 to 2**15       := 4*1024;      -- size of instruction TCM in bytes (use a power of 2)
+    MEM_INT_DTCM_EN            : boolean                        := false;       -- implement data TCM (hart 0 only)
+    MEM_INT_DTCM_SIZE          : natural range 4 to 2**15       := 4*1024;      -- size of data TCM in bytes (use a power of 2)
+
     -- Internal Instruction Cache (iCACHE) --
     ICACHE_EN                  : boolean                        := false;       -- implement instruction cache
     ICACHE_NUM_BLOCKS          : natural range 1 to 256         := 4;           -- i-cache: number of blocks (min 1), has to be a power of 2
     ICACHE_BLOCK_SIZE          : natural range 4 to 2**16       := 64;          -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY       : natural range 1 to 2           := 1;           -- i-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    ICACHE_PREFETCH_EN         : boolean                        := false;       -- i-cache: implement sequential next-block prefetcher
 
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN                  : boolean                        := false;       -- implement data cache
     DCACHE_NUM_BLOCKS          : natural range 1 to 256         := 4;           -- d-cache: number of blocks (min 1), has to be a power of 2
     DCACHE_BLOCK_SIZE          : natural range 4 to 2**16       := 64;          -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY       : natural range 1 to 4           := 1;           -- d-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    DCACHE_WRITE_POLICY        : natural range 0 to 1           := 0;           -- d-cache: write policy (0=write-through, 1=write-back)
 
     -- External memory interface (WISHBONE) --
     MEM_EXT_EN                 : boolean                        := false;       -- implement external memory bus interface?
@@ -114,6 +131,7 @@ entity neorv32_top is
     MEM_EXT_BIG_ENDIAN         : boolean                        := false;       -- byte order: true=big-endian, false=little-endian
     MEM_EXT_ASYNC_RX           : boolean                        := false;       -- use register buffer for RX data when false
     MEM_EXT_ASYNC_TX           : boolean                        := false;       -- use register buffer for TX data when false
+    MEM_EXT_BURST_EN           : boolean                        := false;       -- use incrementing bursts for cache block transfers (requires MEM_EXT_ASYNC_TX = false)
 
     -- Execute in-place module (XIP) --
     XIP_EN                     : boolean                        := false;       -- implement execute in place module (XIP)?
@@ -153,6 +171,7 @@ entity neorv32_top is
     IO_GPTMR_EN                : boolean                        := false;       -- implement general purpose timer (GPTMR)?
     IO_ONEWIRE_EN              : boolean                        := false;       -- implement 1-wire interface (ONEWIRE)?
     IO_DMA_EN                  : boolean                        := false;       -- implement direct memory access controller (DMA)?
+    IO_DMA_NUM_CH              : natural range 1 to 8           := 1;           -- number of DMA channels
     IO_SLINK_EN                : boolean                        := false;       -- implement stream link interface (SLINK)?
     IO_SLINK_RX_FIFO           : natural range 1 to 2**15       := 1;           -- RX fifo depth, has to be a power of two, min 1
     IO_SLINK_TX_FIFO           : natural range 1 to 2**15       := 1;           -- TX fifo depth, has to be a power of two, min 1
@@ -172,6 +191,8 @@ entity neorv32_top is
 
     -- Wishbone bus interface (available if MEM_EXT_EN = true) --
     wb_tag_o       : out std_ulogic_vector(02 downto 0); -- request tag
+    wb_cti_o       : out std_ulogic_vector(02 downto 0); -- cycle type identifier
+    wb_bte_o       : out std_ulogic_vector(01 downto 0); -- burst type extension
     wb_adr_o       : out std_ulogic_vector(31 downto 0); -- address
     wb_dat_i       : in  std_ulogic_vector(31 downto 0) := (others => 'L'); -- read data
     wb_dat_o       : out std_ulogic_vector(31 downto 0); -- write data
@@ -195,8 +216,9 @@ entity neorv32_top is
     -- XIP (execute in place via SPI) signals (available if XIP_EN = true) --
     xip_csn_o      : out std_ulogic; -- chip-select, low-active
     xip_clk_o      : out std_ulogic; -- serial clock
-    xip_dat_i      : in  std_ulogic := 'L'; -- device data input
-    xip_dat_o      : out std_ulogic; -- controller data output
+    xip_dat_i      : in  std_ulogic_vector(3 downto 0) := (others => 'L'); -- device data input (IO3..IO0)
+    xip_dat_o      : out std_ulogic_vector(3 downto 0); -- controller data output (IO3..IO0)
+    xip_dat_oe_o   : out std_ulogic_vector(3 downto 0); -- controller data output enable (IO3..IO0)
 
     -- GPIO (available if IO_GPIO_NUM > 0) --
     gpio_o         : out std_ulogic_vector(63 downto 0); -- parallel output
@@ -270,6 +292,8 @@ architecture neorv32_top_rtl of neorv32_top is
   constant io_gpio_en_c    : boolean := boolean(IO_GPIO_NUM > 0);
   constant io_xirq_en_c    : boolean := boolean(XIRQ_NUM_CH > 0);
   constant io_pwm_en_c     : boolean := boolean(IO_PWM_NUM_CH > 0);
+  constant num_cores_c     : natural := cond_sel_natural_f(DUAL_CORE_EN, 2, 1);
+  constant xbar_en_c       : boolean := BUS_XBAR_EN and (not DUAL_CORE_EN); -- crossbar is available for single-core only
 
   -- make sure physical memory sizes are a power of two --
   constant imem_size_valid_c : boolean := is_power_of_two_f(MEM_INT_IMEM_SIZE);
@@ -279,6 +303,14 @@ architecture neorv32_top_rtl of neorv32_top is
   constant dmem_size_valid_c : boolean := is_power_of_two_f(MEM_INT_DMEM_SIZE);
   constant dmem_size_pow2_c  : natural := 2**index_size_f(MEM_INT_DMEM_SIZE);
   constant dmem_size_c       : natural := cond_sel_natural_f(dmem_size_valid_c, MEM_INT_DMEM_SIZE, dmem_size_pow2_c);
+  --
+  constant itcm_size_valid_c : boolean := is_power_of_two_f(MEM_INT_ITCM_SIZE);
+  constant itcm_size_pow2_c  : natural := 2**index_size_f(MEM_INT_ITCM_SIZE);
+  constant itcm_size_c       : natural := cond_sel_natural_f(itcm_size_valid_c, MEM_INT_ITCM_SIZE, itcm_size_pow2_c);
+  --
+  constant dtcm_size_valid_c : boolean := is_power_of_two_f(MEM_INT_DTCM_SIZE);
+  constant dtcm_size_pow2_c  : natural := 2**index_size_f(MEM_INT_DTCM_SIZE);
+  constant dtcm_size_c       : natural := cond_sel_natural_f(dtcm_size_valid_c, MEM_INT_DTCM_SIZE, dtcm_size_pow2_c);
 
   -- reset generator --
   signal rstn_wdt                     : std_ulogic;
@@ -298,7 +330,14 @@ architecture neorv32_top_rtl of neorv32_top is
   signal cg_en : cg_en_t;
 
   -- CPU status --
-  signal cpu_debug, cpu_sleep : std_ulogic; -- cpu is in debug/sleep mode
+  signal cpu_debug, cpu_sleep   : std_ulogic; -- cpu is in debug mode (hart 0) / all harts are in sleep mode
+  signal hart_debug, hart_sleep : std_ulogic_vector(num_cores_c-1 downto 0); -- per-hart debug/sleep mode
+  signal xip_miss               : std_ulogic; -- XIP cache miss
+  signal cluster_bus_stall      : std_ulogic; -- core cluster bus switch arbitration stall
+  signal dma_bus_stall          : std_ulogic; -- DMA bus switch arbitration stall
+  signal dma_busy               : std_ulogic; -- DMA bus access in progress
+  signal xbar_stall             : std_ulogic; -- crossbar section port arbitration stall
+  signal xbar_para              : std_ulogic; -- crossbar parallel section port accesses
 
   -- debug module interface (DMI) --
   signal dmi_req : dmi_req_t;
@@ -308,16 +347,23 @@ architecture neorv32_top_rtl of neorv32_top is
   signal dci_ndmrstn, dci_halt_req : std_ulogic;
 
   -- bus: core complex --
-  signal cpu_i_req,  cpu_d_req  : bus_req_t; -- CPU core
-  signal cpu_i_rsp,  cpu_d_rsp  : bus_rsp_t; -- CPU core
-  signal icache_req, dcache_req : bus_req_t; -- CPU caches
-  signal icache_rsp, dcache_rsp : bus_rsp_t; -- CPU caches
-  signal core_req               : bus_req_t; -- core complex (CPU + caches)
-  signal core_rsp               : bus_rsp_t; -- core complex (CPU + caches)
+  type hart_req_t is array (0 to num_cores_c-1) of bus_req_t;
+  type hart_rsp_t is array (0 to num_cores_c-1) of bus_rsp_t;
+  signal icache_req, dcache_req : hart_req_t; -- CPU caches (per hart)
+  signal icache_rsp, dcache_rsp : hart_rsp_t; -- CPU caches (per hart)
+  signal hart_req               : hart_req_t; -- hart complex (CPU + caches)
+  signal hart_rsp               : hart_rsp_t; -- hart complex (CPU + caches)
+  signal core_req               : bus_req_t;  -- core complex (all harts)
+  signal core_rsp               : bus_rsp_t;  -- core complex (all harts)
+  signal core_sel               : std_ulogic; -- hart of the current core complex access
 
   -- bus: core complex + DMA --
-  signal main_req, main2_req, dma_req : bus_req_t; -- core complex (CPU + caches + DMA)
-  signal main_rsp, main2_rsp, dma_rsp : bus_rsp_t; -- core complex (CPU + caches + DMA)
+  signal main_req, main2_req, main3_req, dma_req : bus_req_t; -- core complex (CPU + caches + DMA)
+  signal main_rsp, main2_rsp, main3_rsp, dma_rsp : bus_rsp_t; -- core complex (CPU + caches + DMA)
+
+  -- reservation set --
+  signal rvs_addr  : std_ulogic_vector(31 downto 0);
+  signal rvs_clear : std_ulogic;
 
   -- bus: main sections --
   signal imem_req, dmem_req, xip_req, boot_req, io_req, xbus_req : bus_req_t;
@@ -340,7 +386,8 @@ architecture neorv32_top_rtl of neorv32_top is
     wdt, uart0_rx, uart0_tx, uart1_rx, uart1_tx, spi, sdi, twi, cfs, neoled, xirq, gptmr, onewire, dma, trng, slink : std_ulogic;
   end record;
   signal firq      : irq_t;
-  signal mtime_irq : std_ulogic;
+  signal mtime_irq : std_ulogic_vector(1 downto 0); -- machine timer interrupt (per hart)
+  signal mtime_msi : std_ulogic_vector(1 downto 0); -- machine software interrupt (per hart)
 
   -- misc --
   signal mtime_time : std_ulogic_vector(63 downto 0);
@@ -362,8 +409,11 @@ begin
     -- show main SoC configuration --
     assert false report
       "[NEORV32] Processor Configuration: " &
+      cond_sel_string_f(DUAL_CORE_EN,        "SMP ",      "") &
       cond_sel_string_f(MEM_INT_IMEM_EN,     "IMEM ",     "") &
       cond_sel_string_f(MEM_INT_DMEM_EN,     "DMEM ",     "") &
+      cond_sel_string_f(MEM_INT_ITCM_EN,     "ITCM ",     "") &
+      cond_sel_string_f(MEM_INT_DTCM_EN,     "DTCM ",     "") &
       cond_sel_string_f(INT_BOOTLOADER_EN,   "BOOTROM ",  "") &
       cond_sel_string_f(ICACHE_EN,           "I-CACHE ",  "") &
       cond_sel_string_f(DCACHE_EN,           "D-CACHE ",  "") &
@@ -400,6 +450,20 @@ begin
     assert not ((dmem_size_valid_c = false) and (MEM_INT_DMEM_EN = true)) report
       "[NEORV32] Auto-adjusting invalid DMEM size configuration." severity warning;
 
+    -- TCM sizes --
+    assert not ((itcm_size_valid_c = false) and (MEM_INT_ITCM_EN = true)) report
+      "[NEORV32] Auto-adjusting invalid ITCM size configuration." severity warning;
+    assert not ((dtcm_size_valid_c = false) and (MEM_INT_DTCM_EN = true)) report
+      "[NEORV32] Auto-adjusting invalid DTCM size configuration." severity warning;
+    assert not (DUAL_CORE_EN and (MEM_INT_ITCM_EN or MEM_INT_DTCM_EN)) report
+      "[NEORV32] Tightly-coupled memories (TCMs) are implemented for hart 0 only." severity note;
+
+    -- dual-core configuration --
+    assert not (DUAL_CORE_EN and (not IO_MTIME_EN)) report
+      "[NEORV32] Dual-core configuration requires the machine timer (IO_MTIME_EN) for inter-processor interrupts." severity error;
+    assert not (DUAL_CORE_EN and BUS_XBAR_EN) report
+      "[NEORV32] Multi-layer crossbar is not supported for dual-core configurations, using shared bus." severity warning;
+
   end generate; -- /sanity_checks
 
 
@@ -491,7 +555,7 @@ begin
       port map (
         clk_i  => clk_i,
         rstn_i => rstn_sys,
-        halt_i => cpu_sleep,
+        halt_i => cpu_sleep, -- gate clock only if all harts are sleeping
         clk_o  => clk_cpu
       );
     end generate;
@@ -510,64 +574,266 @@ begin
   core_complex:
   if (true) generate
 
-    -- CPU Core -------------------------------------------------------------------------------
+    -- Hart Complexes (CPU + Caches) ----------------------------------------------------------
     -- -------------------------------------------------------------------------------------------
-    neorv32_cpu_inst: entity neorv32.neorv32_cpu
-    generic map (
-      -- General --
-      HART_ID                    => HART_ID,
-      VENDOR_ID                  => VENDOR_ID,
-      CPU_BOOT_ADDR              => cpu_boot_addr_c,
-      CPU_DEBUG_PARK_ADDR        => dm_park_entry_c,
-      CPU_DEBUG_EXC_ADDR         => dm_exc_entry_c,
-      -- RISC-V CPU Extensions --
-      CPU_EXTENSION_RISCV_A      => CPU_EXTENSION_RISCV_A,
-      CPU_EXTENSION_RISCV_B      => CPU_EXTENSION_RISCV_B,
-      CPU_EXTENSION_RISCV_C      => CPU_EXTENSION_RISCV_C,
-      CPU_EXTENSION_RISCV_E      => CPU_EXTENSION_RISCV_E,
-      CPU_EXTENSION_RISCV_M      => CPU_EXTENSION_RISCV_M,
-      CPU_EXTENSION_RISCV_U      => CPU_EXTENSION_RISCV_U,
-      CPU_EXTENSION_RISCV_Zfinx  => CPU_EXTENSION_RISCV_Zfinx,
-      CPU_EXTENSION_RISCV_Zicntr => CPU_EXTENSION_RISCV_Zicntr,
-      CPU_EXTENSION_RISCV_Zicond => CPU_EXTENSION_RISCV_Zicond,
-      CPU_EXTENSION_RISCV_Zihpm  => CPU_EXTENSION_RISCV_Zihpm,
-      CPU_EXTENSION_RISCV_Zmmul  => CPU_EXTENSION_RISCV_Zmmul,
-      CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,
-      CPU_EXTENSION_RISCV_Sdext  => ON_CHIP_DEBUGGER_EN,
-      CPU_EXTENSION_RISCV_Sdtrig => ON_CHIP_DEBUGGER_EN,
-      -- Tuning Options --
-      FAST_MUL_EN                => FAST_MUL_EN,
-      FAST_SHIFT_EN              => FAST_SHIFT_EN,
-      REGFILE_HW_RST             => REGFILE_HW_RST,
-      -- Physical Memory Protection (PMP) --
-      PMP_NUM_REGIONS            => PMP_NUM_REGIONS,
-      PMP_MIN_GRANULARITY        => PMP_MIN_GRANULARITY,
-      PMP_TOR_MODE_EN            => PMP_TOR_MODE_EN,
-      PMP_NAP_MODE_EN            => PMP_NAP_MODE_EN,
-      -- Hardware Performance Monitors (HPM) --
-      HPM_NUM_CNTS               => HPM_NUM_CNTS,
-      HPM_CNT_WIDTH              => HPM_CNT_WIDTH
-    )
-    port map (
-      -- global control --
-      clk_i      => clk_cpu,
-      clk_aux_i  => clk_i,
-      rstn_i     => rstn_sys,
-      sleep_o    => cpu_sleep,
-      debug_o    => cpu_debug,
+    hart_complex:
+    for i in 0 to num_cores_c-1 generate
+
+      -- in dual-core configurations bit 0 of the hart ID is replaced by the core index --
+      constant hart_id_c : std_ulogic_vector(31 downto 0) := cond_sel_suv_f(DUAL_CORE_EN, HART_ID(31 downto 1) & bool_to_ulogic_f(i = 1), HART_ID);
+
+      -- bus: hart --
+      signal cpu_i_req, cpu_d_req : bus_req_t; -- CPU core
+      signal cpu_i_rsp, cpu_d_rsp : bus_rsp_t; -- CPU core
+      signal tcm_i_req, tcm_d_req : bus_req_t; -- tightly-coupled memories
+      signal tcm_i_rsp, tcm_d_rsp : bus_rsp_t; -- tightly-coupled memories
+
       -- interrupts --
-      msi_i      => msw_irq_i,
-      mei_i      => mext_irq_i,
-      mti_i      => mtime_irq,
-      firq_i     => cpu_firq,
-      dbi_i      => dci_halt_req,
-      -- instruction bus interface --
-      ibus_req_o => cpu_i_req,
-      ibus_rsp_i => cpu_i_rsp,
-      -- data bus interface --
-      dbus_req_o => cpu_d_req,
-      dbus_rsp_i => cpu_d_rsp
-    );
+      signal hart_msi, hart_mei, hart_dbi : std_ulogic;
+      signal hart_firq                    : std_ulogic_vector(15 downto 0);
+
+      -- status --
+      signal cpu_hpm_ev      : std_ulogic_vector(hpmcnt_event_size_c-1 downto 0); -- processor-level HPM events
+      signal icache_pf_issue : std_ulogic; -- i-cache prefetch issued
+      signal icache_pf_hit   : std_ulogic; -- i-cache prefetch useful
+      signal icache_hit      : std_ulogic; -- i-cache hit
+      signal icache_miss     : std_ulogic; -- i-cache miss
+      signal dcache_hit      : std_ulogic; -- d-cache hit
+      signal dcache_miss     : std_ulogic; -- d-cache miss
+      signal hart_bus_stall  : std_ulogic; -- hart bus switch arbitration stall
+
+    begin
+
+      -- CPU Core -----------------------------------------------------------------------------
+      -- -----------------------------------------------------------------------------------------
+      neorv32_cpu_inst: entity neorv32.neorv32_cpu
+      generic map (
+        -- General --
+        HART_ID                    => hart_id_c,
+        VENDOR_ID                  => VENDOR_ID,
+        CPU_BOOT_ADDR              => cpu_boot_addr_c,
+        CPU_DEBUG_PARK_ADDR        => dm_park_entry_c,
+        CPU_DEBUG_EXC_ADDR         => dm_exc_entry_c,
+        -- RISC-V CPU Extensions --
+        CPU_EXTENSION_RISCV_A      => CPU_EXTENSION_RISCV_A,
+        CPU_EXTENSION_RISCV_B      => CPU_EXTENSION_RISCV_B,
+        CPU_EXTENSION_RISCV_C      => CPU_EXTENSION_RISCV_C,
+        CPU_EXTENSION_RISCV_E      => CPU_EXTENSION_RISCV_E,
+        CPU_EXTENSION_RISCV_M      => CPU_EXTENSION_RISCV_M,
+        CPU_EXTENSION_RISCV_U      => CPU_EXTENSION_RISCV_U,
+        CPU_EXTENSION_RISCV_Zfinx  => CPU_EXTENSION_RISCV_Zfinx,
+        CPU_EXTENSION_RISCV_Zicntr => CPU_EXTENSION_RISCV_Zicntr,
+        CPU_EXTENSION_RISCV_Zicond => CPU_EXTENSION_RISCV_Zicond,
+        CPU_EXTENSION_RISCV_Zihpm  => CPU_EXTENSION_RISCV_Zihpm,
+        CPU_EXTENSION_RISCV_Zmmul  => CPU_EXTENSION_RISCV_Zmmul,
+        CPU_EXTENSION_RISCV_Zxcfu  => CPU_EXTENSION_RISCV_Zxcfu,
+        CPU_EXTENSION_RISCV_Sdext  => ON_CHIP_DEBUGGER_EN and (i = 0), -- OCD is connected to hart 0 only
+        CPU_EXTENSION_RISCV_Sdtrig => ON_CHIP_DEBUGGER_EN and (i = 0),
+        -- Tuning Options --
+        FAST_MUL_EN                => FAST_MUL_EN,
+        FAST_SHIFT_EN              => FAST_SHIFT_EN,
+        REGFILE_HW_RST             => REGFILE_HW_RST,
+        CPU_BTB_EN                 => CPU_BTB_EN,
+        CPU_IPB_DEPTH              => CPU_IPB_DEPTH,
+        MULDIV_RADIX               => MULDIV_RADIX,
+        MULDIV_EARLY_EN            => MULDIV_EARLY_EN,
+        -- Physical Memory Protection (PMP) --
+        PMP_NUM_REGIONS            => PMP_NUM_REGIONS,
+        PMP_MIN_GRANULARITY        => PMP_MIN_GRANULARITY,
+        PMP_TOR_MODE_EN            => PMP_TOR_MODE_EN,
+        PMP_NAP_MODE_EN            => PMP_NAP_MODE_EN,
+        -- Hardware Performance Monitors (HPM) --
+        HPM_NUM_CNTS               => HPM_NUM_CNTS,
+        HPM_CNT_WIDTH              => HPM_CNT_WIDTH
+      )
+      port map (
+        -- global control --
+        clk_i      => clk_cpu,
+        clk_aux_i  => clk_i,
+        rstn_i     => rstn_sys,
+        sleep_o    => hart_sleep(i),
+        debug_o    => hart_debug(i),
+        -- interrupts --
+        msi_i      => hart_msi,
+        mei_i      => hart_mei,
+        mti_i      => mtime_irq(i),
+        firq_i     => hart_firq,
+        dbi_i      => hart_dbi,
+        -- performance monitor events --
+        hpm_ev_i   => cpu_hpm_ev,
+        -- instruction bus interface --
+        ibus_req_o => cpu_i_req,
+        ibus_rsp_i => cpu_i_rsp,
+        -- data bus interface --
+        dbus_req_o => cpu_d_req,
+        dbus_rsp_i => cpu_d_rsp
+      );
+
+      -- hart 0 handles all platform interrupts; all other harts only receive timer and software interrupts --
+      hart_msi  <= (msw_irq_i or mtime_msi(0)) when (i = 0) else mtime_msi(i);
+      hart_mei  <= mext_irq_i                  when (i = 0) else '0';
+      hart_firq <= cpu_firq                    when (i = 0) else (others => '0');
+      hart_dbi  <= dci_halt_req                when (i = 0) else '0';
+
+      -- processor-level (CPU-external) HPM events --
+      cpu_hpm_ev(hpmcnt_event_ic_pf_c-1 downto 0) <= (others => '0'); -- CPU-internal events
+      cpu_hpm_ev(hpmcnt_event_ic_pf_c)            <= icache_pf_issue;
+      cpu_hpm_ev(hpmcnt_event_ic_pfhit_c)         <= icache_pf_hit;
+      cpu_hpm_ev(hpmcnt_event_bp_hit_c)           <= '0'; -- CPU-internal event
+      cpu_hpm_ev(hpmcnt_event_bp_miss_c)          <= '0'; -- CPU-internal event
+      cpu_hpm_ev(hpmcnt_event_ic_hit_c)           <= icache_hit;
+      cpu_hpm_ev(hpmcnt_event_ic_miss_c)          <= icache_miss;
+      cpu_hpm_ev(hpmcnt_event_dc_hit_c)           <= dcache_hit;
+      cpu_hpm_ev(hpmcnt_event_dc_miss_c)          <= dcache_miss;
+      cpu_hpm_ev(hpmcnt_event_xip_miss_c)         <= xip_miss;
+      cpu_hpm_ev(hpmcnt_event_bus_wait_c)         <= hart_bus_stall or cluster_bus_stall or dma_bus_stall;
+      cpu_hpm_ev(hpmcnt_event_dma_busy_c)         <= dma_busy;
+      cpu_hpm_ev(hpmcnt_event_irq_wait_c)         <= '0'; -- CPU-internal event
+      cpu_hpm_ev(hpmcnt_event_xb_wait_c)          <= xbar_stall;
+      cpu_hpm_ev(hpmcnt_event_xb_para_c)          <= xbar_para;
+
+
+      -- Tightly-Coupled Memories (TCM) -------------------------------------------------------
+      -- -----------------------------------------------------------------------------------------
+      neorv32_tcm_inst_true:
+      if (MEM_INT_ITCM_EN or MEM_INT_DTCM_EN) and (i = 0) generate
+        neorv32_tcm_inst: entity neorv32.neorv32_tcm
+        generic map (
+          ITCM_EN   => MEM_INT_ITCM_EN,
+          ITCM_SIZE => itcm_size_c,
+          DTCM_EN   => MEM_INT_DTCM_EN,
+          DTCM_SIZE => dtcm_size_c
+        )
+        port map (
+          clk_i       => clk_cpu,
+          rstn_i      => rstn_sys,
+          cpu_i_req_i => cpu_i_req,
+          cpu_i_rsp_o => cpu_i_rsp,
+          cpu_d_req_i => cpu_d_req,
+          cpu_d_rsp_o => cpu_d_rsp,
+          bus_i_req_o => tcm_i_req,
+          bus_i_rsp_i => tcm_i_rsp,
+          bus_d_req_o => tcm_d_req,
+          bus_d_rsp_i => tcm_d_rsp
+        );
+      end generate;
+
+      neorv32_tcm_inst_false:
+      if not ((MEM_INT_ITCM_EN or MEM_INT_DTCM_EN) and (i = 0)) generate
+        tcm_i_req <= cpu_i_req;
+        cpu_i_rsp <= tcm_i_rsp;
+        tcm_d_req <= cpu_d_req;
+        cpu_d_rsp <= tcm_d_rsp;
+      end generate;
+
+
+      -- CPU Instruction Cache ----------------------------------------------------------------
+      -- -----------------------------------------------------------------------------------------
+      neorv32_icache_inst_true:
+      if ICACHE_EN generate
+        neorv32_icache_inst: entity neorv32.neorv32_icache
+        generic map (
+          ICACHE_NUM_BLOCKS  => ICACHE_NUM_BLOCKS,
+          ICACHE_BLOCK_SIZE  => ICACHE_BLOCK_SIZE,
+          ICACHE_NUM_SETS    => ICACHE_ASSOCIATIVITY,
+          ICACHE_PREFETCH_EN => ICACHE_PREFETCH_EN,
+          ICACHE_UC_PBEGIN   => uncached_begin_c(31 downto 28)
+        )
+        port map (
+          clk_i      => clk_cpu,
+          rstn_i     => rstn_sys,
+          cpu_req_i  => tcm_i_req,
+          cpu_rsp_o  => tcm_i_rsp,
+          bus_req_o  => icache_req(i),
+          bus_rsp_i  => icache_rsp(i),
+          pf_issue_o => icache_pf_issue,
+          pf_hit_o   => icache_pf_hit,
+          hit_o      => icache_hit,
+          miss_o     => icache_miss
+        );
+      end generate;
+
+      neorv32_icache_inst_false:
+      if not ICACHE_EN generate
+        icache_req(i)   <= tcm_i_req;
+        tcm_i_rsp       <= icache_rsp(i);
+        icache_pf_issue <= '0';
+        icache_pf_hit   <= '0';
+        icache_hit      <= '0';
+        icache_miss     <= '0';
+      end generate;
+
+
+      -- CPU Data Cache -----------------------------------------------------------------------
+      -- -----------------------------------------------------------------------------------------
+      neorv32_dcache_inst_true:
+      if DCACHE_EN generate
+        neorv32_dcache_inst: entity neorv32.neorv32_dcache
+        generic map (
+          DCACHE_NUM_BLOCKS   => DCACHE_NUM_BLOCKS,
+          DCACHE_BLOCK_SIZE   => DCACHE_BLOCK_SIZE,
+          DCACHE_NUM_SETS     => DCACHE_ASSOCIATIVITY,
+          DCACHE_WRITE_POLICY => DCACHE_WRITE_POLICY,
+          DCACHE_UC_PBEGIN    => uncached_begin_c(31 downto 28)
+        )
+        port map (
+          clk_i     => clk_cpu,
+          rstn_i    => rstn_sys,
+          cpu_req_i => tcm_d_req,
+          cpu_rsp_o => tcm_d_rsp,
+          bus_req_o => dcache_req(i),
+          bus_rsp_i => dcache_rsp(i),
+          hit_o     => dcache_hit,
+          miss_o    => dcache_miss
+        );
+      end generate;
+
+      neorv32_dcache_inst_false:
+      if not DCACHE_EN generate
+        dcache_req(i) <= tcm_d_req;
+        tcm_d_rsp     <= dcache_rsp(i);
+        dcache_hit    <= '0';
+        dcache_miss   <= '0';
+      end generate;
+
+
+      -- Hart Bus Switch ----------------------------------------------------------------------
+      -- -----------------------------------------------------------------------------------------
+      neorv32_core_bus_switch_true:
+      if not xbar_en_c generate
+        neorv32_core_bus_switch_inst: entity neorv32.neorv32_bus_switch
+        generic map (
+          PORT_A_READ_ONLY => false,
+          PORT_B_READ_ONLY => true, -- i-fetch is read-only
+          ROUND_ROBIN_EN   => false
+        )
+        port map (
+          clk_i   => clk_cpu,
+          rstn_i  => rstn_sys,
+          a_req_i => dcache_req(i), -- prioritized
+          a_rsp_o => dcache_rsp(i),
+          b_req_i => icache_req(i),
+          b_rsp_o => icache_rsp(i),
+          x_req_o => hart_req(i),
+          x_rsp_i => hart_rsp(i),
+          stall_o => hart_bus_stall,
+          sel_o   => open
+        );
+      end generate;
+
+      -- the crossbar provides a dedicated host port for instruction fetch (icache_rsp is driven by the crossbar) --
+      neorv32_core_bus_switch_false:
+      if xbar_en_c generate
+        hart_req(i)    <= dcache_req(i);
+        dcache_rsp(i)  <= hart_rsp(i);
+        hart_bus_stall <= '0';
+      end generate;
+
+    end generate; -- /hart_complex
+
+    -- summarized status: clock gating requires all harts to sleep; the OCD controls hart 0 only --
+    cpu_sleep <= and_reduce_f(hart_sleep);
+    cpu_debug <= hart_debug(0);
 
     -- fast interrupt requests (FIRQs) --
     cpu_firq(00) <= firq.wdt; -- highest priority
@@ -588,79 +854,38 @@ begin
     cpu_firq(15) <= firq.trng; -- lowest priority
 
 
-    -- CPU Instruction Cache ------------------------------------------------------------------
+    -- Core Cluster Bus Switch ----------------------------------------------------------------
     -- -------------------------------------------------------------------------------------------
-    neorv32_icache_inst_true:
-    if ICACHE_EN generate
-      neorv32_icache_inst: entity neorv32.neorv32_icache
+    neorv32_cluster_bus_switch_true:
+    if DUAL_CORE_EN generate
+      neorv32_cluster_bus_switch_inst: entity neorv32.neorv32_bus_switch
       generic map (
-        ICACHE_NUM_BLOCKS => ICACHE_NUM_BLOCKS,
-        ICACHE_BLOCK_SIZE => ICACHE_BLOCK_SIZE,
-        ICACHE_NUM_SETS   => ICACHE_ASSOCIATIVITY,
-        ICACHE_UC_PBEGIN  => uncached_begin_c(31 downto 28)
+        PORT_A_READ_ONLY => false,
+        PORT_B_READ_ONLY => false,
+        ROUND_ROBIN_EN   => true -- harts share the bus fairly
       )
       port map (
-        clk_i     => clk_cpu,
-        rstn_i    => rstn_sys,
-        cpu_req_i => cpu_i_req,
-        cpu_rsp_o => cpu_i_rsp,
-        bus_req_o => icache_req,
-        bus_rsp_i => icache_rsp
+        clk_i   => clk_cpu,
+        rstn_i  => rstn_sys,
+        a_req_i => hart_req(0),
+        a_rsp_o => hart_rsp(0),
+        b_req_i => hart_req(1),
+        b_rsp_o => hart_rsp(1),
+        x_req_o => core_req,
+        x_rsp_i => core_rsp,
+        stall_o => cluster_bus_stall,
+        sel_o   => core_sel -- hart index for the reservation set
       );
     end generate;
 
-    neorv32_icache_inst_false:
-    if not ICACHE_EN generate
-      icache_req <= cpu_i_req;
-      cpu_i_rsp  <= icache_rsp;
+    neorv32_cluster_bus_switch_false:
+    if not DUAL_CORE_EN generate
+      core_req          <= hart_req(0);
+      hart_rsp(0)       <= core_rsp;
+      cluster_bus_stall <= '0';
+      core_sel          <= '0';
     end generate;
 
-
-    -- CPU Data Cache -------------------------------------------------------------------------
-    -- -------------------------------------------------------------------------------------------
-    neorv32_dcache_inst_true:
-    if DCACHE_EN generate
-      neorv32_dcache_inst: entity neorv32.neorv32_dcache
-      generic map (
-        DCACHE_NUM_BLOCKS => DCACHE_NUM_BLOCKS,
-        DCACHE_BLOCK_SIZE => DCACHE_BLOCK_SIZE,
-        DCACHE_UC_PBEGIN  => uncached_begin_c(31 downto 28)
-      )
-      port map (
-        clk_i     => clk_cpu,
-        rstn_i    => rstn_sys,
-        cpu_req_i => cpu_d_req,
-        cpu_rsp_o => cpu_d_rsp,
-        bus_req_o => dcache_req,
-        bus_rsp_i => dcache_rsp
-      );
-    end generate;
-
-    neorv32_dcache_inst_false:
-    if not DCACHE_EN generate
-      dcache_req <= cpu_d_req;
-      cpu_d_rsp  <= dcache_rsp;
-    end generate;
-
-
-    -- Core Complex Bus Switch ----------------------------------------------------------------
-    -- -------------------------------------------------------------------------------------------
-    neorv32_core_bus_switch_inst: entity neorv32.neorv32_bus_switch
-    generic map (
-      PORT_A_READ_ONLY => false,
-      PORT_B_READ_ONLY => true -- i-fetch is read-only
-    )
-    port map (
-      clk_i   => clk_cpu,
-      rstn_i  => rstn_sys,
-      a_req_i => dcache_req, -- prioritized
-      a_rsp_o => dcache_rsp,
-      b_req_i => icache_req,
-      b_rsp_o => icache_rsp,
-      x_req_o => core_req,
-      x_rsp_i => core_rsp
-    );
-
   end generate; -- /core_complex
 
 
@@ -673,6 +898,9 @@ begin
     -- DMA Controller -------------------------------------------------------------------------
     -- -------------------------------------------------------------------------------------------
     neorv32_dma_inst: entity neorv32.neorv32_dma
+    generic map (
+      NUM_CH => IO_DMA_NUM_CH
+    )
     port map (
       clk_i     => clk_i,
       rstn_i    => rstn_sys,
@@ -681,36 +909,54 @@ begin
       dma_req_o => dma_req,
       dma_rsp_i => dma_rsp,
       firq_i    => cpu_firq,
-      irq_o     => firq.dma
+      irq_o     => firq.dma,
+      busy_o    => dma_busy
     );
 
 
     -- DMA Bus Switch -------------------------------------------------------------------------
     -- -------------------------------------------------------------------------------------------
-    neorv32_dma_bus_switch_inst: entity neorv32.neorv32_bus_switch
-    generic map (
-      PORT_A_READ_ONLY => false,
-      PORT_B_READ_ONLY => false
-    )
-    port map (
-      clk_i   => clk_i,
-      rstn_i  => rstn_sys,
-      a_req_i => core_req, -- prioritized
-      a_rsp_o => core_rsp,
-      b_req_i => dma_req,
-      b_rsp_o => dma_rsp,
-      x_req_o => main_req,
-      x_rsp_i => main_rsp
-    );
+    neorv32_dma_bus_switch_true:
+    if not xbar_en_c generate
+      neorv32_dma_bus_switch_inst: entity neorv32.neorv32_bus_switch
+      generic map (
+        PORT_A_READ_ONLY => false,
+        PORT_B_READ_ONLY => false,
+        ROUND_ROBIN_EN   => false
+      )
+      port map (
+        clk_i   => clk_i,
+        rstn_i  => rstn_sys,
+        a_req_i => core_req, -- prioritized
+        a_rsp_o => core_rsp,
+        b_req_i => dma_req,
+        b_rsp_o => dma_rsp,
+        x_req_o => main_req,
+        x_rsp_i => main_rsp,
+        stall_o => dma_bus_stall,
+        sel_o   => open
+      );
+    end generate;
+
+    -- the crossbar provides a dedicated host port for the DMA (dma_rsp is driven by the crossbar) --
+    neorv32_dma_bus_switch_false:
+    if xbar_en_c generate
+      main_req      <= core_req;
+      core_rsp      <= main_rsp;
+      dma_bus_stall <= '0';
+    end generate;
 
   end generate; -- /neorv32_dma_complex_true
 
   neorv32_dma_complex_false:
   if not IO_DMA_EN generate
     iodev_rsp(IODEV_DMA) <= rsp_terminate_c;
+    dma_req              <= req_terminate_c;
     main_req             <= core_req;
     core_rsp             <= main_rsp;
     firq.dma             <= '0';
+    dma_busy             <= '0';
+    dma_bus_stall        <= '0';
   end generate;
 
 
@@ -721,19 +967,25 @@ begin
   if CPU_EXTENSION_RISCV_A generate
     neorv32_bus_reservation_set_inst: entity neorv32.neorv32_bus_reservation_set
     generic map (
-      GRANULARITY => AMO_RVS_GRANULARITY
+      GRANULARITY => AMO_RVS_GRANULARITY,
+      NUM_HARTS   => num_cores_c
     )
     port map (
       clk_i       => clk_i,
       rstn_i      => rstn_sys,
-      rvs_addr_o  => open, -- yet unused
+      rvs_addr_o  => rvs_addr,
       rvs_valid_o => open, -- yet unused
-      rvs_clear_i => '0',  -- yet unused
+      rvs_clear_i => rvs_clear,
+      hart_i      => core_sel,
       core_req_i  => main_req,
       core_rsp_o  => main_rsp,
       sys_req_o   => main2_req,
       sys_rsp_i   => main2_rsp
     );
+
+    -- DMA write accesses bypass the reservation set if the crossbar is implemented --
+    rvs_clear <= '1' when xbar_en_c and (dma_req.stb = '1') and (dma_req.rw = '1') and
+                          (dma_req.addr(31 downto index_size_f(AMO_RVS_GRANULARITY)) = rvs_addr(31 downto index_size_f(AMO_RVS_GRANULARITY))) else '0';
   end generate;
 
   neorv32_bus_reservation_set_false:
@@ -743,56 +995,146 @@ begin
   end generate;
 
 
+  -- **************************************************************************************************************************
+  -- Atomic Memory Operations Controller (for atomic read-modify-write AMO*.W memory accesses)
+  -- **************************************************************************************************************************
+  neorv32_bus_amo_ctrl_true:
+  if CPU_EXTENSION_RISCV_A generate
+    neorv32_bus_amo_ctrl_inst: entity neorv32.neorv32_bus_amo_ctrl
+    port map (
+      clk_i      => clk_i,
+      rstn_i     => rstn_sys,
+      core_req_i => main2_req,
+      core_rsp_o => main2_rsp,
+      sys_req_o  => main3_req,
+      sys_rsp_i  => main3_rsp
+    );
+  end generate;
+
+  neorv32_bus_amo_ctrl_false:
+  if not CPU_EXTENSION_RISCV_A generate
+    main3_req <= main2_req;
+    main2_rsp <= main3_rsp;
+  end generate;
+
+
   -- **************************************************************************************************************************
   -- Address Region Gateway
   -- **************************************************************************************************************************
-  neorv32_bus_gateway_inst: entity neorv32.neorv32_bus_gateway
-  generic map (
-    TIMEOUT     => bus_timeout_c,
-    -- IMEM port --
-    IMEM_ENABLE => MEM_INT_IMEM_EN,
-    IMEM_BASE   => mem_imem_base_c,
-    IMEM_SIZE   => imem_size_c,
-    -- DMEM port --
-    DMEM_ENABLE => MEM_INT_DMEM_EN,
-    DMEM_BASE   => mem_dmem_base_c,
-    DMEM_SIZE   => dmem_size_c,
-    -- XIP port --
-    XIP_ENABLE  => XIP_EN,
-    XIP_BASE    => mem_xip_base_c,
-    XIP_SIZE    => mem_xip_size_c,
-    -- BOOT ROM port --
-    BOOT_ENABLE => INT_BOOTLOADER_EN,
-    BOOT_BASE   => mem_boot_base_c,
-    BOOT_SIZE   => mem_boot_size_c,
-    -- IO port --
-    IO_ENABLE   => true, -- always enabled (mandatory core module)
-    IO_BASE     => mem_io_base_c,
-    IO_SIZE     => mem_io_size_c,
-    -- EXT port --
-    EXT_ENABLE  => MEM_EXT_EN
-  )
-  port map (
-    -- global control --
-    clk_i      => clk_i,
-    rstn_i     => rstn_sys,
-    -- host port --
-    main_req_i => main2_req,
-    main_rsp_o => main2_rsp,
-    -- section ports --
-    imem_req_o => imem_req,
-    imem_rsp_i => imem_rsp,
-    dmem_req_o => dmem_req,
-    dmem_rsp_i => dmem_rsp,
-    xip_req_o  => xip_req,
-    xip_rsp_i  => xip_rsp,
-    boot_req_o => boot_req,
-    boot_rsp_i => boot_rsp,
-    io_req_o   => io_req,
-    io_rsp_i   => io_rsp,
-    ext_req_o  => xbus_req,
-    ext_rsp_i  => xbus_rsp
-  );
+  neorv32_bus_gateway_true:
+  if not xbar_en_c generate
+    neorv32_bus_gateway_inst: entity neorv32.neorv32_bus_gateway
+    generic map (
+      TIMEOUT     => bus_timeout_c,
+      -- IMEM port --
+      IMEM_ENABLE => MEM_INT_IMEM_EN,
+      IMEM_BASE   => mem_imem_base_c,
+      IMEM_SIZE   => imem_size_c,
+      -- DMEM port --
+      DMEM_ENABLE => MEM_INT_DMEM_EN,
+      DMEM_BASE   => mem_dmem_base_c,
+      DMEM_SIZE   => dmem_size_c,
+      -- XIP port --
+      XIP_ENABLE  => XIP_EN,
+      XIP_BASE    => mem_xip_base_c,
+      XIP_SIZE    => mem_xip_size_c,
+      -- BOOT ROM port --
+      BOOT_ENABLE => INT_BOOTLOADER_EN,
+      BOOT_BASE   => mem_boot_base_c,
+      BOOT_SIZE   => mem_boot_size_c,
+      -- IO port --
+      IO_ENABLE   => true, -- always enabled (mandatory core module)
+      IO_BASE     => mem_io_base_c,
+      IO_SIZE     => mem_io_size_c,
+      -- EXT port --
+      EXT_ENABLE  => MEM_EXT_EN
+    )
+    port map (
+      -- global control --
+      clk_i      => clk_i,
+      rstn_i     => rstn_sys,
+      -- host port --
+      main_req_i => main3_req,
+      main_rsp_o => main3_rsp,
+      -- section ports --
+      imem_req_o => imem_req,
+      imem_rsp_i => imem_rsp,
+      dmem_req_o => dmem_req,
+      dmem_rsp_i => dmem_rsp,
+      xip_req_o  => xip_req,
+      xip_rsp_i  => xip_rsp,
+      boot_req_o => boot_req,
+      boot_rsp_i => boot_rsp,
+      io_req_o   => io_req,
+      io_rsp_i   => io_rsp,
+      ext_req_o  => xbus_req,
+      ext_rsp_i  => xbus_rsp
+    );
+    xbar_stall <= '0';
+    xbar_para  <= '0';
+  end generate;
+
+
+  -- **************************************************************************************************************************
+  -- Multi-Layer Crossbar (replaces the bus switches and the address region gateway)
+  -- **************************************************************************************************************************
+  neorv32_bus_crossbar_true:
+  if xbar_en_c generate
+    neorv32_bus_crossbar_inst: entity neorv32.neorv32_bus_crossbar
+    generic map (
+      TIMEOUT     => bus_timeout_c,
+      -- IMEM port --
+      IMEM_ENABLE => MEM_INT_IMEM_EN,
+      IMEM_BASE   => mem_imem_base_c,
+      IMEM_SIZE   => imem_size_c,
+      -- DMEM port --
+      DMEM_ENABLE => MEM_INT_DMEM_EN,
+      DMEM_BASE   => mem_dmem_base_c,
+      DMEM_SIZE   => dmem_size_c,
+      -- XIP port --
+      XIP_ENABLE  => XIP_EN,
+      XIP_BASE    => mem_xip_base_c,
+      XIP_SIZE    => mem_xip_size_c,
+      -- BOOT ROM port --
+      BOOT_ENABLE => INT_BOOTLOADER_EN,
+      BOOT_BASE   => mem_boot_base_c,
+      BOOT_SIZE   => mem_boot_size_c,
+      -- IO port --
+      IO_ENABLE   => true, -- always enabled (mandatory core module)
+      IO_BASE     => mem_io_base_c,
+      IO_SIZE     => mem_io_size_c,
+      -- EXT port --
+      EXT_ENABLE  => MEM_EXT_EN
+    )
+    port map (
+      -- global control --
+      clk_i      => clk_i,
+      rstn_i     => rstn_sys,
+      -- host ports --
+      a_req_i    => main3_req, -- CPU data (via reservation set and AMO controller)
+      a_rsp_o    => main3_rsp,
+      b_req_i    => icache_req(0), -- CPU instruction fetch
+      b_rsp_o    => icache_rsp(0),
+      c_req_i    => dma_req, -- DMA
+      c_rsp_o    => dma_rsp,
+      -- section ports --
+      imem_req_o => imem_req,
+      imem_rsp_i => imem_rsp,
+      dmem_req_o => dmem_req,
+      dmem_rsp_i => dmem_rsp,
+      xip_req_o  => xip_req,
+      xip_rsp_i  => xip_rsp,
+      boot_req_o => boot_req,
+      boot_rsp_i => boot_rsp,
+      io_req_o   => io_req,
+      io_rsp_i   => io_rsp,
+      ext_req_o  => xbus_req,
+      ext_rsp_i  => xbus_rsp,
+      -- status --
+      stall_o    => xbar_stall,
+      para_o     => xbar_para
+    );
+  end generate;
 
 
   -- **************************************************************************************************************************
@@ -877,18 +1219,20 @@ begin
       )
       port map (
         -- global control --
-        clk_i       => clk_i,
-        rstn_i      => rstn_sys,
-        bus_req_i   => iodev_req(IODEV_XIP),
-        bus_rsp_o   => iodev_rsp(IODEV_XIP),
-        xip_req_i   => xip_req,
-        xip_rsp_o   => xip_rsp,
-        clkgen_en_o => cg_en.xip,
-        clkgen_i    => clk_gen,
-        spi_csn_o   => xip_csn_o,
-        spi_clk_o   => xip_clk_o,
-        spi_dat_i   => xip_dat_i,
-        spi_dat_o   => xip_dat_o
+        clk_i        => clk_i,
+        rstn_i       => rstn_sys,
+        bus_req_i    => iodev_req(IODEV_XIP),
+        bus_rsp_o    => iodev_rsp(IODEV_XIP),
+        xip_req_i    => xip_req,
+        xip_rsp_o    => xip_rsp,
+        clkgen_en_o  => cg_en.xip,
+        clkgen_i     => clk_gen,
+        spi_csn_o    => xip_csn_o,
+        spi_clk_o    => xip_clk_o,
+        spi_dat_i    => xip_dat_i,
+        spi_dat_o    => xip_dat_o,
+        spi_dat_oe_o => xip_dat_oe_o,
+        miss_o       => xip_miss
       );
     end generate;
 
@@ -899,7 +1243,9 @@ begin
       cg_en.xip            <= '0';
       xip_csn_o            <= '1';
       xip_clk_o            <= '0';
-      xip_dat_o            <= '0';
+      xip_dat_o            <= (others => '0');
+      xip_dat_oe_o         <= (others => '0');
+      xip_miss             <= '0';
     end generate;
 
 
@@ -913,7 +1259,8 @@ begin
         PIPE_MODE   => MEM_EXT_PIPE_MODE,
         BIG_ENDIAN  => MEM_EXT_BIG_ENDIAN,
         ASYNC_RX    => MEM_EXT_ASYNC_RX,
-        ASYNC_TX    => MEM_EXT_ASYNC_TX
+        ASYNC_TX    => MEM_EXT_ASYNC_TX,
+        BURST_EN    => MEM_EXT_BURST_EN
       )
       port map (
         clk_i     => clk_i,
@@ -922,6 +1269,8 @@ begin
         bus_rsp_o => xbus_rsp,
         --
         wb_tag_o  => wb_tag_o,
+        wb_cti_o  => wb_cti_o,
+        wb_bte_o  => wb_bte_o,
         wb_adr_o  => wb_adr_o,
         wb_dat_i  => wb_dat_i,
         wb_dat_o  => wb_dat_o,
@@ -944,6 +1293,8 @@ begin
       wb_stb_o <= '0';
       wb_cyc_o <= '0';
       wb_tag_o <= (others => '0');
+      wb_cti_o <= (others => '0');
+      wb_bte_o <= (others => '0');
     end generate;
 
   end generate; -- /memory_system
@@ -1132,13 +1483,17 @@ begin
     neorv32_mtime_inst_true:
     if IO_MTIME_EN generate
       neorv32_mtime_inst: entity neorv32.neorv32_mtime
+      generic map (
+        NUM_HARTS => num_cores_c
+      )
       port map (
         clk_i     => clk_i,
         rstn_i    => rstn_sys,
         bus_req_i => iodev_req(IODEV_MTIME),
         bus_rsp_o => iodev_rsp(IODEV_MTIME),
         time_o    => mtime_time,
-        irq_o     => mtime_irq
+        irq_o     => mtime_irq,
+        msi_o     => mtime_msi
       );
 
       -- synchronize system time output LO --
@@ -1159,7 +1514,8 @@ begin
     neorv32_mtime_inst_false:
     if not IO_MTIME_EN generate
       iodev_rsp(IODEV_MTIME) <= rsp_terminate_c;
-      mtime_irq              <= mtime_irq_i;
+      mtime_irq              <= '0' & mtime_irq_i;
+      mtime_msi              <= (others => '0');
       mtime_time_o           <= (others => '0');
     end generate;
 
@@ -1535,17 +1891,27 @@ begin
       -- Internal Data memory --
       MEM_INT_DMEM_EN      => MEM_INT_DMEM_EN,
       MEM_INT_DMEM_SIZE    => dmem_size_c,
+      MEM_INT_ITCM_EN      => MEM_INT_ITCM_EN,
+      MEM_INT_ITCM_SIZE    => itcm_size_c,
+      MEM_INT_DTCM_EN      => MEM_INT_DTCM_EN,
+      MEM_INT_DTCM_SIZE    => dtcm_size_c,
       -- Reservation Set Granularity --
       AMO_RVS_GRANULARITY  => AMO_RVS_GRANULARITY,
+      -- Bus interconnect --
+      DUAL_CORE_EN         => DUAL_CORE_EN,
+      BUS_XBAR_EN          => xbar_en_c,
       -- Instruction cache --
       ICACHE_EN            => ICACHE_EN,
       ICACHE_NUM_BLOCKS    => ICACHE_NUM_BLOCKS,
       ICACHE_BLOCK_SIZE    => ICACHE_BLOCK_SIZE,
       ICACHE_ASSOCIATIVITY => ICACHE_ASSOCIATIVITY,
+      ICACHE_PREFETCH_EN   => ICACHE_PREFETCH_EN,
       -- Data cache --
       DCACHE_EN            => DCACHE_EN,
       DCACHE_NUM_BLOCKS    => DCACHE_NUM_BLOCKS,
       DCACHE_BLOCK_SIZE    => DCACHE_BLOCK_SIZE,
+      DCACHE_ASSOCIATIVITY => DCACHE_ASSOCIATIVITY,
+      DCACHE_WRITE_POLICY  => DCACHE_WRITE_POLICY,
       -- External memory interface --
       MEM_EXT_EN           => MEM_EXT_EN,
       MEM_EXT_BIG_ENDIAN   => MEM_EXT_BIG_ENDIAN,
@@ -7,6 +7,11 @@
 -- # The Wishbone gateway registers all outgoing signals. These signals will remain stable (gated) #
 -- # if there is no active Wishbone access. By default, also the incoming signals are registered,  #
 -- # too. this can be disabled by setting ASYNC_RX = false.                                        #
+-- #                                                                                               #
+-- # If BURST_EN = true, accesses flagged as burst (cache block transfers, DMA) are issued as      #
+-- # registered-feedback incrementing bursts (CTI/BTE) that keep CYC asserted between the beats.   #
+-- # The hosts guarantee that a beat flagged as burst is always followed by the next sequential    #
+-- # beat, so the last beat of a burst is always marked as end-of-burst (CTI = 111).               #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -52,7 +57,8 @@ entity neorv32_wishbone is
     PIPE_MODE   : boolean; -- protocol: false=classic/standard wishbone mode, true=pipelined wishbone mode
     BIG_ENDIAN  : boolean; -- byte order: true=big-endian, false=little-endian
     ASYNC_RX    : boolean; -- use register buffer for RX data when false
-    ASYNC_TX    : boolean  -- use register buffer for TX data when false
+    ASYNC_TX    : boolean; -- use register buffer for TX data when false
+    BURST_EN    : boolean  -- enable registered-feedback incrementing bursts (requires ASYNC_TX = false)
   );
   port (
     clk_i     : in  std_ulogic; -- global clock line
@@ -61,6 +67,8 @@ entity neorv32_wishbone is
     bus_rsp_o : out bus_rsp_t;  -- bus response
     --
     wb_tag_o  : out std_ulogic_vector(02 downto 0); -- request tag
+    wb_cti_o  : out std_ulogic_vector(02 downto 0); -- cycle type identifier
+    wb_bte_o  : out std_ulogic_vector(01 downto 0); -- burst type extension
     wb_adr_o  : out std_ulogic_vector(31 downto 0); -- address
     wb_dat_i  : in  std_ulogic_vector(31 downto 0); -- read data
     wb_dat_o  : out std_ulogic_vector(31 downto 0); -- write data
@@ -77,6 +85,7 @@ architecture neorv32_wishbone_rtl of neorv32_wishbone is
 
   -- auto-configuration --
   constant async_rx_c : boolean := ASYNC_RX and PIPE_MODE; -- classic mode requires a sync RX path for the inter-cycle pause
+  constant burst_en_c : boolean := BURST_EN and (not ASYNC_TX); -- bursts require a registered TX path
 
   -- timeout enable --
   constant timeout_en_c : boolean := boolean(BUS_TIMEOUT /= 0); -- timeout enabled if BUS_TIMEOUT > 0
@@ -95,10 +104,16 @@ architecture neorv32_wishbone_rtl of neorv32_wishbone is
     timeout  : std_ulogic_vector(index_size_f(BUS_TIMEOUT) downto 0);
     src      : std_ulogic;
     priv     : std_ulogic;
+    burst    : std_ulogic; -- current beat is followed by another beat
+    bseq     : std_ulogic; -- current beat is part of an active burst
+    hold     : std_ulogic; -- keep CYC asserted while waiting for the next burst beat
+    pend     : std_ulogic; -- pending request after closing the cycle
   end record;
   signal ctrl    : ctrl_t;
   signal stb_int : std_ulogic;
+  signal act_int : std_ulogic;
   signal cyc_int : std_ulogic;
+  signal seq     : std_ulogic;
   signal rdata   : std_ulogic_vector(31 downto 0);
 
   -- endianness conversion --
@@ -120,13 +135,18 @@ begin
     cond_sel_string_f(boolean(BUS_TIMEOUT /= 0), "auto-timeout, ", "NO auto-timeout, ") &
     cond_sel_string_f(BIG_ENDIAN, "BIG", "LITTLE") & "-endian byte order, " &
     cond_sel_string_f(async_rx_c, "ASYNC ", "registered ") & "RX, " &
-    cond_sel_string_f(ASYNC_TX, "ASYNC ", "registered ") & "TX"
+    cond_sel_string_f(ASYNC_TX, "ASYNC ", "registered ") & "TX" &
+    cond_sel_string_f(burst_en_c, ", incrementing bursts", "")
     severity note;
 
   -- async RX override warning --
   assert not ((ASYNC_RX = true) and (async_rx_c = false)) report
     "[NEORV32] Ext. Bus Interface - Non-pipelined/standard mode requires sync RX (auto-disabling async RX)." severity warning;
 
+  -- burst override warning --
+  assert not ((BURST_EN = true) and (burst_en_c = false)) report
+    "[NEORV32] Ext. Bus Interface - Burst mode requires sync TX (auto-disabling bursts)." severity warning;
+
   -- zero timeout warning --
   assert not (BUS_TIMEOUT = 0) report
     "[NEORV32] Ext. Bus Interface - NO auto-timeout defined; can cause permanent CPU stall!" severity warning;
@@ -149,6 +169,10 @@ begin
       ctrl.err      <= '0';
       ctrl.src      <= '0';
       ctrl.priv     <= '0';
+      ctrl.burst    <= '0';
+      ctrl.bseq     <= '0';
+      ctrl.hold     <= '0';
+      ctrl.pend     <= '0';
     elsif rising_edge(clk_i) then
       -- defaults --
       ctrl.state_ff <= ctrl.state;
@@ -160,15 +184,25 @@ begin
       -- state machine --
       if (ctrl.state = '0') then -- IDLE, waiting for host request
         -- ------------------------------------------------------------
-        if (bus_req_i.stb = '1') then -- request
-          -- buffer (and gate) all outgoing signals --
-          ctrl.we    <= bus_req_i.rw;
-          ctrl.adr   <= bus_req_i.addr;
-          ctrl.src   <= bus_req_i.src;
-          ctrl.priv  <= bus_req_i.priv;
-          ctrl.wdat  <= end_wdata;
-          ctrl.sel   <= end_byteen;
-          ctrl.state <= '1';
+        if (bus_req_i.stb = '1') or (ctrl.pend = '1') then -- (buffered) request
+          ctrl.pend <= '0';
+          if (ctrl.hold = '1') and (seq = '0') then -- not the next beat of the active burst; never issued by the processor-internal hosts
+            ctrl.hold <= '0'; -- close the cycle first
+            ctrl.bseq <= '0';
+            ctrl.pend <= '1'; -- start the request afterwards; request signals remain stable until the transfer is completed
+          else
+            -- buffer (and gate) all outgoing signals --
+            ctrl.we    <= bus_req_i.rw;
+            ctrl.adr   <= bus_req_i.addr;
+            ctrl.src   <= bus_req_i.src;
+            ctrl.priv  <= bus_req_i.priv;
+            ctrl.wdat  <= end_wdata;
+            ctrl.sel   <= end_byteen;
+            ctrl.burst <= bus_req_i.burst and bool_to_ulogic_f(burst_en_c);
+            ctrl.bseq  <= ctrl.hold; -- next beat of the active burst?
+            ctrl.hold  <= '0';
+            ctrl.state <= '1';
+          end if;
         end if;
 
       else -- BUSY, transfer in progress
@@ -179,9 +213,12 @@ begin
         if (wb_ack_i = '1') then -- normal bus termination
           ctrl.ack   <= '1';
           ctrl.state <= '0';
+          ctrl.hold  <= ctrl.burst; -- keep cycle alive if another beat will follow
+          ctrl.bseq  <= ctrl.burst;
         elsif (wb_err_i = '1') or ((timeout_en_c = true) and (or_reduce_f(ctrl.timeout) = '0')) then -- bus error or timeout
           ctrl.err   <= '1';
           ctrl.state <= '0';
+          ctrl.bseq  <= '0'; -- abort burst
         end if;
         -- timeout counter --
         if (timeout_en_c = true) then
@@ -195,6 +232,10 @@ begin
   end_wdata  <= bswap32_f(bus_req_i.data) when (BIG_ENDIAN = true) else bus_req_i.data;
   end_byteen <= bit_rev_f(bus_req_i.ben)  when (BIG_ENDIAN = true) else bus_req_i.ben;
 
+  -- next beat of active burst: same direction and next sequential word address --
+  seq <= '1' when (bus_req_i.rw = ctrl.we) and
+                  (bus_req_i.addr(31 downto 2) = std_ulogic_vector(unsigned(ctrl.adr(31 downto 2)) + 1)) else '0';
+
   -- host access --
   ack_gated   <= wb_ack_i when (ctrl.state = '1') else '0'; -- CPU ACK gate for "async" RX
   err_gated   <= wb_err_i when (ctrl.state = '1') else '0'; -- CPU ERR gate for "async" RX
@@ -211,13 +252,17 @@ begin
   wb_tag_o(2) <= bus_req_i.src when (ASYNC_TX = true) else ctrl.src; -- 0 = data access, 1 = instruction access
 
   stb_int <=  bus_req_i.stb                when (ASYNC_TX = true) else (ctrl.state and (not ctrl.state_ff));
-  cyc_int <= (bus_req_i.stb or ctrl.state) when (ASYNC_TX = true) else  ctrl.state;
+  act_int <= (bus_req_i.stb or ctrl.state) when (ASYNC_TX = true) else  ctrl.state;
+  cyc_int <= act_int or ctrl.hold;
+
+  wb_cti_o <= "010" when (ctrl.burst = '1') else "111" when (ctrl.bseq = '1') else "000"; -- incrementing burst / end-of-burst / classic
+  wb_bte_o <= "00"; -- linear burst
 
   wb_adr_o <= bus_req_i.addr when (ASYNC_TX = true) else ctrl.adr;
   wb_dat_o <= bus_req_i.data when (ASYNC_TX = true) else ctrl.wdat;
   wb_we_o  <= bus_req_i.rw   when (ASYNC_TX = true) else ctrl.we;
   wb_sel_o <= end_byteen when (ASYNC_TX = true) else ctrl.sel;
-  wb_stb_o <= stb_int    when (PIPE_MODE = true) else cyc_int;
+  wb_stb_o <= stb_int    when (PIPE_MODE = true) else act_int;
   wb_cyc_o <= cyc_int;
 
 
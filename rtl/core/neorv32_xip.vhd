@@ -51,18 +51,20 @@ entity neorv32_xip is
     XIP_CACHE_BLOCK_SIZE : natural range 1 to 2**16 -- block size in bytes (min 4), has to be a power of 2
   );
   port (
-    clk_i       : in  std_ulogic; -- global clock line
-    rstn_i      : in  std_ulogic; -- global reset line, low-active
-    bus_req_i   : in  bus_req_t;  -- bus request
-    bus_rsp_o   : out bus_rsp_t;  -- bus response
-    xip_req_i   : in  bus_req_t;  -- XIP request
-    xip_rsp_o   : out bus_rsp_t;  -- XIP response
-    clkgen_en_o : out std_ulogic; -- enable clock generator
-    clkgen_i    : in  std_ulogic_vector(7 downto 0);
-    spi_csn_o   : out std_ulogic; -- chip-select, low-active
-    spi_clk_o   : out std_ulogic; -- serial clock
-    spi_dat_i   : in  std_ulogic; -- device data output
-    spi_dat_o   : out std_ulogic  -- controller data output
+    clk_i        : in  std_ulogic; -- global clock line
+    rstn_i       : in  std_ulogic; -- global reset line, low-active
+    bus_req_i    : in  bus_req_t;  -- bus request
+    bus_rsp_o    : out bus_rsp_t;  -- bus response
+    xip_req_i    : in  bus_req_t;  -- XIP request
+    xip_rsp_o    : out bus_rsp_t;  -- XIP response
+    clkgen_en_o  : out std_ulogic; -- enable clock generator
+    clkgen_i     : in  std_ulogic_vector(7 downto 0);
+    spi_csn_o    : out std_ulogic; -- chip-select, low-active
+    spi_clk_o    : out std_ulogic; -- serial clock
+    spi_dat_i    : in  std_ulogic_vector(3 downto 0); -- device data output (IO3..IO0)
+    spi_dat_o    : out std_ulogic_vector(3 downto 0); -- controller data output (IO3..IO0)
+    spi_dat_oe_o : out std_ulogic_vector(3 downto 0); -- controller data output enable (IO3..IO0)
+    miss_o       : out std_ulogic  -- XIP cache miss (HPM event)
   );
 end neorv32_xip;
 
@@ -88,20 +90,29 @@ architecture neorv32_xip_rtl of neorv32_xip is
   constant ctrl_cdiv1_c       : natural := 24; -- r/w: clock divider bit 1
   constant ctrl_cdiv2_c       : natural := 25; -- r/w: clock divider bit 2
   constant ctrl_cdiv3_c       : natural := 26; -- r/w: clock divider bit 3
+  constant ctrl_quad_c        : natural := 27; -- r/w: XIP quad I/O read mode (1-4-4) enable
   --
   constant ctrl_burst_en_c    : natural := 29; -- r/-: XIP burst mode enable (when cache is implemented)
   constant ctrl_phy_busy_c    : natural := 30; -- r/-: SPI PHY is busy when set
   constant ctrl_xip_busy_c    : natural := 31; -- r/-: XIP access in progress
   --
-  signal ctrl : std_ulogic_vector(26 downto 0);
+  signal ctrl : std_ulogic_vector(27 downto 0);
+
+  -- quad I/O control register --
+  constant qctrl_dummy0_c : natural :=  0; -- r/w: number of dummy clock cycles (0..15) - bit 0
+  constant qctrl_dummy3_c : natural :=  3; -- r/w: number of dummy clock cycles (0..15) - bit 3
+  constant qctrl_mode0_c  : natural :=  4; -- r/w: mode bits (sent after address) - bit 0
+  constant qctrl_mode7_c  : natural := 11; -- r/w: mode bits (sent after address) - bit 7
+  --
+  signal qctrl : std_ulogic_vector(11 downto 0);
 
   -- Direct SPI access registers --
   signal spi_data_lo : std_ulogic_vector(31 downto 0);
   signal spi_data_hi : std_ulogic_vector(31 downto 0); -- write-only!
   signal spi_trigger : std_ulogic; -- trigger direct SPI operation
 
-  -- XIP access address --
-  signal xip_addr : std_ulogic_vector(31 downto 0);
+  -- XIP access address (+ mode bits in quad mode) --
+  signal xip_addr : std_ulogic_vector(39 downto 0);
 
   -- SPI access fetch arbiter --
   type arbiter_state_t is (S_DIRECT, S_IDLE, S_CHECK, S_TRIG, S_BUSY, S_ERROR);
@@ -138,7 +149,8 @@ architecture neorv32_xip_rtl of neorv32_xip is
       cpu_req_i : in  bus_req_t;  -- request bus
       cpu_rsp_o : out bus_rsp_t;  -- response bus
       bus_req_o : out bus_req_t;  -- request bus
-      bus_rsp_i : in  bus_rsp_t   -- response bus
+      bus_rsp_i : in  bus_rsp_t;  -- response bus
+      miss_o    : out std_ulogic  -- cache miss (HPM event)
     );
   end component;
 
@@ -158,14 +170,17 @@ architecture neorv32_xip_rtl of neorv32_xip is
       op_final_i   : in  std_ulogic; -- end current transmission
       op_csen_i    : in  std_ulogic; -- actually enabled device for transmission
       op_busy_o    : out std_ulogic; -- transmission in progress when set
-      op_nbytes_i  : in  std_ulogic_vector(3 downto 0); -- actual number of bytes to transmit (1..9)
-      op_wdata_i   : in  std_ulogic_vector(71 downto 0); -- write data
+      op_quad_i    : in  std_ulogic; -- quad I/O transmission (1-4-4)
+      op_dummy_i   : in  std_ulogic_vector(3 downto 0); -- number of dummy cycles (quad I/O transmission only)
+      op_nbytes_i  : in  std_ulogic_vector(3 downto 0); -- actual number of bytes to transmit (1..10)
+      op_wdata_i   : in  std_ulogic_vector(79 downto 0); -- write data
       op_rdata_o   : out std_ulogic_vector(31 downto 0); -- read data
       -- SPI interface --
       spi_csn_o    : out std_ulogic;
       spi_clk_o    : out std_ulogic;
-      spi_dat_i    : in  std_ulogic;
-      spi_dat_o    : out std_ulogic
+      spi_dat_i    : in  std_ulogic_vector(3 downto 0);
+      spi_dat_o    : out std_ulogic_vector(3 downto 0);
+      spi_dat_oe_o : out std_ulogic_vector(3 downto 0)
     );
   end component;
 
@@ -174,7 +189,8 @@ architecture neorv32_xip_rtl of neorv32_xip is
     start : std_ulogic; -- trigger new transmission
     final : std_ulogic; -- stop current transmission
     busy  : std_ulogic; -- transmission in progress when set
-    wdata : std_ulogic_vector(71 downto 0); -- write data
+    quad  : std_ulogic; -- quad I/O transmission
+    wdata : std_ulogic_vector(79 downto 0); -- write data
     rdata : std_ulogic_vector(31 downto 0); -- read data
   end record;
   signal phy_if : phy_if_t;
@@ -190,6 +206,7 @@ begin
       bus_rsp_o.err  <= '0';
       bus_rsp_o.data <= (others => '0');
       ctrl           <= (others => '0');
+      qctrl          <= (others => '0');
       spi_data_lo    <= (others => '0');
       spi_data_hi    <= (others => '0');
       spi_trigger    <= '0';
@@ -219,6 +236,12 @@ begin
             ctrl(ctrl_spi_csen_c)                              <= bus_req_i.data(ctrl_spi_csen_c);
             ctrl(ctrl_highspeed_c)                             <= bus_req_i.data(ctrl_highspeed_c);
             ctrl(ctrl_cdiv3_c downto ctrl_cdiv0_c)             <= bus_req_i.data(ctrl_cdiv3_c downto ctrl_cdiv0_c);
+            ctrl(ctrl_quad_c)                                  <= bus_req_i.data(ctrl_quad_c);
+          end if;
+          -- quad I/O control register --
+          if (bus_req_i.addr(3 downto 2) = "01") then
+            qctrl(qctrl_dummy3_c downto qctrl_dummy0_c) <= bus_req_i.data(qctrl_dummy3_c downto qctrl_dummy0_c);
+            qctrl(qctrl_mode7_c downto qctrl_mode0_c)   <= bus_req_i.data(qctrl_mode7_c downto qctrl_mode0_c);
           end if;
           -- SPI direct data access register lo --
           if (bus_req_i.addr(3 downto 2) = "10") then
@@ -245,10 +268,14 @@ begin
               bus_rsp_o.data(ctrl_spi_csen_c)                              <= ctrl(ctrl_spi_csen_c);
               bus_rsp_o.data(ctrl_highspeed_c)                             <= ctrl(ctrl_highspeed_c);
               bus_rsp_o.data(ctrl_cdiv3_c downto ctrl_cdiv0_c)             <= ctrl(ctrl_cdiv3_c downto ctrl_cdiv0_c);
+              bus_rsp_o.data(ctrl_quad_c)                                  <= ctrl(ctrl_quad_c);
               --
               bus_rsp_o.data(ctrl_burst_en_c) <= bool_to_ulogic_f(XIP_CACHE_EN);
               bus_rsp_o.data(ctrl_phy_busy_c) <= phy_if.busy;
               bus_rsp_o.data(ctrl_xip_busy_c) <= arbiter.busy;
+            when "01" => -- 'xip_qctrl_addr_c' - quad I/O control register
+              bus_rsp_o.data(qctrl_dummy3_c downto qctrl_dummy0_c) <= qctrl(qctrl_dummy3_c downto qctrl_dummy0_c);
+              bus_rsp_o.data(qctrl_mode7_c downto qctrl_mode0_c)   <= qctrl(qctrl_mode7_c downto qctrl_mode0_c);
             when "10" => -- 'xip_data_lo_addr_c' - SPI direct data access register lo
               bus_rsp_o.data <= phy_if.rdata;
             when others => -- unavailable (not implemented or write-only)
@@ -277,7 +304,8 @@ begin
       cpu_req_i => xip_req_i,
       cpu_rsp_o => xip_rsp_o,
       bus_req_o => xip_req,
-      bus_rsp_i => xip_rsp
+      bus_rsp_i => xip_rsp,
+      miss_o    => miss_o
     );
     -- clear cache when entire module or XIP-mode is disabled or on global FENCE operation --
     cache_clear <= '1' when (ctrl(ctrl_enable_c) = '0') or (ctrl(ctrl_xip_enable_c) = '0') or (xip_req_i.fence = '1') else '0';
@@ -287,22 +315,29 @@ begin
   if not XIP_CACHE_EN generate
     xip_req   <= xip_req_i;
     xip_rsp_o <= xip_rsp;
+    miss_o    <= '0';
   end generate;
 
 
   -- XIP Address Computation Logic ----------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
-  xip_access_logic: process(arbiter.addr, ctrl)
-    variable tmp_v : std_ulogic_vector(31 downto 0);
+  xip_access_logic: process(arbiter.addr, ctrl, qctrl)
+    variable tmp_v  : std_ulogic_vector(31 downto 0);
+    variable mode_v : std_ulogic_vector(7 downto 0);
   begin
     tmp_v(31 downto 28) := "0000";
     tmp_v(27 downto 02) := arbiter.addr(27 downto 02);
     tmp_v(01 downto 00) := "00"; -- always align to 32-bit boundary; sub-word read accesses are handled by the CPU logic
+    if (ctrl(ctrl_quad_c) = '1') then -- mode bits are sent right after the address in quad I/O mode
+      mode_v := qctrl(qctrl_mode7_c downto qctrl_mode0_c);
+    else
+      mode_v := x"00";
+    end if;
     case ctrl(ctrl_xip_abytes1_c downto ctrl_xip_abytes0_c) is -- shift address bits to be MSB-aligned
-      when "00"   => xip_addr <= tmp_v(07 downto 0) & x"000000"; -- 1 address byte
-      when "01"   => xip_addr <= tmp_v(15 downto 0) & x"0000";   -- 2 address bytes
-      when "10"   => xip_addr <= tmp_v(23 downto 0) & x"00";     -- 3 address bytes
-      when others => xip_addr <= tmp_v(31 downto 0);             -- 4 address bytes
+      when "00"   => xip_addr <= tmp_v(07 downto 0) & mode_v & x"000000"; -- 1 address byte
+      when "01"   => xip_addr <= tmp_v(15 downto 0) & mode_v & x"0000";   -- 2 address bytes
+      when "10"   => xip_addr <= tmp_v(23 downto 0) & mode_v & x"00";     -- 3 address bytes
+      when others => xip_addr <= tmp_v(31 downto 0) & mode_v;             -- 4 address bytes
     end case;
   end process xip_access_logic;
 
@@ -359,14 +394,16 @@ begin
     -- SPI PHY interface defaults --
     phy_if.start <= '0';
     phy_if.final <= arbiter.tmo_cnt(arbiter.tmo_cnt'left) or (not bool_to_ulogic_f(XIP_CACHE_EN)); -- terminate if timeout or if burst mode not enabled
-    phy_if.wdata <= ctrl(ctrl_rd_cmd7_c downto ctrl_rd_cmd0_c) & xip_addr & x"00000000"; -- MSB-aligned: CMD + address + 32-bit zero data
+    phy_if.quad  <= ctrl(ctrl_quad_c);
+    phy_if.wdata <= ctrl(ctrl_rd_cmd7_c downto ctrl_rd_cmd0_c) & xip_addr & x"00000000"; -- MSB-aligned: CMD + address (+ mode) + 32-bit zero data
 
     -- fsm --
     case arbiter.state is
 
       when S_DIRECT => -- XIP access disabled; direct SPI access
       -- ------------------------------------------------------------
-        phy_if.wdata      <= spi_data_hi & spi_data_lo & x"00"; -- MSB-aligned data
+        phy_if.quad       <= '0'; -- direct SPI access is always single-bit
+        phy_if.wdata      <= spi_data_hi & spi_data_lo & x"0000"; -- MSB-aligned data
         phy_if.start      <= spi_trigger;
         phy_if.final      <= '1'; -- do not keep CS active after transmission is done
         arbiter.state_nxt <= S_IDLE;
@@ -465,6 +502,8 @@ begin
     op_final_i   => phy_if.final,          -- end current transmission
     op_csen_i    => ctrl(ctrl_spi_csen_c), -- actually enabled device for transmission
     op_busy_o    => phy_if.busy,           -- transmission in progress when set
+    op_quad_i    => phy_if.quad,           -- quad I/O transmission
+    op_dummy_i   => qctrl(qctrl_dummy3_c downto qctrl_dummy0_c), -- number of dummy cycles
     op_nbytes_i  => ctrl(ctrl_spi_nbytes3_c downto ctrl_spi_nbytes0_c), -- actual number of bytes to transmit
     op_wdata_i   => phy_if.wdata,          -- write data
     op_rdata_o   => phy_if.rdata,          -- read data
@@ -472,7 +511,8 @@ begin
     spi_csn_o    => spi_csn_o,
     spi_clk_o    => spi_clk_o,
     spi_dat_i    => spi_dat_i,
-    spi_dat_o    => spi_dat_o
+    spi_dat_o    => spi_dat_o,
+    spi_dat_oe_o => spi_dat_oe_o
   );
 
 
@@ -538,30 +578,40 @@ entity neorv32_xip_phy is
     op_final_i   : in  std_ulogic; -- end current transmission
     op_csen_i    : in  std_ulogic; -- actually enabled device for transmission
     op_busy_o    : out std_ulogic; -- transmission in progress when set
-    op_nbytes_i  : in  std_ulogic_vector(03 downto 0); -- actual number of bytes to transmit (1..9)
-    op_wdata_i   : in  std_ulogic_vector(71 downto 0); -- write data
+    op_quad_i    : in  std_ulogic; -- quad I/O transmission (1-4-4)
+    op_dummy_i   : in  std_ulogic_vector(03 downto 0); -- number of dummy cycles (quad I/O transmission only)
+    op_nbytes_i  : in  std_ulogic_vector(03 downto 0); -- actual number of bytes to transmit (1..10)
+    op_wdata_i   : in  std_ulogic_vector(79 downto 0); -- write data
     op_rdata_o   : out std_ulogic_vector(31 downto 0); -- read data
     -- SPI interface --
     spi_csn_o    : out std_ulogic;
     spi_clk_o    : out std_ulogic;
-    spi_dat_i    : in  std_ulogic;
-    spi_dat_o    : out std_ulogic
+    spi_dat_i    : in  std_ulogic_vector(03 downto 0);
+    spi_dat_o    : out std_ulogic_vector(03 downto 0);
+    spi_dat_oe_o : out std_ulogic_vector(03 downto 0)
   );
 end neorv32_xip_phy;
 
 architecture neorv32_xip_phy_rtl of neorv32_xip_phy is
 
   -- serial engine --
-  type ctrl_state_t is (S_IDLE, S_WAIT, S_START, S_SYNC, S_RTX_A, S_RTX_B, S_DONE);
+  type ctrl_state_t is (S_IDLE, S_WAIT, S_START, S_SYNC, S_RTX_A, S_RTX_B, S_DUMMY_A, S_DUMMY_B, S_DONE);
   type ctrl_t is record
     state   : ctrl_state_t;
-    sreg    : std_ulogic_vector(71 downto 0); -- only the lowest 32-bit are used as RX data
+    sreg    : std_ulogic_vector(79 downto 0); -- only the lowest 32-bit are used as RX data
     bitcnt  : std_ulogic_vector(06 downto 0);
-    di_sync : std_ulogic;
+    dumcnt  : std_ulogic_vector(03 downto 0); -- remaining dummy cycles
+    di_sync : std_ulogic_vector(03 downto 0);
     csen    : std_ulogic;
+    qmode   : std_ulogic; -- quad I/O transmission
+    quad    : std_ulogic; -- 4-bit transfers (after command byte of quad I/O transmission)
+    qout    : std_ulogic; -- drive all four data lines (address + mode bits of quad I/O transmission)
   end record;
   signal ctrl : ctrl_t;
 
+  -- end of command byte (quad I/O transmission) --
+  signal cmd_end : std_ulogic_vector(06 downto 0);
+
 begin
 
   -- Serial Interface Engine ----------------------------------------------------------------
@@ -575,7 +625,11 @@ begin
       ctrl.csen    <= '0';
       ctrl.sreg    <= (others => '0');
       ctrl.bitcnt  <= (others => '0');
-      ctrl.di_sync <= '0';
+      ctrl.dumcnt  <= (others => '0');
+      ctrl.di_sync <= (others => '0');
+      ctrl.qmode   <= '0';
+      ctrl.quad    <= '0';
+      ctrl.qout    <= '0';
     elsif rising_edge(clk_i) then
       if (cf_enable_i = '0') then -- sync reset
         spi_clk_o    <= '0';
@@ -584,7 +638,11 @@ begin
         ctrl.csen    <= '0';
         ctrl.sreg    <= (others => '0');
         ctrl.bitcnt  <= (others => '0');
-        ctrl.di_sync <= '0';
+        ctrl.dumcnt  <= (others => '0');
+        ctrl.di_sync <= (others => '0');
+        ctrl.qmode   <= '0';
+        ctrl.quad    <= '0';
+        ctrl.qout    <= '0';
       else -- fsm
         case ctrl.state is
 
@@ -593,7 +651,9 @@ begin
             spi_csn_o   <= '1'; -- flash disabled
             spi_clk_o   <= cf_cpol_i;
             ctrl.bitcnt <= op_nbytes_i & "000"; -- number of bytes
+            ctrl.dumcnt <= op_dummy_i;
             ctrl.csen   <= op_csen_i;
+            ctrl.qmode  <= op_quad_i;
             if (op_start_i = '1') then
               ctrl.state <= S_START;
             end if;
@@ -601,6 +661,8 @@ begin
           when S_START => -- start of transmission (keep current spi_csn_o state!)
           -- ------------------------------------------------------------
             ctrl.sreg <= op_wdata_i;
+            ctrl.quad <= '0'; -- command byte is always single-bit
+            ctrl.qout <= '0';
             if (spi_clk_en_i = '1') then
               ctrl.state <= S_SYNC;
             end if;
@@ -630,20 +692,61 @@ begin
             if (spi_clk_en_i = '1') then
               spi_clk_o    <= not (cf_cpha_i xor cf_cpol_i);
               ctrl.di_sync <= spi_dat_i;
-              ctrl.bitcnt  <= std_ulogic_vector(unsigned(ctrl.bitcnt) - 1);
+              if (ctrl.quad = '1') then
+                ctrl.bitcnt <= std_ulogic_vector(unsigned(ctrl.bitcnt) - 4);
+              else
+                ctrl.bitcnt <= std_ulogic_vector(unsigned(ctrl.bitcnt) - 1);
+              end if;
               ctrl.state   <= S_RTX_B;
             end if;
 
           when S_RTX_B => -- second half of bit transmission
           -- ------------------------------------------------------------
             if (spi_clk_en_i = '1') then
-              ctrl.sreg <= ctrl.sreg(ctrl.sreg'left-1 downto 0) & ctrl.di_sync;
+              if (ctrl.quad = '1') then -- IO3..IO0
+                ctrl.sreg <= ctrl.sreg(ctrl.sreg'left-4 downto 0) & ctrl.di_sync;
+              else -- MISO = IO1
+                ctrl.sreg <= ctrl.sreg(ctrl.sreg'left-1 downto 0) & ctrl.di_sync(1);
+              end if;
+              -- quad I/O transmission: switch to 4-bit transfers after the command byte --
+              if (ctrl.qmode = '1') and (ctrl.quad = '0') and (ctrl.bitcnt = cmd_end) then
+                ctrl.quad <= '1';
+                ctrl.qout <= '1';
+              end if;
+              -- quad I/O transmission: release data lines after address + mode bits --
+              if (ctrl.quad = '1') and (ctrl.bitcnt = "0100000") then
+                ctrl.qout <= '0';
+              end if;
+              -- next state --
               if (or_reduce_f(ctrl.bitcnt) = '0') then -- all bits transferred?
                 spi_clk_o  <= cf_cpol_i;
                 ctrl.state <= S_DONE; -- transmission done
               else
                 spi_clk_o  <= cf_cpha_i xor cf_cpol_i;
-                ctrl.state <= S_RTX_A; -- next bit
+                if (ctrl.quad = '1') and (ctrl.bitcnt = "0100000") and (or_reduce_f(ctrl.dumcnt) = '1') then
+                  ctrl.state <= S_DUMMY_A; -- dummy cycles before read data
+                else
+                  ctrl.state <= S_RTX_A; -- next bit
+                end if;
+              end if;
+            end if;
+
+          when S_DUMMY_A => -- first half of dummy cycle
+          -- ------------------------------------------------------------
+            if (spi_clk_en_i = '1') then
+              spi_clk_o  <= not (cf_cpha_i xor cf_cpol_i);
+              ctrl.state <= S_DUMMY_B;
+            end if;
+
+          when S_DUMMY_B => -- second half of dummy cycle
+          -- ------------------------------------------------------------
+            if (spi_clk_en_i = '1') then
+              spi_clk_o   <= cf_cpha_i xor cf_cpol_i;
+              ctrl.dumcnt <= std_ulogic_vector(unsigned(ctrl.dumcnt) - 1);
+              if (ctrl.dumcnt = "0001") then -- last dummy cycle?
+                ctrl.state <= S_RTX_A;
+              else
+                ctrl.state <= S_DUMMY_A;
               end if;
             end if;
 
@@ -662,11 +765,23 @@ begin
     end if;
   end process serial_engine;
 
+  -- remaining bits after the command byte --
+  cmd_end <= std_ulogic_vector(unsigned(op_nbytes_i) - 1) & "000";
+
   -- serial unit busy --
   op_busy_o <= '0' when (ctrl.state = S_IDLE) or (ctrl.state = S_WAIT) else '1';
 
   -- serial data output --
-  spi_dat_o <= ctrl.sreg(ctrl.sreg'left);
+  serial_data_output: process(ctrl)
+  begin
+    if (ctrl.quad = '1') then -- quad I/O: drive IO3..IO0 during address + mode bits only
+      spi_dat_o    <= ctrl.sreg(ctrl.sreg'left downto ctrl.sreg'left-3);
+      spi_dat_oe_o <= (others => ctrl.qout);
+    else -- single-bit: IO0 = MOSI, IO1 = MISO, keep IO2 = /WP and IO3 = /HOLD high
+      spi_dat_o    <= "11" & '0' & ctrl.sreg(ctrl.sreg'left);
+      spi_dat_oe_o <= "1101";
+    end if;
+  end process serial_data_output;
 
   -- RX data --
   op_rdata_o <= ctrl.sreg(31 downto 0);
@@ -733,7 +848,8 @@ entity neorv32_xip_cache is
     cpu_req_i : in  bus_req_t;  -- request bus
     cpu_rsp_o : out bus_rsp_t;  -- response bus
     bus_req_o : out bus_req_t;  -- request bus
-    bus_rsp_i : in  bus_rsp_t   -- response bus
+    bus_rsp_i : in  bus_rsp_t;  -- response bus
+    miss_o    : out std_ulogic  -- cache miss (HPM event)
   );
 end neorv32_xip_cache;
 
@@ -820,6 +936,9 @@ begin
     cpu_rsp_o.err   <= '0';
     cpu_rsp_o.data  <= (others => '0');
 
+    -- HPM event default --
+    miss_o          <= '0';
+
     -- bus interface defaults --
     bus_req_o.data  <= (others => '0');
     bus_req_o.ben   <= (others => '0');
@@ -829,7 +948,10 @@ begin
     bus_req_o.rw    <= '0'; -- read-only
     bus_req_o.stb   <= '0';
     bus_req_o.rvso  <= cpu_req_i.rvso;
+    bus_req_o.amo   <= cpu_req_i.amo;
+    bus_req_o.amoop <= cpu_req_i.amoop;
     bus_req_o.fence <= cpu_req_i.fence;
+    bus_req_o.burst <= '0'; -- block download from the XIP module's SPI engine
 
     -- fsm --
     case state is
@@ -856,6 +978,7 @@ begin
           cpu_rsp_o.ack <= not cache.host_rderr;
           state_nxt     <= S_IDLE;
         else -- cache MISS
+          miss_o    <= '1';
           state_nxt <= S_DOWNLOAD_REQ;
         end if;
 
@@ -45,6 +45,7 @@ entity neorv32_top_avalonmm is
     -- General --
     CLOCK_FREQUENCY              : natural;           -- clock frequency of clk_i in Hz
     HART_ID                      : std_ulogic_vector(31 downto 0) := x"00000000"; -- hardware thread ID
+    DUAL_CORE_EN                 : boolean := false;  -- implement a second CPU core (SMP dual-core cluster)
     VENDOR_ID                    : std_ulogic_vector(31 downto 0) := x"00000000"; -- vendor's JEDEC ID
     INT_BOOTLOADER_EN            : boolean := false;  -- boot configuration: true = boot explicit bootloader; false = boot from int/ext (I)MEM
 
@@ -66,6 +67,10 @@ entity neorv32_top_avalonmm is
     -- Extension Options --
     FAST_MUL_EN                  : boolean := false;  -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN                : boolean := false;  -- use barrel shifter for shift operations
+    CPU_BTB_EN                   : boolean := false;  -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH                : natural := 2;      -- instruction prefetch buffer depth (2..16), has to be a power of two
+    MULDIV_RADIX                 : natural := 2;      -- serial mul/div radix: 2, 4 or 16
+    MULDIV_EARLY_EN              : boolean := false;  -- skip leading all-zero operand bytes in serial mul/div
 
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS              : natural := 0;      -- number of regions (0..16)
@@ -75,6 +80,9 @@ entity neorv32_top_avalonmm is
     HPM_NUM_CNTS                 : natural := 0;      -- number of implemented HPM counters (0..29)
     HPM_CNT_WIDTH                : natural := 40;     -- total size of HPM counters (0..64)
 
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN                  : boolean := false;  -- implement multi-layer crossbar instead of the shared bus
+
     -- Internal Instruction memory (IMEM) --
     MEM_INT_IMEM_EN              : boolean := false;  -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            : natural := 16*1024; -- size of processor-internal instruction memory in bytes
@@ -83,16 +91,25 @@ entity neorv32_top_avalonmm is
     MEM_INT_DMEM_EN              : boolean := false;  -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            : natural := 8*1024; -- size of processor-internal data memory in bytes
 
+    -- Tightly-Coupled Memories (TCM) --
+    MEM_INT_ITCM_EN              : boolean := false;  -- implement instruction TCM
+    MEM_INT_ITCM_SIZE            : natural := 4*1024; -- size of instruction TCM in bytes
+    MEM_INT_DTCM_EN              : boolean := false;  -- implement data TCM
+    MEM_INT_DTCM_SIZE            : natural := 4*1024; -- size of data TCM in bytes
+
     -- Internal Cache memory (iCACHE) --
     ICACHE_EN                    : boolean := false;  -- implement instruction cache
     ICACHE_NUM_BLOCKS            : natural := 4;      -- i-cache: number of blocks (min 1), has to be a power of 2
     ICACHE_BLOCK_SIZE            : natural := 64;     -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY         : natural := 1;      -- i-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    ICACHE_PREFETCH_EN           : boolean := false;  -- i-cache: implement sequential next-block prefetcher
 
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN                    : boolean := false;  -- implement data cache
     DCACHE_NUM_BLOCKS            : natural := 4;      -- d-cache: number of blocks (min 1), has to be a power of 2
     DCACHE_BLOCK_SIZE            : natural := 64;     -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY         : natural := 1;      -- d-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    DCACHE_WRITE_POLICY          : natural := 0;      -- d-cache: write policy (0=write-through, 1=write-back)
 
     -- Execute in-place module (XIP) --
     XIP_EN                       : boolean := false;  -- implement execute in place module (XIP)?
@@ -154,8 +171,9 @@ entity neorv32_top_avalonmm is
     -- XIP (execute in place via SPI) signals (available if IO_XIP_EN = true) --
     xip_csn_o      : out std_ulogic; -- chip-select, low-active
     xip_clk_o      : out std_ulogic; -- serial clock
-    xip_dat_i      : in  std_ulogic := 'L'; -- device data input
-    xip_dat_o      : out std_ulogic; -- controller data output
+    xip_dat_i      : in  std_ulogic_vector(3 downto 0) := (others => 'L'); -- device data input (IO3..IO0)
+    xip_dat_o      : out std_ulogic_vector(3 downto 0); -- controller data output (IO3..IO0)
+    xip_dat_oe_o   : out std_ulogic_vector(3 downto 0); -- controller data output enable (IO3..IO0)
 
     -- GPIO (available if IO_GPIO_EN = true) --
     gpio_o         : out std_ulogic_vector(63 downto 0); -- parallel output
@@ -230,6 +248,7 @@ begin
     -- General --
     CLOCK_FREQUENCY => CLOCK_FREQUENCY,
     HART_ID => HART_ID,
+    DUAL_CORE_EN => DUAL_CORE_EN,
     VENDOR_ID => VENDOR_ID,
 
     -- On-Chip Debugger (OCD) --
@@ -250,6 +269,10 @@ begin
     -- Extension Options --
     FAST_MUL_EN => FAST_MUL_EN,
     FAST_SHIFT_EN => FAST_SHIFT_EN,
+    CPU_BTB_EN => CPU_BTB_EN,
+    CPU_IPB_DEPTH => CPU_IPB_DEPTH,
+    MULDIV_RADIX => MULDIV_RADIX,
+    MULDIV_EARLY_EN => MULDIV_EARLY_EN,
 
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS => PMP_NUM_REGIONS,
@@ -259,6 +282,9 @@ begin
     HPM_NUM_CNTS => HPM_NUM_CNTS,
     HPM_CNT_WIDTH => HPM_CNT_WIDTH,
 
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN => BUS_XBAR_EN,
+
     -- Internal Instruction memory (IMEM) --
     MEM_INT_IMEM_EN => MEM_INT_IMEM_EN,
     MEM_INT_IMEM_SIZE => MEM_INT_IMEM_SIZE,
@@ -267,16 +293,25 @@ begin
     MEM_INT_DMEM_EN => MEM_INT_IMEM_EN,
     MEM_INT_DMEM_SIZE => MEM_INT_DMEM_SIZE,
 
+    -- Tightly-Coupled Memories (TCM) --
+    MEM_INT_ITCM_EN => MEM_INT_ITCM_EN,
+    MEM_INT_ITCM_SIZE => MEM_INT_ITCM_SIZE,
+    MEM_INT_DTCM_EN => MEM_INT_DTCM_EN,
+    MEM_INT_DTCM_SIZE => MEM_INT_DTCM_SIZE,
+
     -- Internal Cache memory (iCACHE) --
     ICACHE_EN => ICACHE_EN,
     ICACHE_NUM_BLOCKS => ICACHE_NUM_BLOCKS,
     ICACHE_BLOCK_SIZE => ICACHE_BLOCK_SIZE,
     ICACHE_ASSOCIATIVITY => ICACHE_ASSOCIATIVITY,
+    ICACHE_PREFETCH_EN => ICACHE_PREFETCH_EN,
 
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN => DCACHE_EN,
     DCACHE_NUM_BLOCKS => DCACHE_NUM_BLOCKS,
     DCACHE_BLOCK_SIZE => DCACHE_BLOCK_SIZE,
+    DCACHE_ASSOCIATIVITY => DCACHE_ASSOCIATIVITY,
+    DCACHE_WRITE_POLICY => DCACHE_WRITE_POLICY,
 
     -- External memory interface (WISHBONE) --
     MEM_EXT_EN => true,
@@ -285,6 +320,7 @@ begin
     MEM_EXT_BIG_ENDIAN => false,
     MEM_EXT_ASYNC_RX => false,
     MEM_EXT_ASYNC_TX => false,
+    MEM_EXT_BURST_EN => false,
 
     -- Execute in-place module (XIP) --
     XIP_EN => XIP_EN,
@@ -336,6 +372,8 @@ begin
 
     -- Wishbone bus interface (available if MEM_EXT_EN = true) --
     wb_tag_o => wb_tag_o,
+    wb_cti_o => open,
+    wb_bte_o => open,
     wb_adr_o => wb_adr_o,
     wb_dat_i => wb_dat_i,
     wb_dat_o => wb_dat_o,
@@ -351,6 +389,7 @@ begin
     xip_clk_o => xip_clk_o,
     xip_dat_i => xip_dat_i,
     xip_dat_o => xip_dat_o,
+    xip_dat_oe_o => xip_dat_oe_o,
 
     -- GPIO (available if IO_GPIO_EN = true) --
     gpio_o => gpio_o,
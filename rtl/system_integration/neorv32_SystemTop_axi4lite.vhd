@@ -48,6 +48,7 @@ entity neorv32_SystemTop_axi4lite is
     -- General --
     CLOCK_FREQUENCY              : natural := 0;      -- clock frequency of clk_i in Hz
     HART_ID                      : std_ulogic_vector(31 downto 0) := x"00000000"; -- hardware thread ID
+    DUAL_CORE_EN                 : boolean := false;  -- implement a second CPU core (SMP dual-core cluster)
     VENDOR_ID                    : std_ulogic_vector(31 downto 0) := x"00000000"; -- vendor's JEDEC ID
     INT_BOOTLOADER_EN            : boolean := true;   -- boot configuration: true = boot explicit bootloader; false = boot from int/ext (I)MEM
     -- On-Chip Debugger (OCD) --
@@ -68,6 +69,10 @@ entity neorv32_SystemTop_axi4lite is
     -- Extension Options --
     FAST_MUL_EN                  : boolean := false;  -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN                : boolean := false;  -- use barrel shifter for shift operations
+    CPU_BTB_EN                   : boolean := false;  -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH                : natural := 2;      -- instruction prefetch buffer depth (2..16), has to be a power of two
+    MULDIV_RADIX                 : natural := 2;      -- serial mul/div radix: 2, 4 or 16
+    MULDIV_EARLY_EN              : boolean := false;  -- skip leading all-zero operand bytes in serial mul/div
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS              : natural := 0;      -- number of regions (0..16)
     PMP_MIN_GRANULARITY          : natural := 4;      -- minimal region granularity in bytes, has to be a power of 2, min 4 bytes
@@ -76,21 +81,31 @@ entity neorv32_SystemTop_axi4lite is
     HPM_CNT_WIDTH                : natural := 40;     -- total size of HPM counters (0..64)
     -- Atomic Memory Access - Reservation Set Granularity --
     AMO_RVS_GRANULARITY          : natural := 4;      -- size in bytes, has to be a power of 2, min 4
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN                  : boolean := false;  -- implement multi-layer crossbar instead of the shared bus
     -- Internal Instruction memory --
     MEM_INT_IMEM_EN              : boolean := true;   -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            : natural := 16*1024; -- size of processor-internal instruction memory in bytes
     -- Internal Data memory --
     MEM_INT_DMEM_EN              : boolean := true;   -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            : natural := 8*1024; -- size of processor-internal data memory in bytes
+    -- Tightly-coupled memories --
+    MEM_INT_ITCM_EN              : boolean := false;  -- implement instruction TCM
+    MEM_INT_ITCM_SIZE            : natural := 4*1024; -- size of instruction TCM in bytes
+    MEM_INT_DTCM_EN              : boolean := false;  -- implement data TCM
+    MEM_INT_DTCM_SIZE            : natural := 4*1024; -- size of data TCM in bytes
     -- Internal Cache memory --
     ICACHE_EN                    : boolean := false;  -- implement instruction cache
     ICACHE_NUM_BLOCKS            : natural := 4;      -- i-cache: number of blocks (min 1), has to be a power of 2
     ICACHE_BLOCK_SIZE            : natural := 64;     -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY         : natural := 1;      -- i-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    ICACHE_PREFETCH_EN           : boolean := false;  -- i-cache: implement sequential next-block prefetcher
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN                    : boolean := false;  -- implement data cache
     DCACHE_NUM_BLOCKS            : natural := 4;      -- d-cache: number of blocks (min 1), has to be a power of 2
     DCACHE_BLOCK_SIZE            : natural := 64;     -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY         : natural := 1;      -- d-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    DCACHE_WRITE_POLICY          : natural := 0;      -- d-cache: write policy (0=write-through, 1=write-back)
     -- Execute in-place module (XIP) --
     XIP_EN                       : boolean := false;  -- implement execute in place module (XIP)?
     XIP_CACHE_EN                 : boolean := false;  -- implement XIP cache?
@@ -127,6 +142,7 @@ entity neorv32_SystemTop_axi4lite is
     IO_GPTMR_EN                  : boolean := false;  -- implement general purpose timer (GPTMR)?
     IO_ONEWIRE_EN                : boolean := false;  -- implement 1-wire interface (ONEWIRE)?
     IO_DMA_EN                    : boolean := false;  -- implement direct memory access controller (DMA)?
+    IO_DMA_NUM_CH                : natural := 1;      -- number of DMA channels (1..8)
     IO_SLINK_EN                  : boolean := false;  -- implement stream link interface (SLINK)?
     IO_SLINK_RX_FIFO             : natural := 1;      -- RX fifo depth, has to be a power of two, min 1
     IO_SLINK_TX_FIFO             : natural := 1;      -- TX fifo depth, has to be a power of two, min 1
@@ -192,8 +208,9 @@ entity neorv32_SystemTop_axi4lite is
     -- XIP (execute in place via SPI) signals (available if IO_XIP_EN = true) --
     xip_csn_o      : out std_logic; -- chip-select, low-active
     xip_clk_o      : out std_logic; -- serial clock
-    xip_dat_i      : in  std_logic; -- device data input
-    xip_dat_o      : out std_logic; -- controller data output
+    xip_dat_i      : in  std_logic_vector(3 downto 0); -- device data input (IO3..IO0)
+    xip_dat_o      : out std_logic_vector(3 downto 0); -- controller data output (IO3..IO0)
+    xip_dat_oe_o   : out std_logic_vector(3 downto 0); -- controller data output enable (IO3..IO0)
     -- GPIO (available if IO_GPIO_EN = true) --
     gpio_o         : out std_logic_vector(63 downto 0); -- parallel output
     gpio_i         : in  std_logic_vector(63 downto 0); -- parallel input
@@ -268,8 +285,9 @@ architecture neorv32_SystemTop_axi4lite_rtl of neorv32_SystemTop_axi4lite is
   --
   signal xip_csn_o_int      : std_ulogic;
   signal xip_clk_o_int      : std_ulogic;
-  signal xip_dat_i_int      : std_ulogic;
-  signal xip_dat_o_int      : std_ulogic;
+  signal xip_dat_i_int      : std_ulogic_vector(3 downto 0);
+  signal xip_dat_o_int      : std_ulogic_vector(3 downto 0);
+  signal xip_dat_oe_o_int   : std_ulogic_vector(3 downto 0);
   --
   signal gpio_o_int         : std_ulogic_vector(63 downto 0);
   signal gpio_i_int         : std_ulogic_vector(63 downto 0);
@@ -345,6 +363,7 @@ begin
     -- General --
     CLOCK_FREQUENCY              => CLOCK_FREQUENCY,    -- clock frequency of clk_i in Hz
     HART_ID                      => HART_ID,            -- hardware thread ID
+    DUAL_CORE_EN                 => DUAL_CORE_EN,       -- implement a second CPU core (SMP dual-core cluster)
     VENDOR_ID                    => VENDOR_ID,          -- vendor's JEDEC ID
     INT_BOOTLOADER_EN            => INT_BOOTLOADER_EN,  -- boot configuration: true = boot explicit bootloader; false = boot from int/ext (I)MEM
     -- On-Chip Debugger (OCD) --
@@ -365,6 +384,10 @@ begin
     -- Extension Options --
     FAST_MUL_EN                  => FAST_MUL_EN,        -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN                => FAST_SHIFT_EN,      -- use barrel shifter for shift operations
+    CPU_BTB_EN                   => CPU_BTB_EN,         -- implement branch target buffer with bimodal prediction
+    CPU_IPB_DEPTH                => CPU_IPB_DEPTH,      -- instruction prefetch buffer depth
+    MULDIV_RADIX                 => MULDIV_RADIX,       -- serial mul/div radix
+    MULDIV_EARLY_EN              => MULDIV_EARLY_EN,    -- skip leading all-zero operand bytes in serial mul/div
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS              => PMP_NUM_REGIONS,    -- number of regions (0..16)
     PMP_MIN_GRANULARITY          => PMP_MIN_GRANULARITY, -- minimal region granularity in bytes, has to be a power of 2, min 4 bytes
@@ -373,21 +396,31 @@ begin
     HPM_CNT_WIDTH                => HPM_CNT_WIDTH,      -- total size of HPM counters (0..64)
     -- Atomic Memory Access - Reservation Set Granularity --
     AMO_RVS_GRANULARITY          => AMO_RVS_GRANULARITY, -- size in bytes, has to be a power of 2, min 4
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN                  => BUS_XBAR_EN,        -- implement multi-layer crossbar instead of the shared bus
     -- Internal Instruction memory --
     MEM_INT_IMEM_EN              => MEM_INT_IMEM_EN,    -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            => MEM_INT_IMEM_SIZE,  -- size of processor-internal instruction memory in bytes
     -- Internal Data memory --
     MEM_INT_DMEM_EN              => MEM_INT_DMEM_EN,    -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            => MEM_INT_DMEM_SIZE,  -- size of processor-internal data memory in bytes
+    -- Tightly-coupled memories --
+    MEM_INT_ITCM_EN              => MEM_INT_ITCM_EN,    -- implement instruction TCM
+    MEM_INT_ITCM_SIZE            => MEM_INT_ITCM_SIZE,  -- size of instruction TCM in bytes
+    MEM_INT_DTCM_EN              => MEM_INT_DTCM_EN,    -- implement data TCM
+    MEM_INT_DTCM_SIZE            => MEM_INT_DTCM_SIZE,  -- size of data TCM in bytes
     -- Internal Cache memory --
     ICACHE_EN                    => ICACHE_EN,          -- implement instruction cache
     ICACHE_NUM_BLOCKS            => ICACHE_NUM_BLOCKS,  -- i-cache: number of blocks (min 1), has to be a power of 2
     ICACHE_BLOCK_SIZE            => ICACHE_BLOCK_SIZE,  -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY         => ICACHE_ASSOCIATIVITY, -- i-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    ICACHE_PREFETCH_EN           => ICACHE_PREFETCH_EN, -- i-cache: implement sequential next-block prefetcher
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN                    => DCACHE_EN,          -- implement data cache
     DCACHE_NUM_BLOCKS            => DCACHE_NUM_BLOCKS,  -- d-cache: number of blocks (min 1), has to be a power of 2
     DCACHE_BLOCK_SIZE            => DCACHE_BLOCK_SIZE,  -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY         => DCACHE_ASSOCIATIVITY, -- d-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    DCACHE_WRITE_POLICY          => DCACHE_WRITE_POLICY, -- d-cache: write policy (0=write-through, 1=write-back)
     -- External memory interface --
     MEM_EXT_EN                   => true,               -- implement external memory bus interface?
     MEM_EXT_TIMEOUT              => 0,                  -- cycles after a pending bus access auto-terminates (0 = disabled)
@@ -395,6 +428,7 @@ begin
     MEM_EXT_BIG_ENDIAN           => false,              -- byte order: true=big-endian, false=little-endian
     MEM_EXT_ASYNC_RX             => false,              -- use register buffer for RX data when false
     MEM_EXT_ASYNC_TX             => false,              -- use register buffer for TX data when false
+    MEM_EXT_BURST_EN             => false,              -- AXI4-Lite does not support bursts
     -- Execute in-place module (XIP) --
     XIP_EN                       => XIP_EN,             -- implement execute in place module (XIP)?
     XIP_CACHE_EN                 => XIP_CACHE_EN,       -- implement XIP cache?
@@ -431,6 +465,7 @@ begin
     IO_GPTMR_EN                  => IO_GPTMR_EN,        -- implement general purpose timer (GPTMR)?
     IO_ONEWIRE_EN                => IO_ONEWIRE_EN,      -- implement 1-wire interface (ONEWIRE)?
     IO_DMA_EN                    => IO_DMA_EN,          -- implement direct memory access controller (DMA)?
+    IO_DMA_NUM_CH                => IO_DMA_NUM_CH,      -- number of DMA channels
     IO_SLINK_EN                  => IO_SLINK_EN,        -- implement stream link interface (SLINK)?
     IO_SLINK_RX_FIFO             => IO_SLINK_RX_FIFO,   -- RX fifo depth, has to be a power of two, min 1
     IO_SLINK_TX_FIFO             => IO_SLINK_TX_FIFO,   -- TX fifo depth, has to be a power of two, min 1
@@ -448,6 +483,8 @@ begin
     jtag_tms_i     => jtag_tms_i_int,  -- mode select
     -- Wishbone bus interface (available if MEM_EXT_EN = true) --
     wb_tag_o       => wb_core.tag,     -- tag
+    wb_cti_o       => open,            -- cycle type identifier
+    wb_bte_o       => open,            -- burst type extension
     wb_adr_o       => wb_core.adr,     -- address
     wb_dat_i       => wb_core.di,      -- read data
     wb_dat_o       => wb_core.do,      -- write data
@@ -471,6 +508,7 @@ begin
     xip_clk_o      => xip_clk_o_int,   -- serial clock
     xip_dat_i      => xip_dat_i_int,   -- device data input
     xip_dat_o      => xip_dat_o_int,   -- controller data output
+    xip_dat_oe_o   => xip_dat_oe_o_int, -- controller data output enable
     -- GPIO (available if IO_GPIO_NUM > 0) --
     gpio_o         => gpio_o_int,      -- parallel output
     gpio_i         => gpio_i_int,      -- parallel input
@@ -524,8 +562,9 @@ begin
 
   xip_csn_o          <= std_logic(xip_csn_o_int);
   xip_clk_o          <= std_logic(xip_clk_o_int);
-  xip_dat_i_int      <= std_ulogic(xip_dat_i);
-  xip_dat_o          <= std_logic(xip_dat_o_int);
+  xip_dat_i_int      <= std_ulogic_vector(xip_dat_i);
+  xip_dat_o          <= std_logic_vector(xip_dat_o_int);
+  xip_dat_oe_o       <= std_logic_vector(xip_dat_oe_o_int);
 
   gpio_o             <= std_logic_vector(gpio_o_int);
   gpio_i_int         <= std_ulogic_vector(gpio_i);
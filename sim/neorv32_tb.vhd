@@ -59,7 +59,11 @@ use work.uart_rx_pkg.all;
 
 entity neorv32_tb is
   generic (runner_cfg : string := runner_cfg_default;
-           ci_mode : boolean := false);
+           ci_mode : boolean := false;
+           dcache_en : boolean := false; -- implement a 2-way set-associative write-back d-cache
+           cpu_perf_en : boolean := false; -- implement BTB, 4-entry IPB and radix-4 mul/div with early termination
+           ext_burst_en : boolean := false; -- use Wishbone bursts (registered TX path) for the simulated external memories
+           dma_num_ch : natural := 1); -- number of DMA channels
 end neorv32_tb;
 
 architecture neorv32_tb_rtl of neorv32_tb is
@@ -120,6 +124,11 @@ architecture neorv32_tb_rtl of neorv32_tb is
   signal spi_di, spi_do, spi_clk : std_ulogic;
   signal sdi_di, sdi_do, sdi_clk, sdi_csn : std_ulogic;
 
+  -- xip --
+  signal xip_csn, xip_clk : std_ulogic;
+  signal xip_dat_i, xip_dat_o, xip_dat_oe : std_ulogic_vector(3 downto 0);
+  signal xip_io : std_logic_vector(3 downto 0);
+
   -- irq --
   signal msi_ring, mei_ring : std_ulogic;
 
@@ -141,6 +150,7 @@ architecture neorv32_tb_rtl of neorv32_tb is
     ack   : std_ulogic; -- transfer acknowledge
     err   : std_ulogic; -- transfer error
     tag   : std_ulogic_vector(02 downto 0); -- request tag
+    cti   : std_ulogic_vector(02 downto 0); -- cycle type identifier
   end record;
   signal wb_cpu, wb_mem_a, wb_mem_b, wb_mem_c, wb_irq : wishbone_t;
 
@@ -155,6 +165,7 @@ architecture neorv32_tb_rtl of neorv32_tb is
     rdata  : ext_mem_read_latency_t;
     acc_en : std_ulogic;
     ack    : std_ulogic_vector(255 downto 0);
+    bst    : std_ulogic; -- burst in progress: next beat is acknowledged without latency
   end record;
   signal ext_mem_a, ext_mem_b, ext_mem_c : ext_mem_t;
 
@@ -185,7 +196,7 @@ begin
     if ci_mode then
       -- No need to send the full expectation in one big chunk
       check_uart(net, uart1_rx_handle, nul & nul);
-      check_uart(net, uart1_rx_handle, "0/58" & cr & lf);
+      check_uart(net, uart1_rx_handle, "0/61" & cr & lf);
     end if;
 
     -- Wait until all expected data has been received
@@ -243,6 +254,10 @@ begin
     FAST_MUL_EN                  => false,         -- use DSPs for M extension's multiplier
     FAST_SHIFT_EN                => false,         -- use barrel shifter for shift operations
     REGFILE_HW_RST               => true,          -- full hardware reset
+    CPU_BTB_EN                   => cpu_perf_en,   -- implement branch target buffer
+    CPU_IPB_DEPTH                => cond_sel_natural_f(cpu_perf_en, 4, 2), -- instruction prefetch buffer depth
+    MULDIV_RADIX                 => cond_sel_natural_f(cpu_perf_en, 4, 2), -- serial mul/div radix
+    MULDIV_EARLY_EN              => cpu_perf_en,   -- skip leading all-zero operand bytes in serial mul/div
     -- Physical Memory Protection (PMP) --
     PMP_NUM_REGIONS              => 5,             -- number of regions (0..16)
     PMP_MIN_GRANULARITY          => 4,             -- minimal region granularity in bytes, has to be a power of 2, min 4 bytes
@@ -262,14 +277,19 @@ begin
     -- Internal Cache memory --
     ICACHE_EN                    => false,         -- implement instruction cache
     -- Internal Data Cache (dCACHE) --
-    DCACHE_EN                    => false,         -- implement data cache
+    DCACHE_EN                    => dcache_en,     -- implement data cache
+    DCACHE_NUM_BLOCKS            => 4,             -- d-cache: number of blocks (min 1), has to be a power of 2
+    DCACHE_BLOCK_SIZE            => 32,            -- d-cache: block size in bytes (min 4), has to be a power of 2
+    DCACHE_ASSOCIATIVITY         => 2,             -- d-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    DCACHE_WRITE_POLICY          => 1,             -- d-cache: write policy (0=write-through, 1=write-back)
     -- External memory interface --
     MEM_EXT_EN                   => true,          -- implement external memory bus interface?
     MEM_EXT_TIMEOUT              => 256,           -- cycles after a pending bus access auto-terminates (0 = disabled)
     MEM_EXT_PIPE_MODE            => false,         -- protocol: false=classic/standard wishbone mode, true=pipelined wishbone mode
     MEM_EXT_BIG_ENDIAN           => false,         -- byte order: true=big-endian, false=little-endian
     MEM_EXT_ASYNC_RX             => true,          -- use register buffer for RX data when false
-    MEM_EXT_ASYNC_TX             => true,          -- use register buffer for TX data when false
+    MEM_EXT_ASYNC_TX             => not ext_burst_en, -- use register buffer for TX data when false
+    MEM_EXT_BURST_EN             => ext_burst_en,  -- use incrementing bursts for cache block and DMA transfers
     -- Execute in-place module (XIP) --
     XIP_EN                       => true,          -- implement execute in place module (XIP)?
     XIP_CACHE_EN                 => true,          -- implement XIP cache?
@@ -306,6 +326,7 @@ begin
     IO_GPTMR_EN                  => true,          -- implement general purpose timer (GPTMR)?
     IO_ONEWIRE_EN                => true,          -- implement 1-wire interface (ONEWIRE)?
     IO_DMA_EN                    => true,          -- implement direct memory access controller (DMA)?
+    IO_DMA_NUM_CH                => dma_num_ch,    -- number of DMA channels
     IO_SLINK_EN                  => true,          -- implement stream link interface (SLINK)?
     IO_SLINK_RX_FIFO             => 2,             -- RX fifo depth, has to be a power of two, min 1
     IO_SLINK_TX_FIFO             => 2,             -- TX fifo depth, has to be a power of two, min 1
@@ -323,6 +344,8 @@ begin
     jtag_tms_i     => '0',             -- mode select
     -- Wishbone bus interface (available if MEM_EXT_EN = true) --
     wb_tag_o       => wb_cpu.tag,      -- request tag
+    wb_cti_o       => wb_cpu.cti,      -- cycle type identifier
+    wb_bte_o       => open,            -- burst type extension
     wb_adr_o       => wb_cpu.addr,     -- address
     wb_dat_i       => wb_cpu.rdata,    -- read data
     wb_dat_o       => wb_cpu.wdata,    -- write data
@@ -342,10 +365,11 @@ begin
     slink_tx_lst_o => slink_lst,       -- last element of stream
     slink_tx_rdy_i => slink_rdy,       -- TX ready to send
     -- XIP (execute in place via SPI) signals (available if XIP_EN = true) --
-    xip_csn_o      => open,            -- chip-select, low-active
-    xip_clk_o      => open,            -- serial clock
-    xip_dat_i      => '1',             -- device data input
-    xip_dat_o      => open,            -- controller data output
+    xip_csn_o      => xip_csn,         -- chip-select, low-active
+    xip_clk_o      => xip_clk,         -- serial clock
+    xip_dat_i      => xip_dat_i,       -- device data input
+    xip_dat_o      => xip_dat_o,       -- controller data output
+    xip_dat_oe_o   => xip_dat_oe,      -- controller data output enable
     -- GPIO (available if IO_GPIO_NUM > 0) --
     gpio_o         => gpio,            -- parallel output
     gpio_i         => gpio,            -- parallel input
@@ -413,6 +437,16 @@ begin
   -- 1-Wire termination (pull-up) --
   onewire <= 'H';
 
+  -- XIP tri-state driver --
+  xip_io_driver:
+  for i in 0 to 3 generate
+    xip_io(i) <= xip_dat_o(i) when (xip_dat_oe(i) = '1') else 'Z';
+  end generate;
+  xip_dat_i <= to_x01(std_ulogic_vector(xip_io));
+
+  -- XIP termination (pull-ups) --
+  xip_io <= (others => 'H');
+
   -- SPI/SDI echo --
   sdi_clk <= spi_clk;
   sdi_csn <= spi_csn(7);
@@ -432,6 +466,67 @@ begin
       uart_txd => uart1_txd);
 
 
+  -- XIP SPI Flash --------------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  -- simplified read-only flash model (SPI clock mode 0, 3 address bytes); the byte at address A contains A(7:0)
+  -- supported commands: 0x03 = read data (single-bit), 0xEB = fast read quad I/O (1-4-4, 2 mode cycles + 4 dummy cycles)
+  xip_flash_model: process
+    variable cmd_v  : std_ulogic_vector(7 downto 0);
+    variable addr_v : std_ulogic_vector(23 downto 0);
+    variable data_v : std_ulogic_vector(7 downto 0);
+  begin
+    xip_io <= (others => 'Z');
+    wait until falling_edge(xip_csn);
+    flash_access: loop -- abort whenever chip-select is de-asserted
+      -- command byte (IO0) --
+      for i in 7 downto 0 loop
+        wait until rising_edge(xip_clk) or (xip_csn = '1');
+        exit flash_access when (xip_csn = '1');
+        cmd_v(i) := to_x01(xip_io(0));
+      end loop;
+      -- address --
+      if (cmd_v = x"03") then -- address via IO0
+        for i in 23 downto 0 loop
+          wait until rising_edge(xip_clk) or (xip_csn = '1');
+          exit flash_access when (xip_csn = '1');
+          addr_v(i) := to_x01(xip_io(0));
+        end loop;
+      elsif (cmd_v = x"EB") then -- address via IO3..IO0, followed by mode bits and dummy cycles
+        for i in 5 downto 0 loop
+          wait until rising_edge(xip_clk) or (xip_csn = '1');
+          exit flash_access when (xip_csn = '1');
+          addr_v(i*4+3 downto i*4) := to_x01(std_ulogic_vector(xip_io));
+        end loop;
+        for i in 0 to 5 loop
+          wait until rising_edge(xip_clk) or (xip_csn = '1');
+          exit flash_access when (xip_csn = '1');
+        end loop;
+      else -- unsupported command
+        wait until (xip_csn = '1');
+        exit flash_access;
+      end if;
+      -- read data (incrementing address), updated on falling clock edge --
+      loop
+        data_v := addr_v(7 downto 0);
+        if (cmd_v = x"03") then -- data via IO1
+          for i in 7 downto 0 loop
+            wait until falling_edge(xip_clk) or (xip_csn = '1');
+            exit flash_access when (xip_csn = '1');
+            xip_io(1) <= data_v(i);
+          end loop;
+        else -- data via IO3..IO0
+          for i in 1 downto 0 loop
+            wait until falling_edge(xip_clk) or (xip_csn = '1');
+            exit flash_access when (xip_csn = '1');
+            xip_io <= data_v(i*4+3 downto i*4);
+          end loop;
+        end if;
+        addr_v := std_ulogic_vector(unsigned(addr_v) + 1);
+      end loop;
+    end loop flash_access;
+  end process xip_flash_model;
+
+
   -- Wishbone Fabric ------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   -- CPU broadcast signals --
@@ -440,6 +535,7 @@ begin
   wb_mem_a.we    <= wb_cpu.we;
   wb_mem_a.sel   <= wb_cpu.sel;
   wb_mem_a.tag   <= wb_cpu.tag;
+  wb_mem_a.cti   <= wb_cpu.cti;
   wb_mem_a.cyc   <= wb_cpu.cyc;
 
   wb_mem_b.addr  <= wb_cpu.addr;
@@ -447,6 +543,7 @@ begin
   wb_mem_b.we    <= wb_cpu.we;
   wb_mem_b.sel   <= wb_cpu.sel;
   wb_mem_b.tag   <= wb_cpu.tag;
+  wb_mem_b.cti   <= wb_cpu.cti;
   wb_mem_b.cyc   <= wb_cpu.cyc;
 
   wb_mem_c.addr  <= wb_cpu.addr;
@@ -454,6 +551,7 @@ begin
   wb_mem_c.we    <= wb_cpu.we;
   wb_mem_c.sel   <= wb_cpu.sel;
   wb_mem_c.tag   <= wb_cpu.tag;
+  wb_mem_c.cti   <= wb_cpu.cti;
   wb_mem_c.cyc   <= wb_cpu.cyc;
 
   wb_irq.addr    <= wb_cpu.addr;
@@ -461,6 +559,7 @@ begin
   wb_irq.we      <= wb_cpu.we;
   wb_irq.sel     <= wb_cpu.sel;
   wb_irq.tag     <= wb_cpu.tag;
+  wb_irq.cti     <= wb_cpu.cti;
   wb_irq.cyc     <= wb_cpu.cyc;
 
   -- CPU read-back signals (no mux here since peripherals have "output gates") --
@@ -484,7 +583,7 @@ begin
     begin
       if rising_edge(clk_gen) then
         -- control --
-        ext_mem_a.ack(0) <= wb_mem_a.cyc and wb_mem_a.stb; -- wishbone acknowledge
+        ext_mem_a.ack(0) <= wb_mem_a.cyc and wb_mem_a.stb and (not wb_mem_a.ack) and (not ext_mem_a.bst); -- wishbone acknowledge
 
         -- write access --
         if ((wb_mem_a.cyc and wb_mem_a.stb and wb_mem_a.we) = '1') then -- valid write access
@@ -501,18 +600,24 @@ begin
         if (ext_mem_a_latency_c > 1) then
           for i in 1 to ext_mem_a_latency_c-1 loop
             ext_mem_a.rdata(i) <= ext_mem_a.rdata(i-1);
-            ext_mem_a.ack(i)   <= ext_mem_a.ack(i-1) and wb_mem_a.cyc;
+            ext_mem_a.ack(i)   <= ext_mem_a.ack(i-1) and wb_mem_a.cyc and (not wb_mem_a.ack);
           end loop;
         end if;
 
         -- bus output register --
         wb_mem_a.err <= '0';
-        if (ext_mem_a.ack(ext_mem_a_latency_c-1) = '1') and (wb_mem_a.cyc = '1') then
+        if (ext_mem_a.bst = '1') and (wb_mem_a.cyc = '1') and (wb_mem_a.stb = '1') and (wb_mem_a.ack = '0') then -- burst continuation
+          wb_mem_a.rdata <= ext_ram_a(to_integer(unsigned(wb_mem_a.addr(index_size_f(ext_mem_a_size_c/4)+1 downto 2))));
+          wb_mem_a.ack   <= '1';
+          ext_mem_a.bst  <= bool_to_ulogic_f(wb_mem_a.cti = "010");
+        elsif (ext_mem_a.ack(ext_mem_a_latency_c-1) = '1') and (wb_mem_a.cyc = '1') and (wb_mem_a.ack = '0') then
           wb_mem_a.rdata <= ext_mem_a.rdata(ext_mem_a_latency_c-1);
           wb_mem_a.ack   <= '1';
+          ext_mem_a.bst  <= bool_to_ulogic_f(wb_mem_a.cti = "010");
         else
           wb_mem_a.rdata <= (others => '0');
           wb_mem_a.ack   <= '0';
+          ext_mem_a.bst  <= ext_mem_a.bst and wb_mem_a.cyc;
         end if;
       end if;
     end process ext_mem_a_access;
@@ -535,7 +640,7 @@ begin
     begin
       if rising_edge(clk_gen) then
         -- control --
-        ext_mem_b.ack(0) <= wb_mem_b.cyc and wb_mem_b.stb; -- wishbone acknowledge
+        ext_mem_b.ack(0) <= wb_mem_b.cyc and wb_mem_b.stb and (not wb_mem_b.ack) and (not ext_mem_b.bst); -- wishbone acknowledge
 
         -- write access --
         if ((wb_mem_b.cyc and wb_mem_b.stb and wb_mem_b.we) = '1') then -- valid write access
@@ -552,18 +657,24 @@ begin
         if (ext_mem_b_latency_c > 1) then
           for i in 1 to ext_mem_b_latency_c-1 loop
             ext_mem_b.rdata(i) <= ext_mem_b.rdata(i-1);
-            ext_mem_b.ack(i)   <= ext_mem_b.ack(i-1) and wb_mem_b.cyc;
+            ext_mem_b.ack(i)   <= ext_mem_b.ack(i-1) and wb_mem_b.cyc and (not wb_mem_b.ack);
           end loop;
         end if;
 
         -- bus output register --
         wb_mem_b.err <= '0';
-        if (ext_mem_b.ack(ext_mem_b_latency_c-1) = '1') and (wb_mem_b.cyc = '1') then
+        if (ext_mem_b.bst = '1') and (wb_mem_b.cyc = '1') and (wb_mem_b.stb = '1') and (wb_mem_b.ack = '0') then -- burst continuation
+          wb_mem_b.rdata <= ext_ram_b(to_integer(unsigned(wb_mem_b.addr(index_size_f(ext_mem_b_size_c/4)+1 downto 2))));
+          wb_mem_b.ack   <= '1';
+          ext_mem_b.bst  <= bool_to_ulogic_f(wb_mem_b.cti = "010");
+        elsif (ext_mem_b.ack(ext_mem_b_latency_c-1) = '1') and (wb_mem_b.cyc = '1') and (wb_mem_b.ack = '0') then
           wb_mem_b.rdata <= ext_mem_b.rdata(ext_mem_b_latency_c-1);
           wb_mem_b.ack   <= '1';
+          ext_mem_b.bst  <= bool_to_ulogic_f(wb_mem_b.cti = "010");
         else
           wb_mem_b.rdata <= (others => '0');
           wb_mem_b.ack   <= '0';
+          ext_mem_b.bst  <= ext_mem_b.bst and wb_mem_b.cyc;
         end if;
       end if;
     end process ext_mem_b_access;
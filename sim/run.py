@@ -32,6 +32,18 @@ NEORV32.add_source_files([
 
 NEORV32.test_bench("neorv32_tb").set_generic("ci_mode", args.ci_mode)
 
+# optional features are simulated in separate configurations; "default" is the plain testbench setup
+TB_CONFIGS = {
+    "default": {},
+    "dcache_wb": {"dcache_en": True},
+    "cpu_perf": {"cpu_perf_en": True},
+    "wb_burst": {"ext_burst_en": True},
+    "dma_2ch": {"dma_num_ch": 2},
+    "wb_burst_dcache_wb": {"ext_burst_en": True, "dcache_en": True},
+}
+for name, generics in TB_CONFIGS.items():
+    NEORV32.test_bench("neorv32_tb").add_config(name=name, generics=generics)
+
 PRJ.set_sim_option("disable_ieee_warnings", True)
 PRJ.set_sim_option("ghdl.sim_flags", ["--max-stack-alloc=256"])
 
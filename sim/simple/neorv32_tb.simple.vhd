@@ -64,6 +64,7 @@ architecture neorv32_tb_simple_rtl of neorv32_tb_simple is
   constant baud1_rate_c            : natural := 19200; -- simulation UART1 (secondary UART) baud rate
   constant icache_en_c             : boolean := true; -- implement i-cache
   constant icache_block_size_c     : natural := 64; -- i-cache block size in bytes
+  constant icache_pf_en_c          : boolean := true; -- implement i-cache next-block prefetcher
   -- simulated external Wishbone memory A (can be used as external IMEM) --
   constant ext_mem_a_base_addr_c   : std_ulogic_vector(31 downto 0) := x"00000000"; -- wishbone memory base address (external IMEM base)
   constant ext_mem_a_size_c        : natural := imem_size_c; -- wishbone memory size in bytes
@@ -196,17 +197,25 @@ begin
     HPM_CNT_WIDTH                => 40,            -- total size of HPM counters (0..64)
     -- Atomic Memory Access - Reservation Set Granularity --
     AMO_RVS_GRANULARITY          => 4,             -- size in bytes, has to be a power of 2, min 4
+    -- Processor-Internal Bus Interconnect --
+    BUS_XBAR_EN                  => true,          -- implement multi-layer crossbar instead of the shared bus
     -- Internal Instruction memory --
     MEM_INT_IMEM_EN              => int_imem_c ,   -- implement processor-internal instruction memory
     MEM_INT_IMEM_SIZE            => imem_size_c,   -- size of processor-internal instruction memory in bytes
     -- Internal Data memory --
     MEM_INT_DMEM_EN              => int_dmem_c,    -- implement processor-internal data memory
     MEM_INT_DMEM_SIZE            => dmem_size_c,   -- size of processor-internal data memory in bytes
+    -- Tightly-coupled memories --
+    MEM_INT_ITCM_EN              => true,          -- implement instruction TCM
+    MEM_INT_ITCM_SIZE            => 4*1024,        -- size of instruction TCM in bytes
+    MEM_INT_DTCM_EN              => true,          -- implement data TCM
+    MEM_INT_DTCM_SIZE            => 4*1024,        -- size of data TCM in bytes
     -- Internal Cache memory --
     ICACHE_EN                    => icache_en_c,   -- implement instruction cache
     ICACHE_NUM_BLOCKS            => 8,             -- i-cache: number of blocks (min 2), has to be a power of 2
     ICACHE_BLOCK_SIZE            => icache_block_size_c, -- i-cache: block size in bytes (min 4), has to be a power of 2
     ICACHE_ASSOCIATIVITY         => 2,             -- i-cache: associativity / number of sets (1=direct_mapped), has to be a power of 2
+    ICACHE_PREFETCH_EN           => icache_pf_en_c, -- i-cache: implement sequential next-block prefetcher
     -- Internal Data Cache (dCACHE) --
     DCACHE_EN                    => true,          -- implement data cache
     DCACHE_NUM_BLOCKS            => 8,             -- d-cache: number of blocks (min 1), has to be a power of 2
@@ -292,8 +301,9 @@ begin
     -- XIP (execute in place via SPI) signals (available if XIP_EN = true) --
     xip_csn_o      => open,            -- chip-select, low-active
     xip_clk_o      => open,            -- serial clock
-    xip_dat_i      => '0',             -- device data input
+    xip_dat_i      => (others => '0'), -- device data input
     xip_dat_o      => open,            -- controller data output
+    xip_dat_oe_o   => open,            -- controller data output enable
     -- GPIO (available if IO_GPIO_NUM > true) --
     gpio_o         => gpio,            -- parallel output
     gpio_i         => gpio,            -- parallel input
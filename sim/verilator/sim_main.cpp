@@ -0,0 +1,212 @@
+// #################################################################################################
+// # << NEORV32 - Verilator C++ simulation harness (clock, UART0 receiver, Wishbone memory) >>     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "Vneorv32_verilator_top.h"
+
+// external Wishbone memory: begin of the "external IO" area (same as ext_mem_c of the VHDL testbench)
+#define XMEM_BASE 0xF0000000U
+#define XMEM_SIZE (64*1024)
+
+
+/**********************************************************************//**
+ * Get value of a "+name=value" plusarg; returns default if not set.
+ **************************************************************************/
+static std::string plusarg(VerilatedContext *ctx, const char *name, const char *def) {
+
+  std::string key = std::string(name) + "=";
+  std::string match = ctx->commandArgsPlusMatch(key.c_str()); // returns the complete argument
+  if (match.empty()) {
+    return def;
+  }
+  return match.substr(key.length() + 1);
+}
+
+
+int main(int argc, char **argv) {
+
+  auto ctx = std::make_unique<VerilatedContext>();
+  ctx->commandArgs(argc, argv);
+  auto top = std::make_unique<Vneorv32_verilator_top>(ctx.get());
+
+  // configuration; +clk has to match the CLOCK_FREQUENCY generic of the top entity
+  uint64_t max_cycles = strtoull(plusarg(ctx.get(), "max-cycles", "0").c_str(), NULL, 0);
+  uint64_t clk        = strtoull(plusarg(ctx.get(), "clk", "100000000").c_str(), NULL, 0);
+  uint64_t baud       = strtoull(plusarg(ctx.get(), "baud", "19200").c_str(), NULL, 0);
+  uint64_t latency    = strtoull(plusarg(ctx.get(), "wb-latency", "1").c_str(), NULL, 0);
+  std::string stop    = plusarg(ctx.get(), "stop", "");
+
+  if ((clk == 0) || (baud == 0) || (baud > clk) || (latency == 0)) {
+    fprintf(stderr, "Usage: %s [+max-cycles=N] [+clk=HZ] [+baud=N] [+wb-latency=N] [+stop=STRING]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<uint8_t> xmem(XMEM_SIZE, 0);
+  std::string uart_log;
+
+  // Wishbone slave state
+  bool wb_ack = false, wb_err = false;
+  uint32_t wb_rdata = 0;
+  uint64_t wb_wait = 0;
+
+  // UART0 receiver state (8N1)
+  const uint64_t bit_cycles = clk / baud;
+  bool rx_busy = false;
+  int rx_prev = 1, rx_bit = 0;
+  uint64_t rx_cnt = 0;
+  uint32_t rx_sreg = 0;
+
+  // reset
+  top->clk_i       = 0;
+  top->rstn_i      = 0;
+  top->uart0_rxd_i = 1; // idle
+  top->wb_dat_i    = 0;
+  top->wb_ack_i    = 0;
+  top->wb_err_i    = 0;
+  for (int i=0; i<16; i++) {
+    top->clk_i = 1; top->eval();
+    top->clk_i = 0; top->eval();
+  }
+  top->rstn_i = 1;
+  rx_prev = top->uart0_txd_o;
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t cycles = 0;
+  bool stopped = false;
+
+  while (!ctx->gotFinish() && ((max_cycles == 0) || (cycles < max_cycles))) {
+
+    // rising edge; the outputs are evaluated here and the responses are applied for the next edge
+    top->clk_i = 1;
+    top->eval();
+    cycles++;
+
+    // Wishbone memory (classic mode, one access at a time)
+    if (wb_ack || wb_err) { // response has been sampled by the processor
+      wb_ack = false;
+      wb_err = false;
+    }
+    else if (top->wb_cyc_o && top->wb_stb_o) {
+      if (++wb_wait >= latency) {
+        wb_wait = 0;
+        uint32_t addr = top->wb_adr_o;
+        if ((addr >= XMEM_BASE) && (addr < (XMEM_BASE + XMEM_SIZE))) {
+          uint32_t offs = (addr - XMEM_BASE) & ~3U;
+          if (top->wb_we_o) {
+            for (int i=0; i<4; i++) {
+              if (top->wb_sel_o & (1 << i)) {
+                xmem[offs + i] = (uint8_t)(top->wb_dat_o >> (8*i));
+              }
+            }
+          }
+          else {
+            wb_rdata = 0;
+            for (int i=0; i<4; i++) {
+              wb_rdata |= (uint32_t)xmem[offs + i] << (8*i);
+            }
+          }
+          wb_ack = true;
+        }
+        else { // unmapped address
+          wb_err = true;
+        }
+      }
+    }
+    else {
+      wb_wait = 0;
+    }
+    top->wb_ack_i = wb_ack;
+    top->wb_err_i = wb_err;
+    top->wb_dat_i = wb_rdata;
+
+    // UART0 receiver: sample in the middle of each bit
+    int txd = top->uart0_txd_o;
+    if (!rx_busy) {
+      if ((rx_prev == 1) && (txd == 0)) { // start bit
+        rx_busy = true;
+        rx_cnt  = bit_cycles + bit_cycles/2;
+        rx_bit  = 0;
+        rx_sreg = 0;
+      }
+    }
+    else if (--rx_cnt == 0) {
+      if (rx_bit < 8) { // data bits, LSB first
+        rx_sreg |= (uint32_t)txd << rx_bit;
+        rx_bit++;
+        rx_cnt = bit_cycles;
+      }
+      else { // stop bit
+        rx_busy = false;
+        putchar((int)rx_sreg);
+        fflush(stdout);
+        if (!stop.empty()) {
+          uart_log += (char)rx_sreg;
+          if (uart_log.find(stop) != std::string::npos) {
+            stopped = true;
+            break;
+          }
+        }
+      }
+    }
+    rx_prev = txd;
+
+    // falling edge
+    top->clk_i = 0;
+    top->eval();
+  }
+
+  top->final();
+
+  double host = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  fprintf(stderr, "\n[neorv32_verilator] %s after %llu cycles (%.3f ms @ %llu Hz)\n",
+          stopped ? "stop string received" : "simulation stopped", (unsigned long long)cycles,
+          (1000.0 * (double)cycles) / (double)clk, (unsigned long long)clk);
+  fprintf(stderr, "[neorv32_verilator] %.2f s host time, %.1f kHz simulation speed\n",
+          host, (host > 0.0) ? ((double)cycles / host / 1000.0) : 0.0);
+
+  // a missing stop string is an error (regression runs)
+  if (!stop.empty() && !stopped) {
+    return 1;
+  }
+  return 0;
+}
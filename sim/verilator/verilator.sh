@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+
+# Abort if any command returns != 0
+set -e
+
+cd $(dirname "$0")
+
+NEORV32_LOCAL_RTL=${NEORV32_LOCAL_RTL:-../../rtl}
+GHDL="${GHDL:-ghdl}"
+VERILATOR="${VERILATOR:-verilator}"
+
+mkdir -p build
+
+# Analyze all sources (the application image has to be installed to rtl/core already)
+$GHDL -i --work=neorv32 --workdir=build \
+  "$NEORV32_LOCAL_RTL"/core/*.vhd \
+  "$NEORV32_LOCAL_RTL"/core/mem/*.vhd \
+  neorv32_verilator_top.vhd
+
+$GHDL -m --work=neorv32 --workdir=build neorv32_verilator_top
+
+# Convert the top entity into a plain Verilog netlist
+echo "Converting VHDL to Verilog (build/neorv32_verilator_top.v)..."
+$GHDL synth --work=neorv32 --workdir=build --out=verilog neorv32_verilator_top > build/neorv32_verilator_top.v
+
+# Build the C++ model and the harness
+echo "Building Verilator model (build/obj_dir/Vneorv32_verilator_top)..."
+$VERILATOR --cc --exe --build -j 0 -O3 \
+  --x-assign fast --x-initial fast --noassert -Wno-fatal -Wno-lint -Wno-style \
+  --top-module neorv32_verilator_top --Mdir build/obj_dir \
+  build/neorv32_verilator_top.v sim_main.cpp > build/verilator.log
+
+VERILATOR_RUN_ARGS="${@:-+max-cycles=1000000}"
+
+echo "Using simulation run arguments: $VERILATOR_RUN_ARGS";
+
+./build/obj_dir/Vneorv32_verilator_top $VERILATOR_RUN_ARGS
@@ -66,6 +66,12 @@ GDB_ARGS ?= -ex "target extended-remote localhost:3333"
 # GHDL simulation run arguments
 GHDL_RUN_FLAGS ?=
 
+# Verilator simulation run arguments
+VERILATOR_RUN_FLAGS ?=
+
+# Instruction-set simulator run arguments
+ISS_RUN_FLAGS ?=
+
 
 # -----------------------------------------------------------------------------
 # NEORV32 framework
@@ -82,6 +88,8 @@ NEORV32_EXG_PATH = $(NEORV32_HOME)/sw/image_gen
 NEORV32_RTL_PATH = $(NEORV32_LOCAL_RTL)/core
 # Path to NEORV32 sim folder
 NEORV32_SIM_PATH = $(NEORV32_HOME)/sim
+# Path to NEORV32 instruction-set simulator
+NEORV32_ISS_PATH = $(NEORV32_HOME)/sw/iss
 # Marker file to check for NEORV32 home folder
 NEORV32_HOME_MARKER = $(NEORV32_INC_PATH)/neorv32.h
 
@@ -130,6 +138,9 @@ CC_HOST = gcc -Wall -O -g
 # NEORV32 executable image generator
 IMAGE_GEN = $(NEORV32_EXG_PATH)/image_gen
 
+# NEORV32 instruction-set simulator
+ISS = $(NEORV32_ISS_PATH)/neorv32_iss
+
 # Compiler & linker flags
 CC_OPTS  = -march=$(MARCH) -mabi=$(MABI) $(EFFORT) -Wall -ffunction-sections -fdata-sections -nostartfiles -mno-fdiv
 CC_OPTS += -mstrict-align -mbranch-cost=10 -g -Wl,--gc-sections
@@ -176,6 +187,11 @@ $(IMAGE_GEN): $(NEORV32_EXG_PATH)/image_gen.c
 	@echo Compiling $(IMAGE_GEN)
 	@$(CC_HOST) $< -o $(IMAGE_GEN)
 
+# install/compile instruction-set simulator
+$(ISS): $(NEORV32_ISS_PATH)/neorv32_iss.c
+	@echo Compiling $(ISS)
+	@$(CC_HOST) $< -o $(ISS)
+
 
 # -----------------------------------------------------------------------------
 # General targets: Assemble, compile, link, dump
@@ -206,13 +222,15 @@ $(APP_ELF): $(OBJ)
 $(APP_ASM): $(APP_ELF)
 	@$(OBJDUMP) -d -S -z  $< > $@
 
-# Generate final executable from .text + .rodata + .data (in THIS order!)
+# Generate final executable from .text + .rodata + .data + .itcm + .dtcm (in THIS order!)
 main.bin: $(APP_ELF)
 	@$(OBJCOPY) -I elf32-little $< -j .text   -O binary text.bin
 	@$(OBJCOPY) -I elf32-little $< -j .rodata -O binary rodata.bin
 	@$(OBJCOPY) -I elf32-little $< -j .data   -O binary data.bin
-	@cat text.bin rodata.bin data.bin > $@
-	@rm -f text.bin rodata.bin data.bin
+	@$(OBJCOPY) -I elf32-little $< -j .itcm   -O binary itcm.bin
+	@$(OBJCOPY) -I elf32-little $< -j .dtcm   -O binary dtcm.bin
+	@cat text.bin rodata.bin data.bin itcm.bin dtcm.bin > $@
+	@rm -f text.bin rodata.bin data.bin itcm.bin dtcm.bin
 
 
 # -----------------------------------------------------------------------------
@@ -301,6 +319,22 @@ sim: $(APP_IMG) install
 	@sh $(NEORV32_SIM_PATH)/simple/ghdl.sh $(GHDL_RUN_FLAGS)
 
 
+# -----------------------------------------------------------------------------
+# In-console simulation using a Verilator model (VHDL converted by GHDL synth)
+# -----------------------------------------------------------------------------
+sim_verilator: $(APP_IMG) install
+	@echo "Simulating $(APP_IMG) using Verilator..."
+	@sh $(NEORV32_SIM_PATH)/verilator/verilator.sh $(VERILATOR_RUN_FLAGS)
+
+
+# -----------------------------------------------------------------------------
+# In-console simulation using the host-side instruction-set simulator
+# -----------------------------------------------------------------------------
+iss: $(APP_EXE) $(ISS)
+	@echo "Simulating $(APP_EXE) using $(ISS)..."
+	@$(ISS) $(ISS_RUN_FLAGS) -elf $(APP_ELF) -prof neorv32_iss_profile.out $(APP_EXE)
+
+
 # -----------------------------------------------------------------------------
 # Show final ELF details (just for debugging)
 # -----------------------------------------------------------------------------
@@ -322,7 +356,7 @@ clean:
 	@rm -f *.elf *.o *.bin *.out *.asm *.vhd *.hex .gdb_history
 
 clean_all: clean
-	@rm -f $(OBJ) $(IMAGE_GEN)
+	@rm -f $(OBJ) $(IMAGE_GEN) $(ISS)
 
 
 # -----------------------------------------------------------------------------
@@ -372,6 +406,14 @@ info:
 	@echo "------------------------------------------------------"
 	@echo "GHDL_RUN_FLAGS: $(GHDL_RUN_FLAGS)"
 	@echo "------------------------------------------------------"
+	@echo "-- Verilator Run Arguments"
+	@echo "------------------------------------------------------"
+	@echo "VERILATOR_RUN_FLAGS: $(VERILATOR_RUN_FLAGS)"
+	@echo "------------------------------------------------------"
+	@echo "-- ISS Run Arguments"
+	@echo "------------------------------------------------------"
+	@echo "ISS_RUN_FLAGS:  $(ISS_RUN_FLAGS)"
+	@echo "------------------------------------------------------"
 	@echo "-- Libraries"
 	@echo "------------------------------------------------------"
 	@echo "LIBGCC:"
@@ -410,6 +452,8 @@ help:
 	@echo " image      - compile and generate VHDL IMEM boot image (for application, no header) in local folder"
 	@echo " install    - compile, generate and install VHDL IMEM boot image (for application, no header)"
 	@echo " sim        - in-console simulation using default/simple testbench and GHDL"
+	@echo " sim_verilator - in-console simulation using a Verilator model of the processor (GHDL synth + Verilator)"
+	@echo " iss        - in-console simulation using the host-side instruction-set simulator (writes neorv32_iss_profile.out)"
 	@echo " all        - exe + install + hex + bin + asm"
 	@echo " elf_info   - show ELF layout info"
 	@echo " clean      - clean up project home folder"
@@ -429,4 +473,6 @@ help:
 	@echo " NEORV32_HOME   - NEORV32 home folder: \"$(NEORV32_HOME)\""
 	@echo " GDB_ARGS       - GDB (connection) arguments: \"$(GDB_ARGS)\""
 	@echo " GHDL_RUN_FLAGS - GHDL simulation run arguments: \"$(GHDL_RUN_FLAGS)\""
+	@echo " VERILATOR_RUN_FLAGS - Verilator simulation run arguments: \"$(VERILATOR_RUN_FLAGS)\""
+	@echo " ISS_RUN_FLAGS  - Instruction-set simulator run arguments: \"$(ISS_RUN_FLAGS)\""
 	@echo ""
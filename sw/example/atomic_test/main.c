@@ -36,8 +36,8 @@
 /**********************************************************************//**
  * @file atomic_test/main.c
  * @author Stephan Nolting
- * @brief Test program for the NEORV32 'A' ISA extension - check the emulation
- * of the AMO (read-modify-write) operations.
+ * @brief Test program for the NEORV32 'A' ISA extension - check the native AMO
+ * (read-modify-write) instructions and their LR/SC-based emulation and compare their performance.
  **************************************************************************/
 
 #include <neorv32.h>
@@ -53,10 +53,13 @@
 #define NUM_TEST_CASES (10000)
 //** Silent mode (only show actual errors when != 0) */
 #define SILENT_MODE    (1)
+//** Number of operations for the performance comparison */
+#define NUM_BENCH_OPS  (1000)
 
 
 // Prototypes
 uint32_t xorshift32(void);
+void benchmark(uint32_t amo_addr);
 uint32_t check_result(uint32_t num, uint32_t amo_var_old, uint32_t amo_var_pre, uint32_t amo_var_new, uint32_t amo_var);
 void print_report(int num_err, int num_tests);
 
@@ -76,7 +79,7 @@ static inline int32_t MINU(uint32_t a, uint32_t b) { return((a) < (b) ? a : b);
 
 
 /**********************************************************************//**
- * Main function; test all provided AMO emulation functions.
+ * Main function; test all native AMO instructions and all provided AMO emulation functions.
  *
  * @note This program requires the RISC-V A CPU extension.
  *
@@ -93,7 +96,7 @@ int main() {
   neorv32_uart0_setup(BAUD_RATE, 0);
 
   // intro
-  neorv32_uart0_printf("<<< NEORV32 AMO Operations (atomic read-modify-write) Emulation Test >>>\n\n");
+  neorv32_uart0_printf("<<< NEORV32 AMO Operations (atomic read-modify-write) Test >>>\n\n");
 
   // check if A extension is implemented at all
   if ((neorv32_cpu_csr_read(CSR_MISA) & (1<<CSR_MISA_A)) == 0) {
@@ -115,7 +118,7 @@ int main() {
 
 
   // AMOSWAP.W
-  neorv32_uart0_printf("\namoswap.w:\n");
+  neorv32_uart0_printf("\namoswap.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -128,12 +131,19 @@ int main() {
     amo_var_new = amo_var_update;
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amoswap.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOADD.W
-  neorv32_uart0_printf("\namoadd.w:\n");
+  neorv32_uart0_printf("\namoadd.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -146,12 +156,19 @@ int main() {
     amo_var_new = amo_var_old + amo_var_update;
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amoadd.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOAND.W
-  neorv32_uart0_printf("\namoand.w:\n");
+  neorv32_uart0_printf("\namoand.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -164,12 +181,19 @@ int main() {
     amo_var_new = amo_var_old & amo_var_update;
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amoand.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOOR.W
-  neorv32_uart0_printf("\namoor.w:\n");
+  neorv32_uart0_printf("\namoor.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -182,12 +206,19 @@ int main() {
     amo_var_new = amo_var_old | amo_var_update;
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amoor.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOXOR.W
-  neorv32_uart0_printf("\namoxor.w:\n");
+  neorv32_uart0_printf("\namoxor.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -200,12 +231,19 @@ int main() {
     amo_var_new = amo_var_old ^ amo_var_update;
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amoxor.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOMAX.W
-  neorv32_uart0_printf("\namomax.w:\n");
+  neorv32_uart0_printf("\namomax.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -218,12 +256,19 @@ int main() {
     amo_var_new = (uint32_t)MAX((int32_t)amo_var_old, (int32_t)amo_var_update);
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amomax.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOMAXU.W
-  neorv32_uart0_printf("\namomaxu.w:\n");
+  neorv32_uart0_printf("\namomaxu.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -236,12 +281,19 @@ int main() {
     amo_var_new = MAXU(amo_var_old, amo_var_update);
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amomaxu.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOMIN.W
-  neorv32_uart0_printf("\namomin.w:\n");
+  neorv32_uart0_printf("\namomin.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -254,12 +306,19 @@ int main() {
     amo_var_new = (uint32_t)MIN((int32_t)amo_var_old, (int32_t)amo_var_update);
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amomin.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
 
 
   // AMOMINU.W
-  neorv32_uart0_printf("\namominu.w:\n");
+  neorv32_uart0_printf("\namominu.w (emulated / native):\n");
   err_cnt = 0;
   for (i=0; i<num_tests; i++) {
     amo_var_old = xorshift32();
@@ -272,8 +331,19 @@ int main() {
     amo_var_new = MINU(amo_var_old, amo_var_update);
 
     err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
+
+    amo_var = amo_var_old;
+    asm volatile ("fence");
+    amo_var_pre = neorv32_cpu_amo(amominu.w, amo_addr, amo_var_update);
+    asm volatile ("fence");
+
+    err_cnt += check_result(i, amo_var_old, amo_var_pre, amo_var_new, amo_var);
   }
-  print_report(err_cnt, num_tests);
+  print_report(err_cnt, 2*num_tests);
+
+
+  // performance comparison
+  benchmark(amo_addr);
 
 #else 
  
@@ -287,6 +357,55 @@ int main() {
 }
 
 
+/**********************************************************************//**
+ * Compare the average execution time of a native AMO instruction and its LR/SC-based emulation.
+ *
+ * @note This function requires the Zicntr ISA extension.
+ *
+ * @param[in] amo_addr Address of the atomic variable.
+ **************************************************************************/
+void benchmark(uint32_t amo_addr) {
+
+#if defined __riscv_atomic
+  uint32_t i, cycles_start, cycles_native, cycles_emulated;
+
+  neorv32_uart0_printf("\n\nPerformance comparison (amoadd.w, %u operations):\n", (uint32_t)NUM_BENCH_OPS);
+
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("Skipped - Zicntr ISA extension not implemented.\n");
+    return;
+  }
+
+  // native read-modify-write instruction
+  amo_var = 0;
+  cycles_start = neorv32_cpu_csr_read(CSR_MCYCLE);
+  for (i=0; i<(uint32_t)NUM_BENCH_OPS; i++) {
+    neorv32_cpu_amo(amoadd.w, amo_addr, 1);
+  }
+  cycles_native = neorv32_cpu_csr_read(CSR_MCYCLE) - cycles_start;
+
+  // LR/SC emulation
+  cycles_start = neorv32_cpu_csr_read(CSR_MCYCLE);
+  for (i=0; i<(uint32_t)NUM_BENCH_OPS; i++) {
+    neorv32_cpu_amoaddw(amo_addr, 1);
+  }
+  cycles_emulated = neorv32_cpu_csr_read(CSR_MCYCLE) - cycles_start;
+
+  neorv32_uart0_printf("native:   %u cycles/op\n", cycles_native / (uint32_t)NUM_BENCH_OPS);
+  neorv32_uart0_printf("emulated: %u cycles/op\n", cycles_emulated / (uint32_t)NUM_BENCH_OPS);
+  neorv32_uart0_printf("(including loop overhead; final value = %u) ", amo_var);
+  if (amo_var == 2*(uint32_t)NUM_BENCH_OPS) {
+    neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
+  }
+  else {
+    neorv32_uart0_printf("%c[1m[FAILED]%c[0m\n", 27, 27);
+  }
+#else
+  (void)amo_addr;
+#endif
+}
+
+
 /**********************************************************************//**
  * Pseudo-Random Number Generator (to generate deterministic test vectors).
  *
@@ -0,0 +1,217 @@
+// #################################################################################################
+// # << NEORV32 - Trap Entry/Exit Latency Benchmark >>                                             #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+
+/**********************************************************************//**
+ * @file bench_irq_latency/main.c
+ * @author Stephan Nolting
+ * @brief Measure trap entry and exit latency of the RTE (standard and fast-path core) for several
+ * trap types using mcycle. Interrupts are triggered by the testbench's IRQ trigger.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Simulation IRQ trigger (irq_trigger_base_addr_c of the VHDL testbenches) */
+#define SIM_IRQ_TRIGGER (*((volatile uint32_t*) (0xFF000000)))
+/**@}*/
+
+
+// time stamps
+static volatile uint32_t t_enter, t_leave, irq_flag;
+
+// prototypes
+void exc_handler(void);
+void irq_handler(void);
+void measure(const char *name, int type);
+
+
+/**********************************************************************//**
+ * Trap types
+ **************************************************************************/
+enum TRAP_TYPE_enum {
+  TRAP_ECALL   = 0,
+  TRAP_EBREAK  = 1,
+  TRAP_ILLEGAL = 2,
+  TRAP_MSI     = 3,
+  TRAP_MEI     = 4
+};
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the CPU Zicntr extension and UART0. The interrupt tests require
+ * the IRQ trigger of the VHDL testbench and are skipped if this is not a simulation.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  int core;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Trap Entry/Exit Latency Benchmark >>>\n\n");
+
+  // check if base counters are implemented
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // install handlers
+  neorv32_rte_handler_install(RTE_TRAP_MENV_CALL, exc_handler);
+  neorv32_rte_handler_install(RTE_TRAP_BREAKPOINT, exc_handler);
+  neorv32_rte_handler_install(RTE_TRAP_I_ILLEGAL, exc_handler);
+  neorv32_rte_handler_install(RTE_TRAP_MSI, irq_handler);
+  neorv32_rte_handler_install(RTE_TRAP_MEI, irq_handler);
+
+  neorv32_uart0_printf("entry: trap trigger -> first instruction of the handler (incl. handler prologue)\n"
+                       "exit:  last instruction of the handler -> first instruction after the trap\n\n");
+  neorv32_uart0_printf("RTE core | trap    | entry | exit\n");
+  neorv32_uart0_printf("---------+---------+-------+------\n");
+
+  for (core=0; core<2; core++) {
+    neorv32_rte_fast_core(core);
+    measure(core ? "fast    " : "standard", TRAP_ECALL);
+    measure(core ? "fast    " : "standard", TRAP_EBREAK);
+    measure(core ? "fast    " : "standard", TRAP_ILLEGAL);
+    if (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_IS_SIM)) {
+      measure(core ? "fast    " : "standard", TRAP_MSI);
+      measure(core ? "fast    " : "standard", TRAP_MEI);
+    }
+  }
+  neorv32_rte_fast_core(0);
+
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_IS_SIM)) == 0) {
+    neorv32_uart0_printf("\n[NOTE] Not a simulation - interrupt tests skipped.\n");
+  }
+
+  neorv32_uart0_printf("\nProgram completed.\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Trigger a trap and print entry/exit latency.
+ *
+ * @param[in] name RTE core name.
+ * @param[in] type Trap type (#TRAP_TYPE_enum).
+ **************************************************************************/
+void measure(const char *name, int type) {
+
+  uint32_t t_start = 0, t_stop = 0;
+  const char *trap_name = "";
+
+  irq_flag = 0;
+
+  switch (type) {
+    case TRAP_ECALL:
+      trap_name = "ecall  ";
+      asm volatile ("csrr %[t0], mcycle \n"
+                    "ecall              \n"
+                    "csrr %[t1], mcycle \n"
+                    : [t0] "=&r" (t_start), [t1] "=r" (t_stop) : : "memory");
+      break;
+    case TRAP_EBREAK:
+      trap_name = "ebreak ";
+      asm volatile ("csrr %[t0], mcycle \n"
+                    "ebreak             \n"
+                    "csrr %[t1], mcycle \n"
+                    : [t0] "=&r" (t_start), [t1] "=r" (t_stop) : : "memory");
+      break;
+    case TRAP_ILLEGAL:
+      trap_name = "illegal";
+      asm volatile ("csrr %[t0], mcycle \n"
+                    "csrw 0xfff, zero   \n" // access to non-existing CSR
+                    "csrr %[t1], mcycle \n"
+                    : [t0] "=&r" (t_start), [t1] "=r" (t_stop) : : "memory");
+      break;
+    case TRAP_MSI:
+    case TRAP_MEI:
+      trap_name = (type == TRAP_MSI) ? "msi    " : "mei    ";
+      neorv32_cpu_csr_write(CSR_MIE, (type == TRAP_MSI) ? (1 << CSR_MIE_MSIE) : (1 << CSR_MIE_MEIE));
+      neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+      t_start = neorv32_cpu_csr_read(CSR_MCYCLE);
+      SIM_IRQ_TRIGGER = (type == TRAP_MSI) ? (1 << CSR_MIE_MSIE) : (1 << CSR_MIE_MEIE);
+      while (irq_flag == 0); // the exit latency includes leaving this loop
+      t_stop = neorv32_cpu_csr_read(CSR_MCYCLE);
+      neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+      neorv32_cpu_csr_write(CSR_MIE, 0);
+      break;
+    default:
+      return;
+  }
+
+  neorv32_uart0_printf("%s | %s | %u   | %u\n", name, trap_name, t_enter - t_start, t_stop - t_leave);
+}
+
+
+/**********************************************************************//**
+ * Exception handler: take time stamps only.
+ **************************************************************************/
+void exc_handler(void) {
+
+  t_enter = neorv32_cpu_csr_read(CSR_MCYCLE);
+  t_leave = neorv32_cpu_csr_read(CSR_MCYCLE);
+}
+
+
+/**********************************************************************//**
+ * Interrupt handler: take time stamps and acknowledge the simulation IRQ trigger.
+ **************************************************************************/
+void irq_handler(void) {
+
+  t_enter = neorv32_cpu_csr_read(CSR_MCYCLE);
+  SIM_IRQ_TRIGGER = 0; // clear MSI and MEI
+  irq_flag = 1;
+  t_leave = neorv32_cpu_csr_read(CSR_MCYCLE);
+}
@@ -0,0 +1,154 @@
+// #################################################################################################
+// # << NEORV32 - Serial Multiplier/Divider Timing Benchmark >>                                    #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+
+/**********************************************************************//**
+ * @file bench_muldiv/main.c
+ * @author Stephan Nolting
+ * @brief Measure the data-dependent execution time of the M extension's serial multiplier/divider
+ * using the HPM "multi-cycle ALU wait" event.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/**@}*/
+
+
+/**********************************************************************//**
+ * Execute a single M-extension R-type instruction and return the number of
+ * multi-cycle ALU wait cycles it took (counted by mhpmcounter3).
+ *
+ * @param[in] op Instruction mnemonic (string literal).
+ * @param[in] a Operand rs1.
+ * @param[in] b Operand rs2.
+ **************************************************************************/
+#define MEASURE(op, a, b) ({                                        \
+  uint32_t _rd, _rs1 = (a), _rs2 = (b), _start, _stop;              \
+  _start = neorv32_cpu_csr_read(CSR_MHPMCOUNTER3);                  \
+  asm volatile (op " %[rd], %[rs1], %[rs2]"                         \
+                : [rd] "=r" (_rd) : [rs1] "r" (_rs1), [rs2] "r" (_rs2)); \
+  _stop = neorv32_cpu_csr_read(CSR_MHPMCOUNTER3);                   \
+  (void)_rd;                                                        \
+  _stop - _start;                                                   \
+})
+
+
+/**********************************************************************//**
+ * Test operands with 0, 1, 2 and 3 leading zero bytes
+ **************************************************************************/
+static const uint32_t operands[4] = {0xcafe1234, 0x00fe1234, 0x00001234, 0x00000034};
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the CPU M and Zihpm extensions (with at least 1 HPM counter) and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  int i;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Serial Multiplier/Divider Timing Benchmark >>>\n\n");
+
+  // check if M extension is implemented
+  if ((neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_M)) == 0) {
+    neorv32_uart0_printf("ERROR! M CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // check if at least one HPM counter is implemented
+  if (((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZIHPM)) == 0) ||
+      (neorv32_cpu_hpm_get_num_counters() == 0)) {
+    neorv32_uart0_printf("ERROR! No HPM counters implemented!\n");
+    return 1;
+  }
+
+  if (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_FASTMUL)) {
+    neorv32_uart0_printf("[NOTE] DSP-based multiplier implemented (FAST_MUL_EN) - multiplications are time-constant.\n");
+  }
+
+  // count multi-cycle ALU wait cycles using HPM counter 3
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, -1);
+  neorv32_cpu_csr_write(CSR_MHPMCOUNTER3, 0);
+  neorv32_cpu_csr_write(CSR_MHPMEVENT3, 1 << HPMCNT_EVENT_WAIT_ALU);
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, ~(1 << 3));
+
+  // the wait cycles of a single instruction are measured; CSR accesses do not trigger the ALU wait event
+  neorv32_uart0_printf("ALU wait cycles per instruction (rs1 = operand, rs2 = 0x13):\n\n");
+  neorv32_uart0_printf("operand     | mul | mulh | mulhu | div | divu | rem | remu\n");
+  neorv32_uart0_printf("------------+-----+------+-------+-----+------+-----+-----\n");
+
+  for (i=0; i<4; i++) {
+    uint32_t a = operands[i];
+    uint32_t b = 0x13;
+    neorv32_uart0_printf("0x%x  | %u  | %u   | %u    | %u  | %u   | %u  | %u\n", a,
+                         MEASURE("mul",   a, b),
+                         MEASURE("mulh",  a, b),
+                         MEASURE("mulhu", a, b),
+                         MEASURE("div",   a, b),
+                         MEASURE("divu",  a, b),
+                         MEASURE("rem",   a, b),
+                         MEASURE("remu",  a, b));
+  }
+
+  // stop counters
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, -1);
+
+  neorv32_uart0_printf("\nNOTE: Multiplication early termination depends on the leading zero bytes of rs1,\n"
+                       "division early termination depends on the leading zero bytes of |rs1|.\n"
+                       "Program completed.\n");
+
+  return 0;
+}
@@ -40,6 +40,7 @@
  **************************************************************************/
 
 #include <neorv32.h>
+#include <string.h>
 
 
 /**********************************************************************//**
@@ -48,14 +49,38 @@
 /**@{*/
 /** UART BAUD rate */
 #define BAUD_RATE 19200
+/** Number of fragments for the scatter-gather benchmark */
+#define NUM_FRAGMENTS 8
+/** Size of a single fragment in words for the scatter-gather benchmark */
+#define FRAGMENT_SIZE 4
+/** Number of bytes to copy for the memcpy benchmark */
+#define COPY_SIZE 1024
 /**@}*/
 
 // arrays for DMA data
 volatile uint32_t dma_src[4], dma_dst[4];
 
+// arrays for scatter-gather benchmark: every second fragment of bench_src is gathered into bench_dst
+volatile uint32_t bench_src[2*NUM_FRAGMENTS*FRAGMENT_SIZE], bench_dst[NUM_FRAGMENTS*FRAGMENT_SIZE];
+
+// byte arrays for memcpy benchmark (+4 bytes for misaligned copies)
+volatile uint8_t copy_src[COPY_SIZE+4] __attribute__((aligned(4))), copy_dst[COPY_SIZE+4] __attribute__((aligned(4)));
+
+// DMA descriptor chain
+neorv32_dma_desc_t dma_desc[NUM_FRAGMENTS];
+
 // prototypes
 void show_arrays(void);
 void dma_firq_handler(void);
+void chain_benchmark(void);
+int check_fragments(void);
+void multi_channel_demo(void);
+void memcpy_benchmark(void);
+int check_copy(uint32_t src_offset, uint32_t dst_offset);
+void async_done(int status);
+
+// completion flag for asynchronous UART transfer
+volatile int async_status = 1;
 
 
 /**********************************************************************//**
@@ -258,6 +283,52 @@ int main() {
   }
 
 
+  // ----------------------------------------------------------
+  // example 5
+  // ----------------------------------------------------------
+  neorv32_uart0_printf("\nExample 5: Scatter-gather benchmark - manual reprogramming vs. descriptor chain.\n");
+  chain_benchmark();
+
+
+  // ----------------------------------------------------------
+  // example 6
+  // ----------------------------------------------------------
+  neorv32_uart0_printf("\nExample 6: Concurrent transfers using two DMA channels.\n");
+  if (neorv32_dma_get_num_channels() > 1) { // only execute if at least two channels are implemented
+    multi_channel_demo();
+  }
+  else {
+    neorv32_uart0_printf("Example skipped as only a single DMA channel is implemented.\n");
+  }
+
+
+  // ----------------------------------------------------------
+  // example 7
+  // ----------------------------------------------------------
+  neorv32_uart0_printf("\nExample 7: Byte copy benchmark - CPU memcpy vs. DMA.\n");
+  memcpy_benchmark();
+
+
+  // ----------------------------------------------------------
+  // example 8
+  // ----------------------------------------------------------
+  neorv32_uart0_printf("\nExample 8: Asynchronous (DMA-backed) UART0 transmission.\n");
+  {
+    static const char async_msg[] = "This message is sent by the DMA while the CPU keeps on running.\n";
+    uint32_t cnt = 0;
+    while (neorv32_uart0_tx_busy()); // wait for previous (blocking) output to complete
+    if (neorv32_uart0_put_async(async_msg, sizeof(async_msg)-1, async_done) == 0) {
+      while (async_status > 0) { // do something useful while waiting for the transfer to complete
+        cnt++;
+      }
+      neorv32_uart0_printf("Transfer %s (%u CPU loop iterations meanwhile).\n", (async_status == 0) ? "done" : "failed", cnt);
+    }
+    else {
+      neorv32_uart0_printf("Example skipped as the DMA is busy or the UART0 TX FIFO is too small (min %u).\n", (uint32_t)DMA_STREAM_CHUNK_MIN);
+    }
+  }
+
+
   neorv32_uart0_printf("\nProgram completed.\n");
   return 0;
 }
@@ -279,6 +350,234 @@ void show_arrays(void) {
 }
 
 
+/**********************************************************************//**
+ * Gather NUM_FRAGMENTS fragments (FRAGMENT_SIZE words each) using two approaches:
+ * (1) manually reprogramming the DMA for each fragment and (2) a single descriptor chain.
+ **************************************************************************/
+void chain_benchmark(void) {
+
+  int i, fail;
+  uint32_t cmd, t_manual, t_chain;
+
+  // disable DMA interrupt; use busy wait
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+
+  cmd = DMA_CMD_W2W     | // read source in word quantities, write destination in word quantities
+        DMA_CMD_SRC_INC | // auto-increment source address
+        DMA_CMD_DST_INC;  // auto-increment destination address
+
+  for (i=0; i<(2*NUM_FRAGMENTS*FRAGMENT_SIZE); i++) {
+    bench_src[i] = 0xcafe0000UL + i;
+  }
+
+  // (1) manual reprogramming loop
+  for (i=0; i<(NUM_FRAGMENTS*FRAGMENT_SIZE); i++) {
+    bench_dst[i] = 0;
+  }
+  asm volatile ("fence"); // write back caches
+
+  t_manual = neorv32_cpu_csr_read(CSR_MCYCLE);
+  for (i=0; i<NUM_FRAGMENTS; i++) {
+    neorv32_dma_transfer((uint32_t)(&bench_src[2*i*FRAGMENT_SIZE]), (uint32_t)(&bench_dst[i*FRAGMENT_SIZE]), FRAGMENT_SIZE, cmd);
+    while (neorv32_dma_done() == 0); // wait for fragment transfer to complete
+  }
+  t_manual = neorv32_cpu_csr_read(CSR_MCYCLE) - t_manual;
+
+  fail = check_fragments();
+
+  // (2) descriptor chain
+  for (i=0; i<(NUM_FRAGMENTS*FRAGMENT_SIZE); i++) {
+    bench_dst[i] = 0;
+  }
+  for (i=0; i<NUM_FRAGMENTS; i++) {
+    neorv32_dma_chain_setup(&dma_desc[i], (uint32_t)(&bench_src[2*i*FRAGMENT_SIZE]), (uint32_t)(&bench_dst[i*FRAGMENT_SIZE]), FRAGMENT_SIZE, cmd);
+    if (i != 0) {
+      neorv32_dma_chain_link(&dma_desc[i-1], &dma_desc[i]);
+    }
+  }
+  asm volatile ("fence"); // write back caches (including the descriptors)
+
+  t_chain = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_dma_chain_start(&dma_desc[0]);
+  while (neorv32_dma_done() == 0); // wait for entire chain to complete
+  t_chain = neorv32_cpu_csr_read(CSR_MCYCLE) - t_chain;
+
+  fail += check_fragments();
+
+  neorv32_uart0_printf("Manual reprogramming: %u cycles\n", t_manual);
+  neorv32_uart0_printf("Descriptor chain:     %u cycles\n", t_chain);
+  if (fail) {
+    neorv32_uart0_printf("Transfer failed!\n");
+  }
+}
+
+
+/**********************************************************************//**
+ * Verify gathered fragments of the scatter-gather benchmark.
+ *
+ * @return Number of incorrect words.
+ **************************************************************************/
+int check_fragments(void) {
+
+  int i, j, fail = 0;
+
+  if (neorv32_dma_status() != DMA_STATUS_IDLE) {
+    return 1;
+  }
+
+  asm volatile ("fence"); // re-sync caches
+  for (i=0; i<NUM_FRAGMENTS; i++) {
+    for (j=0; j<FRAGMENT_SIZE; j++) {
+      if (bench_dst[i*FRAGMENT_SIZE+j] != bench_src[2*i*FRAGMENT_SIZE+j]) {
+        fail++;
+      }
+    }
+  }
+  return fail;
+}
+
+
+/**********************************************************************//**
+ * Copy the two halves of bench_src to bench_dst using DMA channel 0 and 1 in parallel.
+ **************************************************************************/
+void multi_channel_demo(void) {
+
+  int i, fail = 0;
+  const uint32_t half = NUM_FRAGMENTS*FRAGMENT_SIZE/2;
+  uint32_t cmd = DMA_CMD_W2W | DMA_CMD_SRC_INC | DMA_CMD_DST_INC;
+
+  for (i=0; i<(NUM_FRAGMENTS*FRAGMENT_SIZE); i++) {
+    bench_dst[i] = 0;
+  }
+  asm volatile ("fence"); // write back caches
+
+  neorv32_dma_ch_enable(NEORV32_DMA_CH(1));
+
+  // start both channels; bus accesses are interleaved by the round-robin arbiter
+  neorv32_dma_ch_transfer(NEORV32_DMA_CH(0), (uint32_t)(&bench_src[0]),    (uint32_t)(&bench_dst[0]),    half, cmd);
+  neorv32_dma_ch_transfer(NEORV32_DMA_CH(1), (uint32_t)(&bench_src[half]), (uint32_t)(&bench_dst[half]), half, cmd);
+
+  // wait for both channels to complete
+  while ((neorv32_dma_ch_done(NEORV32_DMA_CH(0)) == 0) || (neorv32_dma_ch_done(NEORV32_DMA_CH(1)) == 0));
+
+  if ((neorv32_dma_ch_status(NEORV32_DMA_CH(0)) != DMA_STATUS_IDLE) ||
+      (neorv32_dma_ch_status(NEORV32_DMA_CH(1)) != DMA_STATUS_IDLE)) {
+    fail = 1;
+  }
+
+  asm volatile ("fence"); // re-sync caches
+  for (i=0; i<(NUM_FRAGMENTS*FRAGMENT_SIZE); i++) {
+    if (bench_dst[i] != bench_src[i]) {
+      fail++;
+    }
+  }
+
+  neorv32_dma_ch_disable(NEORV32_DMA_CH(1));
+
+  if (fail) {
+    neorv32_uart0_printf("Transfer failed!\n");
+  }
+  else {
+    neorv32_uart0_printf("Transfer done.\n");
+  }
+}
+
+
+/**********************************************************************//**
+ * Copy COPY_SIZE bytes from copy_src to copy_dst using (1) the CPU's memcpy,
+ * (2) a DMA byte-to-byte transfer with identical source/destination alignment
+ * (packed into word accesses) and (3) a DMA byte-to-byte transfer with different
+ * source/destination alignment (one access per byte).
+ **************************************************************************/
+void memcpy_benchmark(void) {
+
+  int i, fail = 0;
+  uint32_t cmd, t_cpu, t_packed, t_single;
+
+  // disable DMA interrupt; use busy wait
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+
+  cmd = DMA_CMD_B2B     | // read source in byte quantities, write destination in byte quantities
+        DMA_CMD_SRC_INC | // auto-increment source address
+        DMA_CMD_DST_INC;  // auto-increment destination address
+
+  for (i=0; i<(COPY_SIZE+4); i++) {
+    copy_src[i] = (uint8_t)(i*7 + 3);
+  }
+
+  // (1) CPU memcpy
+  memset((void*)copy_dst, 0, COPY_SIZE+4);
+  t_cpu = neorv32_cpu_csr_read(CSR_MCYCLE);
+  memcpy((void*)copy_dst, (void*)copy_src, COPY_SIZE);
+  t_cpu = neorv32_cpu_csr_read(CSR_MCYCLE) - t_cpu;
+  fail += check_copy(0, 0);
+
+  // (2) DMA, identical alignment
+  memset((void*)copy_dst, 0, COPY_SIZE+4);
+  asm volatile ("fence"); // write back caches
+  t_packed = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_dma_transfer((uint32_t)(&copy_src[0]), (uint32_t)(&copy_dst[0]), COPY_SIZE, cmd);
+  while (neorv32_dma_done() == 0); // wait for transfer to complete
+  t_packed = neorv32_cpu_csr_read(CSR_MCYCLE) - t_packed;
+  fail += check_copy(0, 0);
+
+  // (3) DMA, different alignment
+  memset((void*)copy_dst, 0, COPY_SIZE+4);
+  asm volatile ("fence"); // write back caches
+  t_single = neorv32_cpu_csr_read(CSR_MCYCLE);
+  neorv32_dma_transfer((uint32_t)(&copy_src[1]), (uint32_t)(&copy_dst[0]), COPY_SIZE, cmd);
+  while (neorv32_dma_done() == 0); // wait for transfer to complete
+  t_single = neorv32_cpu_csr_read(CSR_MCYCLE) - t_single;
+  fail += check_copy(1, 0);
+
+  neorv32_uart0_printf("CPU memcpy:                %u cycles\n", t_cpu);
+  neorv32_uart0_printf("DMA, identical alignment:  %u cycles\n", t_packed);
+  neorv32_uart0_printf("DMA, different alignment:  %u cycles\n", t_single);
+  if (fail) {
+    neorv32_uart0_printf("Transfer failed!\n");
+  }
+}
+
+
+/**********************************************************************//**
+ * Verify destination array of the memcpy benchmark.
+ *
+ * @param[in] src_offset Byte offset of the source data in copy_src.
+ * @param[in] dst_offset Byte offset of the destination data in copy_dst.
+ * @return Number of incorrect bytes.
+ **************************************************************************/
+int check_copy(uint32_t src_offset, uint32_t dst_offset) {
+
+  int i, fail = 0;
+
+  if (neorv32_dma_status() != DMA_STATUS_IDLE) {
+    return 1;
+  }
+
+  asm volatile ("fence"); // re-sync caches
+  for (i=0; i<COPY_SIZE; i++) {
+    if (copy_dst[dst_offset+i] != copy_src[src_offset+i]) {
+      fail++;
+    }
+  }
+  if (copy_dst[dst_offset+COPY_SIZE] != 0) { // must not write beyond the end of the destination
+    fail++;
+  }
+  return fail;
+}
+
+
+/**********************************************************************//**
+ * Completion callback for asynchronous UART transfer (called from DMA interrupt handler).
+ *
+ * @param[in] status 0 if transfer was successful, DMA error code otherwise.
+ **************************************************************************/
+void async_done(int status) {
+
+  async_status = status;
+}
+
+
 /**********************************************************************//**
  * DMA FIRQ handler.
  *
@@ -0,0 +1,147 @@
+// #################################################################################################
+// # << NEORV32 - Dual-Core (SMP) Demo Program >>                                                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+/**********************************************************************//**
+ * @file demo_dual_core/main.c
+ * @author Stephan Nolting
+ * @brief Dual-core example program: launch the secondary hart and let both
+ * harts update a shared counter using LR/SC-based atomic operations.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of increments per hart */
+#define NUM_INCR 1000
+/** Stack size of the secondary hart in bytes */
+#define STACK_SIZE 1024
+/**@}*/
+
+
+/** Stack memory of the secondary hart */
+uint8_t hart1_stack[STACK_SIZE] __attribute__((aligned(16)));
+
+/** Shared variables (accessed via atomic operations only; these always operate on main memory as the caches of the harts are not coherent) */
+volatile uint32_t shared_cnt = 0;
+volatile uint32_t shared_done = 0;
+volatile uint32_t shared_hartid = 0;
+
+// prototypes
+void hart1_main(void);
+
+
+/**********************************************************************//**
+ * Main function (executed by hart 0)
+ *
+ * @note This program requires the dual-core configuration (DUAL_CORE_EN), the CPU A extension and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Dual-Core Demo Program >>>\n\n");
+
+  // check hardware configuration
+  if ((NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_DUAL_CORE)) == 0) {
+    neorv32_uart0_printf("ERROR! Dual-core configuration not implemented!\n");
+    return 1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_A)) == 0) {
+    neorv32_uart0_printf("ERROR! CPU A extension not implemented!\n");
+    return 1;
+  }
+
+  // start secondary hart
+  neorv32_uart0_printf("Launching hart 1... ");
+  if (neorv32_rte_smp_launch(hart1_main, hart1_stack, STACK_SIZE)) {
+    neorv32_uart0_printf("FAILED!\n");
+    return 1;
+  }
+  neorv32_uart0_printf("ok\n");
+
+  // concurrent updates of the shared counter
+  int i;
+  for (i=0; i<NUM_INCR; i++) {
+    neorv32_cpu_amoaddw((uint32_t)&shared_cnt, 1);
+  }
+
+  // wait for secondary hart to finish
+  while (neorv32_cpu_amoaddw((uint32_t)&shared_done, 0) == 0);
+
+  uint32_t cnt = neorv32_cpu_amoaddw((uint32_t)&shared_cnt, 0);
+  neorv32_uart0_printf("Hart 1 ID: 0x%x\n", neorv32_cpu_amoaddw((uint32_t)&shared_hartid, 0));
+  neorv32_uart0_printf("Counter:   %u (expected %u)\n", cnt, 2*NUM_INCR);
+
+  if (cnt == 2*NUM_INCR) {
+    neorv32_uart0_printf("\nTest OK\n");
+    return 0;
+  }
+  else {
+    neorv32_uart0_printf("\nTest FAILED\n");
+    return 1;
+  }
+}
+
+
+/**********************************************************************//**
+ * Main function of the secondary hart (hart 1).
+ **************************************************************************/
+void hart1_main(void) {
+
+  neorv32_cpu_amoswapw((uint32_t)&shared_hartid, neorv32_cpu_csr_read(CSR_MHARTID));
+
+  int i;
+  for (i=0; i<NUM_INCR; i++) {
+    neorv32_cpu_amoaddw((uint32_t)&shared_cnt, 1);
+  }
+
+  neorv32_cpu_amoswapw((uint32_t)&shared_done, 1);
+}
@@ -85,7 +85,7 @@ int main() {
 
   // intro
   neorv32_uart0_printf("\n<<< NEORV32 Hardware Performance Monitors (HPMs) Example Program >>>\n\n");
-  neorv32_uart0_printf("[NOTE] This program will use up to 9 HPM counters (if available).\n\n");
+  neorv32_uart0_printf("[NOTE] This program will use up to 13 HPM counters (if available).\n\n");
 
 
   // show HPM hardware configuration
@@ -110,6 +110,10 @@ int main() {
   if (hpm_num > 6) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER9,  0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER9H,  0); }
   if (hpm_num > 7) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER10, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER10H, 0); }
   if (hpm_num > 8) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER11, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER11H, 0); }
+  if (hpm_num > 9) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER12, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER12H, 0); }
+  if (hpm_num > 10) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER13, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER13H, 0); }
+  if (hpm_num > 11) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER14, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER14H, 0); }
+  if (hpm_num > 12) { neorv32_cpu_csr_write(CSR_MHPMCOUNTER15, 0); neorv32_cpu_csr_write(CSR_MHPMCOUNTER15H, 0); }
 
   // NOTE regarding HPMs 0..2, which are not "actual" HPMs
   // - HPM 0 is the machine cycle counter
@@ -136,6 +140,10 @@ int main() {
   if (hpm_num > 6) { neorv32_cpu_csr_write(CSR_MHPMEVENT9,  1 << HPMCNT_EVENT_STORE);    } // executed store operation
   if (hpm_num > 7) { neorv32_cpu_csr_write(CSR_MHPMEVENT10, 1 << HPMCNT_EVENT_WAIT_LSU); } // load-store unit memory wait cycle
   if (hpm_num > 8) { neorv32_cpu_csr_write(CSR_MHPMEVENT11, 1 << HPMCNT_EVENT_TRAP);     } // entered trap
+  if (hpm_num > 9) { neorv32_cpu_csr_write(CSR_MHPMEVENT12, 1 << HPMCNT_EVENT_IC_PF);    } // i-cache prefetch issued
+  if (hpm_num > 10) { neorv32_cpu_csr_write(CSR_MHPMEVENT13, 1 << HPMCNT_EVENT_IC_PFHIT); } // i-cache prefetch useful
+  if (hpm_num > 11) { neorv32_cpu_csr_write(CSR_MHPMEVENT14, 1 << HPMCNT_EVENT_BP_HIT);   } // correctly predicted taken branch
+  if (hpm_num > 12) { neorv32_cpu_csr_write(CSR_MHPMEVENT15, 1 << HPMCNT_EVENT_BP_MISS);  } // mispredicted branch
 
 
   // enable all CPU counters including HPMs
@@ -152,6 +160,12 @@ int main() {
     asm volatile ("ecall"); // environment call
     neorv32_uart0_printf(" > An invalid instruction handled by the RTE: ");
     asm volatile ("csrwi marchid, 1"); // illegal instruction (writing to read-only CSR)
+    neorv32_uart0_printf(" > A tight loop (branch prediction): ");
+    volatile uint32_t sum = 0;
+    for (uint32_t i=0; i<256; i++) {
+      sum += i;
+    }
+    neorv32_uart0_printf("%u\n", (uint32_t)sum);
   }
 
 
@@ -174,6 +188,10 @@ int main() {
   if (hpm_num > 6) { neorv32_uart0_printf(" HPM09 (store instructions)          : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER9));  }
   if (hpm_num > 7) { neorv32_uart0_printf(" HPM10 (load/store wait cycles)      : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER10)); }
   if (hpm_num > 8) { neorv32_uart0_printf(" HPM11 (entered traps)               : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER11)); }
+  if (hpm_num > 9) { neorv32_uart0_printf(" HPM12 (i-cache prefetches issued)   : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER12)); }
+  if (hpm_num > 10) { neorv32_uart0_printf(" HPM13 (i-cache prefetches used)     : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER13)); }
+  if (hpm_num > 11) { neorv32_uart0_printf(" HPM14 (correctly predicted branches): %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER14)); }
+  if (hpm_num > 12) { neorv32_uart0_printf(" HPM15 (mispredicted branches)       : %u\n", (uint32_t)neorv32_cpu_csr_read(CSR_MHPMCOUNTER15)); }
 
   neorv32_uart0_printf("\nProgram completed.\n");
 
@@ -0,0 +1,184 @@
+// #################################################################################################
+// # << NEORV32 - Sampling Profiler Demo Program >>                                                #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_profiler/main.c
+ * @author Stephan Nolting
+ * @brief Sampling profiler example program using HPM counter overflow interrupts.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of histogram bins */
+#define PROF_BINS 1024
+/** Active cycles per sample */
+#define PROF_PERIOD 997
+/**@}*/
+
+
+// symbols provided by the linker script
+extern char __text_start[];
+extern char __etext[];
+
+/** Sampling profiler histogram */
+uint32_t histogram[PROF_BINS];
+
+// prototypes
+uint32_t work_mul(uint32_t n);
+uint32_t work_mem(uint32_t n);
+uint32_t work_branch(uint32_t n);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the CPU Zihpm extension (with at least 1 counter) and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Sampling Profiler Example Program >>>\n\n");
+
+  // check if counter overflow interrupts are available
+  if (((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_SSCOFPMF)) == 0) ||
+      (neorv32_cpu_hpm_get_num_counters() == 0)) {
+    neorv32_uart0_printf("ERROR! HPM counter overflow interrupts (Sscofpmf) not available!\n");
+    return 1;
+  }
+
+  // select histogram granularity so the entire .text section is covered
+  uint32_t base = (uint32_t)__text_start;
+  uint32_t size = (uint32_t)__etext - base;
+  int shift = 1; // one bin per compressed instruction at best
+  while ((size >> shift) >= PROF_BINS) {
+    shift++;
+  }
+  neorv32_uart0_printf("Profiling 0x%x..0x%x with %u bytes per bin\n\n", base, base + size, 1 << shift);
+
+  // sample every PROF_PERIOD active cycles using HPM counter 3
+  neorv32_rte_profiler_setup(histogram, PROF_BINS, base, shift);
+  if (neorv32_rte_profiler_start(3, HPMCNT_EVENT_CY, PROF_PERIOD)) {
+    neorv32_uart0_printf("ERROR! Profiler setup failed!\n");
+    return 1;
+  }
+
+  // workload to be profiled
+  uint32_t res = 0;
+  res += work_mul(20000);
+  res += work_mem(20000);
+  res += work_branch(20000);
+
+  // stop sampling and dump histogram
+  neorv32_rte_profiler_stop();
+  neorv32_uart0_printf("Workload result: 0x%x\n\n", res);
+  neorv32_rte_profiler_dump();
+
+  neorv32_uart0_printf("\nProgram completed. Resolve the histogram using 'python3 profile.py <log> main.elf'.\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Test workload: multiplications.
+ *
+ * @param[in] n Number of iterations.
+ * @return Dummy result.
+ **************************************************************************/
+uint32_t __attribute__ ((noinline)) work_mul(uint32_t n) {
+
+  uint32_t i, tmp = 1;
+  for (i=0; i<n; i++) {
+    tmp = (tmp * 1103515245) + 12345;
+  }
+  return tmp;
+}
+
+
+/**********************************************************************//**
+ * Test workload: memory accesses.
+ *
+ * @param[in] n Number of iterations.
+ * @return Dummy result.
+ **************************************************************************/
+uint32_t __attribute__ ((noinline)) work_mem(uint32_t n) {
+
+  static volatile uint32_t buf[64];
+  uint32_t i, tmp = 0;
+  for (i=0; i<n; i++) {
+    buf[i & 63] = i;
+    tmp += buf[(i + 17) & 63];
+  }
+  return tmp;
+}
+
+
+/**********************************************************************//**
+ * Test workload: data-dependent branches.
+ *
+ * @param[in] n Number of iterations.
+ * @return Dummy result.
+ **************************************************************************/
+uint32_t __attribute__ ((noinline)) work_branch(uint32_t n) {
+
+  uint32_t i, tmp = 0;
+  for (i=0; i<n; i++) {
+    if ((i ^ (i >> 3)) & 1) {
+      tmp += i;
+    }
+    else {
+      tmp ^= i;
+    }
+  }
+  return tmp;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+
+# Resolve a NEORV32 RTE sampling profiler dump (neorv32_rte_profiler_dump) against the
+# application's ELF file and print a flat per-function / per-line profile.
+#
+# Usage: python3 profile.py <uart_log> <main.elf> [--lines] [--prefix riscv32-unknown-elf-]
+
+import argparse
+import collections
+import re
+import subprocess
+import sys
+
+
+def parse_dump(path):
+    """Return (header dict, list of (address, samples)) of the last dump in the log."""
+    header, bins, inside = None, [], False
+    with open(path, errors="replace") as log:
+        for line in log:
+            line = line.strip()
+            if line.startswith("<NEORV32-PROF>"):
+                header = dict(re.findall(r"(\w+)=(\d+)", line))
+                bins, inside = [], True
+            elif line.startswith("</NEORV32-PROF>"):
+                inside = False
+            elif inside:
+                fields = line.split()
+                if len(fields) == 2:
+                    bins.append((int(fields[0], 16), int(fields[1])))
+    if header is None:
+        sys.exit("ERROR: no <NEORV32-PROF> block found in " + path)
+    return header, bins
+
+
+def symbolize(elf, addresses, prefix):
+    """Return a list of (function, file:line) for each address using addr2line."""
+    cmd = [prefix + "addr2line", "-f", "-C", "-e", elf] + ["0x%08x" % a for a in addresses]
+    out = subprocess.run(cmd, check=True, capture_output=True, text=True).stdout.splitlines()
+    return [(out[2 * i], out[2 * i + 1]) for i in range(len(addresses))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="NEORV32 sampling profiler symbolizer")
+    parser.add_argument("log", help="UART log containing the profiler dump")
+    parser.add_argument("elf", help="application ELF file (e.g. main.elf)")
+    parser.add_argument("--lines", action="store_true", help="show per source line instead of per function")
+    parser.add_argument("--prefix", default="riscv32-unknown-elf-", help="toolchain prefix (default: %(default)s)")
+    args = parser.parse_args()
+
+    header, bins = parse_dump(args.log)
+    if not bins:
+        sys.exit("ERROR: empty histogram")
+
+    symbols = symbolize(args.elf, [a for a, _ in bins], args.prefix)
+    profile = collections.Counter()
+    for (_, samples), (func, loc) in zip(bins, symbols):
+        profile[loc if args.lines else func] += samples
+
+    total = int(header.get("samples", sum(profile.values())))
+    print("samples=%d dropped=%s period=%s event=%s" %
+          (total, header.get("dropped", "?"), header.get("period", "?"), header.get("event", "?")))
+    print("%8s %7s  %s" % ("samples", "%", "line" if args.lines else "function"))
+    for name, samples in profile.most_common():
+        print("%8d %6.2f%%  %s" % (samples, 100.0 * samples / max(total, 1), name))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+// #################################################################################################
+// # << NEORV32 - Tightly-Coupled Memory (TCM) Demo Program >>                                     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+/**********************************************************************//**
+ * @file demo_tcm/main.c
+ * @author Stephan Nolting
+ * @brief Tightly-coupled memory example program: run the same kernel from the
+ * regular memories and from the instruction/data TCMs and compare execution times.
+ **************************************************************************/
+#include <neorv32.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Number of data words to process */
+#define NUM_WORDS 256
+/**@}*/
+
+
+/** Data buffer in regular data memory (.bss) */
+uint32_t buffer_ram[NUM_WORDS];
+/** Data buffer in data TCM (.dtcm) */
+NEORV32_DTCM uint32_t buffer_dtcm[NUM_WORDS];
+
+// prototypes
+uint32_t kernel_rom(uint32_t *buf, int num);
+uint32_t kernel_itcm(uint32_t *buf, int num);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the ITCM and DTCM (MEM_INT_ITCM_EN, MEM_INT_DTCM_EN), the Zicntr
+ * CPU extension and UART0.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Tightly-Coupled Memory (TCM) Demo Program >>>\n\n");
+
+  // check hardware configuration
+  uint32_t tcm = (uint32_t)NEORV32_SYSINFO->MEM[SYSINFO_MEM_TCM];
+  if (((tcm & 0x0F) == 0) || ((tcm >> 4) == 0)) {
+    neorv32_uart0_printf("ERROR! ITCM and/or DTCM not implemented!\n");
+    return 1;
+  }
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+  neorv32_uart0_printf("ITCM: %u bytes @ 0x%x\n", (uint32_t)(1 << (tcm & 0x0F)), ITCM_BASE_ADDRESS);
+  neorv32_uart0_printf("DTCM: %u bytes @ 0x%x\n\n", (uint32_t)(1 << (tcm >> 4)), DTCM_BASE_ADDRESS);
+
+  // initialize buffers
+  int i;
+  for (i=0; i<NUM_WORDS; i++) {
+    buffer_ram[i]  = (uint32_t)i;
+    buffer_dtcm[i] = (uint32_t)i;
+  }
+
+  // run kernel from regular memories and from TCMs
+  uint32_t res[2], cycles[2];
+
+  cycles[0] = neorv32_cpu_csr_read(CSR_MCYCLE);
+  res[0] = kernel_rom(buffer_ram, NUM_WORDS);
+  cycles[0] = neorv32_cpu_csr_read(CSR_MCYCLE) - cycles[0];
+
+  cycles[1] = neorv32_cpu_csr_read(CSR_MCYCLE);
+  res[1] = kernel_itcm(buffer_dtcm, NUM_WORDS);
+  cycles[1] = neorv32_cpu_csr_read(CSR_MCYCLE) - cycles[1];
+
+  neorv32_uart0_printf("IMEM/DMEM: %u cycles (result 0x%x)\n", cycles[0], res[0]);
+  neorv32_uart0_printf("ITCM/DTCM: %u cycles (result 0x%x)\n", cycles[1], res[1]);
+
+  if (res[0] == res[1]) {
+    neorv32_uart0_printf("\nTest OK\n");
+    return 0;
+  }
+  else {
+    neorv32_uart0_printf("\nTest FAILED\n");
+    return 1;
+  }
+}
+
+
+/**********************************************************************//**
+ * Test kernel executed from regular instruction memory.
+ *
+ * @param[in,out] buf Data buffer.
+ * @param[in] num Number of words.
+ * @return Checksum.
+ **************************************************************************/
+uint32_t __attribute__((noinline)) kernel_rom(uint32_t *buf, int num) {
+
+  uint32_t sum = 0;
+  int i;
+  for (i=0; i<num; i++) {
+    buf[i] = (buf[i] << 3) ^ (sum + 0x9e3779b9);
+    sum += buf[i];
+  }
+  return sum;
+}
+
+
+/**********************************************************************//**
+ * Test kernel executed from the instruction TCM (identical to #kernel_rom).
+ *
+ * @param[in,out] buf Data buffer.
+ * @param[in] num Number of words.
+ * @return Checksum.
+ **************************************************************************/
+NEORV32_ITCM uint32_t kernel_itcm(uint32_t *buf, int num) {
+
+  uint32_t sum = 0;
+  int i;
+  for (i=0; i<num; i++) {
+    buf[i] = (buf[i] << 3) ^ (sum + 0x9e3779b9);
+    sum += buf[i];
+  }
+  return sum;
+}
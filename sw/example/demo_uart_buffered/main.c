@@ -0,0 +1,257 @@
+// #################################################################################################
+// # << NEORV32 - Buffered (Interrupt-Driven) UART Demo Program >>                                 #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file demo_uart_buffered/main.c
+ * @author Stephan Nolting
+ * @brief Buffered (interrupt-driven) UART driver example using both UARTs.
+ **************************************************************************/
+
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** UART0 RX/TX ring buffer sizes in bytes (power of two); small RX buffer to provoke overflows */
+#define UART0_RX_SIZE 16
+#define UART0_TX_SIZE 256
+/** UART1 RX/TX ring buffer sizes in bytes (power of two) */
+#define UART1_RX_SIZE 16
+#define UART1_TX_SIZE 64
+/** Time in ms between two reads of the RX ring buffers */
+#define POLL_INTERVAL 1000
+/**@}*/
+
+
+// ring buffer memory (owned by the application)
+static char uart0_rx_buf[UART0_RX_SIZE], uart0_tx_buf[UART0_TX_SIZE];
+static char uart1_rx_buf[UART1_RX_SIZE], uart1_tx_buf[UART1_TX_SIZE];
+
+// number of ECALL traps
+static uint32_t ecall_cnt;
+
+// prototypes
+void buffered_puts(neorv32_uart_t *UARTx, const char *s);
+void buffered_putu(neorv32_uart_t *UARTx, uint32_t num);
+void bridge(neorv32_uart_t *UARTx, neorv32_uart_t *UARTy, const char *name);
+void ecall_handler(void);
+
+
+/**********************************************************************//**
+ * Buffered UART demo program. Both UARTs are operated in buffered mode. All characters
+ * received by one UART are echoed and forwarded to the other UART. The RX ring buffers
+ * are read only once per POLL_INTERVAL ms, so sending more than UART0_RX_SIZE (UART1_RX_SIZE)
+ * characters within that time (e.g. by pasting a line into the terminal) overflows the ring
+ * buffer; the number of lost characters is reported. Sending '!' issues an environment call
+ * (ECALL) whose trap handler prints a status report that is sent by polling (interrupts are
+ * disabled while in the trap handler).
+ *
+ * @note This program requires UART0 and UART1 to be synthesized.
+ *
+ * @return Irrelevant.
+ **************************************************************************/
+int main() {
+
+  uint32_t lost0 = 0, lost1 = 0, tmp;
+
+  // setup NEORV32 runtime environment (for trap handling)
+  neorv32_rte_setup();
+
+  // setup UARTs at default baud rate, no interrupts (yet)
+  neorv32_uart_setup(NEORV32_UART0, BAUD_RATE, 0);
+
+  // check if UART1 is implemented at all
+  if (neorv32_uart_available(NEORV32_UART1) == 0) {
+    neorv32_uart_puts(NEORV32_UART0, "ERROR! UART1 not implemented!\n");
+    return 1;
+  }
+  neorv32_uart_setup(NEORV32_UART1, BAUD_RATE, 0);
+
+  // switch both UARTs to buffered mode; this also installs the RTE RX/TX handlers and enables their FIRQs
+  if ((neorv32_uart_buffered_setup(NEORV32_UART0, uart0_rx_buf, UART0_RX_SIZE, uart0_tx_buf, UART0_TX_SIZE)) ||
+      (neorv32_uart_buffered_setup(NEORV32_UART1, uart1_rx_buf, UART1_RX_SIZE, uart1_tx_buf, UART1_TX_SIZE))) {
+    neorv32_uart_puts(NEORV32_UART0, "ERROR! Invalid ring buffer size!\n");
+    return 1;
+  }
+
+  // install ECALL trap handler
+  ecall_cnt = 0;
+  neorv32_rte_handler_install(RTE_TRAP_MENV_CALL, ecall_handler);
+
+  // enable machine-mode interrupts
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  // intro (via the TX ring buffers)
+  buffered_puts(NEORV32_UART0, "Buffered UART demo program (UART0).\n"
+                               "Characters are echoed and forwarded to UART1. Send '!' for a status report.\n\n");
+  buffered_puts(NEORV32_UART1, "Buffered UART demo program (UART1).\n"
+                               "Characters are echoed and forwarded to UART0.\n\n");
+
+  while (1) {
+
+    // give the RX interrupt handlers some time to fill the RX ring buffers
+    neorv32_cpu_delay_ms(POLL_INTERVAL);
+
+    bridge(NEORV32_UART0, NEORV32_UART1, "UART0");
+    bridge(NEORV32_UART1, NEORV32_UART0, "UART1");
+
+    // report RX ring buffer overflows
+    tmp = neorv32_uart_buffered_rx_lost(NEORV32_UART0);
+    if (tmp != lost0) {
+      buffered_puts(NEORV32_UART0, "\n[UART0 RX ring buffer overflow, ");
+      buffered_putu(NEORV32_UART0, tmp - lost0);
+      buffered_puts(NEORV32_UART0, " character(s) lost]\n");
+      lost0 = tmp;
+    }
+    tmp = neorv32_uart_buffered_rx_lost(NEORV32_UART1);
+    if (tmp != lost1) {
+      buffered_puts(NEORV32_UART1, "\n[UART1 RX ring buffer overflow, ");
+      buffered_putu(NEORV32_UART1, tmp - lost1);
+      buffered_puts(NEORV32_UART1, " character(s) lost]\n");
+      lost1 = tmp;
+    }
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Write string to the TX ring buffer of a UART. Waits for free space if the ring buffer
+ * is full (the TX ring buffer is drained by polling if interrupts are disabled).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] s Pointer to zero-terminated string.
+ **************************************************************************/
+void buffered_puts(neorv32_uart_t *UARTx, const char *s) {
+
+  int len = (int)strlen(s);
+  int cnt = 0;
+
+  while (1) {
+    cnt += neorv32_uart_buffered_write(UARTx, s + cnt, len - cnt);
+    if (cnt >= len) {
+      break;
+    }
+    neorv32_uart_buffered_flush(UARTx); // ring buffer full: wait until it has been sent
+  }
+}
+
+
+/**********************************************************************//**
+ * Write unsigned number in decimal representation to the TX ring buffer of a UART.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] num Number to print.
+ **************************************************************************/
+void buffered_putu(neorv32_uart_t *UARTx, uint32_t num) {
+
+  char str[11];
+  int i = 10;
+
+  str[i] = '\0';
+  do {
+    str[--i] = '0' + (char)(num % 10);
+    num /= 10;
+  } while (num);
+
+  buffered_puts(UARTx, &str[i]);
+}
+
+
+/**********************************************************************//**
+ * Read all characters from the RX ring buffer of UARTx, echo them via UARTx and forward
+ * them to UARTy. Sending '!' via UART0 issues an environment call.
+ *
+ * @param[in,out] UARTx Source UART.
+ * @param[in,out] UARTy Destination UART.
+ * @param[in] name Name of the source UART.
+ **************************************************************************/
+void bridge(neorv32_uart_t *UARTx, neorv32_uart_t *UARTy, const char *name) {
+
+  char buf[16];
+  int i, num;
+
+  while ((num = neorv32_uart_buffered_read(UARTx, buf, (int)sizeof(buf)-1)) != 0) {
+    buf[num] = '\0';
+
+    buffered_puts(UARTx, buf); // echo
+    buffered_puts(UARTy, "[");
+    buffered_puts(UARTy, name);
+    buffered_puts(UARTy, "] ");
+    buffered_puts(UARTy, buf); // forward
+    buffered_puts(UARTy, "\n");
+
+    if (UARTx == NEORV32_UART0) {
+      for (i=0; i<num; i++) {
+        if (buf[i] == '!') {
+          asm volatile ("ecall");
+        }
+      }
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * ECALL trap handler. Prints a status report via the UART0 TX ring buffer. Since interrupts
+ * are disabled while executing a trap handler the TX interrupt cannot drain the ring buffer;
+ * neorv32_uart_buffered_flush() sends the pending data by polling instead.
+ *
+ * @warning This function has to be of type "void xyz(void)" and must not use any interrupt attributes!
+ **************************************************************************/
+void ecall_handler(void) {
+
+  ecall_cnt++;
+
+  buffered_puts(NEORV32_UART0, "\n[ECALL #");
+  buffered_putu(NEORV32_UART0, ecall_cnt);
+  buffered_puts(NEORV32_UART0, "] UART0: RX available = ");
+  buffered_putu(NEORV32_UART0, (uint32_t)neorv32_uart_buffered_rx_available(NEORV32_UART0));
+  buffered_puts(NEORV32_UART0, ", TX free = ");
+  buffered_putu(NEORV32_UART0, (uint32_t)neorv32_uart_buffered_tx_free(NEORV32_UART0));
+  buffered_puts(NEORV32_UART0, ", RX lost = ");
+  buffered_putu(NEORV32_UART0, neorv32_uart_buffered_rx_lost(NEORV32_UART0));
+  buffered_puts(NEORV32_UART0, "; UART1: RX lost = ");
+  buffered_putu(NEORV32_UART0, neorv32_uart_buffered_rx_lost(NEORV32_UART1));
+  buffered_puts(NEORV32_UART0, "\n");
+
+  neorv32_uart_buffered_flush(NEORV32_UART0); // polled (interrupts are disabled)
+}
@@ -54,6 +54,10 @@
 #define FLASH_ABYTES 3
 /** XIP SPI clock prescaler select */
 #define XIP_CLK_PRSC CLK_PRSC_128
+/** Use quad I/O flash reads when 1 (requires the flash's quad-enable bit to be set), single-bit SPI reads when 0 */
+#define XIP_QUAD_EN 0
+/** XIP dummy clock cycles (quad I/O mode only) */
+#define XIP_DUMMY 4
 /** Executable RAM buffer size in bytes */
 #define BUFFER_SIZE (7*1024)
 /**@}*/
@@ -65,6 +69,7 @@
 enum SPI_FLASH_CMD {
   SPI_FLASH_CMD_WRITE         = 0x02, /**< Write data */
   SPI_FLASH_CMD_READ          = 0x03, /**< Read data */
+  SPI_FLASH_CMD_READ_QUAD_IO  = 0xEB, /**< Fast read quad I/O */
   SPI_FLASH_CMD_READ_STATUS   = 0x05, /**< Get status register */
   SPI_FLASH_CMD_WRITE_ENABLE  = 0x06, /**< Allow write access */
   SPI_FLASH_CMD_SECTOR_ERASE  = 0xD8  /**< Erase complete sector */
@@ -139,6 +144,11 @@ int main() {
   // -> this function will also send 64 dummy clock cycles via the XIP's SPI port (with CS disabled)
   neorv32_xip_setup(XIP_CLK_PRSC, 4, 0, 0, SPI_FLASH_CMD_READ);
 
+  // optional: use quad I/O reads (flash read command = SPI_FLASH_CMD_READ_QUAD_IO, XIP_DUMMY dummy cycles) for XIP accesses
+  if (XIP_QUAD_EN) {
+    neorv32_xip_quad_setup(SPI_FLASH_CMD_READ_QUAD_IO, XIP_DUMMY);
+  }
+
   neorv32_uart0_printf("XIP SPI clock speed: %u Hz\n\n", neorv32_xip_get_clock_speed());
 
 
@@ -77,6 +77,8 @@
 #define RUN_ADDSUB_TESTS   (1)
 //** Run multiplication tests when != 0 */
 #define RUN_MUL_TESTS      (1)
+//** Run fused multiply-add tests when != 0 */
+#define RUN_FMA_TESTS      (1)
 //** Run min/max tests when != 0 */
 #define RUN_MINMAX_TESTS   (1)
 //** Run comparison tests when != 0 */
@@ -126,6 +128,7 @@ int main() {
   uint32_t i = 0;
   float_conv_t opa;
   float_conv_t opb;
+  float_conv_t opc;
   float_conv_t res_hw;
   float_conv_t res_sw;
 
@@ -356,6 +359,69 @@ int main() {
 #endif
 
 
+// ----------------------------------------------------------------------------
+// Fused Multiply-Add Tests
+// ----------------------------------------------------------------------------
+
+#if (RUN_FMA_TESTS != 0)
+  neorv32_uart0_printf("\n#%u: FMADD.S (fused multiply-add)...\n", test_cnt);
+  err_cnt = 0;
+  for (i=0;i<(uint32_t)NUM_TEST_CASES; i++) {
+    opa.binary_value = get_test_vector();
+    opb.binary_value = get_test_vector();
+    opc.binary_value = get_test_vector();
+    res_hw.float_value = riscv_intrinsic_fmadds(opa.float_value, opb.float_value, opc.float_value);
+    res_sw.float_value = riscv_emulate_fmadds(opa.float_value, opb.float_value, opc.float_value);
+    err_cnt += verify_result(i, opa.binary_value, opb.binary_value, res_sw.binary_value, res_hw.binary_value);
+  }
+  print_report(err_cnt);
+  err_cnt_total += err_cnt;
+  test_cnt++;
+
+  neorv32_uart0_printf("\n#%u: FMSUB.S (fused multiply-sub)...\n", test_cnt);
+  err_cnt = 0;
+  for (i=0;i<(uint32_t)NUM_TEST_CASES; i++) {
+    opa.binary_value = get_test_vector();
+    opb.binary_value = get_test_vector();
+    opc.binary_value = get_test_vector();
+    res_hw.float_value = riscv_intrinsic_fmsubs(opa.float_value, opb.float_value, opc.float_value);
+    res_sw.float_value = riscv_emulate_fmsubs(opa.float_value, opb.float_value, opc.float_value);
+    err_cnt += verify_result(i, opa.binary_value, opb.binary_value, res_sw.binary_value, res_hw.binary_value);
+  }
+  print_report(err_cnt);
+  err_cnt_total += err_cnt;
+  test_cnt++;
+
+  neorv32_uart0_printf("\n#%u: FNMSUB.S (fused negated multiply-sub)...\n", test_cnt);
+  err_cnt = 0;
+  for (i=0;i<(uint32_t)NUM_TEST_CASES; i++) {
+    opa.binary_value = get_test_vector();
+    opb.binary_value = get_test_vector();
+    opc.binary_value = get_test_vector();
+    res_hw.float_value = riscv_intrinsic_fnmsubs(opa.float_value, opb.float_value, opc.float_value);
+    res_sw.float_value = riscv_emulate_fnmsubs(opa.float_value, opb.float_value, opc.float_value);
+    err_cnt += verify_result(i, opa.binary_value, opb.binary_value, res_sw.binary_value, res_hw.binary_value);
+  }
+  print_report(err_cnt);
+  err_cnt_total += err_cnt;
+  test_cnt++;
+
+  neorv32_uart0_printf("\n#%u: FNMADD.S (fused negated multiply-add)...\n", test_cnt);
+  err_cnt = 0;
+  for (i=0;i<(uint32_t)NUM_TEST_CASES; i++) {
+    opa.binary_value = get_test_vector();
+    opb.binary_value = get_test_vector();
+    opc.binary_value = get_test_vector();
+    res_hw.float_value = riscv_intrinsic_fnmadds(opa.float_value, opb.float_value, opc.float_value);
+    res_sw.float_value = riscv_emulate_fnmadds(opa.float_value, opb.float_value, opc.float_value);
+    err_cnt += verify_result(i, opa.binary_value, opb.binary_value, res_sw.binary_value, res_hw.binary_value);
+  }
+  print_report(err_cnt);
+  err_cnt_total += err_cnt;
+  test_cnt++;
+#endif
+
+
 // ----------------------------------------------------------------------------
 // Min/Max Tests
 // ----------------------------------------------------------------------------
@@ -530,58 +596,6 @@ int main() {
   else {
     neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
   }
-
-  neorv32_uart0_printf("\n# unsupported FMADD.S (fused multiply-add) [illegal instruction]...\n");
-  neorv32_cpu_csr_write(CSR_MCAUSE, 0);
-  opa.binary_value = get_test_vector();
-  opb.binary_value = get_test_vector();
-  riscv_intrinsic_fmadds(opa.float_value, opb.float_value, -opa.float_value);
-  if (neorv32_cpu_csr_read(CSR_MCAUSE) != TRAP_CODE_I_ILLEGAL) {
-    neorv32_uart0_printf("%c[1m[FAILED]%c[0m\n", 27, 27);
-    err_cnt_total++;
-  }
-  else {
-    neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
-  }
-
-  neorv32_uart0_printf("\n# unsupported FMSUB.S (fused multiply-sub) [illegal instruction]...\n");
-  neorv32_cpu_csr_write(CSR_MCAUSE, 0);
-  opa.binary_value = get_test_vector();
-  opb.binary_value = get_test_vector();
-  riscv_intrinsic_fmsubs(opa.float_value, opb.float_value, -opa.float_value);
-  if (neorv32_cpu_csr_read(CSR_MCAUSE) != TRAP_CODE_I_ILLEGAL) {
-    neorv32_uart0_printf("%c[1m[FAILED]%c[0m\n", 27, 27);
-    err_cnt_total++;
-  }
-  else {
-    neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
-  }
-
-  neorv32_uart0_printf("\n# unsupported FNMSUB.S (fused negated multiply-sub) [illegal instruction]...\n");
-  neorv32_cpu_csr_write(CSR_MCAUSE, 0);
-  opa.binary_value = get_test_vector();
-  opb.binary_value = get_test_vector();
-  riscv_intrinsic_fnmadds(opa.float_value, opb.float_value, -opa.float_value);
-  if (neorv32_cpu_csr_read(CSR_MCAUSE) != TRAP_CODE_I_ILLEGAL) {
-    neorv32_uart0_printf("%c[1m[FAILED]%c[0m\n", 27, 27);
-    err_cnt_total++;
-  }
-  else {
-    neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
-  }
-
-  neorv32_uart0_printf("\n# unsupported FNMADD.S (fused negated multiply-add) [illegal instruction]...\n");
-  neorv32_cpu_csr_write(CSR_MCAUSE, 0);
-  opa.binary_value = get_test_vector();
-  opb.binary_value = get_test_vector();
-  riscv_intrinsic_fnmadds(opa.float_value, opb.float_value, -opa.float_value);
-  if (neorv32_cpu_csr_read(CSR_MCAUSE) != TRAP_CODE_I_ILLEGAL) {
-    neorv32_uart0_printf("%c[1m[FAILED]%c[0m\n", 27, 27);
-    err_cnt_total++;
-  }
-  else {
-    neorv32_uart0_printf("%c[1m[ok]%c[0m\n", 27, 27);
-  }
 #endif
 
 
@@ -785,6 +799,45 @@ int main() {
   }
 
 
+  // fused multiply-add
+  neorv32_uart0_printf("FMADD.S:  ");
+  time_sw = 0;
+  time_hw = 0;
+  err_cnt = 0;
+  for (i=0; i<num_runs; i++) {
+    opa.binary_value = get_test_vector();
+    opb.binary_value = get_test_vector();
+    opc.binary_value = get_test_vector();
+
+    // hardware execution time
+    time_start = neorv32_cpu_csr_read(CSR_CYCLE);
+    {
+      res_hw.float_value = riscv_intrinsic_fmadds(opa.float_value, opb.float_value, opc.float_value);
+    }
+    time_hw += neorv32_cpu_csr_read(CSR_CYCLE) - time_start;
+    time_hw -= 4; // remove the 2 dummy instructions
+
+    // software (emulation) execution time
+    time_start = neorv32_cpu_csr_read(CSR_CYCLE);
+    {
+      res_sw.float_value = riscv_emulate_fmadds(opa.float_value, opb.float_value, opc.float_value);
+    }
+    time_sw += neorv32_cpu_csr_read(CSR_CYCLE) - time_start;
+
+    if (res_sw.binary_value != res_hw.binary_value) {
+      err_cnt++;
+    }
+  }
+
+  if (err_cnt == 0) {
+    neorv32_uart0_printf("cycles[SW] = %u vs. cycles[HW] = %u\n", time_sw/num_runs, time_hw/num_runs);
+  }
+  else {
+    neorv32_uart0_printf("%c[1m[TEST FAILED!]%c[0m\n", 27, 27);
+    err_cnt_total++;
+  }
+
+
   // Max
   neorv32_uart0_printf("FMAX.S:   ");
   time_sw = 0;
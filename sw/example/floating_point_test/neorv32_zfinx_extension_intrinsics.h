@@ -425,8 +425,6 @@ inline float __attribute__ ((always_inline)) riscv_intrinsic_fsqrts(float rs1) {
 /**********************************************************************//**
  * Single-precision floating-point fused multiply-add
  *
- * @warning This instruction is not supported and should raise an illegal instruction exception when executed.
- *
  * @param[in] rs1 Source operand 1
  * @param[in] rs2 Source operand 2
  * @param[in] rs3 Source operand 3
@@ -447,8 +445,6 @@ inline float __attribute__ ((always_inline)) riscv_intrinsic_fmadds(float rs1, f
 /**********************************************************************//**
  * Single-precision floating-point fused multiply-sub
  *
- * @warning This instruction is not supported and should raise an illegal instruction exception when executed.
- *
  * @param[in] rs1 Source operand 1
  * @param[in] rs2 Source operand 2
  * @param[in] rs3 Source operand 3
@@ -469,8 +465,6 @@ inline float __attribute__ ((always_inline)) riscv_intrinsic_fmsubs(float rs1, f
 /**********************************************************************//**
  * Single-precision floating-point fused negated multiply-sub
  *
- * @warning This instruction is not supported and should raise an illegal instruction exception when executed.
- *
  * @param[in] rs1 Source operand 1
  * @param[in] rs2 Source operand 2
  * @param[in] rs3 Source operand 3
@@ -491,8 +485,6 @@ inline float __attribute__ ((always_inline)) riscv_intrinsic_fnmsubs(float rs1,
 /**********************************************************************//**
  * Single-precision floating-point fused negated multiply-add
  *
- * @warning This instruction is not supported and should raise an illegal instruction exception when executed.
- *
  * @param[in] rs1 Source operand 1
  * @param[in] rs2 Source operand 2
  * @param[in] rs3 Source operand 3
@@ -1005,9 +997,48 @@ float __attribute__ ((noinline)) riscv_emulate_fsqrts(float rs1) {
 
 
 /**********************************************************************//**
- * Single-precision floating-point fused multiply-add
+ * Fused multiply-add helper: rs1 * rs2 + rs3 using a single rounding step.
+ *
+ * @note The product is exact in double precision. The rounding error of the
+ * double-precision sum is recovered (TwoSum) and used to "round to odd", so the
+ * final conversion to single precision does not suffer from double rounding.
  *
- * @warning This instruction is not supported!
+ * @param[in] rs1 Source operand 1
+ * @param[in] rs2 Source operand 2
+ * @param[in] rs3 Source operand 3
+ * @return Result.
+ **************************************************************************/
+float fused_multiply_add(float rs1, float rs2, float rs3) {
+
+  union {
+    double   float_value;
+    uint64_t binary_value;
+  } sum;
+
+  double prod = (double)rs1 * (double)rs2;
+  double add  = (double)rs3;
+
+  sum.float_value = prod + add;
+
+  if (isfinite(sum.float_value)) {
+    double tmp = sum.float_value - prod;
+    double err = (add - tmp) + (prod - (sum.float_value - tmp));
+    if ((err != 0.0) && ((sum.binary_value & 1) == 0)) { // inexact: force LSB towards the exact result
+      if ((err > 0.0) == (sum.float_value > 0.0)) {
+        sum.binary_value++;
+      }
+      else {
+        sum.binary_value--;
+      }
+    }
+  }
+
+  return (float)sum.float_value;
+}
+
+
+/**********************************************************************//**
+ * Single-precision floating-point fused multiply-add
  *
  * @param[in] rs1 Source operand 1
  * @param[in] rs2 Source operand 2
@@ -1020,7 +1051,7 @@ float __attribute__ ((noinline)) riscv_emulate_fmadds(float rs1, float rs2, floa
   float opb = subnormal_flush(rs2);
   float opc = subnormal_flush(rs3);
 
-  float res = (opa * opb) + opc;
+  float res = fused_multiply_add(opa, opb, opc);
   return subnormal_flush(res);
 }
 
@@ -1039,7 +1070,7 @@ float __attribute__ ((noinline)) riscv_emulate_fmsubs(float rs1, float rs2, floa
   float opb = subnormal_flush(rs2);
   float opc = subnormal_flush(rs3);
 
-  float res = (opa * opb) - opc;
+  float res = fused_multiply_add(opa, opb, -opc);
   return subnormal_flush(res);
 }
 
@@ -1058,7 +1089,7 @@ float __attribute__ ((noinline)) riscv_emulate_fnmsubs(float rs1, float rs2, flo
   float opb = subnormal_flush(rs2);
   float opc = subnormal_flush(rs3);
 
-  float res = -(opa * opb) + opc;
+  float res = fused_multiply_add(-opa, opb, opc);
   return subnormal_flush(res);
 }
 
@@ -1077,7 +1108,7 @@ float __attribute__ ((noinline)) riscv_emulate_fnmadds(float rs1, float rs2, flo
   float opb = subnormal_flush(rs2);
   float opc = subnormal_flush(rs3);
 
-  float res = -(opa * opb) - opc;
+  float res = fused_multiply_add(-opa, opb, -opc);
   return subnormal_flush(res);
 }
 
@@ -0,0 +1,286 @@
+// #################################################################################################
+// # << NEORV32 - Performance Regression Benchmark Suite >>                                        #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * @file perf_suite/main.c
+ * @author Stephan Nolting
+ * @brief Performance regression benchmark suite. Runs a fixed set of kernels and prints the
+ * according counter values in a machine-parsable format (one "PERF" line per kernel).
+ **************************************************************************/
+#include <neorv32.h>
+#include <string.h>
+
+
+/**********************************************************************//**
+ * @name User configuration
+ **************************************************************************/
+/**@{*/
+/** UART BAUD rate */
+#define BAUD_RATE 19200
+/** Size of the memcpy/memset/CRC data buffers in bytes */
+#define BUF_SIZE 1024
+/** Size of the d-cache miss stream buffer in bytes */
+#define STREAM_SIZE 2048
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Counter snapshot (mcycle, minstret and the HPM counters 3..5)
+ **************************************************************************/
+/**@{*/
+#define NUM_HPM 3
+static uint32_t perf_cnt[2 + NUM_HPM];
+static int perf_hpm_num;
+/**@}*/
+
+// kernel data
+static uint8_t buf_src[BUF_SIZE], buf_dst[BUF_SIZE];
+static volatile uint32_t buf_stream[STREAM_SIZE/4];
+static volatile uint32_t irq_flag;
+static volatile float float_in = 1.2345f;
+static volatile float float_out;
+static volatile uint32_t stream_out;
+
+// prototypes
+void perf_start(void);
+void perf_stop(void);
+void perf_print(const char *name);
+void mtime_irq_handler(void);
+
+
+/**********************************************************************//**
+ * Main function
+ *
+ * @note This program requires the CPU Zicntr extension, UART0 and MTIME. The CRC kernel requires the CRC
+ * module, the HPM columns require the Zihpm extension (with at least 3 HPM counters); they are zero otherwise.
+ *
+ * @return 0 if execution was successful
+ **************************************************************************/
+int main() {
+
+  int i;
+  uint32_t tmp;
+  float x, y;
+
+  // initialize NEORV32 run-time environment
+  neorv32_rte_setup();
+
+  // setup UART at default baud rate, no interrupts
+  neorv32_uart0_setup(BAUD_RATE, 0);
+
+  // check if UART0 is implemented
+  if (neorv32_uart0_available() == 0) {
+    return 1; // UART0 not available, exit
+  }
+
+  // intro
+  neorv32_uart0_printf("\n<<< NEORV32 Performance Regression Suite >>>\n"
+                       "PERF <kernel> <mcycle> <minstret> <lsu_wait> <dcache_miss> <irq_wait>\n");
+
+  // check if base counters are implemented
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZICNTR)) == 0) {
+    neorv32_uart0_printf("ERROR! Zicntr CPU extension not implemented!\n");
+    return 1;
+  }
+
+  // configure HPM counters (if available)
+  perf_hpm_num = 0;
+  if (neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_ZIHPM)) {
+    if (neorv32_cpu_hpm_get_num_counters() >= NUM_HPM) {
+      perf_hpm_num = NUM_HPM;
+    }
+  }
+  if (perf_hpm_num) {
+    neorv32_cpu_csr_write(CSR_MHPMEVENT3, 1 << HPMCNT_EVENT_WAIT_LSU);
+    neorv32_cpu_csr_write(CSR_MHPMEVENT4, 1 << HPMCNT_EVENT_DC_MISS);
+    neorv32_cpu_csr_write(CSR_MHPMEVENT5, 1 << HPMCNT_EVENT_IRQ_WAIT);
+  }
+
+  // initialize data buffers
+  for (i=0; i<BUF_SIZE; i++) {
+    buf_src[i] = (uint8_t)(i * 7);
+  }
+
+
+  // ----------------------------------------------------------
+  // memory copy / fill (C library)
+  // ----------------------------------------------------------
+  perf_start();
+  memcpy(buf_dst, buf_src, BUF_SIZE);
+  perf_stop();
+  perf_print("memcpy_1k");
+
+  perf_start();
+  memset(buf_dst, 0xA5, BUF_SIZE);
+  perf_stop();
+  perf_print("memset_1k");
+
+
+  // ----------------------------------------------------------
+  // CRC32 using the CRC module
+  // ----------------------------------------------------------
+  if (neorv32_crc_available()) {
+    neorv32_crc_setup(CRC_MODE32, 0x04C11DB7, 0xFFFFFFFF);
+    perf_start();
+    neorv32_crc_block(buf_src, BUF_SIZE);
+    perf_stop();
+    perf_print("crc32_1k");
+  }
+
+
+  // ----------------------------------------------------------
+  // single-precision floating-point math (Zfinx or soft-float)
+  // ----------------------------------------------------------
+  perf_start();
+  x = float_in;
+  y = 0.0f;
+  for (i=0; i<32; i++) { // polynomial evaluation (Horner) plus one division per iteration
+    y = (y * x) + 0.5f;
+    y = y / (x + 1.0f);
+  }
+  float_out = y;
+  perf_stop();
+  perf_print("float_32");
+
+
+  // ----------------------------------------------------------
+  // formatted output; UART0 is put into simulation mode to measure the formatting only
+  // (the output is discarded by real hardware)
+  // ----------------------------------------------------------
+  while (neorv32_uart0_tx_busy()); // make sure all previous output has been sent
+  NEORV32_UART0->CTRL |= 1 << UART_CTRL_SIM_MODE;
+  perf_start();
+  neorv32_uart0_printf("%s: %i 0x%x %u\n", "printf", -123456, 0xcafe1234, 987654321);
+  perf_stop();
+  NEORV32_UART0->CTRL &= ~(1 << UART_CTRL_SIM_MODE);
+  perf_print("printf");
+
+
+  // ----------------------------------------------------------
+  // interrupt latency: MTIME interrupt via the RTE
+  // ----------------------------------------------------------
+  if (neorv32_mtime_available()) {
+    neorv32_rte_handler_install(RTE_TRAP_MTI, mtime_irq_handler);
+    neorv32_mtime_set_timecmp(-1);
+    neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_MTIE);
+    neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    irq_flag = 0;
+    perf_start();
+    neorv32_mtime_set_timecmp(neorv32_mtime_get_time() + 100);
+    while (irq_flag == 0);
+    perf_stop();
+    neorv32_cpu_csr_clr(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+    neorv32_cpu_csr_clr(CSR_MIE, 1 << CSR_MIE_MTIE);
+    perf_print("irq_mtime");
+  }
+
+
+  // ----------------------------------------------------------
+  // d-cache miss stream: sequential read of a buffer that is larger than the cache
+  // ----------------------------------------------------------
+  asm volatile ("fence"); // write-back and clear data cache
+  perf_start();
+  tmp = 0;
+  for (i=0; i<(STREAM_SIZE/4); i++) {
+    tmp += buf_stream[i];
+  }
+  stream_out = tmp;
+  perf_stop();
+  perf_print("dcache_stream_2k");
+
+
+  neorv32_uart0_printf("PERF_END\n");
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Reset and start all counters.
+ **************************************************************************/
+void __attribute__ ((noinline)) perf_start(void) {
+
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, -1);
+  neorv32_cpu_csr_write(CSR_MCYCLE, 0);
+  neorv32_cpu_csr_write(CSR_MINSTRET, 0);
+  if (perf_hpm_num) { // CSR numbers have to be compile-time constants
+    neorv32_cpu_csr_write(CSR_MHPMCOUNTER3, 0);
+    neorv32_cpu_csr_write(CSR_MHPMCOUNTER4, 0);
+    neorv32_cpu_csr_write(CSR_MHPMCOUNTER5, 0);
+  }
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, 0);
+}
+
+
+/**********************************************************************//**
+ * Stop all counters and take a snapshot.
+ **************************************************************************/
+void __attribute__ ((noinline)) perf_stop(void) {
+
+  int i;
+
+  neorv32_cpu_csr_write(CSR_MCOUNTINHIBIT, -1);
+  perf_cnt[0] = neorv32_cpu_csr_read(CSR_MCYCLE);
+  perf_cnt[1] = neorv32_cpu_csr_read(CSR_MINSTRET);
+  for (i=0; i<NUM_HPM; i++) {
+    perf_cnt[2+i] = 0;
+  }
+  if (perf_hpm_num) {
+    perf_cnt[2] = neorv32_cpu_csr_read(CSR_MHPMCOUNTER3);
+    perf_cnt[3] = neorv32_cpu_csr_read(CSR_MHPMCOUNTER4);
+    perf_cnt[4] = neorv32_cpu_csr_read(CSR_MHPMCOUNTER5);
+  }
+}
+
+
+/**********************************************************************//**
+ * Print the last counter snapshot as machine-parsable result line.
+ *
+ * @param[in] name Kernel name (no white spaces, max 16 characters).
+ **************************************************************************/
+void perf_print(const char *name) {
+
+  neorv32_uart0_printf("PERF %s %u %u %u %u %u\n", name,
+                       perf_cnt[0], perf_cnt[1], perf_cnt[2], perf_cnt[3], perf_cnt[4]);
+}
+
+
+/**********************************************************************//**
+ * MTIME interrupt handler.
+ **************************************************************************/
+void mtime_irq_handler(void) {
+
+  neorv32_mtime_set_timecmp(-1); // no more interrupts
+  irq_flag = 1;
+}
@@ -930,6 +930,49 @@ int main() {
   }
 
 
+  // ----------------------------------------------------------
+  // HPM counter overflow interrupt (LCOFI)
+  // ----------------------------------------------------------
+  neorv32_cpu_csr_write(CSR_MCAUSE, mcause_never_c);
+  PRINT_STANDARD("[%i] LCOFI IRQ ", cnt_test);
+
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_SSCOFPMF)) && (num_hpm_cnts_global > 9)) {
+    cnt_test++;
+
+    // configure HPM counter 12 to overflow after a few active cycles
+    neorv32_cpu_csr_set(CSR_MCOUNTINHIBIT, 1 << 12);
+    neorv32_cpu_csr_write(CSR_MHPMEVENT12H, 0); // clear overflow flag
+    neorv32_cpu_csr_write(CSR_MHPMEVENT12, 1 << HPMCNT_EVENT_CY);
+    neorv32_cpu_csr_write(CSR_MHPMCOUNTER12H, -1);
+    neorv32_cpu_csr_write(CSR_MHPMCOUNTER12, -4);
+    // enable interrupt
+    neorv32_cpu_csr_write(CSR_MIE, 1 << CSR_MIE_LCOFIE);
+    neorv32_cpu_csr_clr(CSR_MCOUNTINHIBIT, 1 << 12);
+
+    // wait some time for the counter to overflow
+    asm volatile ("nop");
+    asm volatile ("nop");
+    asm volatile ("nop");
+    asm volatile ("nop");
+
+    neorv32_cpu_csr_write(CSR_MIE, 0);
+    neorv32_cpu_csr_set(CSR_MCOUNTINHIBIT, 1 << 12);
+    neorv32_cpu_csr_write(CSR_MHPMEVENT12, 0);
+
+    if ((neorv32_cpu_csr_read(CSR_MCAUSE) == TRAP_CODE_LCOFI) &&
+        (neorv32_cpu_csr_read(CSR_MHPMEVENT12H) == (1 << CSR_MHPMEVENTH_OF)) && // overflow flag has to be set
+        ((neorv32_cpu_csr_read(CSR_MIP) & (1 << CSR_MIP_LCOFIP)) == 0)) { // cleared by trap handler
+      test_ok();
+    }
+    else {
+      test_fail();
+    }
+  }
+  else {
+    PRINT_STANDARD("[n.a.]\n");
+  }
+
+
   // ----------------------------------------------------------
   // Machine software interrupt (MSI) via testbench
   // ----------------------------------------------------------
@@ -1498,6 +1541,7 @@ int main() {
 
     // setup source data
     dma_src = 0x7788ee11;
+    asm volatile ("fence"); // flush d-cache (write-back dirty blocks)
 
     // setup CRC unit
     neorv32_crc_setup(CRC_MODE32, 0x4C11DB7, 0xFFFFFFFF);
@@ -1726,6 +1770,56 @@ int main() {
   }
 
 
+  // ----------------------------------------------------------
+  // XIP flash read: single-bit SPI vs. quad I/O (testbench flash model)
+  // ----------------------------------------------------------
+  neorv32_cpu_csr_write(CSR_MCAUSE, mcause_never_c);
+  PRINT_STANDARD("[%i] XIP quad I/O ", cnt_test);
+
+  if ((NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_XIP)) && (NEORV32_XIP->CTRL & (1 << XIP_CTRL_BURST_EN))) {
+    cnt_test++;
+
+    uint32_t xip_data[4];
+
+    // single-bit SPI: read command 0x03, 3 address bytes
+    neorv32_xip_setup(CLK_PRSC_2, 0, 0, 0, 0x03);
+    neorv32_xip_start(3);
+    asm volatile ("fence"); // reload d-cache
+    tmp_a = neorv32_cpu_csr_read(CSR_MCYCLE);
+    xip_data[0] = neorv32_cpu_load_unsigned_word(XIP_MEM_BASE_ADDRESS + 0x100); // XIP cache block refill
+    tmp_a = neorv32_cpu_csr_read(CSR_MCYCLE) - tmp_a;
+    xip_data[1] = neorv32_cpu_load_unsigned_word(XIP_MEM_BASE_ADDRESS + 0x1fc); // last word of block
+
+    // quad I/O: read command 0xEB, 3 address bytes, 2 mode cycles, 4 dummy cycles
+    neorv32_xip_setup(CLK_PRSC_2, 0, 0, 0, 0x03);
+    neorv32_xip_quad_setup(0xEB, 4);
+    neorv32_xip_start(3);
+    asm volatile ("fence"); // reload d-cache
+    tmp_b = neorv32_cpu_csr_read(CSR_MCYCLE);
+    xip_data[2] = neorv32_cpu_load_unsigned_word(XIP_MEM_BASE_ADDRESS + 0x100); // XIP cache block refill
+    tmp_b = neorv32_cpu_csr_read(CSR_MCYCLE) - tmp_b;
+    xip_data[3] = neorv32_cpu_load_unsigned_word(XIP_MEM_BASE_ADDRESS + 0x1fc); // last word of block
+
+    // shut down XIP module
+    NEORV32_XIP->CTRL = 0;
+    asm volatile ("fence"); // reload d-cache
+
+    // flash model: byte at address A = A(7:0)
+    if ((xip_data[0] == 0x03020100) && (xip_data[1] == 0xfffefdfc) &&
+        (xip_data[2] == 0x03020100) && (xip_data[3] == 0xfffefdfc) &&
+        ((tmp_b * 3) < tmp_a) && // quad I/O block refill has to be more than 3x faster
+        (neorv32_cpu_csr_read(CSR_MCAUSE) == mcause_never_c)) {
+      test_ok();
+    }
+    else {
+      test_fail();
+    }
+  }
+  else {
+    PRINT_STANDARD("[n.a.]\n");
+  }
+
+
   // ----------------------------------------------------------
   // RTE context modification
   // implemented as "system service call"
@@ -1967,8 +2061,8 @@ int main() {
   if (neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_A)) {
     cnt_test++;
 
-    // [NOTE] LR/SC operations bypass the data cache so we need to flush/reload
-    //        it before/after making "normal" load/store operations
+    // [NOTE] no fences here: the d-cache has to write back/invalidate the accessed block
+    //        before each LR/SC bus access on its own
 
     neorv32_cpu_invalidate_reservations(); // invalidate all current reservations
 
@@ -1976,11 +2070,9 @@ int main() {
 
     tmp_a = neorv32_cpu_load_reservate_word((uint32_t)&amo_var);
     amo_var = 0x10cafe00; // break reservation
-    asm volatile ("fence"); // flush/reload d-cache
     tmp_b = neorv32_cpu_store_conditional_word((uint32_t)&amo_var, 0xaaaaaaaa);
     tmp_b = (tmp_b << 1) | neorv32_cpu_store_conditional_word((uint32_t)&amo_var, 0xcccccccc); // another SC: must fail
     tmp_b = (tmp_b << 1) | neorv32_cpu_store_conditional_word((uint32_t)ADDR_UNREACHABLE, 0); // another SC: must fail; no bus exception!
-    asm volatile ("fence"); // flush/reload d-cache
 
     if ((tmp_a   == 0x00cafe00) && // correct LR.W result
         (amo_var == 0x10cafe00) && // atomic variable NOT updates by SC.W
@@ -2009,20 +2101,18 @@ int main() {
   if (neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_A)) {
     cnt_test++;
 
-    // [NOTE] LR/SC operations bypass the data cache so we need to flush/reload
-    //        it before/after making "normal" load/store operations
+    // [NOTE] no fences here: the d-cache has to write back/invalidate the accessed block
+    //        before each LR/SC bus access on its own
 
     neorv32_cpu_invalidate_reservations(); // invalidate all current reservations
 
     amo_var = 0x00abba00; // initialize
 
     tmp_a = neorv32_cpu_load_reservate_word((uint32_t)&amo_var);
-    asm volatile ("fence"); // flush/reload d-cache
     neorv32_cpu_load_unsigned_word((uint32_t)&amo_var); // dummy read, must not alter reservation set state
     tmp_b = neorv32_cpu_store_conditional_word((uint32_t)&amo_var, 0xcccccccc);
     tmp_b = (tmp_b << 1) | neorv32_cpu_store_conditional_word((uint32_t)&amo_var, 0xcccccccc); // another SC: must fail
     tmp_b = (tmp_b << 1) | neorv32_cpu_store_conditional_word((uint32_t)ADDR_UNREACHABLE, 0); // another SC: must fail; no bus exception!
-    asm volatile ("fence"); // flush/reload d-cache
 
     if ((tmp_a   == 0x00abba00) && // correct LR.W result
         (amo_var == 0xcccccccc) && // atomic variable WAS updates by SC.W
@@ -2040,6 +2130,38 @@ int main() {
 #endif
 
 
+  // ----------------------------------------------------------
+  // Test atomic read-modify-write access to cached data
+  // ----------------------------------------------------------
+#if defined __riscv_atomic
+  neorv32_cpu_csr_write(CSR_MCAUSE, mcause_never_c);
+  PRINT_STANDARD("[%i] AMO RMW (cached) ", cnt_test);
+
+  if (neorv32_cpu_csr_read(CSR_MISA) & (1 << CSR_MISA_A)) {
+    cnt_test++;
+
+    // [NOTE] no fences here: the d-cache has to write back/invalidate the accessed block
+    //        before the AMO bus access on its own
+
+    amo_var = 0x11223344; // normal store (cached, block becomes dirty in write-back mode)
+    tmp_a = neorv32_cpu_amo(amoadd.w, (uint32_t)&amo_var, 0x01010101);
+    tmp_b = amo_var; // normal load (has to re-fetch the block)
+
+    if ((tmp_a == 0x11223344) && // AMO has seen the stored data
+        (tmp_b == 0x12233445) && // load has seen the AMO result
+        (neorv32_cpu_csr_read(CSR_MCAUSE) == mcause_never_c)) { // no exception
+      test_ok();
+    }
+    else {
+      test_fail();
+    }
+  }
+  else {
+    PRINT_STANDARD("[n.a.]\n");
+  }
+#endif
+
+
   // ----------------------------------------------------------
   // Test physical memory protection
   // ----------------------------------------------------------
@@ -0,0 +1,1409 @@
+// #################################################################################################
+// # << NEORV32 - Host-side instruction-set simulator (ISS) >>                                     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2024, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEORV32 Processor - https://github.com/stnolting/neorv32              (c) Stephan Nolting #
+// #################################################################################################
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// -------------------------------------------------------------------------------------------------
+// Default configuration (matches the default VHDL testbench sim/neorv32_tb.vhd)
+// -------------------------------------------------------------------------------------------------
+#define DEF_CLK       100000000U // processor clock in Hz
+#define DEF_IMEM_SIZE (32*1024)  // IMEM size in bytes
+#define DEF_DMEM_SIZE (8*1024)   // DMEM size in bytes
+#define DEF_ITCM_SIZE 0          // ITCM size in bytes (0 = not implemented)
+#define DEF_DTCM_SIZE 0          // DTCM size in bytes (0 = not implemented)
+#define DEF_HPM_NUM   12         // number of HPM counters (0..13)
+#define DEF_HPM_WIDTH 40         // total HPM counter width (1..64)
+#define DEF_RADIX     2          // serial mul/div radix (2, 4, 16)
+#define DEF_EARLY     0          // serial mul/div early termination
+
+// processor version reported via mimpid (keep in sync with hw_version_c of rtl/core/neorv32_package.vhd)
+#define HW_VERSION 0x01090534U
+
+// executable signature ("magic word")
+const uint32_t signature = 0x4788CAFE;
+
+// address space (see sw/lib/include/neorv32.h)
+#define IMEM_BASE    0x00000000U
+#define DMEM_BASE    0x80000000U
+#define ITCM_BASE    0x10000000U
+#define DTCM_BASE    0x90000000U
+#define IO_BASE      0xFFFFE000U
+#define MTIME_BASE   0xFFFFF400U
+#define UART0_BASE   0xFFFFF500U
+#define SYSINFO_BASE 0xFFFFFE00U
+
+// trap codes (see NEORV32_EXCEPTION_CODES_enum in sw/lib/include/neorv32_cpu_csr.h)
+#define TRAP_IAF   0x00000001U // instruction access fault
+#define TRAP_II    0x00000002U // illegal instruction
+#define TRAP_BP    0x00000003U // breakpoint
+#define TRAP_LMA   0x00000004U // load address misaligned
+#define TRAP_LAF   0x00000005U // load access fault
+#define TRAP_SMA   0x00000006U // store address misaligned
+#define TRAP_SAF   0x00000007U // store access fault
+#define TRAP_MENV  0x0000000BU // environment call from M-mode
+#define TRAP_MTI   0x80000007U // machine timer interrupt
+#define TRAP_LCOFI 0x8000000DU // local counter overflow interrupt
+
+// mie/mip bits
+#define IRQ_MTI   7
+#define IRQ_LCOFI 13
+
+// HPM events (see NEORV32_HPMCNT_EVENT_enum in sw/lib/include/neorv32_cpu_csr.h)
+enum hpm_event_enum {
+  EV_CY       = 0,
+  EV_IR       = 2,
+  EV_COMPR    = 3,
+  EV_WAIT_ALU = 5,
+  EV_BRANCH   = 6,
+  EV_BRANCHED = 7,
+  EV_LOAD     = 8,
+  EV_STORE    = 9,
+  EV_TRAP     = 11
+};
+
+// simulation result
+enum sim_state_enum {SIM_RUN, SIM_EXIT, SIM_TIMEOUT, SIM_DEADLOCK};
+
+
+// -------------------------------------------------------------------------------------------------
+// Simulator state
+// -------------------------------------------------------------------------------------------------
+typedef struct {
+  uint32_t clk;        // processor clock in Hz (SYSINFO.CLK)
+  uint32_t imem_size;  // IMEM size in bytes
+  uint32_t dmem_size;  // DMEM size in bytes
+  uint32_t itcm_size;  // ITCM size in bytes (0 = not implemented)
+  uint32_t dtcm_size;  // DTCM size in bytes (0 = not implemented)
+  int      hpm_num;    // number of HPM counters
+  int      hpm_width;  // HPM counter width
+  int      radix;      // serial mul/div radix
+  int      early;      // serial mul/div early termination
+  int      fast_mul;   // DSP-based multiplier
+  int      fast_shift; // barrel shifter
+  uint64_t max_cycles; // abort simulation after this number of cycles (0 = never)
+  int      trace;      // print instruction trace to stderr
+} cfg_t;
+
+typedef struct {
+  uint32_t x[32];          // register file
+  uint32_t pc;             // program counter
+  // machine-mode CSRs
+  int      mstatus_mie;
+  int      mstatus_mpie;
+  uint32_t mie;
+  uint32_t mtvec;
+  uint32_t mscratch;
+  uint32_t mepc;
+  uint32_t mcause;
+  uint32_t mtval;
+  uint32_t mtinst;
+  int      lcofip;
+  uint32_t mcountinhibit;
+  // counters
+  uint64_t cycle;
+  uint64_t instret;
+  uint64_t hpm_cnt[13];
+  uint32_t hpm_event[13];
+  int      hpm_of[13];
+  uint32_t cnt_we;         // counters written by the current instruction (do not increment)
+  // reservation set controller
+  int      rsv_valid;
+  uint32_t rsv_addr;
+  // MTIME
+  uint64_t mtime;
+  uint64_t mtimecmp;
+  // UART0
+  uint32_t uart0_ctrl;
+  uint64_t uart0_tx_done;  // time at which the (non-simulation-mode) transmitter becomes idle
+  // free-running time base (not affected by mcountinhibit or counter writes)
+  uint64_t ticks;
+} cpu_t;
+
+typedef struct {
+  uint32_t addr;
+  uint32_t size;
+  char    *name;
+} sym_t;
+
+static cfg_t    cfg;
+static cpu_t    cpu;
+static uint8_t *imem, *dmem, *itcm, *dtcm;
+static uint64_t *prof_cyc, *prof_ir;      // per-halfword profile of the IMEM address space
+static uint64_t prof_other_cyc, prof_other_ir; // code executed outside of IMEM
+static sym_t   *syms;
+static int      num_syms;
+
+// per-instruction side-band information for the timing model / HPMs
+static uint32_t ev_cycles, ev_alu_wait, ev_mask;
+
+
+// -------------------------------------------------------------------------------------------------
+// Helpers
+// -------------------------------------------------------------------------------------------------
+static uint32_t get_le32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t get_le16(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static int32_t sext(uint32_t val, int bits) {
+  return (int32_t)(val << (32 - bits)) >> (32 - bits);
+}
+
+static uint64_t hpm_mask(void) {
+  return (cfg.hpm_width >= 64) ? ~0ULL : ((1ULL << cfg.hpm_width) - 1);
+}
+
+static int log2_ceil(uint32_t val) {
+  int i = 0;
+  while ((1U << i) < val) {
+    i++;
+  }
+  return i;
+}
+
+// SYSINFO.MEM byte 2: log2(ITCM size) in bits 3:0, log2(DTCM size) in bits 7:4 (zero if not implemented)
+static uint32_t tcm_info(void) {
+  uint32_t res = 0;
+  if (cfg.itcm_size) {
+    res |= (uint32_t)log2_ceil(cfg.itcm_size);
+  }
+  if (cfg.dtcm_size) {
+    res |= (uint32_t)log2_ceil(cfg.dtcm_size) << 4;
+  }
+  return res;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Memory and IO devices
+// -------------------------------------------------------------------------------------------------
+// get host pointer for a memory access, NULL if not backed by IMEM/DMEM/ITCM/DTCM
+static uint8_t *mem_ptr(uint32_t addr, uint32_t size) {
+  if ((addr - IMEM_BASE) <= (cfg.imem_size - size)) {
+    return &imem[addr - IMEM_BASE];
+  }
+  if ((addr - DMEM_BASE) <= (cfg.dmem_size - size)) {
+    return &dmem[addr - DMEM_BASE];
+  }
+  if ((cfg.itcm_size >= size) && ((addr - ITCM_BASE) <= (cfg.itcm_size - size))) {
+    return &itcm[addr - ITCM_BASE];
+  }
+  if ((cfg.dtcm_size >= size) && ((addr - DTCM_BASE) <= (cfg.dtcm_size - size))) {
+    return &dtcm[addr - DTCM_BASE];
+  }
+  return NULL;
+}
+
+// UART0 transmitter: simulation mode prints immediately, normal mode is timed by the BAUD configuration
+static void uart0_tx(uint32_t data) {
+  static const uint32_t prsc_tab[8] = {2, 4, 8, 64, 128, 1024, 2048, 4096};
+  if ((cpu.uart0_ctrl & 1U) == 0) { // UART disabled
+    return;
+  }
+  putchar((int)(data & 0xFFU));
+  if ((data & 0xFFU) == '\n') {
+    fflush(stdout);
+  }
+  if ((cpu.uart0_ctrl & 2U) == 0) { // real transmitter: start bit + 8 data bits + stop bit
+    uint32_t prsc = prsc_tab[(cpu.uart0_ctrl >> 3) & 7];
+    uint32_t baud = ((cpu.uart0_ctrl >> 6) & 0x3FFU) + 1;
+    cpu.uart0_tx_done = cpu.ticks + 10ULL * prsc * baud;
+  }
+}
+
+static int io_read(uint32_t addr, uint32_t *data) {
+  int busy;
+  switch (addr) {
+    // MTIME
+    case MTIME_BASE +  0: *data = (uint32_t)(cpu.mtime);         return 0;
+    case MTIME_BASE +  4: *data = (uint32_t)(cpu.mtime >> 32);    return 0;
+    case MTIME_BASE +  8: *data = (uint32_t)(cpu.mtimecmp);      return 0;
+    case MTIME_BASE + 12: *data = (uint32_t)(cpu.mtimecmp >> 32); return 0;
+    // UART0: single-entry FIFOs, no receiver
+    case UART0_BASE + 0:
+      busy = (cpu.ticks < cpu.uart0_tx_done) ? 1 : 0;
+      *data = (cpu.uart0_ctrl & 0x07C0FFFFU) | (busy ? ((1U << 21) | (1U << 31)) : ((1U << 19) | (1U << 20)));
+      return 0;
+    case UART0_BASE + 4: *data = 0; return 0;
+    // SYSINFO
+    case SYSINFO_BASE +  0: *data = cfg.clk; return 0;
+    case SYSINFO_BASE +  4: *data = (2U << 24) | (tcm_info() << 16) | ((uint32_t)log2_ceil(cfg.dmem_size) << 8) | (uint32_t)log2_ceil(cfg.imem_size); return 0;
+    case SYSINFO_BASE +  8: *data = (1U << 2) | (1U << 3) | (1U << 16) | (1U << 17); return 0; // IMEM, DMEM, MTIME, UART0
+    case SYSINFO_BASE + 12: *data = 0; return 0;
+    default: return -1; // not implemented: bus error
+  }
+}
+
+static int io_write(uint32_t addr, uint32_t data) {
+  switch (addr) {
+    case MTIME_BASE +  0: cpu.mtime    = (cpu.mtime    & 0xFFFFFFFF00000000ULL) | data;                return 0;
+    case MTIME_BASE +  4: cpu.mtime    = (cpu.mtime    & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); return 0;
+    case MTIME_BASE +  8: cpu.mtimecmp = (cpu.mtimecmp & 0xFFFFFFFF00000000ULL) | data;                return 0;
+    case MTIME_BASE + 12: cpu.mtimecmp = (cpu.mtimecmp & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); return 0;
+    case UART0_BASE + 0:  cpu.uart0_ctrl = data; return 0;
+    case UART0_BASE + 4:  uart0_tx(data); return 0;
+    case SYSINFO_BASE + 0: case SYSINFO_BASE + 4: case SYSINFO_BASE + 8: case SYSINFO_BASE + 12:
+      return 0; // read-only, writes are ignored
+    default: return -1; // not implemented: bus error
+  }
+}
+
+static int bus_read(uint32_t addr, uint32_t size, uint32_t *data) {
+  uint8_t *p = mem_ptr(addr, size);
+  uint32_t tmp;
+  if (p != NULL) {
+    if      (size == 4) { *data = get_le32(p); }
+    else if (size == 2) { *data = get_le16(p); }
+    else                { *data = p[0]; }
+    return 0;
+  }
+  if ((addr >= IO_BASE) && (io_read(addr & ~3U, &tmp) == 0)) {
+    *data = tmp >> (8 * (addr & 3));
+    return 0;
+  }
+  return -1;
+}
+
+static int bus_write(uint32_t addr, uint32_t size, uint32_t data) {
+  uint8_t *p = mem_ptr(addr, size);
+  uint32_t i;
+  if (cpu.rsv_valid && ((addr & ~3U) == cpu.rsv_addr)) { // any write to the reserved address
+    cpu.rsv_valid = 0;
+  }
+  if (p != NULL) {
+    for (i=0; i<size; i++) {
+      p[i] = (uint8_t)(data >> (8 * i));
+    }
+    return 0;
+  }
+  if (addr >= IO_BASE) {
+    return io_write(addr & ~3U, data << (8 * (addr & 3)));
+  }
+  return -1;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Compressed instructions: expand to 32-bit equivalent (0 = illegal)
+// -------------------------------------------------------------------------------------------------
+static uint32_t enc_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+  return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_i(int32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+  return (((uint32_t)imm & 0xFFFU) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+
+static uint32_t enc_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t op) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 5) & 0x7FU) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | ((i & 0x1FU) << 7) | op;
+}
+
+static uint32_t enc_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 12) & 1U) << 31) | (((i >> 5) & 0x3FU) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) |
+         (((i >> 1) & 0xFU) << 8) | (((i >> 11) & 1U) << 7) | 0x63U;
+}
+
+static uint32_t enc_j(int32_t imm, uint32_t rd) {
+  uint32_t i = (uint32_t)imm;
+  return (((i >> 20) & 1U) << 31) | (((i >> 1) & 0x3FFU) << 21) | (((i >> 11) & 1U) << 20) |
+         (((i >> 12) & 0xFFU) << 12) | (rd << 7) | 0x6FU;
+}
+
+static uint32_t decompress(uint32_t ci) {
+
+  uint32_t rd   = (ci >> 7) & 0x1FU; // full register fields
+  uint32_t rs2  = (ci >> 2) & 0x1FU;
+  uint32_t rdp  = 8 + ((ci >> 2) & 7U); // compressed register fields
+  uint32_t rs1p = 8 + ((ci >> 7) & 7U);
+  int32_t  imm6 = sext(((ci >> 7) & 0x20U) | ((ci >> 2) & 0x1FU), 6);
+  uint32_t shamt = ((ci >> 7) & 0x20U) | ((ci >> 2) & 0x1FU);
+  uint32_t tmp;
+
+  switch (((ci >> 11) & 0x1CU) | (ci & 3U)) { // funct3 & opcode
+    // quadrant 0
+    case 0x00: // c.addi4spn
+      tmp = ((ci >> 7) & 0x30U) | ((ci >> 1) & 0x3C0U) | ((ci >> 4) & 4U) | ((ci >> 2) & 8U);
+      return (tmp == 0) ? 0 : enc_i((int32_t)tmp, 2, 0, rdp, 0x13);
+    case 0x08: // c.lw
+      tmp = ((ci >> 7) & 0x38U) | ((ci >> 4) & 4U) | ((ci << 1) & 0x40U);
+      return enc_i((int32_t)tmp, rs1p, 2, rdp, 0x03);
+    case 0x18: // c.sw
+      tmp = ((ci >> 7) & 0x38U) | ((ci >> 4) & 4U) | ((ci << 1) & 0x40U);
+      return enc_s((int32_t)tmp, rdp, rs1p, 2, 0x23);
+    // quadrant 1
+    case 0x01: // c.addi, c.nop
+      return enc_i(imm6, rd, 0, rd, 0x13);
+    case 0x05: // c.jal
+    case 0x15: // c.j
+      tmp = ((ci >> 1) & 0x800U) | ((ci >> 7) & 0x10U) | ((ci >> 1) & 0x300U) | ((ci << 2) & 0x400U) |
+            ((ci >> 1) & 0x40U) | ((ci << 1) & 0x80U) | ((ci >> 2) & 0xEU) | ((ci << 3) & 0x20U);
+      return enc_j(sext(tmp, 12), (ci & 0x8000U) ? 0 : 1);
+    case 0x09: // c.li
+      return enc_i(imm6, 0, 0, rd, 0x13);
+    case 0x0D: // c.addi16sp, c.lui
+      if (rd == 2) {
+        tmp = ((ci >> 3) & 0x200U) | ((ci >> 2) & 0x10U) | ((ci << 1) & 0x40U) | ((ci << 4) & 0x180U) | ((ci << 3) & 0x20U);
+        return (tmp == 0) ? 0 : enc_i(sext(tmp, 10), 2, 0, 2, 0x13);
+      }
+      tmp = ((ci << 5) & 0x20000U) | ((ci << 10) & 0x1F000U);
+      return (tmp == 0) ? 0 : (((uint32_t)sext(tmp, 18) & 0xFFFFF000U) | (rd << 7) | 0x37U);
+    case 0x11: // misc-alu
+      switch ((ci >> 10) & 3U) {
+        case 0: return (shamt & 0x20U) ? 0 : enc_r(0x00, shamt, rs1p, 5, rs1p, 0x13); // c.srli
+        case 1: return (shamt & 0x20U) ? 0 : enc_r(0x20, shamt, rs1p, 5, rs1p, 0x13); // c.srai
+        case 2: return enc_i(imm6, rs1p, 7, rs1p, 0x13); // c.andi
+        default:
+          if (ci & 0x1000U) {
+            return 0;
+          }
+          switch ((ci >> 5) & 3U) {
+            case 0:  return enc_r(0x20, rdp, rs1p, 0, rs1p, 0x33); // c.sub
+            case 1:  return enc_r(0x00, rdp, rs1p, 4, rs1p, 0x33); // c.xor
+            case 2:  return enc_r(0x00, rdp, rs1p, 6, rs1p, 0x33); // c.or
+            default: return enc_r(0x00, rdp, rs1p, 7, rs1p, 0x33); // c.and
+          }
+      }
+    case 0x19: // c.beqz
+    case 0x1D: // c.bnez
+      tmp = ((ci >> 4) & 0x100U) | ((ci >> 7) & 0x18U) | ((ci << 1) & 0xC0U) | ((ci >> 2) & 6U) | ((ci << 3) & 0x20U);
+      return enc_b(sext(tmp, 9), 0, rs1p, (ci & 0x2000U) ? 1 : 0);
+    // quadrant 2
+    case 0x02: // c.slli
+      return (shamt & 0x20U) ? 0 : enc_r(0x00, shamt, rd, 1, rd, 0x13);
+    case 0x0A: // c.lwsp
+      tmp = ((ci >> 7) & 0x20U) | ((ci >> 2) & 0x1CU) | ((ci << 4) & 0xC0U);
+      return (rd == 0) ? 0 : enc_i((int32_t)tmp, 2, 2, rd, 0x03);
+    case 0x12: // c.jr, c.mv, c.ebreak, c.jalr, c.add
+      if ((ci & 0x1000U) == 0) {
+        if (rs2 == 0) {
+          return (rd == 0) ? 0 : enc_i(0, rd, 0, 0, 0x67); // c.jr
+        }
+        return enc_r(0x00, rs2, 0, 0, rd, 0x33); // c.mv
+      }
+      if (rs2 == 0) {
+        return (rd == 0) ? 0x00100073U : enc_i(0, rd, 0, 1, 0x67); // c.ebreak, c.jalr
+      }
+      return enc_r(0x00, rs2, rd, 0, rd, 0x33); // c.add
+    case 0x1A: // c.swsp
+      tmp = ((ci >> 7) & 0x3CU) | ((ci >> 1) & 0xC0U);
+      return enc_s((int32_t)tmp, rs2, 2, 2, 0x23);
+    default:
+      return 0;
+  }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// CSRs
+// -------------------------------------------------------------------------------------------------
+static uint32_t mxisa(void) {
+  uint32_t tmp = (1U << 0) | (1U << 1) | (1U << 6) | (1U << 7) | (1U << 20); // Zicsr, Zifencei, Zicond, Zicntr, IS_SIM
+  if (cfg.hpm_num > 0) {
+    tmp |= (1U << 9) | (1U << 12); // Zihpm, Sscofpmf
+  }
+  if (cfg.fast_mul) {
+    tmp |= 1U << 30;
+  }
+  if (cfg.fast_shift) {
+    tmp |= 1U << 31;
+  }
+  return tmp;
+}
+
+static uint32_t mip(void) {
+  uint32_t tmp = 0;
+  if (cpu.mtime >= cpu.mtimecmp) {
+    tmp |= 1U << IRQ_MTI;
+  }
+  if (cpu.lcofip) {
+    tmp |= 1U << IRQ_LCOFI;
+  }
+  return tmp;
+}
+
+// returns -1 if CSR is not implemented
+static int csr_read(uint32_t addr, uint32_t *data) {
+  int i;
+  uint64_t cnt;
+
+  if (((addr >= 0xB03) && (addr <= 0xB0F)) || ((addr >= 0xC03) && (addr <= 0xC0F)) || // HPM counters low
+      ((addr >= 0xB83) && (addr <= 0xB8F)) || ((addr >= 0xC83) && (addr <= 0xC8F))) { // HPM counters high
+    if (cfg.hpm_num == 0) {
+      return -1;
+    }
+    i = (int)(addr & 0x1FU) - 3;
+    cnt = (i < cfg.hpm_num) ? cpu.hpm_cnt[i] : 0;
+    *data = (addr & 0x80U) ? (uint32_t)(cnt >> 32) : (uint32_t)cnt;
+    return 0;
+  }
+  if ((addr >= 0x323) && (addr <= 0x32F)) { // mhpmevent
+    if (cfg.hpm_num == 0) {
+      return -1;
+    }
+    i = (int)(addr & 0x1FU) - 3;
+    *data = (i < cfg.hpm_num) ? cpu.hpm_event[i] : 0;
+    return 0;
+  }
+  if ((addr >= 0x723) && (addr <= 0x72F)) { // mhpmeventh
+    if (cfg.hpm_num == 0) {
+      return -1;
+    }
+    i = (int)(addr & 0x1FU) - 3;
+    *data = ((i < cfg.hpm_num) && cpu.hpm_of[i]) ? (1U << 31) : 0;
+    return 0;
+  }
+
+  switch (addr) {
+    case 0x300: *data = ((uint32_t)cpu.mstatus_mie << 3) | ((uint32_t)cpu.mstatus_mpie << 7) | (3U << 11); return 0; // mstatus
+    case 0x301: *data = (1U << 30) | (1U << 0) | (1U << 2) | (1U << 8) | (1U << 12) | (1U << 23); return 0; // misa: rv32imacx
+    case 0x304: *data = cpu.mie;           return 0;
+    case 0x305: *data = cpu.mtvec;         return 0;
+    case 0x310: *data = 0;                 return 0; // mstatush
+    case 0x320: *data = cpu.mcountinhibit; return 0;
+    case 0x340: *data = cpu.mscratch;      return 0;
+    case 0x341: *data = cpu.mepc;          return 0;
+    case 0x342: *data = cpu.mcause;        return 0;
+    case 0x343: *data = cpu.mtval;         return 0;
+    case 0x344: *data = mip();             return 0;
+    case 0x34A: *data = cpu.mtinst;        return 0;
+    case 0xB00: case 0xC00: *data = (uint32_t)(cpu.cycle);          return 0; // [m]cycle
+    case 0xB80: case 0xC80: *data = (uint32_t)(cpu.cycle >> 32);    return 0; // [m]cycleh
+    case 0xB02: case 0xC02: *data = (uint32_t)(cpu.instret);        return 0; // [m]instret
+    case 0xB82: case 0xC82: *data = (uint32_t)(cpu.instret >> 32);  return 0; // [m]instreth
+    case 0xF11: *data = 0;          return 0; // mvendorid
+    case 0xF12: *data = 19;         return 0; // marchid: official RISC-V open-source architecture ID
+    case 0xF13: *data = HW_VERSION; return 0; // mimpid
+    case 0xF14: *data = 0;          return 0; // mhartid
+    case 0xF15: *data = 0;          return 0; // mconfigptr
+    case 0xFC0: *data = mxisa();    return 0;
+    default: return -1;
+  }
+}
+
+static void csr_write(uint32_t addr, uint32_t data) {
+  int i;
+  uint64_t *cnt;
+
+  if (((addr >= 0xB03) && (addr <= 0xB0F)) || ((addr >= 0xB83) && (addr <= 0xB8F))) { // mhpmcounter[h]
+    i = (int)(addr & 0x1FU) - 3;
+    if (i < cfg.hpm_num) {
+      cnt = &cpu.hpm_cnt[i];
+      if (addr & 0x80U) {
+        *cnt = ((*cnt & 0xFFFFFFFFULL) | ((uint64_t)data << 32)) & hpm_mask();
+      }
+      else {
+        *cnt = ((*cnt & 0xFFFFFFFF00000000ULL) | data) & hpm_mask();
+      }
+      cpu.cnt_we |= 1U << (i + 3);
+    }
+    return;
+  }
+  if ((addr >= 0x323) && (addr <= 0x32F)) { // mhpmevent
+    i = (int)(addr & 0x1FU) - 3;
+    if (i < cfg.hpm_num) {
+      cpu.hpm_event[i] = data & 0x03FFFFFFU;
+    }
+    return;
+  }
+  if ((addr >= 0x723) && (addr <= 0x72F)) { // mhpmeventh
+    i = (int)(addr & 0x1FU) - 3;
+    if (i < cfg.hpm_num) {
+      cpu.hpm_of[i] = (data >> 31) & 1;
+    }
+    return;
+  }
+
+  switch (addr) {
+    case 0x300: cpu.mstatus_mie = (data >> 3) & 1; cpu.mstatus_mpie = (data >> 7) & 1; break;
+    case 0x304: cpu.mie = data & (0xFFFF0888U | ((cfg.hpm_num > 0) ? (1U << IRQ_LCOFI) : 0)); break;
+    case 0x305: cpu.mtvec = data & ~2U; break;
+    case 0x320: cpu.mcountinhibit = data & (5U | ((((1U << cfg.hpm_num) - 1)) << 3)); break;
+    case 0x340: cpu.mscratch = data; break;
+    case 0x341: cpu.mepc = data & ~1U; break;
+    case 0x342: cpu.mcause = data & 0x8000001FU; break;
+    case 0x344: if ((data & (1U << IRQ_LCOFI)) == 0) { cpu.lcofip = 0; } break; // LCOFIP can only be cleared
+    case 0xB00: cpu.cycle   = (cpu.cycle   & 0xFFFFFFFF00000000ULL) | data;                cpu.cnt_we |= 1U; break;
+    case 0xB80: cpu.cycle   = (cpu.cycle   & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); cpu.cnt_we |= 1U; break;
+    case 0xB02: cpu.instret = (cpu.instret & 0xFFFFFFFF00000000ULL) | data;                cpu.cnt_we |= 4U; break;
+    case 0xB82: cpu.instret = (cpu.instret & 0x00000000FFFFFFFFULL) | ((uint64_t)data << 32); cpu.cnt_we |= 4U; break;
+    default: break; // read-only (mtval, mtinst, ...)
+  }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Counters and traps
+// -------------------------------------------------------------------------------------------------
+// update all counters after an instruction (or trap entry) took "cycles" clock cycles
+static void counters_update(uint32_t cycles) {
+  int i;
+  uint32_t ev, inc;
+  uint64_t old;
+
+  if (((cpu.mcountinhibit & 1U) == 0) && ((cpu.cnt_we & 1U) == 0)) {
+    cpu.cycle += cycles;
+  }
+  if (((cpu.mcountinhibit & 4U) == 0) && ((cpu.cnt_we & 4U) == 0) && (ev_mask & (1U << EV_IR))) {
+    cpu.instret++;
+  }
+  for (i=0; i<cfg.hpm_num; i++) {
+    ev = cpu.hpm_event[i] & ev_mask;
+    if ((ev == 0) || (cpu.mcountinhibit & (1U << (i + 3))) || (cpu.cnt_we & (1U << (i + 3)))) {
+      continue;
+    }
+    if (ev & (1U << EV_CY)) { // the counter increments once per cycle if any of the selected events is active
+      inc = cycles;
+    }
+    else {
+      inc = (ev & (1U << EV_WAIT_ALU)) ? ev_alu_wait : 0;
+      ev &= ~(1U << EV_WAIT_ALU);
+      while (ev) {
+        inc += ev & 1U;
+        ev >>= 1;
+      }
+      if (inc > cycles) {
+        inc = cycles;
+      }
+    }
+    old = cpu.hpm_cnt[i];
+    cpu.hpm_cnt[i] = (old + inc) & hpm_mask();
+    if (cpu.hpm_cnt[i] < old) { // overflow: set OF and raise LCOFI if OF was cleared
+      if (cpu.hpm_of[i] == 0) {
+        cpu.lcofip = 1;
+      }
+      cpu.hpm_of[i] = 1;
+    }
+  }
+  cpu.mtime += cycles;
+  cpu.ticks += cycles;
+}
+
+static void trap_enter(uint32_t cause, uint32_t epc, uint32_t tval, uint32_t tinst) {
+  cpu.mcause       = cause;
+  cpu.mepc         = epc & ~1U;
+  cpu.mtval        = tval;
+  cpu.mtinst       = (cause >> 31) ? 0 : tinst;
+  cpu.mstatus_mpie = cpu.mstatus_mie;
+  cpu.mstatus_mie  = 0;
+  if (((cpu.mtvec & 3U) == 1) && (cause >> 31)) { // vectored mode
+    cpu.pc = (cpu.mtvec & ~0x7FU) + ((cause & 0x1FU) << 2);
+  }
+  else {
+    cpu.pc = cpu.mtvec & ~3U;
+  }
+  ev_mask |= (1U << EV_TRAP) | (1U << EV_BRANCHED);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Timing model (see "Instructions and Timing" tables in docs/datasheet/cpu.adoc)
+// -------------------------------------------------------------------------------------------------
+static uint32_t shift_cycles(uint32_t shamt) {
+  if (cfg.fast_shift) {
+    return 4;
+  }
+  ev_alu_wait = (shamt > 1) ? shamt : 1;
+  return 3 + ev_alu_wait;
+}
+
+static uint32_t muldiv_cycles(uint32_t funct3, uint32_t rs1, uint32_t rs2) {
+  int step = (cfg.radix == 16) ? 4 : ((cfg.radix == 4) ? 2 : 1);
+  int lzb = 0;
+  uint32_t op = rs1;
+  if ((funct3 < 4) && cfg.fast_mul) {
+    return 4;
+  }
+  if (cfg.early && !((funct3 >= 4) && (rs2 == 0))) { // no early termination for division by zero
+    if ((funct3 >= 4) && ((funct3 & 1U) == 0) && ((int32_t)rs1 < 0)) { // signed division: absolute dividend
+      op = 0 - rs1;
+    }
+    if      ((op >>  8) == 0) { lzb = 3; }
+    else if ((op >> 16) == 0) { lzb = 2; }
+    else if ((op >> 24) == 0) { lzb = 1; }
+  }
+  ev_alu_wait = (uint32_t)((32 / step) - lzb * (8 / step));
+  return 4 + ev_alu_wait;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Atomic memory operations (funct5 of the AMO opcode)
+// -------------------------------------------------------------------------------------------------
+static int amo_op_valid(uint32_t funct5) {
+  switch (funct5) {
+    case 0x00: case 0x01: case 0x02: case 0x03: case 0x04: case 0x08: // AMOADD, AMOSWAP, LR, SC, AMOXOR, AMOOR
+    case 0x0C: case 0x10: case 0x14: case 0x18: case 0x1C: return 1; // AMOAND, AMOMIN, AMOMAX, AMOMINU, AMOMAXU
+    default: return 0;
+  }
+}
+
+static uint32_t amo_op_exe(uint32_t funct5, uint32_t mem, uint32_t opb) {
+  switch (funct5) {
+    case 0x01: return opb; // AMOSWAP
+    case 0x04: return mem ^ opb; // AMOXOR
+    case 0x08: return mem | opb; // AMOOR
+    case 0x0C: return mem & opb; // AMOAND
+    case 0x10: return ((int32_t)mem < (int32_t)opb) ? mem : opb; // AMOMIN
+    case 0x14: return ((int32_t)mem > (int32_t)opb) ? mem : opb; // AMOMAX
+    case 0x18: return (mem < opb) ? mem : opb; // AMOMINU
+    case 0x1C: return (mem > opb) ? mem : opb; // AMOMAXU
+    default:   return mem + opb; // AMOADD
+  }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Execute a single instruction (or take a pending interrupt)
+// -------------------------------------------------------------------------------------------------
+static int step(void) {
+
+  uint32_t pc = cpu.pc, ir, ci = 0, next_pc, rd, rs1, rs2, f3, f7, addr = 0, tmp, res, csr_old;
+  int is_c, taken, lsu_size, exc = 0, state = SIM_RUN;
+  int32_t imm;
+  uint8_t *p;
+
+  ev_cycles   = 2;
+  ev_alu_wait = 0;
+  ev_mask     = (1U << EV_CY);
+  cpu.cnt_we  = 0;
+
+  // interrupts (priority: MTI, LCOFI)
+  tmp = mip() & cpu.mie;
+  if (cpu.mstatus_mie && tmp) {
+    trap_enter((tmp & (1U << IRQ_MTI)) ? TRAP_MTI : TRAP_LCOFI, pc, 0, 0);
+    ev_cycles = 3;
+    counters_update(ev_cycles);
+    pc = cpu.pc; // account trap entry to the handler's first instruction
+    goto profile;
+  }
+
+  // fetch
+  p = mem_ptr(pc, 2);
+  if (p == NULL) {
+    trap_enter(TRAP_IAF, pc, 0, 0);
+    ev_cycles = 3;
+    counters_update(ev_cycles);
+    goto profile;
+  }
+  ir = get_le16(p);
+  is_c = ((ir & 3U) != 3U);
+  if (is_c) {
+    ci = ir;
+    ir = decompress(ci);
+    next_pc = pc + 2;
+    ev_mask |= 1U << EV_COMPR;
+  }
+  else {
+    p = mem_ptr(pc + 2, 2);
+    if (p == NULL) {
+      trap_enter(TRAP_IAF, pc, 0, 0);
+      ev_cycles = 3;
+      counters_update(ev_cycles);
+      goto profile;
+    }
+    ir |= get_le16(p) << 16;
+    next_pc = pc + 4;
+  }
+
+  if (cfg.trace) {
+    fprintf(stderr, "%08x: %08x\n", pc, is_c ? ci : ir);
+  }
+
+  rd  = (ir >> 7)  & 0x1FU;
+  rs1 = (ir >> 15) & 0x1FU;
+  rs2 = (ir >> 20) & 0x1FU;
+  f3  = (ir >> 12) & 7U;
+  f7  = ir >> 25;
+  imm = (int32_t)ir >> 20; // I-type immediate
+
+  if (ir == 0) { // illegal (compressed) instruction
+    exc = TRAP_II;
+  }
+  else {
+    switch (ir & 0x7FU) {
+
+      case 0x37: // LUI
+        cpu.x[rd] = ir & 0xFFFFF000U;
+        break;
+
+      case 0x17: // AUIPC
+        cpu.x[rd] = pc + (ir & 0xFFFFF000U);
+        break;
+
+      case 0x6F: // JAL
+        imm = sext(((ir >> 11) & 0x100000U) | (ir & 0xFF000U) | ((ir >> 9) & 0x800U) | ((ir >> 20) & 0x7FEU), 21);
+        cpu.x[rd] = next_pc;
+        next_pc = pc + (uint32_t)imm;
+        ev_cycles = 6;
+        ev_mask |= 1U << EV_BRANCHED;
+        break;
+
+      case 0x67: // JALR
+        if (f3 != 0) {
+          exc = TRAP_II;
+          break;
+        }
+        tmp = (cpu.x[rs1] + (uint32_t)imm) & ~1U;
+        cpu.x[rd] = next_pc;
+        next_pc = tmp;
+        ev_cycles = 6;
+        ev_mask |= 1U << EV_BRANCHED;
+        break;
+
+      case 0x63: // BRANCH
+        imm = sext(((ir >> 19) & 0x1000U) | ((ir << 4) & 0x800U) | ((ir >> 20) & 0x7E0U) | ((ir >> 7) & 0x1EU), 13);
+        switch (f3) {
+          case 0:  taken = (cpu.x[rs1] == cpu.x[rs2]); break;
+          case 1:  taken = (cpu.x[rs1] != cpu.x[rs2]); break;
+          case 4:  taken = ((int32_t)cpu.x[rs1] <  (int32_t)cpu.x[rs2]); break;
+          case 5:  taken = ((int32_t)cpu.x[rs1] >= (int32_t)cpu.x[rs2]); break;
+          case 6:  taken = (cpu.x[rs1] <  cpu.x[rs2]); break;
+          case 7:  taken = (cpu.x[rs1] >= cpu.x[rs2]); break;
+          default: exc = TRAP_II; taken = 0; break;
+        }
+        if (exc) {
+          break;
+        }
+        ev_mask |= 1U << EV_BRANCH;
+        if (taken) {
+          next_pc = pc + (uint32_t)imm;
+          ev_cycles = 6;
+          ev_mask |= 1U << EV_BRANCHED;
+        }
+        else {
+          ev_cycles = 3;
+        }
+        break;
+
+      case 0x03: // LOAD
+        addr = cpu.x[rs1] + (uint32_t)imm;
+        lsu_size = 1 << (f3 & 3U);
+        if ((f3 == 3) || (f3 > 5)) {
+          exc = TRAP_II;
+          break;
+        }
+        ev_cycles = is_c ? 4 : 5;
+        ev_mask |= 1U << EV_LOAD;
+        if (addr & (uint32_t)(lsu_size - 1)) {
+          exc = TRAP_LMA;
+        }
+        else if (bus_read(addr, (uint32_t)lsu_size, &tmp)) {
+          exc = TRAP_LAF;
+        }
+        else {
+          if      (f3 == 0) { tmp = (uint32_t)sext(tmp, 8);  }
+          else if (f3 == 1) { tmp = (uint32_t)sext(tmp, 16); }
+          cpu.x[rd] = tmp;
+        }
+        break;
+
+      case 0x23: // STORE
+        imm = sext(((ir >> 20) & 0xFE0U) | ((ir >> 7) & 0x1FU), 12);
+        addr = cpu.x[rs1] + (uint32_t)imm;
+        lsu_size = 1 << (f3 & 3U);
+        if (f3 > 2) {
+          exc = TRAP_II;
+          break;
+        }
+        ev_cycles = is_c ? 4 : 5;
+        ev_mask |= 1U << EV_STORE;
+        if (addr & (uint32_t)(lsu_size - 1)) {
+          exc = TRAP_SMA;
+        }
+        else if (bus_write(addr, (uint32_t)lsu_size, cpu.x[rs2])) {
+          exc = TRAP_SAF;
+        }
+        break;
+
+      case 0x13: // OP-IMM
+        switch (f3) {
+          case 0: cpu.x[rd] = cpu.x[rs1] + (uint32_t)imm; break;
+          case 2: cpu.x[rd] = ((int32_t)cpu.x[rs1] < imm) ? 1 : 0; break;
+          case 3: cpu.x[rd] = (cpu.x[rs1] < (uint32_t)imm) ? 1 : 0; break;
+          case 4: cpu.x[rd] = cpu.x[rs1] ^ (uint32_t)imm; break;
+          case 6: cpu.x[rd] = cpu.x[rs1] | (uint32_t)imm; break;
+          case 7: cpu.x[rd] = cpu.x[rs1] & (uint32_t)imm; break;
+          case 1: // SLLI
+            if (f7 != 0) { exc = TRAP_II; break; }
+            ev_cycles = shift_cycles(rs2);
+            cpu.x[rd] = cpu.x[rs1] << rs2;
+            break;
+          default: // SRLI, SRAI
+            if      (f7 == 0x00) { cpu.x[rd] = cpu.x[rs1] >> rs2; }
+            else if (f7 == 0x20) { cpu.x[rd] = (uint32_t)((int32_t)cpu.x[rs1] >> rs2); }
+            else                 { exc = TRAP_II; break; }
+            ev_cycles = shift_cycles(rs2);
+            break;
+        }
+        break;
+
+      case 0x33: // OP
+        if (f7 == 0x00) {
+          switch (f3) {
+            case 0: cpu.x[rd] = cpu.x[rs1] + cpu.x[rs2]; break;
+            case 1: ev_cycles = shift_cycles(cpu.x[rs2] & 0x1FU); cpu.x[rd] = cpu.x[rs1] << (cpu.x[rs2] & 0x1FU); break;
+            case 2: cpu.x[rd] = ((int32_t)cpu.x[rs1] < (int32_t)cpu.x[rs2]) ? 1 : 0; break;
+            case 3: cpu.x[rd] = (cpu.x[rs1] < cpu.x[rs2]) ? 1 : 0; break;
+            case 4: cpu.x[rd] = cpu.x[rs1] ^ cpu.x[rs2]; break;
+            case 5: ev_cycles = shift_cycles(cpu.x[rs2] & 0x1FU); cpu.x[rd] = cpu.x[rs1] >> (cpu.x[rs2] & 0x1FU); break;
+            case 6: cpu.x[rd] = cpu.x[rs1] | cpu.x[rs2]; break;
+            default: cpu.x[rd] = cpu.x[rs1] & cpu.x[rs2]; break;
+          }
+        }
+        else if ((f7 == 0x20) && (f3 == 0)) { // SUB
+          cpu.x[rd] = cpu.x[rs1] - cpu.x[rs2];
+        }
+        else if ((f7 == 0x20) && (f3 == 5)) { // SRA
+          ev_cycles = shift_cycles(cpu.x[rs2] & 0x1FU);
+          cpu.x[rd] = (uint32_t)((int32_t)cpu.x[rs1] >> (cpu.x[rs2] & 0x1FU));
+        }
+        else if (f7 == 0x01) { // M extension
+          uint32_t a = cpu.x[rs1], b = cpu.x[rs2];
+          ev_cycles = muldiv_cycles(f3, a, b);
+          switch (f3) {
+            case 0: res = a * b; break;
+            case 1: res = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(int32_t)b) >> 32); break;
+            case 2: res = (uint32_t)(((int64_t)(int32_t)a * (int64_t)(uint64_t)b) >> 32); break;
+            case 3: res = (uint32_t)(((uint64_t)a * (uint64_t)b) >> 32); break;
+            case 4: // DIV
+              if (b == 0) { res = 0xFFFFFFFFU; }
+              else if ((a == 0x80000000U) && (b == 0xFFFFFFFFU)) { res = a; }
+              else { res = (uint32_t)((int32_t)a / (int32_t)b); }
+              break;
+            case 5: res = (b == 0) ? 0xFFFFFFFFU : (a / b); break; // DIVU
+            case 6: // REM
+              if (b == 0) { res = a; }
+              else if ((a == 0x80000000U) && (b == 0xFFFFFFFFU)) { res = 0; }
+              else { res = (uint32_t)((int32_t)a % (int32_t)b); }
+              break;
+            default: res = (b == 0) ? a : (a % b); break; // REMU
+          }
+          cpu.x[rd] = res;
+        }
+        else if ((f7 == 0x07) && ((f3 == 5) || (f3 == 7))) { // Zicond
+          ev_cycles = 3;
+          cpu.x[rd] = (((f3 == 5) ? (cpu.x[rs2] == 0) : (cpu.x[rs2] != 0))) ? 0 : cpu.x[rs1];
+        }
+        else {
+          exc = TRAP_II;
+        }
+        break;
+
+      case 0x0F: // FENCE, FENCE.I
+        if (f3 > 1) {
+          exc = TRAP_II;
+          break;
+        }
+        ev_cycles = 5;
+        break;
+
+      case 0x2F: // A extension: LR.W, SC.W, AMO*.W
+        addr = cpu.x[rs1];
+        ev_cycles = 5;
+        if ((f3 != 2) || (amo_op_valid(ir >> 27) == 0) || (((ir >> 27) == 0x02) && (rs2 != 0))) {
+          exc = TRAP_II;
+        }
+        else if (((ir >> 27) & 0x02) == 0) { // AMO*.W: read-modify-write
+          ev_mask |= 1U << EV_STORE;
+          ev_cycles = 7; // additional bus write access
+          if (addr & 3U) {
+            exc = TRAP_SMA;
+          }
+          else if (bus_read(addr, 4, &tmp) || bus_write(addr, 4, amo_op_exe(ir >> 27, tmp, cpu.x[rs2]))) {
+            exc = TRAP_SAF;
+          }
+          else {
+            cpu.x[rd] = tmp;
+          }
+        }
+        else if ((ir >> 27) == 0x02) { // LR.W
+          ev_mask |= 1U << EV_LOAD;
+          if (addr & 3U) {
+            exc = TRAP_LMA;
+          }
+          else if (bus_read(addr, 4, &tmp)) {
+            exc = TRAP_LAF;
+          }
+          else {
+            cpu.x[rd] = tmp;
+            cpu.rsv_valid = 1;
+            cpu.rsv_addr = addr;
+          }
+        }
+        else { // SC.W
+          ev_mask |= 1U << EV_STORE;
+          if (addr & 3U) {
+            exc = TRAP_SMA;
+          }
+          else if (cpu.rsv_valid && (cpu.rsv_addr == addr)) {
+            if (bus_write(addr, 4, cpu.x[rs2])) {
+              exc = TRAP_SAF;
+            }
+            else {
+              cpu.x[rd] = 0;
+            }
+          }
+          else {
+            cpu.x[rd] = 1;
+          }
+          cpu.rsv_valid = 0;
+        }
+        break;
+
+      case 0x73: // SYSTEM
+        ev_cycles = 3;
+        if (f3 == 0) {
+          if      (ir == 0x00000073U) { exc = TRAP_MENV; } // ECALL
+          else if (ir == 0x00100073U) { exc = TRAP_BP; } // EBREAK
+          else if (ir == 0x30200073U) { // MRET
+            next_pc = cpu.mepc;
+            cpu.mstatus_mie  = cpu.mstatus_mpie;
+            cpu.mstatus_mpie = 1;
+            ev_cycles = 5;
+            ev_mask |= 1U << EV_BRANCHED;
+          }
+          else if (ir == 0x10500073U) { // WFI
+            if ((cpu.mie & (1U << IRQ_MTI)) == 0) { // no wake-up source left: end of simulation
+              state = SIM_EXIT;
+            }
+            else if ((mip() & cpu.mie) == 0) { // sleep until the timer interrupt becomes pending
+              uint64_t sleep = cpu.mtimecmp - cpu.mtime;
+              if (sleep > (1ULL << 48)) {
+                state = SIM_DEADLOCK;
+              }
+              else { // sleep cycles are no "active" cycles: only [m]cycle and MTIME keep counting
+                if ((cpu.mcountinhibit & 1U) == 0) {
+                  cpu.cycle += sleep;
+                }
+                cpu.mtime += sleep;
+                cpu.ticks += sleep;
+                if ((uint32_t)((pc - IMEM_BASE) >> 1) < (cfg.imem_size >> 1)) {
+                  prof_cyc[(pc - IMEM_BASE) >> 1] += sleep;
+                }
+              }
+            }
+          }
+          else { exc = TRAP_II; }
+        }
+        else if (f3 == 4) {
+          exc = TRAP_II;
+        }
+        else { // CSR access
+          uint32_t csr = ir >> 20;
+          uint32_t src = (f3 & 4U) ? rs1 : cpu.x[rs1];
+          int we = ((f3 & 3U) == 1) || (rs1 != 0);
+          if ((csr_read(csr, &csr_old) != 0) || (we && ((csr >> 10) == 3))) {
+            exc = TRAP_II;
+            break;
+          }
+          if (we) {
+            switch (f3 & 3U) {
+              case 1:  csr_write(csr, src); break;
+              case 2:  csr_write(csr, csr_old | src); break;
+              default: csr_write(csr, csr_old & ~src); break;
+            }
+          }
+          cpu.x[rd] = csr_old;
+        }
+        break;
+
+      default:
+        exc = TRAP_II;
+        break;
+    }
+  }
+
+  cpu.x[0] = 0;
+
+  if (exc) {
+    trap_enter((uint32_t)exc, pc, ((exc == TRAP_LMA) || (exc == TRAP_LAF) || (exc == TRAP_SMA) || (exc == TRAP_SAF)) ? addr : 0,
+               is_c ? ((ir ? ir : ci) & ~2U) : ir);
+    if (exc == TRAP_II) {
+      ev_cycles = 3;
+    }
+    ev_mask &= ~(1U << EV_COMPR);
+  }
+  else {
+    cpu.pc = next_pc;
+    ev_mask |= 1U << EV_IR;
+  }
+  counters_update(ev_cycles);
+
+profile:
+  if ((uint32_t)((pc - IMEM_BASE) >> 1) < (cfg.imem_size >> 1)) {
+    prof_cyc[(pc - IMEM_BASE) >> 1] += ev_cycles;
+    prof_ir[(pc - IMEM_BASE) >> 1]  += (ev_mask >> EV_IR) & 1U;
+  }
+  else {
+    prof_other_cyc += ev_cycles;
+    prof_other_ir  += (ev_mask >> EV_IR) & 1U;
+  }
+  if ((state == SIM_RUN) && cfg.max_cycles && (cpu.ticks >= cfg.max_cycles)) {
+    state = SIM_TIMEOUT;
+  }
+  return state;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// ELF symbol table (function symbols only)
+// -------------------------------------------------------------------------------------------------
+static int sym_cmp(const void *a, const void *b) {
+  const sym_t *x = a, *y = b;
+  return (x->addr > y->addr) - (x->addr < y->addr);
+}
+
+static int elf_load_symbols(const char *file) {
+
+  FILE *f = fopen(file, "rb");
+  uint8_t *elf;
+  long size;
+  uint32_t shoff, shnum, shentsize, i, j;
+
+  if (f == NULL) {
+    return -1;
+  }
+  fseek(f, 0L, SEEK_END);
+  size = ftell(f);
+  rewind(f);
+  elf = malloc((size_t)size);
+  if ((elf == NULL) || (fread(elf, 1, (size_t)size, f) != (size_t)size) || (size < 52) ||
+      (memcmp(elf, "\177ELF", 4) != 0) || (elf[4] != 1) || (elf[5] != 1)) { // 32-bit little-endian ELF only
+    fclose(f);
+    free(elf);
+    return -1;
+  }
+  fclose(f);
+
+  shoff     = get_le32(&elf[32]);
+  shentsize = get_le16(&elf[46]);
+  shnum     = get_le16(&elf[48]);
+
+  for (i=0; i<shnum; i++) {
+    const uint8_t *sh = &elf[shoff + i*shentsize];
+    if (get_le32(&sh[4]) != 2) { // SHT_SYMTAB
+      continue;
+    }
+    const uint8_t *strtab = &elf[get_le32(&elf[shoff + get_le32(&sh[24])*shentsize + 16])];
+    uint32_t off = get_le32(&sh[16]), num = get_le32(&sh[20]) / 16;
+    syms = calloc(num, sizeof(sym_t));
+    for (j=0; j<num; j++) {
+      const uint8_t *st = &elf[off + j*16];
+      if ((st[12] & 0xFU) == 2) { // STT_FUNC
+        syms[num_syms].addr = get_le32(&st[4]);
+        syms[num_syms].size = get_le32(&st[8]);
+        syms[num_syms].name = strdup((const char*)&strtab[get_le32(&st[0])]);
+        num_syms++;
+      }
+    }
+    break;
+  }
+  free(elf);
+  qsort(syms, (size_t)num_syms, sizeof(sym_t), sym_cmp);
+  return 0;
+}
+
+// index of the function containing addr, -1 if none
+static int sym_find(uint32_t addr) {
+  int lo = 0, hi = num_syms - 1, mid, res = -1;
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    if (syms[mid].addr <= addr) {
+      res = mid;
+      lo = mid + 1;
+    }
+    else {
+      hi = mid - 1;
+    }
+  }
+  if ((res >= 0) && syms[res].size && (addr >= syms[res].addr + syms[res].size)) {
+    return -1;
+  }
+  return res;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Profile report
+// -------------------------------------------------------------------------------------------------
+typedef struct {
+  const char *name;
+  uint32_t addr;
+  uint64_t cyc;
+  uint64_t ir;
+} prof_entry_t;
+
+static int prof_cmp(const void *a, const void *b) {
+  const prof_entry_t *x = a, *y = b;
+  return (x->cyc < y->cyc) - (x->cyc > y->cyc);
+}
+
+static void prof_write(FILE *out) {
+
+  uint32_t i, n = 0, num = cfg.imem_size >> 1;
+  int s;
+  prof_entry_t *tab = calloc((size_t)num + (size_t)num_syms + 2, sizeof(prof_entry_t));
+  uint64_t tcyc = cpu.cycle ? cpu.cycle : 1, tir = cpu.instret ? cpu.instret : 1;
+
+  if (num_syms) { // per function
+    for (s=0; s<num_syms; s++) {
+      tab[s].name = syms[s].name;
+      tab[s].addr = syms[s].addr;
+    }
+    tab[num_syms].name = "<unknown>";
+    n = (uint32_t)num_syms + 1;
+    for (i=0; i<num; i++) {
+      if (prof_cyc[i] == 0) {
+        continue;
+      }
+      s = sym_find(IMEM_BASE + 2*i);
+      tab[(s < 0) ? num_syms : s].cyc += prof_cyc[i];
+      tab[(s < 0) ? num_syms : s].ir  += prof_ir[i];
+    }
+  }
+  else { // per instruction address
+    for (i=0; i<num; i++) {
+      if (prof_cyc[i]) {
+        tab[n].addr = IMEM_BASE + 2*i;
+        tab[n].cyc  = prof_cyc[i];
+        tab[n].ir   = prof_ir[i];
+        n++;
+      }
+    }
+  }
+  tab[n].name = "<outside IMEM>";
+  tab[n].cyc  = prof_other_cyc;
+  tab[n].ir   = prof_other_ir;
+  n++;
+
+  qsort(tab, n, sizeof(prof_entry_t), prof_cmp);
+
+  fprintf(out, "# NEORV32 ISS profile: %llu cycles, %llu instructions\n",
+          (unsigned long long)cpu.cycle, (unsigned long long)cpu.instret);
+  fprintf(out, "# %14s %7s %14s %7s %6s  %s\n", "cycles", "%", "instructions", "%", "CPI", num_syms ? "function" : "address");
+  for (i=0; i<n; i++) {
+    if (tab[i].cyc == 0) {
+      continue;
+    }
+    fprintf(out, "  %14llu %6.2f%% %14llu %6.2f%% %6.2f  ",
+            (unsigned long long)tab[i].cyc, 100.0 * (double)tab[i].cyc / (double)tcyc,
+            (unsigned long long)tab[i].ir, 100.0 * (double)tab[i].ir / (double)tir,
+            tab[i].ir ? (double)tab[i].cyc / (double)tab[i].ir : 0.0);
+    if (tab[i].name) {
+      fprintf(out, "%s\n", tab[i].name);
+    }
+    else {
+      fprintf(out, "0x%08x\n", tab[i].addr);
+    }
+  }
+  free(tab);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+// Executable loader (image_gen -app_bin format)
+// -------------------------------------------------------------------------------------------------
+static int load_executable(const char *file) {
+
+  FILE *f = fopen(file, "rb");
+  uint8_t buffer[12];
+  uint32_t size, checksum, i;
+
+  if (f == NULL) {
+    fprintf(stderr, "ERROR: cannot open executable '%s'!\n", file);
+    return -1;
+  }
+  if ((fread(buffer, 1, 12, f) != 12) || (get_le32(&buffer[0]) != signature)) {
+    fprintf(stderr, "ERROR: '%s' is not a NEORV32 executable (image_gen -app_bin)!\n", file);
+    fclose(f);
+    return -1;
+  }
+  size     = get_le32(&buffer[4]);
+  checksum = get_le32(&buffer[8]);
+  if (size > cfg.imem_size) {
+    fprintf(stderr, "ERROR: executable (%u bytes) exceeds IMEM size (%u bytes)!\n", size, cfg.imem_size);
+    fclose(f);
+    return -1;
+  }
+  if (fread(imem, 1, size, f) != size) {
+    fprintf(stderr, "ERROR: unexpected end of executable!\n");
+    fclose(f);
+    return -1;
+  }
+  fclose(f);
+  for (i=0; i<size; i+=4) {
+    checksum += get_le32(&imem[i]);
+  }
+  if (checksum != 0) {
+    fprintf(stderr, "ERROR: executable checksum error!\n");
+    return -1;
+  }
+  return 0;
+}
+
+
+int main(int argc, char *argv[]) {
+
+  const char *exe_file = NULL, *elf_file = NULL, *prof_file = NULL;
+  int i, state = SIM_RUN;
+  FILE *prof_out;
+  clock_t t_start, t_end;
+  double t_host;
+
+  cfg.clk        = DEF_CLK;
+  cfg.imem_size  = DEF_IMEM_SIZE;
+  cfg.dmem_size  = DEF_DMEM_SIZE;
+  cfg.itcm_size  = DEF_ITCM_SIZE;
+  cfg.dtcm_size  = DEF_DTCM_SIZE;
+  cfg.hpm_num    = DEF_HPM_NUM;
+  cfg.hpm_width  = DEF_HPM_WIDTH;
+  cfg.radix      = DEF_RADIX;
+  cfg.early      = DEF_EARLY;
+
+  for (i=1; i<argc; i++) {
+    int has_arg = (i+1 < argc);
+    if      ((strcmp(argv[i], "-elf")   == 0) && has_arg) { elf_file       = argv[++i]; }
+    else if ((strcmp(argv[i], "-prof")  == 0) && has_arg) { prof_file      = argv[++i]; }
+    else if ((strcmp(argv[i], "-max")   == 0) && has_arg) { cfg.max_cycles = strtoull(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-clk")   == 0) && has_arg) { cfg.clk        = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-imem")  == 0) && has_arg) { cfg.imem_size  = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-dmem")  == 0) && has_arg) { cfg.dmem_size  = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-itcm")  == 0) && has_arg) { cfg.itcm_size  = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-dtcm")  == 0) && has_arg) { cfg.dtcm_size  = (uint32_t)strtoul(argv[++i], NULL, 0); }
+    else if ((strcmp(argv[i], "-hpm")   == 0) && has_arg) { cfg.hpm_num    = atoi(argv[++i]); }
+    else if ((strcmp(argv[i], "-hpmw")  == 0) && has_arg) { cfg.hpm_width  = atoi(argv[++i]); }
+    else if ((strcmp(argv[i], "-radix") == 0) && has_arg) { cfg.radix      = atoi(argv[++i]); }
+    else if ((strcmp(argv[i], "-early") == 0) && has_arg) { cfg.early      = atoi(argv[++i]); }
+    else if  (strcmp(argv[i], "-fastmul")   == 0)         { cfg.fast_mul   = 1; }
+    else if  (strcmp(argv[i], "-fastshift") == 0)         { cfg.fast_shift = 1; }
+    else if  (strcmp(argv[i], "-trace")     == 0)         { cfg.trace      = 1; }
+    else if ((argv[i][0] != '-') && (exe_file == NULL))   { exe_file       = argv[i]; }
+    else { exe_file = NULL; break; }
+  }
+
+  if ((exe_file == NULL) || (cfg.hpm_num < 0) || (cfg.hpm_num > 13) || (cfg.hpm_width < 1) || (cfg.hpm_width > 64) ||
+      ((cfg.radix != 2) && (cfg.radix != 4) && (cfg.radix != 16)) || (cfg.imem_size < 4) || (cfg.dmem_size < 4) ||
+      (cfg.itcm_size > 32*1024) || (cfg.dtcm_size > 32*1024)) {
+    printf("NEORV32 instruction-set simulator (rv32imac_zicsr_zifencei_zicntr_zicond_zihpm)\n"
+           "Usage: neorv32_iss [options] <neorv32_exe.bin>\n"
+           "Executable: application executable generated by 'image_gen -app_bin' (make exe)\n"
+           "Options:\n"
+           " -elf <file>   : application ELF file (main.elf) for per-function profiling\n"
+           " -prof <file>  : write cycle/instruction profile to <file> ('-' = stderr)\n"
+           " -max <n>      : abort simulation after <n> clock cycles (default: unlimited)\n"
+           " -clk <hz>     : processor clock in Hz (default: %u)\n"
+           " -imem <bytes> : IMEM size (default: %u)\n"
+           " -dmem <bytes> : DMEM size (default: %u)\n"
+           " -itcm <bytes> : instruction TCM size, max 32kB (default: %u = none)\n"
+           " -dtcm <bytes> : data TCM size, max 32kB (default: %u = none)\n"
+           " -hpm <n>      : number of HPM counters 0..13 (default: %d)\n"
+           " -hpmw <n>     : HPM counter width 1..64 (default: %d)\n"
+           " -radix <n>    : serial mul/div radix 2, 4 or 16 (default: %d)\n"
+           " -early <0|1>  : serial mul/div early termination (default: %d)\n"
+           " -fastmul      : DSP-based multiplier (FAST_MUL_EN)\n"
+           " -fastshift    : barrel shifter (FAST_SHIFT_EN)\n"
+           " -trace        : print executed instructions to stderr\n",
+           DEF_CLK, DEF_IMEM_SIZE, DEF_DMEM_SIZE, DEF_ITCM_SIZE, DEF_DTCM_SIZE, DEF_HPM_NUM, DEF_HPM_WIDTH, DEF_RADIX, DEF_EARLY);
+    return 0;
+  }
+
+  imem     = calloc(cfg.imem_size, 1);
+  dmem     = calloc(cfg.dmem_size, 1);
+  itcm     = calloc(cfg.itcm_size + 4, 1);
+  dtcm     = calloc(cfg.dtcm_size + 4, 1);
+  prof_cyc = calloc(cfg.imem_size >> 1, sizeof(uint64_t));
+  prof_ir  = calloc(cfg.imem_size >> 1, sizeof(uint64_t));
+  if ((imem == NULL) || (dmem == NULL) || (itcm == NULL) || (dtcm == NULL) || (prof_cyc == NULL) || (prof_ir == NULL)) {
+    fprintf(stderr, "ERROR: out of memory!\n");
+    return -1;
+  }
+
+  if (load_executable(exe_file)) {
+    return -1;
+  }
+  if (elf_file && elf_load_symbols(elf_file)) {
+    fprintf(stderr, "WARNING: cannot read symbols from '%s'!\n", elf_file);
+  }
+
+  // reset
+  memset(&cpu, 0, sizeof(cpu));
+  cpu.pc       = IMEM_BASE;
+  cpu.mtimecmp = ~0ULL;
+
+  // run
+  t_start = clock();
+  while (state == SIM_RUN) {
+    state = step();
+  }
+  t_end = clock();
+  fflush(stdout);
+
+  t_host = (double)(t_end - t_start) / CLOCKS_PER_SEC;
+  switch (state) {
+    case SIM_EXIT:    fprintf(stderr, "\n[neorv32_iss] program terminated, exit code %d (mscratch)\n", (int)cpu.mscratch); break;
+    case SIM_TIMEOUT: fprintf(stderr, "\n[neorv32_iss] cycle limit reached at PC 0x%08x\n", cpu.pc); break;
+    default:          fprintf(stderr, "\n[neorv32_iss] deadlock: sleeping without wake-up source at PC 0x%08x\n", cpu.pc); break;
+  }
+  fprintf(stderr, "[neorv32_iss] %llu cycles, %llu instructions, CPI %.3f, %.3f ms @ %u Hz, %.1f MIPS host speed\n",
+          (unsigned long long)cpu.cycle, (unsigned long long)cpu.instret,
+          cpu.instret ? (double)cpu.cycle / (double)cpu.instret : 0.0,
+          1000.0 * (double)cpu.cycle / (double)cfg.clk, cfg.clk,
+          (t_host > 0.0) ? (double)cpu.instret / t_host / 1e6 : 0.0);
+
+  if (prof_file) {
+    prof_out = (strcmp(prof_file, "-") == 0) ? stderr : fopen(prof_file, "w");
+    if (prof_out == NULL) {
+      fprintf(stderr, "ERROR: cannot write profile '%s'!\n", prof_file);
+      return -1;
+    }
+    prof_write(prof_out);
+    if (prof_out != stderr) {
+      fclose(prof_out);
+    }
+  }
+
+  if (state == SIM_EXIT) {
+    return (int)(cpu.mscratch & 0xFFU);
+  }
+  return -1;
+}
@@ -61,6 +61,7 @@
 #define neorv32_uart0_rtscts_disable()             neorv32_uart_rtscts_disable(NEORV32_UART0)
 #define neorv32_uart0_rtscts_enable()              neorv32_uart_rtscts_enable(NEORV32_UART0)
 #define neorv32_uart0_putc(c)                      neorv32_uart_putc(NEORV32_UART0, c)
+#define neorv32_uart0_put_async(buffer, len, cb)   neorv32_uart_put_async(NEORV32_UART0, buffer, len, cb)
 #define neorv32_uart0_tx_busy()                    neorv32_uart_tx_busy(NEORV32_UART0)
 #define neorv32_uart0_getc()                       neorv32_uart_getc(NEORV32_UART0)
 #define neorv32_uart0_char_received()              neorv32_uart_char_received(NEORV32_UART0)
@@ -83,6 +84,7 @@
 #define neorv32_uart1_rtscts_disable()             neorv32_uart_rtscts_disable(NEORV32_UART1)
 #define neorv32_uart1_rtscts_enable()              neorv32_uart_rtscts_enable(NEORV32_UART1)
 #define neorv32_uart1_putc(c)                      neorv32_uart_putc(NEORV32_UART1, c)
+#define neorv32_uart1_put_async(buffer, len, cb)   neorv32_uart_put_async(NEORV32_UART1, buffer, len, cb)
 #define neorv32_uart1_tx_busy()                    neorv32_uart_tx_busy(NEORV32_UART1)
 #define neorv32_uart1_getc()                       neorv32_uart_getc(NEORV32_UART1)
 #define neorv32_uart1_char_received()              neorv32_uart_char_received(NEORV32_UART1)
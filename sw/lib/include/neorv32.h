@@ -187,6 +187,10 @@ enum NEORV32_CLOCK_PRSC_enum {
  * @name Main Address Space Sections
  **************************************************************************/
 /**@{*/
+/** instruction tightly-coupled memory (ITCM) base address */
+#define ITCM_BASE_ADDRESS       (0x10000000U)
+/** data tightly-coupled memory (DTCM) base address */
+#define DTCM_BASE_ADDRESS       (0x90000000U)
 /** XIP-mapped memory base address */
 #define XIP_MEM_BASE_ADDRESS    (0xE0000000U)
 /** bootloader memory base address */
@@ -196,6 +200,18 @@ enum NEORV32_CLOCK_PRSC_enum {
 /**@}*/
 
 
+/**********************************************************************//**
+ * @name Tightly-Coupled Memory (TCM) placement attributes
+ * @note The according sections are initialized by the crt0 start-up code.
+ **************************************************************************/
+/**@{*/
+/** place function in instruction TCM (single-cycle instruction fetch) */
+#define NEORV32_ITCM __attribute__((section(".itcm"), noinline))
+/** place (initialized or zero-initialized) variable in data TCM (single-cycle data access) */
+#define NEORV32_DTCM __attribute__((section(".dtcm")))
+/**@}*/
+
+
 /**********************************************************************//**
  * @name IO Address Space - Peripheral/IO Devices
  **************************************************************************/
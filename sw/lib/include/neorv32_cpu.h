@@ -388,6 +388,32 @@ inline void __attribute__ ((always_inline)) neorv32_cpu_invalidate_reservations(
 }
 
 
+/**********************************************************************//**
+ * Atomic memory access: native read-modify-write operation (single AMO instruction).
+ * return <= MEM[addr]; MEM[addr] <= MEM[addr] <op> wdata
+ *
+ * @note The address has to be word-aligned - otherwise an alignment exception will be raised.
+ * @warning This macro requires the A ISA extension. See neorv32_cpu_amo.h for LR/SC-based fallbacks.
+ *
+ * @param[in] op AMO instruction mnemonic (amoswap.w, amoadd.w, amoand.w, amoor.w, amoxor.w,
+ * amomax.w, amomaxu.w, amomin.w or amominu.w).
+ * @param[in] addr Address (32-bit).
+ * @param[in] wdata Operand data word (32-bit).
+ * @return Pre-operation data loaded from address (32-bit).
+ **************************************************************************/
+#define neorv32_cpu_amo(op, addr, wdata)                      \
+({                                                            \
+    uint32_t __amo_rdata;                                     \
+    asm volatile (                                            \
+      #op " %[dst], %[src], (%[adr])"                         \
+      : [dst] "=r" (__amo_rdata)                              \
+      : [src] "r" ((uint32_t)(wdata)), [adr] "r" ((uint32_t)(addr)) \
+      : "memory"                                              \
+    );                                                        \
+    __amo_rdata;                                              \
+})
+
+
 // #################################################################################################
 // CSR access helpers
 // #################################################################################################
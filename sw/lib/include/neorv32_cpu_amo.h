@@ -36,6 +36,8 @@
 /**********************************************************************//**
  * @file neorv32_cpu_amo.h
  * @brief Atomic memory access (read-modify-write) emulation functions using LR/SC pairs - header file.
+ *
+ * @note These functions are fallbacks for the native AMO instructions (see neorv32_cpu_amo() in neorv32_cpu.h).
  **************************************************************************/
 
 #ifndef neorv32_cpu_amo_h
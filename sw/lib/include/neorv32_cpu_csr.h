@@ -110,6 +110,21 @@ enum NEORV32_CSR_enum {
   CSR_PMPADDR14      = 0x3be, /**< 0x3be - pmpaddr14: Physical memory protection address register 14 */
   CSR_PMPADDR15      = 0x3bf, /**< 0x3bf - pmpaddr15: Physical memory protection address register 15 */
 
+  /* hardware performance monitors - event configuration high words (Sscofpmf) */
+  CSR_MHPMEVENT3H    = 0x723, /**< 0x723 - mhpmevent3h: Machine hardware performance monitor event selector 3 high word */
+  CSR_MHPMEVENT4H    = 0x724, /**< 0x724 - mhpmevent4h: Machine hardware performance monitor event selector 4 high word */
+  CSR_MHPMEVENT5H    = 0x725, /**< 0x725 - mhpmevent5h: Machine hardware performance monitor event selector 5 high word */
+  CSR_MHPMEVENT6H    = 0x726, /**< 0x726 - mhpmevent6h: Machine hardware performance monitor event selector 6 high word */
+  CSR_MHPMEVENT7H    = 0x727, /**< 0x727 - mhpmevent7h: Machine hardware performance monitor event selector 7 high word */
+  CSR_MHPMEVENT8H    = 0x728, /**< 0x728 - mhpmevent8h: Machine hardware performance monitor event selector 8 high word */
+  CSR_MHPMEVENT9H    = 0x729, /**< 0x729 - mhpmevent9h: Machine hardware performance monitor event selector 9 high word */
+  CSR_MHPMEVENT10H   = 0x72a, /**< 0x72a - mhpmevent10h: Machine hardware performance monitor event selector 10 high word */
+  CSR_MHPMEVENT11H   = 0x72b, /**< 0x72b - mhpmevent11h: Machine hardware performance monitor event selector 11 high word */
+  CSR_MHPMEVENT12H   = 0x72c, /**< 0x72c - mhpmevent12h: Machine hardware performance monitor event selector 12 high word */
+  CSR_MHPMEVENT13H   = 0x72d, /**< 0x72d - mhpmevent13h: Machine hardware performance monitor event selector 13 high word */
+  CSR_MHPMEVENT14H   = 0x72e, /**< 0x72e - mhpmevent14h: Machine hardware performance monitor event selector 14 high word */
+  CSR_MHPMEVENT15H   = 0x72f, /**< 0x72f - mhpmevent15h: Machine hardware performance monitor event selector 15 high word */
+
   /* on-chip debugger - hardware trigger module */
   CSR_TSELECT        = 0x7a0, /**< 0x7a0 - tselect:  Trigger select */
   CSR_TDATA1         = 0x7a1, /**< 0x7a1 - tdata1:   Trigger data register 0 */
@@ -274,6 +289,7 @@ enum NEORV32_CSR_MIE_enum {
   CSR_MIE_MSIE    =  3, /**< CPU mie CSR  (3): MSIE - Machine software interrupt enable (r/w) */
   CSR_MIE_MTIE    =  7, /**< CPU mie CSR  (7): MTIE - Machine timer interrupt enable bit (r/w) */
   CSR_MIE_MEIE    = 11, /**< CPU mie CSR (11): MEIE - Machine external interrupt enable bit (r/w) */
+  CSR_MIE_LCOFIE  = 13, /**< CPU mie CSR (13): LCOFIE - Local counter overflow interrupt enable bit (r/w) */
 
   /* NEORV32-specific extension: Fast Interrupt Requests (FIRQ) */
   CSR_MIE_FIRQ0E  = 16, /**< CPU mie CSR (16): FIRQ0E - Fast interrupt channel 0 enable bit (r/w) */
@@ -302,6 +318,7 @@ enum NEORV32_CSR_MIP_enum {
   CSR_MIP_MSIP    =  3, /**< CPU mip CSR  (3): MSIP - Machine software interrupt pending (r/-) */
   CSR_MIP_MTIP    =  7, /**< CPU mip CSR  (7): MTIP - Machine timer interrupt pending (r/-) */
   CSR_MIP_MEIP    = 11, /**< CPU mip CSR (11): MEIP - Machine external interrupt pending (r/-) */
+  CSR_MIP_LCOFIP  = 13, /**< CPU mip CSR (13): LCOFIP - Local counter overflow interrupt pending (r/c) */
 
   /* NEORV32-specific extension: Fast Interrupt Requests (FIRQ) */
   CSR_MIP_FIRQ0P  = 16, /**< CPU mip CSR (16): FIRQ0P - Fast interrupt channel 0 pending (r/c) */
@@ -359,11 +376,13 @@ enum NEORV32_CSR_XISA_enum {
   CSR_MXISA_ZIHPM     =  9, /**< CPU mxisa CSR  (9): hardware performance monitors (r/-)*/
   CSR_MXISA_SDEXT     = 10, /**< CPU mxisa CSR (10): RISC-V debug mode (r/-)*/
   CSR_MXISA_SDTRIG    = 11, /**< CPU mxisa CSR (11): RISC-V trigger module (r/-)*/
+  CSR_MXISA_SSCOFPMF  = 12, /**< CPU mxisa CSR (12): HPM counter overflow interrupts (r/-)*/
 
   // Misc
   CSR_MXISA_IS_SIM    = 20, /**< CPU mxisa CSR (20): this might be a simulation when set (r/-)*/
 
   // Tuning options
+  CSR_MXISA_BTB       = 28, /**< CPU mxisa CSR (28): Branch target buffer implemented (r/-)*/
   CSR_MXISA_RFHWRST   = 29, /**< CPU mxisa CSR (29): Register file has full hardware reset (r/-)*/
   CSR_MXISA_FASTMUL   = 30, /**< CPU mxisa CSR (30): DSP-based multiplication (M extensions only) (r/-)*/
   CSR_MXISA_FASTSHIFT = 31  /**< CPU mxisa CSR (31): parallel logic for shifts (barrel shifters) (r/-)*/
@@ -385,7 +404,34 @@ enum NEORV32_HPMCNT_EVENT_enum {
   HPMCNT_EVENT_LOAD     = 8,  /**< CPU mhpmevent CSR (8):  Executed load operation */
   HPMCNT_EVENT_STORE    = 9,  /**< CPU mhpmevent CSR (9):  Executed store operation */
   HPMCNT_EVENT_WAIT_LSU = 10, /**< CPU mhpmevent CSR (10): Load-store unit memory wait cycle */
-  HPMCNT_EVENT_TRAP     = 11  /**< CPU mhpmevent CSR (11): Entered trap */
+  HPMCNT_EVENT_TRAP     = 11, /**< CPU mhpmevent CSR (11): Entered trap */
+
+  HPMCNT_EVENT_IC_PF    = 12, /**< CPU mhpmevent CSR (12): Instruction cache block prefetch issued */
+  HPMCNT_EVENT_IC_PFHIT = 13, /**< CPU mhpmevent CSR (13): Instruction cache miss served by prefetched block */
+
+  HPMCNT_EVENT_BP_HIT   = 14, /**< CPU mhpmevent CSR (14): Correctly predicted taken branch */
+  HPMCNT_EVENT_BP_MISS  = 15, /**< CPU mhpmevent CSR (15): Mispredicted branch */
+
+  HPMCNT_EVENT_IC_HIT   = 16, /**< CPU mhpmevent CSR (16): Instruction cache hit */
+  HPMCNT_EVENT_IC_MISS  = 17, /**< CPU mhpmevent CSR (17): Instruction cache miss */
+  HPMCNT_EVENT_DC_HIT   = 18, /**< CPU mhpmevent CSR (18): Data cache hit */
+  HPMCNT_EVENT_DC_MISS  = 19, /**< CPU mhpmevent CSR (19): Data cache miss */
+  HPMCNT_EVENT_XIP_MISS = 20, /**< CPU mhpmevent CSR (20): XIP cache miss */
+  HPMCNT_EVENT_BUS_WAIT = 21, /**< CPU mhpmevent CSR (21): Bus switch arbitration stall cycle */
+  HPMCNT_EVENT_DMA_BUSY = 22, /**< CPU mhpmevent CSR (22): DMA bus access in progress */
+
+  HPMCNT_EVENT_IRQ_WAIT = 23, /**< CPU mhpmevent CSR (23): Interrupt latency cycle (enabled interrupt pending but not taken yet) */
+
+  HPMCNT_EVENT_XB_WAIT  = 24, /**< CPU mhpmevent CSR (24): Crossbar section port arbitration stall cycle */
+  HPMCNT_EVENT_XB_PARA  = 25  /**< CPU mhpmevent CSR (25): Crossbar parallel section port accesses */
+};
+
+
+/**********************************************************************//**
+ * CPU <b>mhpmevent*h</b> CSR (r/w): Machine hardware performance monitor event selector - high word (Sscofpmf)
+ **************************************************************************/
+enum NEORV32_CSR_MHPMEVENTH_enum {
+  CSR_MHPMEVENTH_OF = 31 /**< CPU mhpmevent*h CSR (31): OF - Counter overflow flag, set by hardware (r/w) */
 };
 
 
@@ -429,6 +475,7 @@ enum NEORV32_EXCEPTION_CODES_enum {
   TRAP_CODE_MSI          = 0x80000003U, /**< 1.3:  Machine software interrupt */
   TRAP_CODE_MTI          = 0x80000007U, /**< 1.7:  Machine timer interrupt */
   TRAP_CODE_MEI          = 0x8000000bU, /**< 1.11: Machine external interrupt */
+  TRAP_CODE_LCOFI        = 0x8000000dU, /**< 1.13: Local counter overflow interrupt */
   TRAP_CODE_FIRQ_0       = 0x80000010U, /**< 1.16: Fast interrupt channel 0 */
   TRAP_CODE_FIRQ_1       = 0x80000011U, /**< 1.17: Fast interrupt channel 1 */
   TRAP_CODE_FIRQ_2       = 0x80000012U, /**< 1.18: Fast interrupt channel 2 */
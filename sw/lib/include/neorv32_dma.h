@@ -47,27 +47,38 @@
  * @name IO Device: Direct Memory Access Controller (DMA)
  **************************************************************************/
 /**@{*/
-/** DMA module prototype */
+/** DMA channel prototype */
 typedef volatile struct __attribute__((packed,aligned(4))) {
-  uint32_t CTRL;     /**< offset  0: control and status register (#NEORV32_DMA_CTRL_enum) */
-  uint32_t SRC_BASE; /**< offset  4: source base address register */
-  uint32_t DST_BASE; /**< offset  8: destination base address register */
-  uint32_t TTYPE;    /**< offset 12: transfer type configuration register & manual trigger (#NEORV32_DMA_TTYPE_enum) */
+  uint32_t CTRL;              /**< offset  0: control and status register (#NEORV32_DMA_CTRL_enum) */
+  uint32_t SRC_BASE;          /**< offset  4: source base address register */
+  uint32_t DST_BASE;          /**< offset  8: destination base address register */
+  uint32_t TTYPE;             /**< offset 12: transfer type configuration register & manual trigger (#NEORV32_DMA_TTYPE_enum) */
+  uint32_t DESC;              /**< offset 16: descriptor chain base address & descriptor chain trigger */
+  const uint32_t reserved[3]; /**< offset 20..28: reserved */
 } neorv32_dma_t;
 
-/** DMA module hardware access (#neorv32_dma_t) */
+/** DMA channel 0 hardware access (#neorv32_dma_t) */
 #define NEORV32_DMA ((neorv32_dma_t*) (NEORV32_DMA_BASE))
 
+/** DMA channel n hardware access (#neorv32_dma_t) */
+#define NEORV32_DMA_CH(n) ((neorv32_dma_t*) (NEORV32_DMA_BASE + ((n) * sizeof(neorv32_dma_t))))
+
 /** DMA control and status register bits */
 enum NEORV32_DMA_CTRL_enum {
   DMA_CTRL_EN            =  0, /**< DMA control register(0) (r/w): DMA enable */
   DMA_CTRL_AUTO          =  1, /**< DMA control register(1) (r/w): Automatic trigger mode enable */
   DMA_CTRL_FENCE         =  2, /**< DMA control register(2) (r/w): Issue FENCE downstream operation when DMA transfer is completed */
+  DMA_CTRL_ONESHOT       =  3, /**< DMA control register(3) (r/w): Clear DMA_CTRL_AUTO when a transfer is completed (one-shot automatic trigger) */
+
+  DMA_CTRL_NUM_CH_LSB    =  4, /**< DMA control register(4) (r/-): Number of implemented channels, LSB */
+  DMA_CTRL_NUM_CH_MSB    =  7, /**< DMA control register(7) (r/-): Number of implemented channels, MSB */
 
   DMA_CTRL_ERROR_RD      =  8, /**< DMA control register(8)  (r/-): Error during read access; SRC_BASE shows the faulting address */
   DMA_CTRL_ERROR_WR      =  9, /**< DMA control register(9)  (r/-): Error during write access; DST_BASE shows the faulting address */
   DMA_CTRL_BUSY          = 10, /**< DMA control register(10) (r/-): DMA busy / transfer in progress */
   DMA_CTRL_DONE          = 11, /**< DMA control register(11) (r/c): A transfer was executed when set */
+  DMA_CTRL_DESC_DONE     = 12, /**< DMA control register(12) (r/c): A descriptor with enabled interrupt was completed when set */
+  DMA_CTRL_CHAIN         = 13, /**< DMA control register(13) (r/-): Descriptor chain in progress */
 
   DMA_CTRL_FIRQ_MASK_LSB = 16, /**< DMA control register(16) (r/w): FIRQ trigger mask LSB */
   DMA_CTRL_FIRQ_MASK_MSB = 31  /**< DMA control register(31) (r/w): FIRQ trigger mask MSB */
@@ -77,6 +88,7 @@ enum NEORV32_DMA_CTRL_enum {
 enum NEORV32_DMA_TTYPE_enum {
   DMA_TTYPE_NUM_LSB  =  0, /**< DMA transfer type register(0)  (r/w): Number of elements to transfer, LSB */
   DMA_TTYPE_NUM_MSB  = 23, /**< DMA transfer type register(23) (r/w): Number of elements to transfer, MSB */
+  DMA_TTYPE_DESC_IRQ = 24, /**< DMA transfer type register(24) (-/w): Interrupt when descriptor is done (descriptor chain mode only) */
 
   DMA_TTYPE_QSEL_LSB = 27, /**< DMA transfer type register(27) (r/w): Data quantity select, LSB */
   DMA_TTYPE_QSEL_MSB = 28, /**< DMA transfer type register(28) (r/w): Data quantity select, MSB */
@@ -103,9 +115,42 @@ enum NEORV32_DMA_TTYPE_enum {
 #define DMA_CMD_DST_INC   (0b1 << DMA_TTYPE_DST_INC) // incrementing destination address
 
 #define DMA_CMD_ENDIAN (0b1 << DMA_TTYPE_ENDIAN) // convert endianness
+
+#define DMA_CMD_DESC_IRQ (0b1 << DMA_TTYPE_DESC_IRQ) // interrupt when descriptor is done (descriptor chain mode only)
 /**@}*/
 
 
+/**********************************************************************//**
+ * DMA transfer descriptor (descriptor chain mode); has to be 16-byte aligned
+ **************************************************************************/
+typedef struct __attribute__((packed,aligned(16))) {
+  uint32_t src;   /**< offset  0: source base address */
+  uint32_t dst;   /**< offset  4: destination base address */
+  uint32_t ttype; /**< offset  8: transfer type configuration (number of elements and #NEORV32_DMA_TTYPE_enum commands) */
+  uint32_t next;  /**< offset 12: address of next descriptor; NULL = end of chain */
+} neorv32_dma_desc_t;
+
+
+/**********************************************************************//**
+ * DMA stream: asynchronous, FIRQ-paced transfer of a caller-owned buffer to
+ * the TX FIFO of an IO device (see neorv32_dma_stream_start()).
+ **************************************************************************/
+typedef struct {
+  uint32_t src;                 /**< source address of next chunk (caller-owned buffer) */
+  uint32_t dst;                 /**< address of the device's TX data register */
+  uint32_t num;                 /**< remaining number of elements */
+  uint32_t config;              /**< transfer type configuration/commands */
+  uint32_t chunk;               /**< maximum number of elements per trigger (device TX FIFO depth, min #DMA_STREAM_CHUNK_MIN) */
+  uint32_t firq_mask;           /**< device FIRQ trigger mask (#NEORV32_CSR_MIP_enum) */
+  volatile uint32_t *dev_ctrl;  /**< device control register */
+  uint32_t dev_irq;             /**< device control register "IRQ if TX FIFO empty" bit mask */
+  void (*callback)(int status); /**< completion callback (0 = success, #NEORV32_DMA_STATUS_enum error code otherwise); can be NULL */
+} neorv32_dma_stream_t;
+
+/** Minimum number of elements per DMA stream trigger (device TX FIFO depth); smaller FIFOs would cause one DMA interrupt per element */
+#define DMA_STREAM_CHUNK_MIN 4
+
+
 /**********************************************************************//**
  * DMA status
  **************************************************************************/
@@ -122,14 +167,41 @@ enum NEORV32_DMA_STATUS_enum {
  **************************************************************************/
 /**@{*/
 int  neorv32_dma_available(void);
-void neorv32_dma_enable(void);
-void neorv32_dma_disable(void);
-void neorv32_dma_fence_enable(void);
-void neorv32_dma_fence_disable(void);
-void neorv32_dma_transfer(uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config);
-void neorv32_dma_transfer_auto(uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config, uint32_t firq_mask);
-int  neorv32_dma_status(void);
-int  neorv32_dma_done(void);
+int  neorv32_dma_get_num_channels(void);
+void neorv32_dma_ch_enable(neorv32_dma_t *DMAx);
+void neorv32_dma_ch_disable(neorv32_dma_t *DMAx);
+void neorv32_dma_ch_fence_enable(neorv32_dma_t *DMAx);
+void neorv32_dma_ch_fence_disable(neorv32_dma_t *DMAx);
+void neorv32_dma_ch_transfer(neorv32_dma_t *DMAx, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config);
+void neorv32_dma_ch_transfer_auto(neorv32_dma_t *DMAx, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config, uint32_t firq_mask);
+int  neorv32_dma_ch_status(neorv32_dma_t *DMAx);
+int  neorv32_dma_ch_done(neorv32_dma_t *DMAx);
+void neorv32_dma_chain_setup(neorv32_dma_desc_t *desc, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config);
+void neorv32_dma_chain_link(neorv32_dma_desc_t *desc, neorv32_dma_desc_t *next);
+void neorv32_dma_ch_chain_start(neorv32_dma_t *DMAx, neorv32_dma_desc_t *first);
+neorv32_dma_desc_t* neorv32_dma_ch_chain_current(neorv32_dma_t *DMAx);
+int  neorv32_dma_ch_chain_desc_done(neorv32_dma_t *DMAx);
+int  neorv32_dma_stream_start(neorv32_dma_stream_t *stream);
+int  neorv32_dma_stream_busy(void);
+void neorv32_dma_stream_wait(void);
+/**@}*/
+
+
+/**********************************************************************//**
+ * @name Channel 0 access (single-channel API)
+ **************************************************************************/
+/**@{*/
+#define neorv32_dma_enable()                                        neorv32_dma_ch_enable(NEORV32_DMA)
+#define neorv32_dma_disable()                                       neorv32_dma_ch_disable(NEORV32_DMA)
+#define neorv32_dma_fence_enable()                                  neorv32_dma_ch_fence_enable(NEORV32_DMA)
+#define neorv32_dma_fence_disable()                                 neorv32_dma_ch_fence_disable(NEORV32_DMA)
+#define neorv32_dma_transfer(base_src, base_dst, num, config)       neorv32_dma_ch_transfer(NEORV32_DMA, base_src, base_dst, num, config)
+#define neorv32_dma_transfer_auto(base_src, base_dst, num, config, firq_mask) neorv32_dma_ch_transfer_auto(NEORV32_DMA, base_src, base_dst, num, config, firq_mask)
+#define neorv32_dma_status()                                        neorv32_dma_ch_status(NEORV32_DMA)
+#define neorv32_dma_done()                                          neorv32_dma_ch_done(NEORV32_DMA)
+#define neorv32_dma_chain_start(first)                              neorv32_dma_ch_chain_start(NEORV32_DMA, first)
+#define neorv32_dma_chain_current()                                 neorv32_dma_ch_chain_current(NEORV32_DMA)
+#define neorv32_dma_chain_desc_done()                               neorv32_dma_ch_chain_desc_done(NEORV32_DMA)
 /**@}*/
 
 
@@ -49,10 +49,13 @@
 /**@{*/
 /** MTIME module prototype */
 typedef volatile struct __attribute__((packed,aligned(4))) {
-  uint32_t TIME_LO;    /**< offset 0:  time register low word */
-  uint32_t TIME_HI;    /**< offset 4:  time register high word */
-  uint32_t TIMECMP_LO; /**< offset 8:  compare register low word */
-  uint32_t TIMECMP_HI; /**< offset 12: compare register high word */
+  uint32_t TIME_LO;     /**< offset 0:  time register low word */
+  uint32_t TIME_HI;     /**< offset 4:  time register high word */
+  uint32_t TIMECMP_LO;  /**< offset 8:  compare register low word */
+  uint32_t TIMECMP_HI;  /**< offset 12: compare register high word */
+  uint32_t TIMECMP1_LO; /**< offset 16: compare register low word of hart 1 (dual-core only) */
+  uint32_t TIMECMP1_HI; /**< offset 20: compare register high word of hart 1 (dual-core only) */
+  uint32_t MSIP[2];     /**< offset 24..28: machine software interrupt pending flag (bit 0) per hart */
 } neorv32_mtime_t;
 
 /** MTIME module hardware access (#neorv32_mtime_t) */
@@ -69,6 +72,10 @@ void     neorv32_mtime_set_time(uint64_t time);
 uint64_t neorv32_mtime_get_time(void);
 void     neorv32_mtime_set_timecmp(uint64_t timecmp);
 uint64_t neorv32_mtime_get_timecmp(void);
+void     neorv32_mtime_set_timecmp_hart(int hart, uint64_t timecmp);
+uint64_t neorv32_mtime_get_timecmp_hart(int hart);
+void     neorv32_mtime_set_msip(int hart);
+void     neorv32_mtime_clr_msip(int hart);
 /**@}*/
 
 
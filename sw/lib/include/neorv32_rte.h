@@ -45,7 +45,7 @@
 /**********************************************************************//**
  * NEORV32 runtime environment: Number of available traps.
  **************************************************************************/
-#define NEORV32_RTE_NUM_TRAPS 29
+#define NEORV32_RTE_NUM_TRAPS 30
 
 
 /**********************************************************************//**
@@ -80,7 +80,8 @@ enum NEORV32_RTE_TRAP_enum {
   RTE_TRAP_FIRQ_12      = 25, /**< Fast interrupt channel 12 */
   RTE_TRAP_FIRQ_13      = 26, /**< Fast interrupt channel 13 */
   RTE_TRAP_FIRQ_14      = 27, /**< Fast interrupt channel 14 */
-  RTE_TRAP_FIRQ_15      = 28  /**< Fast interrupt channel 15 */
+  RTE_TRAP_FIRQ_15      = 28, /**< Fast interrupt channel 15 */
+  RTE_TRAP_LCOFI        = 29  /**< Local counter overflow interrupt */
 };
 
 
@@ -89,12 +90,20 @@ enum NEORV32_RTE_TRAP_enum {
  **************************************************************************/
 /**@{*/
 void     neorv32_rte_setup(void);
+void     neorv32_rte_fast_core(int enable);
 int      neorv32_rte_handler_install(int id, void (*handler)(void));
 int      neorv32_rte_handler_uninstall(int id);
 uint32_t neorv32_rte_context_get(int x);
 void     neorv32_rte_context_put(int x, uint32_t data);
 void     neorv32_rte_print_info(void);
 
+int  neorv32_rte_profiler_setup(uint32_t *buffer, uint32_t size, uint32_t base, int shift);
+int  neorv32_rte_profiler_start(int hpm, int event, uint32_t period);
+void neorv32_rte_profiler_stop(void);
+void neorv32_rte_profiler_dump(void);
+
+int  neorv32_rte_smp_launch(void (*entry)(void), uint8_t *stack_memory, uint32_t stack_size);
+
 void neorv32_rte_print_hw_config(void);
 void neorv32_rte_print_hw_version(void);
 void neorv32_rte_print_credits(void);
@@ -106,6 +106,7 @@ uint32_t neorv32_slink_get(void);
 uint32_t neorv32_slink_check_last(void);
 void     neorv32_slink_put(uint32_t tx_data);
 void     neorv32_slink_put_last(uint32_t tx_data);
+int      neorv32_slink_put_async(const uint32_t *buffer, uint32_t num, void (*callback)(int status));
 int      neorv32_slink_rx_status(void);
 int      neorv32_slink_tx_status(void);
 /**@}*/
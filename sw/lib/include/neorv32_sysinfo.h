@@ -60,7 +60,7 @@ typedef volatile struct __attribute__((packed,aligned(4))) {
 enum NEORV32_SYSINFO_MEM_enum {
   SYSINFO_MEM_IMEM =  0, /**< SYSINFO_MEM byte 0 (r/-): log2(internal IMEM size in bytes) (via MEM_INT_IMEM_SIZE generic) */
   SYSINFO_MEM_DMEM =  1, /**< SYSINFO_MEM byte 1 (r/-): log2(internal DMEM size in bytes) (via MEM_INT_DMEM_SIZE generic) */
-
+  SYSINFO_MEM_TCM  =  2, /**< SYSINFO_MEM byte 2 (r/-): bits 3:0: log2(ITCM size in bytes), bits 7:4: log2(DTCM size in bytes); zero if not implemented (via MEM_INT_xTCM_* generics) */
   SYSINFO_MEM_RVSG =  3  /**< SYSINFO_MEM byte 3 (r/-): log2(reservation set granularity in bytes) (via AMO_RVS_GRANULARITY generic) */
 };
 
@@ -74,7 +74,10 @@ enum NEORV32_SYSINFO_SOC_enum {
   SYSINFO_SOC_ICACHE         =  5, /**< SYSINFO_SOC  (5) (r/-): Processor-internal instruction cache implemented when 1 (via ICACHE_EN generic) */
   SYSINFO_SOC_DCACHE         =  6, /**< SYSINFO_SOC  (6) (r/-): Processor-internal instruction cache implemented when 1 (via DCACHE_EN generic) */
   SYSINFO_SOC_CLOCK_GATING   =  7, /**< SYSINFO_SOC  (7) (r/-): Clock gating enabled when 1 (via CLOCK_GATING_EN generic) */
-
+  SYSINFO_SOC_DCACHE_WB      =  8, /**< SYSINFO_SOC  (8) (r/-): Processor-internal data cache uses write-back policy when 1 (via DCACHE_WRITE_POLICY generic) */
+  SYSINFO_SOC_ICACHE_PF      =  9, /**< SYSINFO_SOC  (9) (r/-): Processor-internal instruction cache implements next-block prefetcher when 1 (via ICACHE_PREFETCH_EN generic) */
+  SYSINFO_SOC_BUS_XBAR       = 10, /**< SYSINFO_SOC (10) (r/-): Multi-layer bus crossbar implemented when 1 (via BUS_XBAR_EN generic) */
+  SYSINFO_SOC_DUAL_CORE      = 11, /**< SYSINFO_SOC (11) (r/-): Dual-core (SMP) configuration implemented when 1 (via DUAL_CORE_EN generic) */
   SYSINFO_SOC_IO_CRC         = 12, /**< SYSINFO_SOC (12) (r/-): Cyclic redundancy check unit implemented when 1 (via IO_CRC_EN generic) */
   SYSINFO_SOC_IO_SLINK       = 13, /**< SYSINFO_SOC (13) (r/-): Stream link interface implemented when 1 (via IO_SLINK_EN generic) */
   SYSINFO_SOC_IO_DMA         = 14, /**< SYSINFO_SOC (14) (r/-): Direct memory access controller implemented when 1 (via IO_DMA_EN generic) */
@@ -129,15 +132,15 @@ enum NEORV32_SYSINFO_SOC_enum {
   SYSINFO_CACHE_DC_NUM_BLOCKS_2    = 22, /**< SYSINFO_CACHE (22) (r/-): d-cache: log2(Number of cache blocks/pages/lines), bit 2 (via DCACHE_NUM_BLOCKS generic) */
   SYSINFO_CACHE_DC_NUM_BLOCKS_3    = 23, /**< SYSINFO_CACHE (23) (r/-): d-cache: log2(Number of cache blocks/pages/lines), bit 3 (via DCACHE_NUM_BLOCKS generic) */
 
-  SYSINFO_CACHE_DC_ASSOCIATIVITY_0 = 24, /**< SYSINFO_CACHE (24) (r/-): d-cache: log2(associativity), bit 0 */
-  SYSINFO_CACHE_DC_ASSOCIATIVITY_1 = 25, /**< SYSINFO_CACHE (25) (r/-): d-cache: log2(associativity), bit 1 */
-  SYSINFO_CACHE_DC_ASSOCIATIVITY_2 = 26, /**< SYSINFO_CACHE (26) (r/-): d-cache: log2(associativity), bit 2 */
-  SYSINFO_CACHE_DC_ASSOCIATIVITY_3 = 27, /**< SYSINFO_CACHE (27) (r/-): d-cache: log2(associativity), bit 3 */
+  SYSINFO_CACHE_DC_ASSOCIATIVITY_0 = 24, /**< SYSINFO_CACHE (24) (r/-): d-cache: log2(associativity), bit 0 (via DCACHE_ASSOCIATIVITY generic) */
+  SYSINFO_CACHE_DC_ASSOCIATIVITY_1 = 25, /**< SYSINFO_CACHE (25) (r/-): d-cache: log2(associativity), bit 1 (via DCACHE_ASSOCIATIVITY generic) */
+  SYSINFO_CACHE_DC_ASSOCIATIVITY_2 = 26, /**< SYSINFO_CACHE (26) (r/-): d-cache: log2(associativity), bit 2 (via DCACHE_ASSOCIATIVITY generic) */
+  SYSINFO_CACHE_DC_ASSOCIATIVITY_3 = 27, /**< SYSINFO_CACHE (27) (r/-): d-cache: log2(associativity), bit 3 (via DCACHE_ASSOCIATIVITY generic) */
 
-  SYSINFO_CACHE_DC_REPLACEMENT_0   = 28, /**< SYSINFO_CACHE (28) (r/-): d-cache: replacement policy, bit 0 */
-  SYSINFO_CACHE_DC_REPLACEMENT_1   = 29, /**< SYSINFO_CACHE (29) (r/-): d-cache: replacement policy, bit 1 */
-  SYSINFO_CACHE_DC_REPLACEMENT_2   = 30, /**< SYSINFO_CACHE (30) (r/-): d-cache: replacement policy, bit 2 */
-  SYSINFO_CACHE_DC_REPLACEMENT_3   = 31, /**< SYSINFO_CACHE (31) (r/-): d-cache: replacement policy, bit 3 */
+  SYSINFO_CACHE_DC_REPLACEMENT_0   = 28, /**< SYSINFO_CACHE (28) (r/-): d-cache: replacement policy (0010 = pseudo-LRU if associativity > 0), bit 0 */
+  SYSINFO_CACHE_DC_REPLACEMENT_1   = 29, /**< SYSINFO_CACHE (29) (r/-): d-cache: replacement policy (0010 = pseudo-LRU if associativity > 0), bit 1 */
+  SYSINFO_CACHE_DC_REPLACEMENT_2   = 30, /**< SYSINFO_CACHE (30) (r/-): d-cache: replacement policy (0010 = pseudo-LRU if associativity > 0), bit 2 */
+  SYSINFO_CACHE_DC_REPLACEMENT_3   = 31, /**< SYSINFO_CACHE (31) (r/-): d-cache: replacement policy (0010 = pseudo-LRU if associativity > 0), bit 3 */
 };
 /**@}*/
 
@@ -110,6 +110,28 @@ enum NEORV32_UART_DATA_enum {
 /**@}*/
 
 
+/**********************************************************************//**
+ * @name Buffered (interrupt-driven) UART driver
+ **************************************************************************/
+/**@{*/
+/** Lock-free single-producer/single-consumer ring buffer */
+typedef struct {
+  char *buf;              /**< buffer memory (caller-owned) */
+  uint32_t mask;          /**< buffer size - 1 (buffer size has to be a power of two) */
+  volatile uint32_t head; /**< free-running write index (modified by producer only) */
+  volatile uint32_t tail; /**< free-running read index (modified by consumer only) */
+} neorv32_uart_ring_t;
+
+/** Buffered UART driver state */
+typedef struct {
+  neorv32_uart_ring_t rx;      /**< RX ring buffer (producer: RX interrupt handler, consumer: application) */
+  neorv32_uart_ring_t tx;      /**< TX ring buffer (producer: application, consumer: TX interrupt handler) */
+  volatile uint32_t rx_lost;   /**< number of received characters discarded due to full RX ring buffer */
+  volatile int enabled;        /**< buffered mode enabled when non-zero */
+} neorv32_uart_buffered_t;
+/**@}*/
+
+
 /**********************************************************************//**
  * @name Prototypes
  **************************************************************************/
@@ -123,6 +145,7 @@ void neorv32_uart_disable(neorv32_uart_t *UARTx);
 void neorv32_uart_rtscts_enable(neorv32_uart_t *UARTx);
 void neorv32_uart_rtscts_disable(neorv32_uart_t *UARTx);
 void neorv32_uart_putc(neorv32_uart_t *UARTx, char c);
+int  neorv32_uart_put_async(neorv32_uart_t *UARTx, const char *buffer, uint32_t len, void (*callback)(int status));
 int  neorv32_uart_tx_busy(neorv32_uart_t *UARTx);
 char neorv32_uart_getc(neorv32_uart_t *UARTx);
 int  neorv32_uart_char_received(neorv32_uart_t *UARTx);
@@ -131,6 +154,15 @@ void neorv32_uart_puts(neorv32_uart_t *UARTx, const char *s);
 void neorv32_uart_vprintf(neorv32_uart_t *UARTx, const char *format, va_list args);
 void neorv32_uart_printf(neorv32_uart_t *UARTx, const char *format, ...);
 int  neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int echo);
+int  neorv32_uart_buffered_setup(neorv32_uart_t *UARTx, char *rx_buf, uint32_t rx_size, char *tx_buf, uint32_t tx_size);
+void neorv32_uart_buffered_disable(neorv32_uart_t *UARTx);
+int  neorv32_uart_buffered_enabled(neorv32_uart_t *UARTx);
+int  neorv32_uart_buffered_read(neorv32_uart_t *UARTx, char *buffer, int len);
+int  neorv32_uart_buffered_write(neorv32_uart_t *UARTx, const char *buffer, int len);
+int  neorv32_uart_buffered_rx_available(neorv32_uart_t *UARTx);
+int  neorv32_uart_buffered_tx_free(neorv32_uart_t *UARTx);
+void neorv32_uart_buffered_flush(neorv32_uart_t *UARTx);
+uint32_t neorv32_uart_buffered_rx_lost(neorv32_uart_t *UARTx);
 /**@}*/
 
 
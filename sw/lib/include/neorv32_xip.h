@@ -49,10 +49,10 @@
 /**@{*/
 /** XIP module prototype */
 typedef volatile struct __attribute__((packed,aligned(4))) {
-  uint32_t CTRL;           /**< offset  0: control register (#NEORV32_XIP_CTRL_enum) */
-  const uint32_t reserved; /**< offset  4: reserved */
-  uint32_t DATA_LO;        /**< offset  8: SPI data register low */
-  uint32_t DATA_HI;        /**< offset 12: SPI data register high */
+  uint32_t CTRL;    /**< offset  0: control register (#NEORV32_XIP_CTRL_enum) */
+  uint32_t QCTRL;   /**< offset  4: quad I/O control register (#NEORV32_XIP_QCTRL_enum) */
+  uint32_t DATA_LO; /**< offset  8: SPI data register low */
+  uint32_t DATA_HI; /**< offset 12: SPI data register high */
 } neorv32_xip_t;
 
 /** XIP module hardware access (#neorv32_xip_t) */
@@ -79,11 +79,20 @@ enum NEORV32_XIP_CTRL_enum {
   XIP_CTRL_CDIV1          = 24, /**< XIP control register(24) (r/w): Clock divider bit 1 */
   XIP_CTRL_CDIV2          = 25, /**< XIP control register(25) (r/w): Clock divider bit 2 */
   XIP_CTRL_CDIV3          = 26, /**< XIP control register(26) (r/w): Clock divider bit 3 */
+  XIP_CTRL_QUAD           = 27, /**< XIP control register(27) (r/w): XIP quad I/O read mode (1-4-4) enable */
 
   XIP_CTRL_BURST_EN       = 29, /**< XIP control register(29) (r/-): Burst mode enabled (set if XIP cache is implemented) */
   XIP_CTRL_PHY_BUSY       = 30, /**< XIP control register(30) (r/-): SPI PHY is busy */
   XIP_CTRL_XIP_BUSY       = 31  /**< XIP control register(31) (r/-): XIP access in progress */
 };
+
+/** XIP quad I/O control register bits */
+enum NEORV32_XIP_QCTRL_enum {
+  XIP_QCTRL_DUMMY_LSB =  0, /**< XIP quad I/O control register( 0) (r/w): Number of dummy clock cycles, LSB */
+  XIP_QCTRL_DUMMY_MSB =  3, /**< XIP quad I/O control register( 3) (r/w): Number of dummy clock cycles, MSB */
+  XIP_QCTRL_MODE_LSB  =  4, /**< XIP quad I/O control register( 4) (r/w): Mode bits (sent after the address), LSB */
+  XIP_QCTRL_MODE_MSB  = 11  /**< XIP quad I/O control register(11) (r/w): Mode bits (sent after the address), MSB */
+};
 /**@}*/
 
 
@@ -93,6 +102,7 @@ enum NEORV32_XIP_CTRL_enum {
 /**@{*/
 int  neorv32_xip_available(void);
 void neorv32_xip_setup(int prsc, int cdiv, int cpol, int cpha, uint8_t rd_cmd);
+int  neorv32_xip_quad_setup(uint8_t rd_cmd, int dummy);
 int  neorv32_xip_start(int abytes);
 void neorv32_xip_highspeed_enable(void);
 void neorv32_xip_highspeed_disable(void);
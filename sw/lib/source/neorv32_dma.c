@@ -43,6 +43,12 @@
 #include "neorv32.h"
 #include "neorv32_dma.h"
 
+// private variables and functions for DMA streams
+static neorv32_dma_stream_t * volatile __neorv32_dma_stream = NULL; // active stream
+static neorv32_dma_t *__neorv32_dma_stream_ch; // DMA channel used for streams
+static void __neorv32_dma_stream_next(void);
+static void __neorv32_dma_stream_handler(void);
+
 
 /**********************************************************************//**
  * Check if DMA controller was synthesized.
@@ -60,91 +66,116 @@ int neorv32_dma_available(void) {
 }
 
 
+/**********************************************************************//**
+ * Get number of implemented DMA channels.
+ *
+ * @return Number of implemented DMA channels (0 if DMA was not synthesized).
+ **************************************************************************/
+int neorv32_dma_get_num_channels(void) {
+
+  if (neorv32_dma_available() == 0) {
+    return 0;
+  }
+  return (int)((NEORV32_DMA->CTRL >> DMA_CTRL_NUM_CH_LSB) & 0xf);
+}
+
+
 /**********************************************************************//**
  * Enable DMA.
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  **************************************************************************/
-void neorv32_dma_enable(void) {
+void neorv32_dma_ch_enable(neorv32_dma_t *DMAx) {
 
-  NEORV32_DMA->CTRL |= (uint32_t)(1 << DMA_CTRL_EN);
+  DMAx->CTRL |= (uint32_t)(1 << DMA_CTRL_EN);
 }
 
 
 /**********************************************************************//**
  * Disable DMA. This will reset the DMA and will also terminate the current transfer.
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  **************************************************************************/
-void neorv32_dma_disable(void) {
+void neorv32_dma_ch_disable(neorv32_dma_t *DMAx) {
 
-  NEORV32_DMA->CTRL &= ~((uint32_t)(1 << DMA_CTRL_EN));
+  DMAx->CTRL &= ~((uint32_t)(1 << DMA_CTRL_EN));
 }
 
 
 /**********************************************************************//**
  * Enable memory barrier (fence): issue a FENCE operation when DMA transfer
  * completes  without errors.
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  **************************************************************************/
-void neorv32_dma_fence_enable(void) {
+void neorv32_dma_ch_fence_enable(neorv32_dma_t *DMAx) {
 
-  NEORV32_DMA->CTRL |= (uint32_t)(1 << DMA_CTRL_FENCE);
+  DMAx->CTRL |= (uint32_t)(1 << DMA_CTRL_FENCE);
 }
 
 
 /**********************************************************************//**
  * Disable memory barrier (fence).
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  **************************************************************************/
-void neorv32_dma_fence_disable(void) {
+void neorv32_dma_ch_fence_disable(neorv32_dma_t *DMAx) {
 
-  NEORV32_DMA->CTRL &= ~((uint32_t)(1 << DMA_CTRL_FENCE));
+  DMAx->CTRL &= ~((uint32_t)(1 << DMA_CTRL_FENCE));
 }
 
 
 /**********************************************************************//**
  * Trigger manual DMA transfer.
  *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  * @param[in] base_src Source base address (has to be aligned to source data type!).
  * @param[in] base_dst Destination base address (has to be aligned to destination data type!).
  * @param[in] num Number of elements to transfer (24-bit).
  * @param[in] config Transfer type configuration/commands.
  **************************************************************************/
-void neorv32_dma_transfer(uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config) {
+void neorv32_dma_ch_transfer(neorv32_dma_t *DMAx, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config) {
 
-  NEORV32_DMA->CTRL &= ~((uint32_t)(1 << DMA_CTRL_AUTO)); // manual transfer trigger
-  NEORV32_DMA->SRC_BASE = base_src;
-  NEORV32_DMA->DST_BASE = base_dst;
-  NEORV32_DMA->TTYPE    = (num & 0x00ffffffUL) | (config & 0xff000000UL); // trigger transfer
+  DMAx->CTRL &= ~((uint32_t)(1 << DMA_CTRL_AUTO)); // manual transfer trigger
+  DMAx->SRC_BASE = base_src;
+  DMAx->DST_BASE = base_dst;
+  DMAx->TTYPE    = (num & 0x00ffffffUL) | (config & 0xff000000UL); // trigger transfer
 }
 
 
 /**********************************************************************//**
  * Configure automatic DMA transfer (triggered by CPU FIRQ).
  *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  * @param[in] base_src Source base address (has to be aligned to source data type!).
  * @param[in] base_dst Destination base address (has to be aligned to destination data type!).
  * @param[in] num Number of elements to transfer (24-bit).
  * @param[in] config Transfer type configuration/commands.
  * @param[in] firq_mask FIRQ trigger mask (#NEORV32_CSR_MIP_enum).
  **************************************************************************/
-void neorv32_dma_transfer_auto(uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config, uint32_t firq_mask) {
+void neorv32_dma_ch_transfer_auto(neorv32_dma_t *DMAx, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config, uint32_t firq_mask) {
 
-  uint32_t tmp = NEORV32_DMA->CTRL;
+  uint32_t tmp = DMAx->CTRL;
   tmp |= (uint32_t)(1 << DMA_CTRL_AUTO); // automatic transfer trigger
   tmp &= 0x0000ffffUL; // clear current FIRQ mask
   tmp |= firq_mask & 0xffff0000UL; // set new FIRQ mask
-  NEORV32_DMA->CTRL = tmp;
+  DMAx->CTRL = tmp;
 
-  NEORV32_DMA->SRC_BASE = base_src;
-  NEORV32_DMA->DST_BASE = base_dst;
-  NEORV32_DMA->TTYPE    = (num & 0x00ffffffUL) | (config & 0xff000000UL);
+  DMAx->SRC_BASE = base_src;
+  DMAx->DST_BASE = base_dst;
+  DMAx->TTYPE    = (num & 0x00ffffffUL) | (config & 0xff000000UL);
 }
 
 
 /**********************************************************************//**
  * Get DMA status.
  *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  * @return Current DMA status (#NEORV32_DMA_STATUS_enum)
  **************************************************************************/
-int neorv32_dma_status(void) {
+int neorv32_dma_ch_status(neorv32_dma_t *DMAx) {
 
-  uint32_t tmp = NEORV32_DMA->CTRL;
+  uint32_t tmp = DMAx->CTRL;
 
   if (tmp & (1 << DMA_CTRL_ERROR_WR)) {
     return DMA_STATUS_ERR_WR; // error during write access
@@ -164,12 +195,13 @@ int neorv32_dma_status(void) {
 /**********************************************************************//**
  * Check if a transfer has actually been executed.
  *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
  * @return 0 if no transfer was executed, 1 if a transfer has actually been executed.
- * Use neorv32_dma_status(void) to check if there was an error during that transfer.
+ * Use neorv32_dma_ch_status() to check if there was an error during that transfer.
  **************************************************************************/
-int neorv32_dma_done(void) {
+int neorv32_dma_ch_done(neorv32_dma_t *DMAx) {
 
-  if (NEORV32_DMA->CTRL & (1 << DMA_CTRL_DONE)) {
+  if (DMAx->CTRL & (1 << DMA_CTRL_DONE)) {
     return 1; // there was a transfer
   }
   else {
@@ -177,3 +209,222 @@ int neorv32_dma_done(void) {
   }
 
 }
+
+
+/**********************************************************************//**
+ * Configure a transfer descriptor for descriptor chain mode. The descriptor
+ * is initialized as end of chain (no next descriptor).
+ *
+ * @param[in,out] desc Pointer to descriptor (has to be 16-byte aligned!).
+ * @param[in] base_src Source base address (has to be aligned to source data type!).
+ * @param[in] base_dst Destination base address (has to be aligned to destination data type!).
+ * @param[in] num Number of elements to transfer (24-bit, has to be greater than zero).
+ * @param[in] config Transfer type configuration/commands (including #DMA_CMD_DESC_IRQ).
+ **************************************************************************/
+void neorv32_dma_chain_setup(neorv32_dma_desc_t *desc, uint32_t base_src, uint32_t base_dst, uint32_t num, uint32_t config) {
+
+  desc->src   = base_src;
+  desc->dst   = base_dst;
+  desc->ttype = (num & 0x00ffffffUL) | (config & 0xff000000UL);
+  desc->next  = 0; // end of chain
+}
+
+
+/**********************************************************************//**
+ * Link two transfer descriptors.
+ *
+ * @param[in,out] desc Pointer to descriptor.
+ * @param[in] next Pointer to descriptor that is executed after desc (NULL = end of chain).
+ **************************************************************************/
+void neorv32_dma_chain_link(neorv32_dma_desc_t *desc, neorv32_dma_desc_t *next) {
+
+  desc->next = (uint32_t)next;
+}
+
+
+/**********************************************************************//**
+ * Start descriptor chain. The DMA fetches and executes all linked descriptors
+ * back-to-back.
+ *
+ * @note The descriptors are fetched directly from memory. Make sure all
+ * descriptors have been written back to main memory (e.g. by executing a
+ * "fence" instruction) before starting the chain.
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
+ * @param[in] first Pointer to first descriptor of the chain (has to be 16-byte aligned!).
+ **************************************************************************/
+void neorv32_dma_ch_chain_start(neorv32_dma_t *DMAx, neorv32_dma_desc_t *first) {
+
+  DMAx->CTRL &= ~((uint32_t)(1 << DMA_CTRL_AUTO)); // manual transfer trigger
+  DMAx->DESC = (uint32_t)first; // trigger descriptor chain
+}
+
+
+/**********************************************************************//**
+ * Get the descriptor that is currently processed (or the last processed one).
+ * In case of an error this is the descriptor that caused the error.
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
+ * @return Pointer to current descriptor.
+ **************************************************************************/
+neorv32_dma_desc_t* neorv32_dma_ch_chain_current(neorv32_dma_t *DMAx) {
+
+  return (neorv32_dma_desc_t*)DMAx->DESC;
+}
+
+
+/**********************************************************************//**
+ * Check if a descriptor with enabled interrupt (#DMA_CMD_DESC_IRQ) has been completed.
+ * This also clears the flag (and the #DMA_CTRL_DONE flag).
+ *
+ * @param[in,out] DMAx Hardware handle to DMA channel register struct, #neorv32_dma_t.
+ * @return 0 if no descriptor has been completed, 1 if a descriptor has been completed.
+ **************************************************************************/
+int neorv32_dma_ch_chain_desc_done(neorv32_dma_t *DMAx) {
+
+  uint32_t tmp = DMAx->CTRL;
+
+  if (tmp & (1 << DMA_CTRL_DESC_DONE)) {
+    DMAx->CTRL = tmp; // clear flag
+    return 1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Start an asynchronous DMA stream: send the caller-owned buffer (stream->src)
+ * to the TX data register of an IO device without CPU interaction. The buffer
+ * is sent in chunks of up to stream->chunk elements. Each chunk is triggered
+ * (DMA one-shot automatic trigger mode) by the device's "TX FIFO empty" interrupt;
+ * the next chunk is programmed by the DMA interrupt handler, which is installed via
+ * the RTE. The completion callback is called from this handler when the entire
+ * buffer has been sent (or when a bus error occurred).
+ *
+ * @note The stream uses the last implemented DMA channel and occupies the RTE's
+ * DMA trap handler (#DMA_RTE_ID). The RTE has to be set up and machine-mode
+ * interrupts have to be enabled globally. The buffer and the stream struct must
+ * not be modified until the stream has completed.
+ *
+ * @note The DMA channel leaves the automatic trigger mode after each chunk
+ * (#DMA_CTRL_ONESHOT), so a late DMA interrupt only delays the stream but never
+ * re-sends the previous chunk.
+ *
+ * @param[in,out] stream Stream configuration/state (#neorv32_dma_stream_t).
+ * @return 0 if the stream has been started, -1 if the DMA is not available, a stream
+ * is already in progress, if stream->num is zero or if stream->chunk is less than
+ * #DMA_STREAM_CHUNK_MIN.
+ **************************************************************************/
+int neorv32_dma_stream_start(neorv32_dma_stream_t *stream) {
+
+  if ((neorv32_dma_available() == 0) || (__neorv32_dma_stream != NULL) || (stream->num == 0) || (stream->chunk < DMA_STREAM_CHUNK_MIN)) {
+    return -1;
+  }
+
+  __neorv32_dma_stream_ch = NEORV32_DMA_CH(neorv32_dma_get_num_channels() - 1);
+  __neorv32_dma_stream = stream;
+
+  asm volatile ("fence"); // make sure the buffer has been written back to main memory
+
+  neorv32_rte_handler_install(DMA_RTE_ID, __neorv32_dma_stream_handler);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+  neorv32_dma_ch_enable(__neorv32_dma_stream_ch);
+  __neorv32_dma_stream_ch->CTRL |= (uint32_t)(1 << DMA_CTRL_ONESHOT); // re-armed for each chunk by __neorv32_dma_stream_next()
+  __neorv32_dma_stream_next();
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Check if a DMA stream is in progress.
+ *
+ * @return 0 if no stream is active, 1 if a stream is in progress.
+ **************************************************************************/
+int neorv32_dma_stream_busy(void) {
+
+  if (__neorv32_dma_stream != NULL) {
+    return 1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Wait for the current DMA stream to complete. If machine-mode interrupts are
+ * globally disabled the DMA interrupt is polled and handled by this function.
+ **************************************************************************/
+void neorv32_dma_stream_wait(void) {
+
+  while (__neorv32_dma_stream != NULL) {
+    if ((neorv32_cpu_csr_read(CSR_MSTATUS) & (1 << CSR_MSTATUS_MIE)) == 0) { // interrupts disabled
+      if (neorv32_cpu_csr_read(CSR_MIP) & (1 << DMA_FIRQ_PENDING)) {
+        __neorv32_dma_stream_handler();
+      }
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Program the next chunk of the active DMA stream.
+ **************************************************************************/
+static void __neorv32_dma_stream_next(void) {
+
+  neorv32_dma_stream_t *stream = __neorv32_dma_stream;
+  uint32_t num = (stream->num < stream->chunk) ? stream->num : stream->chunk;
+
+  *(stream->dev_ctrl) &= ~(stream->dev_irq); // disable device interrupt
+  neorv32_dma_ch_transfer_auto(__neorv32_dma_stream_ch, stream->src, stream->dst, num, stream->config, stream->firq_mask);
+
+  if ((stream->config & (3 << DMA_TTYPE_QSEL_LSB)) == DMA_CMD_W2W) { // word source
+    stream->src += num * 4;
+  }
+  else { // byte source
+    stream->src += num;
+  }
+  stream->num -= num;
+
+  // re-enable device interrupt: the rising edge triggers the DMA as soon as the TX FIFO is empty
+  *(stream->dev_ctrl) |= stream->dev_irq;
+}
+
+
+/**********************************************************************//**
+ * DMA interrupt handler for DMA streams.
+ **************************************************************************/
+static void __neorv32_dma_stream_handler(void) {
+
+  neorv32_dma_stream_t *stream = __neorv32_dma_stream;
+  int status;
+
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << DMA_FIRQ_PENDING); // clear/ack pending FIRQ
+
+  if ((stream == NULL) || (neorv32_dma_ch_done(__neorv32_dma_stream_ch) == 0)) {
+    return; // not caused by the stream's channel
+  }
+
+  status = neorv32_dma_ch_status(__neorv32_dma_stream_ch);
+  if ((status >= 0) && (stream->num != 0)) { // send next chunk
+    __neorv32_dma_stream_next();
+    return;
+  }
+
+  // stream completed or failed: back to manual trigger mode, clear FIRQ mask and DONE flag
+  *(stream->dev_ctrl) &= ~(stream->dev_irq);
+  __neorv32_dma_stream_ch->CTRL &= ~((uint32_t)(0xffff0000UL | (1 << DMA_CTRL_ONESHOT) | (1 << DMA_CTRL_AUTO)));
+  __neorv32_dma_stream = NULL;
+
+  if (stream->callback != NULL) {
+    if (status < 0) {
+      stream->callback(status);
+    }
+    else {
+      stream->callback(0);
+    }
+  }
+}
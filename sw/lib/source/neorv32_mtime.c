@@ -116,7 +116,7 @@ uint64_t neorv32_mtime_get_time(void) {
 
 
 /**********************************************************************//**
- * Set compare time register (MTIMECMP) for generating interrupts.
+ * Set compare time register (MTIMECMP) of hart 0 for generating interrupts.
  *
  * @note The interrupt is triggered when MTIME >= MTIMECMP.
  * @note Global interrupts and the timer interrupt source have to be enabled .
@@ -125,6 +125,32 @@ uint64_t neorv32_mtime_get_time(void) {
  **************************************************************************/
 void neorv32_mtime_set_timecmp(uint64_t timecmp) {
 
+  neorv32_mtime_set_timecmp_hart(0, timecmp);
+}
+
+
+/**********************************************************************//**
+ * Get compare time register (MTIMECMP) of hart 0.
+ *
+ * @return Current MTIMECMP value.
+ **************************************************************************/
+uint64_t neorv32_mtime_get_timecmp(void) {
+
+  return neorv32_mtime_get_timecmp_hart(0);
+}
+
+
+/**********************************************************************//**
+ * Set compare time register (MTIMECMP) of a specific hart for generating interrupts.
+ *
+ * @note The interrupt is triggered when MTIME >= MTIMECMP.
+ * @note Hart 1 is available in dual-core configurations only.
+ *
+ * @param[in] hart Hart index (0 or 1).
+ * @param[in] timecmp System time for interrupt (uint64_t)
+ **************************************************************************/
+void neorv32_mtime_set_timecmp_hart(int hart, uint64_t timecmp) {
+
   union {
     uint64_t uint64;
     uint32_t uint32[sizeof(uint64_t)/sizeof(uint32_t)];
@@ -132,28 +158,66 @@ void neorv32_mtime_set_timecmp(uint64_t timecmp) {
 
   cycles.uint64 = timecmp;
 
-  NEORV32_MTIME->TIMECMP_LO = -1; // prevent MTIMECMP from temporarily becoming smaller than the lesser of the old and new values
-  NEORV32_MTIME->TIMECMP_HI = cycles.uint32[1];
-  NEORV32_MTIME->TIMECMP_LO = cycles.uint32[0];
+  if (hart & 1) {
+    NEORV32_MTIME->TIMECMP1_LO = -1; // prevent MTIMECMP from temporarily becoming smaller than the lesser of the old and new values
+    NEORV32_MTIME->TIMECMP1_HI = cycles.uint32[1];
+    NEORV32_MTIME->TIMECMP1_LO = cycles.uint32[0];
+  }
+  else {
+    NEORV32_MTIME->TIMECMP_LO = -1; // prevent MTIMECMP from temporarily becoming smaller than the lesser of the old and new values
+    NEORV32_MTIME->TIMECMP_HI = cycles.uint32[1];
+    NEORV32_MTIME->TIMECMP_LO = cycles.uint32[0];
+  }
 
   asm volatile("nop"); // delay due to write buffer
 }
 
 
 /**********************************************************************//**
- * Get compare time register (MTIMECMP).
+ * Get compare time register (MTIMECMP) of a specific hart.
  *
+ * @param[in] hart Hart index (0 or 1).
  * @return Current MTIMECMP value.
  **************************************************************************/
-uint64_t neorv32_mtime_get_timecmp(void) {
+uint64_t neorv32_mtime_get_timecmp_hart(int hart) {
 
   union {
     uint64_t uint64;
     uint32_t uint32[sizeof(uint64_t)/sizeof(uint32_t)];
   } cycles;
 
-  cycles.uint32[0] = NEORV32_MTIME->TIMECMP_LO;
-  cycles.uint32[1] = NEORV32_MTIME->TIMECMP_HI;
+  if (hart & 1) {
+    cycles.uint32[0] = NEORV32_MTIME->TIMECMP1_LO;
+    cycles.uint32[1] = NEORV32_MTIME->TIMECMP1_HI;
+  }
+  else {
+    cycles.uint32[0] = NEORV32_MTIME->TIMECMP_LO;
+    cycles.uint32[1] = NEORV32_MTIME->TIMECMP_HI;
+  }
 
   return cycles.uint64;
 }
+
+
+/**********************************************************************//**
+ * Trigger machine software interrupt (inter-processor interrupt) of a hart.
+ *
+ * @note Hart 1 is available in dual-core configurations only.
+ *
+ * @param[in] hart Hart index (0 or 1).
+ **************************************************************************/
+void neorv32_mtime_set_msip(int hart) {
+
+  NEORV32_MTIME->MSIP[hart & 1] = 1;
+}
+
+
+/**********************************************************************//**
+ * Clear pending machine software interrupt (inter-processor interrupt) of a hart.
+ *
+ * @param[in] hart Hart index (0 or 1).
+ **************************************************************************/
+void neorv32_mtime_clr_msip(int hart) {
+
+  NEORV32_MTIME->MSIP[hart & 1] = 0;
+}
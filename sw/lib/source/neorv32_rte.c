@@ -53,8 +53,32 @@
  **************************************************************************/
 static uint32_t __neorv32_rte_vector_lut[NEORV32_RTE_NUM_TRAPS] __attribute__((unused)); // trap handler vector table
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Trap handler vector table of the fast-path core, directly indexed by {mcause[31], mcause[4:0]}.
+ * This table is global as it is accessed from assembly.
+ **************************************************************************/
+uint32_t __neorv32_rte_fast_lut[64] __attribute__((used));
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * mcause trap code of each RTE trap ID.
+ **************************************************************************/
+static const uint32_t __neorv32_rte_trap_code[NEORV32_RTE_NUM_TRAPS] = {
+  TRAP_CODE_I_ACCESS,     TRAP_CODE_I_ILLEGAL,    TRAP_CODE_I_MISALIGNED, TRAP_CODE_BREAKPOINT,
+  TRAP_CODE_L_MISALIGNED, TRAP_CODE_L_ACCESS,     TRAP_CODE_S_MISALIGNED, TRAP_CODE_S_ACCESS,
+  TRAP_CODE_UENV_CALL,    TRAP_CODE_MENV_CALL,    TRAP_CODE_MSI,          TRAP_CODE_MTI,
+  TRAP_CODE_MEI,          TRAP_CODE_FIRQ_0,       TRAP_CODE_FIRQ_1,       TRAP_CODE_FIRQ_2,
+  TRAP_CODE_FIRQ_3,       TRAP_CODE_FIRQ_4,       TRAP_CODE_FIRQ_5,       TRAP_CODE_FIRQ_6,
+  TRAP_CODE_FIRQ_7,       TRAP_CODE_FIRQ_8,       TRAP_CODE_FIRQ_9,       TRAP_CODE_FIRQ_10,
+  TRAP_CODE_FIRQ_11,      TRAP_CODE_FIRQ_12,      TRAP_CODE_FIRQ_13,      TRAP_CODE_FIRQ_14,
+  TRAP_CODE_FIRQ_15,      TRAP_CODE_LCOFI
+};
+
 // private functions
 static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void);
+static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core_fast(void);
+static void __neorv32_rte_set_handler(uint32_t index, uint32_t handler);
 static void __neorv32_rte_debug_handler(void);
 static void __neorv32_rte_print_hex_word(uint32_t num);
 
@@ -83,12 +107,37 @@ void neorv32_rte_setup(void) {
 
   // install debug handler for all trap sources
   int id;
+  for (id = 0; id < 64; id++) {
+    __neorv32_rte_fast_lut[id] = (uint32_t)(&__neorv32_rte_debug_handler); // also covers unused trap codes
+  }
   for (id = 0; id < ((int)NEORV32_RTE_NUM_TRAPS); id++) {
     neorv32_rte_handler_uninstall(id); // this will configure the debug handler
   }
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Select the first-level trap handler (RTE core).
+ *
+ * @note The fast-path core only saves/restores the caller-saved registers (ra, t0-t6, a0-a7)
+ * and selects the second-level handler by directly indexing a table with mcause. Hence,
+ * neorv32_rte_context_get(int x) and neorv32_rte_context_put(int x, uint32_t data) can only
+ * access the caller-saved registers when the fast-path core is used.
+ *
+ * @param[in] enable Use fast-path core when non-zero, use standard core (full context) otherwise.
+ **************************************************************************/
+void neorv32_rte_fast_core(int enable) {
+
+  if (enable) {
+    neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)(&__neorv32_rte_core_fast));
+  }
+  else {
+    neorv32_cpu_csr_write(CSR_MTVEC, (uint32_t)(&__neorv32_rte_core));
+  }
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Install trap handler function (second-level trap handler).
@@ -102,7 +151,7 @@ int neorv32_rte_handler_install(int id, void (*handler)(void)) {
   // id valid?
   uint32_t index = (uint32_t)id;
   if (index < ((uint32_t)NEORV32_RTE_NUM_TRAPS)) {
-    __neorv32_rte_vector_lut[index] = (uint32_t)handler; // install handler
+    __neorv32_rte_set_handler(index, (uint32_t)handler); // install handler
     return 0;
   }
   return -1;
@@ -122,13 +171,29 @@ int neorv32_rte_handler_uninstall(int id) {
   // id valid?
   uint32_t index = (uint32_t)id;
   if (index < ((uint32_t)NEORV32_RTE_NUM_TRAPS)) {
-    __neorv32_rte_vector_lut[index] = (uint32_t)(&__neorv32_rte_debug_handler); // use dummy handler in case the trap is accidentally triggered
+    __neorv32_rte_set_handler(index, (uint32_t)(&__neorv32_rte_debug_handler)); // use dummy handler in case the trap is accidentally triggered
     return 0;
   }
   return -1;
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Update the vector tables of both RTE cores.
+ *
+ * @param[in] index Trap ID (has to be valid).
+ * @param[in] handler Handler function address.
+ **************************************************************************/
+static void __neorv32_rte_set_handler(uint32_t index, uint32_t handler) {
+
+  uint32_t code = __neorv32_rte_trap_code[index];
+
+  __neorv32_rte_vector_lut[index] = handler;
+  __neorv32_rte_fast_lut[((code >> 26) & 32) | (code & 31)] = handler;
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * This is the core of the NEORV32 RTE (first-level trap handler, executed in machine mode).
@@ -216,6 +281,7 @@ static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void) {
     case TRAP_CODE_FIRQ_13:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_13];      break;
     case TRAP_CODE_FIRQ_14:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_14];      break;
     case TRAP_CODE_FIRQ_15:      handler_base = __neorv32_rte_vector_lut[RTE_TRAP_FIRQ_15];      break;
+    case TRAP_CODE_LCOFI:        handler_base = __neorv32_rte_vector_lut[RTE_TRAP_LCOFI];        break;
     default:                     handler_base = (uint32_t)(&__neorv32_rte_debug_handler);        break;
   }
 
@@ -285,6 +351,99 @@ static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core(void) {
 }
 
 
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Fast-path core of the NEORV32 RTE (first-level trap handler, executed in machine mode).
+ * Only the caller-saved registers are saved as the callee-saved registers are preserved by the
+ * (ABI-compliant) second-level handler. The stack frame layout is identical to the standard core.
+ **************************************************************************/
+static void __attribute__((__naked__,aligned(4))) __neorv32_rte_core_fast(void) {
+
+  asm volatile (
+#ifndef __riscv_32e
+    "addi sp, sp, -32*4 \n"
+#else
+    "addi sp, sp, -16*4 \n"
+#endif
+
+    "sw x1,   1*4(sp) \n"
+    "sw x5,   5*4(sp) \n"
+    "sw x6,   6*4(sp) \n"
+    "sw x7,   7*4(sp) \n"
+    "sw x10, 10*4(sp) \n"
+    "sw x11, 11*4(sp) \n"
+    "sw x12, 12*4(sp) \n"
+    "sw x13, 13*4(sp) \n"
+    "sw x14, 14*4(sp) \n"
+    "sw x15, 15*4(sp) \n"
+#ifndef __riscv_32e
+    "sw x16, 16*4(sp) \n"
+    "sw x17, 17*4(sp) \n"
+    "sw x28, 28*4(sp) \n"
+    "sw x29, 29*4(sp) \n"
+    "sw x30, 30*4(sp) \n"
+    "sw x31, 31*4(sp) \n"
+#endif
+    "csrw mscratch, sp \n" // mscratch = base address of original context
+
+    // get handler from vector table: index = {mcause[31], mcause[4:0]}
+    "csrr a0, mcause \n"
+    "srli a1, a0, 26 \n"
+    "andi a1, a1, 32 \n"
+    "andi a0, a0, 31 \n"
+    "or   a0, a0, a1 \n"
+    "slli a0, a0, 2  \n"
+    "la   a1, __neorv32_rte_fast_lut \n"
+    "add  a0, a0, a1 \n"
+    "lw   a0, 0(a0)  \n"
+
+    // execute handler
+    "jalr ra, 0(a0) \n"
+
+    // compute return address (for exceptions only)
+    // do not alter return address if instruction access exception (fatal?)
+    "csrr a0, mcause    \n"
+    "bltz a0, 1f        \n" // interrupt
+    "li   a1, 1         \n" // TRAP_CODE_I_ACCESS
+    "beq  a0, a1, 1f    \n"
+    "csrr a0, mepc      \n"
+    "csrr a1, 0x34a     \n" // mtinst
+    "andi a1, a1, 3     \n"
+    "addi a1, a1, -3    \n"
+    "addi a0, a0, 2     \n" // faulting instruction is compressed
+    "bnez a1, 2f        \n"
+    "addi a0, a0, 2     \n" // faulting instruction is uncompressed
+    "2:                 \n"
+    "csrw mepc, a0      \n"
+    "1:                 \n"
+
+    // restore context
+    "lw x1,   1*4(sp) \n"
+    "lw x5,   5*4(sp) \n"
+    "lw x6,   6*4(sp) \n"
+    "lw x7,   7*4(sp) \n"
+    "lw x10, 10*4(sp) \n"
+    "lw x11, 11*4(sp) \n"
+    "lw x12, 12*4(sp) \n"
+    "lw x13, 13*4(sp) \n"
+    "lw x14, 14*4(sp) \n"
+    "lw x15, 15*4(sp) \n"
+#ifndef __riscv_32e
+    "lw x16, 16*4(sp) \n"
+    "lw x17, 17*4(sp) \n"
+    "lw x28, 28*4(sp) \n"
+    "lw x29, 29*4(sp) \n"
+    "lw x30, 30*4(sp) \n"
+    "lw x31, 31*4(sp) \n"
+    "addi sp, sp, 32*4 \n"
+#else
+    "addi sp, sp, 16*4 \n"
+#endif
+    "mret \n"
+  );
+}
+
+
 /**********************************************************************//**
  * NEORV32 runtime environment (RTE):
  * Read register from application context.
@@ -360,6 +519,7 @@ static void __neorv32_rte_debug_handler(void) {
     case TRAP_CODE_MSI:          neorv32_uart0_puts("Machine software IRQ"); break;
     case TRAP_CODE_MTI:          neorv32_uart0_puts("Machine timer IRQ"); break;
     case TRAP_CODE_MEI:          neorv32_uart0_puts("Machine external IRQ"); break;
+    case TRAP_CODE_LCOFI:        neorv32_uart0_puts("Local counter overflow IRQ"); break;
     case TRAP_CODE_FIRQ_0:
     case TRAP_CODE_FIRQ_1:
     case TRAP_CODE_FIRQ_2:
@@ -384,6 +544,11 @@ static void __neorv32_rte_debug_handler(void) {
     neorv32_cpu_csr_clr(CSR_MIP, 1 << (CSR_MIP_FIRQ0P + (trap_cause & 0xf))); // clear pending FIRQ
   }
 
+  // check if counter overflow IRQ
+  if (trap_cause == TRAP_CODE_LCOFI) {
+    neorv32_cpu_csr_clr(CSR_MIP, 1 << CSR_MIP_LCOFIP); // clear pending LCOFI
+  }
+
   // instruction address
   neorv32_uart0_puts(" @ PC=");
   __neorv32_rte_print_hex_word(neorv32_cpu_csr_read(CSR_MEPC));
@@ -445,7 +610,8 @@ void neorv32_rte_print_info(void) {
     "FIRQ_12   ",
     "FIRQ_13   ",
     "FIRQ_14   ",
-    "FIRQ_15   "
+    "FIRQ_15   ",
+    "LCOFI     "
   };
 
   if (neorv32_uart0_available() == 0) {
@@ -474,6 +640,318 @@ void neorv32_rte_print_info(void) {
 }
 
 
+// #################################################################################################
+// RTE Sampling Profiler
+// #################################################################################################
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * The >private< state of the sampling profiler.
+ **************************************************************************/
+static struct {
+  uint32_t *buffer;  // histogram bins
+  uint32_t size;     // number of histogram bins
+  uint32_t base;     // address of the first bin
+  int      shift;    // log2(bytes per bin)
+  int      hpm;      // HPM counter used for sampling (3..15), 0 if not started
+  int      event;    // HPM event (#NEORV32_HPMCNT_EVENT_enum)
+  uint32_t period;   // number of events per sample
+  uint32_t samples;  // total number of samples
+  uint32_t dropped;  // samples outside of the histogram's address range
+} __neorv32_rte_prof;
+
+// private functions
+static void __neorv32_rte_profiler_arm(void);
+static void __neorv32_rte_profiler_handler(void);
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Setup the histogram of the sampling profiler. The histogram covers the
+ * address range [base, base + (size << shift)), each bin counts the samples
+ * of (1 << shift) bytes of program code. All bins are cleared.
+ *
+ * @param[in] buffer Pointer to the histogram array in RAM (size 32-bit entries).
+ * @param[in] size Number of histogram bins.
+ * @param[in] base Address of the first bin (e.g. start of the .text section).
+ * @param[in] shift Log2 of the bin size in bytes (1 = one bin per compressed instruction).
+ * @return 0 if success, -1 if error (invalid arguments or profiler is running).
+ **************************************************************************/
+int neorv32_rte_profiler_setup(uint32_t *buffer, uint32_t size, uint32_t base, int shift) {
+
+  if ((buffer == NULL) || (size == 0) || (shift < 1) || (shift > 31) || (__neorv32_rte_prof.hpm != 0)) {
+    return -1;
+  }
+
+  __neorv32_rte_prof.buffer  = buffer;
+  __neorv32_rte_prof.size    = size;
+  __neorv32_rte_prof.base    = base;
+  __neorv32_rte_prof.shift   = shift;
+  __neorv32_rte_prof.samples = 0;
+  __neorv32_rte_prof.dropped = 0;
+
+  uint32_t i;
+  for (i=0; i<size; i++) {
+    buffer[i] = 0;
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Start the sampling profiler. The selected HPM counter raises a local counter
+ * overflow interrupt (LCOFI) every period events; the installed RTE handler records
+ * the interrupted program counter (mepc) in the histogram and re-arms the counter.
+ *
+ * @note This function installs the RTE_TRAP_LCOFI handler and enables the LCOFI
+ * and global machine-mode interrupts. The selected HPM counter is overridden.
+ *
+ * @warning Very small periods will spend most of the time in the sampling handler.
+ *
+ * @param[in] hpm HPM counter to be used for sampling (3..15).
+ * @param[in] event HPM event to sample on (#NEORV32_HPMCNT_EVENT_enum, e.g. HPMCNT_EVENT_CY).
+ * @param[in] period Number of events per sample (has to fit into the HPM counter width).
+ * @return 0 if success, -1 if error (Sscofpmf not available, invalid arguments or histogram not set up).
+ **************************************************************************/
+int neorv32_rte_profiler_start(int hpm, int event, uint32_t period) {
+
+  // counter overflow interrupts available?
+  if ((neorv32_cpu_csr_read(CSR_MXISA) & (1 << CSR_MXISA_SSCOFPMF)) == 0) {
+    return -1;
+  }
+
+  // valid arguments?
+  if ((__neorv32_rte_prof.buffer == NULL) || (__neorv32_rte_prof.hpm != 0) ||
+      (hpm < 3) || (hpm > (int)(2 + neorv32_cpu_hpm_get_num_counters())) ||
+      (event < 0) || (event > HPMCNT_EVENT_XB_PARA) || (event == HPMCNT_EVENT_TM) || (period == 0)) {
+    return -1;
+  }
+
+  // period has to fit into the counter
+  uint32_t width = neorv32_cpu_hpm_get_size(); // this overrides mhpmcounter3[h]
+  if ((width < 32) && (period >= (1U << width))) {
+    return -1;
+  }
+
+  __neorv32_rte_prof.hpm    = hpm;
+  __neorv32_rte_prof.event  = event;
+  __neorv32_rte_prof.period = period;
+
+  neorv32_cpu_csr_set(CSR_MCOUNTINHIBIT, 1 << hpm); // halt counter during setup
+  __neorv32_rte_profiler_arm();
+
+  neorv32_rte_handler_install(RTE_TRAP_LCOFI, __neorv32_rte_profiler_handler);
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << CSR_MIP_LCOFIP);
+  neorv32_cpu_csr_set(CSR_MIE, 1 << CSR_MIE_LCOFIE);
+  neorv32_cpu_csr_set(CSR_MSTATUS, 1 << CSR_MSTATUS_MIE);
+
+  neorv32_cpu_csr_clr(CSR_MCOUNTINHIBIT, 1 << hpm); // go!
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Stop the sampling profiler. The histogram is kept for neorv32_rte_profiler_dump(void).
+ **************************************************************************/
+void neorv32_rte_profiler_stop(void) {
+
+  int hpm = __neorv32_rte_prof.hpm;
+  if (hpm == 0) {
+    return; // not running
+  }
+
+  neorv32_cpu_csr_set(CSR_MCOUNTINHIBIT, 1 << hpm);
+  neorv32_cpu_csr_clr(CSR_MIE, 1 << CSR_MIE_LCOFIE);
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << CSR_MIP_LCOFIP);
+  neorv32_rte_handler_uninstall(RTE_TRAP_LCOFI);
+  __neorv32_rte_prof.hpm = 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Dump the sampling profiler's histogram via UART0. Only non-empty bins are printed;
+ * each line provides the bin's start address and the according number of samples:
+ *
+ * <NEORV32-PROF> event=<n> period=<n> samples=<n> dropped=<n> shift=<n>
+ * 0x<address> <samples>
+ * ...
+ * </NEORV32-PROF>
+ *
+ * The addresses can be resolved against the application's ELF file (e.g. via
+ * sw/example/demo_profiler/profile.py).
+ **************************************************************************/
+void neorv32_rte_profiler_dump(void) {
+
+  if ((neorv32_uart0_available() == 0) || (__neorv32_rte_prof.buffer == NULL)) {
+    return;
+  }
+
+  neorv32_uart0_printf("<NEORV32-PROF> event=%u period=%u samples=%u dropped=%u shift=%u\n",
+                       (uint32_t)__neorv32_rte_prof.event, __neorv32_rte_prof.period,
+                       __neorv32_rte_prof.samples, __neorv32_rte_prof.dropped, (uint32_t)__neorv32_rte_prof.shift);
+
+  uint32_t i;
+  for (i=0; i<__neorv32_rte_prof.size; i++) {
+    if (__neorv32_rte_prof.buffer[i] != 0) {
+      neorv32_uart0_printf("0x%x %u\n", __neorv32_rte_prof.base + (i << __neorv32_rte_prof.shift), __neorv32_rte_prof.buffer[i]);
+    }
+  }
+
+  neorv32_uart0_printf("</NEORV32-PROF>\n");
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private function to (re-)arm the sampling HPM counter: preload with -period so
+ * it overflows after period events and clear the counter's overflow flag.
+ **************************************************************************/
+static void __neorv32_rte_profiler_arm(void) {
+
+  uint32_t cfg = 1 << __neorv32_rte_prof.event;
+  uint32_t cnt = 0 - __neorv32_rte_prof.period;
+
+  // clear overflow flag first, then set counter high word (all-ones) before the low word
+  // to prevent a spurious overflow while updating the counter
+  switch (__neorv32_rte_prof.hpm) {
+    case  3: neorv32_cpu_csr_write(CSR_MHPMEVENT3H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT3,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER3H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER3,  cnt); break;
+    case  4: neorv32_cpu_csr_write(CSR_MHPMEVENT4H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT4,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER4H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER4,  cnt); break;
+    case  5: neorv32_cpu_csr_write(CSR_MHPMEVENT5H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT5,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER5H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER5,  cnt); break;
+    case  6: neorv32_cpu_csr_write(CSR_MHPMEVENT6H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT6,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER6H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER6,  cnt); break;
+    case  7: neorv32_cpu_csr_write(CSR_MHPMEVENT7H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT7,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER7H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER7,  cnt); break;
+    case  8: neorv32_cpu_csr_write(CSR_MHPMEVENT8H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT8,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER8H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER8,  cnt); break;
+    case  9: neorv32_cpu_csr_write(CSR_MHPMEVENT9H,  0); neorv32_cpu_csr_write(CSR_MHPMEVENT9,  cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER9H,  -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER9,  cnt); break;
+    case 10: neorv32_cpu_csr_write(CSR_MHPMEVENT10H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT10, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER10H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER10, cnt); break;
+    case 11: neorv32_cpu_csr_write(CSR_MHPMEVENT11H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT11, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER11H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER11, cnt); break;
+    case 12: neorv32_cpu_csr_write(CSR_MHPMEVENT12H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT12, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER12H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER12, cnt); break;
+    case 13: neorv32_cpu_csr_write(CSR_MHPMEVENT13H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT13, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER13H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER13, cnt); break;
+    case 14: neorv32_cpu_csr_write(CSR_MHPMEVENT14H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT14, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER14H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER14, cnt); break;
+    case 15: neorv32_cpu_csr_write(CSR_MHPMEVENT15H, 0); neorv32_cpu_csr_write(CSR_MHPMEVENT15, cfg);
+             neorv32_cpu_csr_write(CSR_MHPMCOUNTER15H, -1); neorv32_cpu_csr_write(CSR_MHPMCOUNTER15, cnt); break;
+    default: break;
+  }
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Private LCOFI handler of the sampling profiler: record the interrupted
+ * program counter and re-arm the sampling counter.
+ **************************************************************************/
+static void __neorv32_rte_profiler_handler(void) {
+
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << CSR_MIP_LCOFIP); // ack before re-arming so no overflow is lost
+
+  uint32_t index = (neorv32_cpu_csr_read(CSR_MEPC) - __neorv32_rte_prof.base) >> __neorv32_rte_prof.shift;
+  if (index < __neorv32_rte_prof.size) { // also covers addresses below base (wrap-around)
+    __neorv32_rte_prof.buffer[index]++;
+  }
+  else {
+    __neorv32_rte_prof.dropped++;
+  }
+  __neorv32_rte_prof.samples++;
+
+  __neorv32_rte_profiler_arm();
+}
+
+
+// #################################################################################################
+// RTE Secondary Hart Launch (Dual-Core Configuration)
+// #################################################################################################
+
+// private functions
+static void __attribute__((__naked__,aligned(4))) __neorv32_rte_smp_entry(void);
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Launch the secondary hart (hart 1) of a dual-core configuration. The secondary hart is
+ * parked by the start-up code (crt0) until it receives a software interrupt (IPI) via the
+ * MTIME unit. It then calls @p entry using its own stack and the trap vector of the
+ * calling hart (so both harts share the RTE trap handlers).
+ *
+ * @note The CPU caches are not coherent. Data shared between the harts has to be placed in
+ * the uncached address space or has to be synchronized using fence instructions. Atomic
+ * operations (LR/SC and AMOs) always bypass the caches.
+ *
+ * @param[in] entry Function to be executed by the secondary hart. The hart goes to sleep if this function returns.
+ * @param[in] stack_memory Pointer to the secondary hart's stack memory.
+ * @param[in] stack_size Size of the stack memory in bytes.
+ * @return 0 if success, -1 if error (no dual-core configuration or secondary hart did not respond).
+ **************************************************************************/
+int neorv32_rte_smp_launch(void (*entry)(void), uint8_t *stack_memory, uint32_t stack_size) {
+
+  if (((NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_DUAL_CORE)) == 0) || (neorv32_mtime_available() == 0)) {
+    return -1;
+  }
+
+  // launch configuration at the top of the (16-byte aligned) stack
+  uint32_t *stack_top = (uint32_t*)(((uint32_t)stack_memory + stack_size) & 0xFFFFFFF0UL);
+  stack_top -= 4;
+  stack_top[0] = (uint32_t)entry;
+  stack_top[1] = neorv32_cpu_csr_read(CSR_MTVEC);
+  asm volatile ("fence"); // write back data cache
+
+  // hart 1's compare register is used as launch mailbox (timer interrupt is disabled while parked);
+  // the secondary hart resets it to all-ones when taking over the launch configuration
+  NEORV32_MTIME->TIMECMP1_LO = (uint32_t)stack_top;
+  NEORV32_MTIME->TIMECMP1_HI = (uint32_t)&__neorv32_rte_smp_entry;
+
+  // wake-up secondary hart; it clears its MSIP flag when starting
+  neorv32_mtime_set_msip(1);
+  uint32_t timeout = 0x10000;
+  while (NEORV32_MTIME->MSIP[1]) {
+    if (--timeout == 0) {
+      neorv32_mtime_clr_msip(1);
+      neorv32_mtime_set_timecmp_hart(1, -1);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * NEORV32 runtime environment (RTE):
+ * Secondary hart start-up code (called by crt0 with the stack pointer set to the
+ * launch configuration of #neorv32_rte_smp_launch).
+ **************************************************************************/
+static void __attribute__((__naked__,aligned(4))) __neorv32_rte_smp_entry(void) {
+
+  asm volatile (
+    ".option push               \n"
+    ".option norelax            \n"
+    "la   gp, __global_pointer$ \n" // global pointer of this program (crt0 might belong to the bootloader)
+    ".option pop                \n"
+    "lw   t0, 0(sp)             \n" // entry function
+    "lw   t1, 4(sp)             \n" // trap vector of the launching hart
+    "csrw mtvec, t1             \n"
+    "fence.i                    \n" // discard stale instruction cache content
+    "jalr ra, t0, 0             \n"
+    "csrw mie, zero             \n" // entry function returned: sleep forever
+    "1:                         \n"
+    "wfi                        \n"
+    "j 1b                       \n"
+  );
+}
+
+
 // #################################################################################################
 // RTE Hardware Analysis Helpers
 // #################################################################################################
@@ -551,6 +1029,7 @@ void neorv32_rte_print_hw_config(void) {
   if (tmp & (1<<CSR_MXISA_SDEXT))     { neorv32_uart0_printf("Sdext ");     }
   if (tmp & (1<<CSR_MXISA_SDTRIG))    { neorv32_uart0_printf("Sdtrig ");    }
   if (tmp & (1<<CSR_MXISA_PMP))       { neorv32_uart0_printf("Smpmp ");     }
+  if (tmp & (1<<CSR_MXISA_SSCOFPMF))  { neorv32_uart0_printf("Sscofpmf ");  }
   if (tmp & (1<<CSR_MXISA_ZFINX))     { neorv32_uart0_printf("Zfinx ");     }
   if (tmp & (1<<CSR_MXISA_ZICNTR))    { neorv32_uart0_printf("Zicntr ");    }
   if (tmp & (1<<CSR_MXISA_ZICOND))    { neorv32_uart0_printf("Zicond ");    }
@@ -626,6 +1105,23 @@ void neorv32_rte_print_hw_config(void) {
     neorv32_uart0_printf("none\n");
   }
 
+  // tightly-coupled memories
+  tmp = (uint32_t)NEORV32_SYSINFO->MEM[SYSINFO_MEM_TCM];
+  neorv32_uart0_printf("Internal ITCM:       ");
+  if (tmp & 0x0F) {
+    neorv32_uart0_printf("%u bytes\n", (uint32_t)(1 << (tmp & 0x0F)));
+  }
+  else {
+    neorv32_uart0_printf("none\n");
+  }
+  neorv32_uart0_printf("Internal DTCM:       ");
+  if (tmp >> 4) {
+    neorv32_uart0_printf("%u bytes\n", (uint32_t)(1 << (tmp >> 4)));
+  }
+  else {
+    neorv32_uart0_printf("none\n");
+  }
+
   // internal i-cache
   neorv32_uart0_printf("Internal i-cache:    ");
   if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_ICACHE)) {
@@ -641,14 +1137,15 @@ void neorv32_rte_print_hw_config(void) {
 
     neorv32_uart0_printf("%u bytes, %u set(s), %u block(s) per set, %u bytes per block", ic_associativity*ic_num_blocks*ic_block_size, ic_associativity, ic_num_blocks, ic_block_size);
     if (ic_associativity == 1) {
-      neorv32_uart0_printf(" (direct-mapped)\n");
+      neorv32_uart0_printf(" (direct-mapped)");
     }
     else if (((NEORV32_SYSINFO->CACHE >> SYSINFO_CACHE_IC_REPLACEMENT_0) & 0x0F) == 1) {
-      neorv32_uart0_printf(" (LRU)\n");
+      neorv32_uart0_printf(" (LRU)");
     }
-    else {
-      neorv32_uart0_printf("\n");
+    if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_ICACHE_PF)) {
+      neorv32_uart0_printf(", next-block prefetch");
     }
+    neorv32_uart0_printf("\n");
   }
   else {
     neorv32_uart0_printf("none\n");
@@ -664,7 +1161,25 @@ void neorv32_rte_print_hw_config(void) {
     uint32_t dc_num_blocks = (NEORV32_SYSINFO->CACHE >> SYSINFO_CACHE_DC_NUM_BLOCKS_0) & 0x0F;
     dc_num_blocks = 1 << dc_num_blocks;
 
-    neorv32_uart0_printf("%u bytes, %u block(s), %u bytes per block, direct-mapped, write-through\n", dc_num_blocks*dc_block_size, dc_num_blocks, dc_block_size);
+    uint32_t dc_associativity = (NEORV32_SYSINFO->CACHE >> SYSINFO_CACHE_DC_ASSOCIATIVITY_0) & 0x0F;
+    dc_associativity = 1 << dc_associativity;
+
+    neorv32_uart0_printf("%u bytes, %u set(s), %u block(s) per set, %u bytes per block", dc_associativity*dc_num_blocks*dc_block_size, dc_associativity, dc_num_blocks, dc_block_size);
+    if (dc_associativity == 1) {
+      neorv32_uart0_printf(" (direct-mapped), ");
+    }
+    else if (((NEORV32_SYSINFO->CACHE >> SYSINFO_CACHE_DC_REPLACEMENT_0) & 0x0F) == 2) {
+      neorv32_uart0_printf(" (pseudo-LRU), ");
+    }
+    else {
+      neorv32_uart0_printf(", ");
+    }
+    if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_DCACHE_WB)) {
+      neorv32_uart0_printf("write-back\n");
+    }
+    else {
+      neorv32_uart0_printf("write-through\n");
+    }
   }
   else {
     neorv32_uart0_printf("none\n");
@@ -679,6 +1194,24 @@ void neorv32_rte_print_hw_config(void) {
     neorv32_uart0_printf("none\n");
   }
 
+  // bus interconnect
+  neorv32_uart0_printf("Bus interconnect:    ");
+  if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_BUS_XBAR)) {
+    neorv32_uart0_printf("multi-layer crossbar\n");
+  }
+  else {
+    neorv32_uart0_printf("shared bus\n");
+  }
+
+  // number of harts
+  neorv32_uart0_printf("Harts:               ");
+  if (NEORV32_SYSINFO->SOC & (1 << SYSINFO_SOC_DUAL_CORE)) {
+    neorv32_uart0_printf("2 (dual-core SMP)\n");
+  }
+  else {
+    neorv32_uart0_printf("1\n");
+  }
+
   // external bus interface
   neorv32_uart0_printf("Ext. bus interface:  ");
   tmp = NEORV32_SYSINFO->SOC;
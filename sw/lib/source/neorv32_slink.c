@@ -164,6 +164,45 @@ inline void __attribute__((always_inline)) neorv32_slink_put_last(uint32_t tx_da
 }
 
 
+/**********************************************************************//**
+ * Send a buffer of data words via SLINK using the DMA (non-blocking). The buffer is
+ * handed to the DMA without copying and is sent in chunks of up to TX FIFO depth words,
+ * each triggered by the SLINK's "TX FIFO empty" interrupt (see neorv32_dma_stream_start()).
+ *
+ * @note The buffer must not be modified until the callback has been called
+ * (or neorv32_dma_stream_busy() returns 0). The SLINK interrupt is shared by RX and
+ * TX conditions, so all RX interrupt sources should be disabled while the transfer is
+ * in progress.
+ *
+ * @param[in] buffer Pointer to caller-owned data buffer (has to be word-aligned).
+ * @param[in] num Number of data words to send (24-bit).
+ * @param[in] callback Function that is called (from the DMA interrupt handler) when the transfer
+ * has completed; status is 0 on success or a #NEORV32_DMA_STATUS_enum error code (can be NULL).
+ * @return 0 if the transfer has been started, -1 if the DMA is not available, busy with another stream
+ * or if the TX FIFO provides less than #DMA_STREAM_CHUNK_MIN entries.
+ **************************************************************************/
+int neorv32_slink_put_async(const uint32_t *buffer, uint32_t num, void (*callback)(int status)) {
+
+  static neorv32_dma_stream_t stream;
+
+  if (neorv32_dma_stream_busy()) {
+    return -1;
+  }
+
+  stream.src       = (uint32_t)buffer;
+  stream.dst       = (uint32_t)(&NEORV32_SLINK->TX_DATA);
+  stream.num       = num;
+  stream.config    = DMA_CMD_W2W | DMA_CMD_SRC_INC | DMA_CMD_DST_CONST;
+  stream.chunk     = (uint32_t)neorv32_slink_get_tx_fifo_depth();
+  stream.firq_mask = 1 << SLINK_FIRQ_PENDING;
+  stream.dev_ctrl  = &NEORV32_SLINK->CTRL;
+  stream.dev_irq   = 1 << SLINK_CTRL_IRQ_TX_EMPTY;
+  stream.callback  = callback;
+
+  return neorv32_dma_stream_start(&stream);
+}
+
+
 /**********************************************************************//**
  * Get RX link FIFO status.
  *
@@ -49,6 +49,17 @@
 static void __neorv32_uart_itoa(uint32_t x, char *res) __attribute__((unused)); // GCC: do not output a warning when this variable is unused
 static void __neorv32_uart_tohex(uint32_t x, char *res) __attribute__((unused)); // GCC: do not output a warning when this variable is unused
 static void __neorv32_uart_touppercase(uint32_t len, char *ptr) __attribute__((unused)); // GCC: do not output a warning when this variable is unused
+static neorv32_uart_buffered_t* __neorv32_uart_buffered_get(neorv32_uart_t *UARTx);
+static void __neorv32_uart_buffered_rx_service(neorv32_uart_t *UARTx, neorv32_uart_buffered_t *drv);
+static void __neorv32_uart_buffered_tx_service(neorv32_uart_t *UARTx, neorv32_uart_buffered_t *drv);
+static void __neorv32_uart0_buffered_rx_handler(void);
+static void __neorv32_uart0_buffered_tx_handler(void);
+static void __neorv32_uart1_buffered_rx_handler(void);
+static void __neorv32_uart1_buffered_tx_handler(void);
+
+// Private variables: buffered driver state of UART0 and UART1
+static neorv32_uart_buffered_t __neorv32_uart0_buffered;
+static neorv32_uart_buffered_t __neorv32_uart1_buffered;
 
 
 /**********************************************************************//**
@@ -216,6 +227,50 @@ void neorv32_uart_putc(neorv32_uart_t *UARTx, char c) {
 }
 
 
+/**********************************************************************//**
+ * Send a buffer via UART using the DMA (non-blocking). The buffer is handed to
+ * the DMA without copying and is sent in chunks of up to TX FIFO depth characters,
+ * each triggered by the UART's "TX FIFO empty" interrupt (see neorv32_dma_stream_start()).
+ *
+ * @note The buffer must not be modified until the callback has been called
+ * (or neorv32_dma_stream_busy() returns 0). The UART's TX interrupt
+ * configuration is modified while the transfer is in progress.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] buffer Pointer to caller-owned data buffer.
+ * @param[in] len Number of characters to send (24-bit).
+ * @param[in] callback Function that is called (from the DMA interrupt handler) when the transfer
+ * has completed; status is 0 on success or a #NEORV32_DMA_STATUS_enum error code (can be NULL).
+ * @return 0 if the transfer has been started, -1 if the DMA is not available, busy with another stream
+ * or if the TX FIFO provides less than #DMA_STREAM_CHUNK_MIN entries.
+ **************************************************************************/
+int neorv32_uart_put_async(neorv32_uart_t *UARTx, const char *buffer, uint32_t len, void (*callback)(int status)) {
+
+  static neorv32_dma_stream_t stream;
+
+  if (neorv32_dma_stream_busy()) {
+    return -1;
+  }
+
+  stream.src       = (uint32_t)buffer;
+  stream.dst       = (uint32_t)(&UARTx->DATA);
+  stream.num       = len;
+  stream.config    = DMA_CMD_B2UW | DMA_CMD_SRC_INC | DMA_CMD_DST_CONST;
+  stream.chunk     = (uint32_t)neorv32_uart_get_tx_fifo_depth(UARTx);
+  stream.dev_ctrl  = &UARTx->CTRL;
+  stream.dev_irq   = 1 << UART_CTRL_IRQ_TX_EMPTY;
+  stream.callback  = callback;
+  if (((uint32_t)UARTx) == NEORV32_UART0_BASE) {
+    stream.firq_mask = 1 << UART0_TX_FIRQ_PENDING;
+  }
+  else {
+    stream.firq_mask = 1 << UART1_TX_FIRQ_PENDING;
+  }
+
+  return neorv32_dma_stream_start(&stream);
+}
+
+
 /**********************************************************************//**
  * Check if UART TX is busy (transmitter busy or data left in TX buffer).
  *
@@ -449,6 +504,340 @@ int neorv32_uart_scan(neorv32_uart_t *UARTx, char *buffer, int max_size, int ech
 }
 
 
+// ================================================================================================
+// Buffered (interrupt-driven) driver
+// ================================================================================================
+
+
+/**********************************************************************//**
+ * Enable buffered (interrupt-driven) mode. Received characters are moved from the
+ * RX FIFO to a software RX ring buffer by the RX interrupt handler; characters that
+ * are written via neorv32_uart_buffered_write() are moved from a software TX ring
+ * buffer to the TX FIFO by the TX interrupt handler. Each interrupt drains/fills the
+ * hardware FIFO as far as possible.
+ *
+ * @note The UART has to be configured (neorv32_uart_setup()) before. This function
+ * installs the UART's RX and TX interrupt handlers via the RTE (neorv32_rte_setup()
+ * has to be called before) and enables the according interrupt sources in the mie
+ * CSR. Machine-mode interrupts have to be enabled globally by the application.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] rx_buf Pointer to caller-owned RX buffer memory.
+ * @param[in] rx_size Size of RX buffer in bytes (has to be a power of two).
+ * @param[in] tx_buf Pointer to caller-owned TX buffer memory.
+ * @param[in] tx_size Size of TX buffer in bytes (has to be a power of two).
+ * @return 0 if success, -1 if invalid buffer size.
+ **************************************************************************/
+int neorv32_uart_buffered_setup(neorv32_uart_t *UARTx, char *rx_buf, uint32_t rx_size, char *tx_buf, uint32_t tx_size) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+
+  if ((rx_size == 0) || (rx_size & (rx_size - 1)) || (tx_size == 0) || (tx_size & (tx_size - 1))) {
+    return -1; // not a power of two
+  }
+
+  neorv32_uart_buffered_disable(UARTx);
+
+  drv->rx.buf  = rx_buf;
+  drv->rx.mask = rx_size - 1;
+  drv->rx.head = 0;
+  drv->rx.tail = 0;
+  drv->tx.buf  = tx_buf;
+  drv->tx.mask = tx_size - 1;
+  drv->tx.head = 0;
+  drv->tx.tail = 0;
+  drv->rx_lost = 0;
+  drv->enabled = 1;
+
+  // RX interrupt if RX FIFO not empty; TX interrupt is enabled on demand
+  uint32_t tmp = UARTx->CTRL;
+  tmp &= ~((uint32_t)(0x1fU << UART_CTRL_IRQ_RX_NEMPTY));
+  tmp |= (uint32_t)(1 << UART_CTRL_IRQ_RX_NEMPTY);
+  UARTx->CTRL = tmp;
+
+  if (((uint32_t)UARTx) == NEORV32_UART0_BASE) {
+    neorv32_rte_handler_install(UART0_RX_RTE_ID, __neorv32_uart0_buffered_rx_handler);
+    neorv32_rte_handler_install(UART0_TX_RTE_ID, __neorv32_uart0_buffered_tx_handler);
+    neorv32_cpu_csr_set(CSR_MIE, (1 << UART0_RX_FIRQ_ENABLE) | (1 << UART0_TX_FIRQ_ENABLE));
+  }
+  else {
+    neorv32_rte_handler_install(UART1_RX_RTE_ID, __neorv32_uart1_buffered_rx_handler);
+    neorv32_rte_handler_install(UART1_TX_RTE_ID, __neorv32_uart1_buffered_tx_handler);
+    neorv32_cpu_csr_set(CSR_MIE, (1 << UART1_RX_FIRQ_ENABLE) | (1 << UART1_TX_FIRQ_ENABLE));
+  }
+
+  return 0;
+}
+
+
+/**********************************************************************//**
+ * Disable buffered mode. Pending TX data is sent (blocking) before.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ **************************************************************************/
+void neorv32_uart_buffered_disable(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+
+  if (drv->enabled == 0) {
+    return;
+  }
+
+  neorv32_uart_buffered_flush(UARTx);
+
+  if (((uint32_t)UARTx) == NEORV32_UART0_BASE) {
+    neorv32_cpu_csr_clr(CSR_MIE, (1 << UART0_RX_FIRQ_ENABLE) | (1 << UART0_TX_FIRQ_ENABLE));
+    neorv32_rte_handler_uninstall(UART0_RX_RTE_ID);
+    neorv32_rte_handler_uninstall(UART0_TX_RTE_ID);
+  }
+  else {
+    neorv32_cpu_csr_clr(CSR_MIE, (1 << UART1_RX_FIRQ_ENABLE) | (1 << UART1_TX_FIRQ_ENABLE));
+    neorv32_rte_handler_uninstall(UART1_RX_RTE_ID);
+    neorv32_rte_handler_uninstall(UART1_TX_RTE_ID);
+  }
+
+  UARTx->CTRL &= ~((uint32_t)(0x1fU << UART_CTRL_IRQ_RX_NEMPTY)); // disable all interrupt sources
+  drv->enabled = 0;
+}
+
+
+/**********************************************************************//**
+ * Check if buffered mode is enabled.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return 0 if buffered mode is disabled, 1 if enabled.
+ **************************************************************************/
+int neorv32_uart_buffered_enabled(neorv32_uart_t *UARTx) {
+
+  if (__neorv32_uart_buffered_get(UARTx)->enabled) {
+    return 1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+/**********************************************************************//**
+ * Read characters from the RX ring buffer (non-blocking).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] buffer Pointer to destination buffer.
+ * @param[in] len Maximum number of characters to read.
+ * @return Number of characters actually read (0 if RX buffer is empty).
+ **************************************************************************/
+int neorv32_uart_buffered_read(neorv32_uart_t *UARTx, char *buffer, int len) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+  uint32_t tail = drv->rx.tail;
+  uint32_t head = drv->rx.head; // snapshot; producer might add more data meanwhile
+  int cnt = 0;
+
+  while ((cnt < len) && (tail != head)) {
+    buffer[cnt++] = drv->rx.buf[tail & drv->rx.mask];
+    tail++;
+  }
+  drv->rx.tail = tail; // release buffer space
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Write characters to the TX ring buffer (non-blocking).
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in] buffer Pointer to source buffer.
+ * @param[in] len Number of characters to write.
+ * @return Number of characters actually written (less than len if TX buffer is full).
+ **************************************************************************/
+int neorv32_uart_buffered_write(neorv32_uart_t *UARTx, const char *buffer, int len) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+  uint32_t head = drv->tx.head;
+  uint32_t tail = drv->tx.tail; // snapshot; consumer might free more space meanwhile
+  int cnt = 0;
+
+  while ((cnt < len) && ((head - tail) <= drv->tx.mask)) {
+    drv->tx.buf[head & drv->tx.mask] = buffer[cnt++];
+    head++;
+  }
+  drv->tx.head = head; // publish data
+
+  // enable TX interrupt (if TX FIFO not at least half-full); the handler disables it again when the buffer is empty
+  if (cnt) {
+    UARTx->CTRL |= (uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF);
+  }
+
+  return cnt;
+}
+
+
+/**********************************************************************//**
+ * Get number of characters in the RX ring buffer.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Number of characters that can be read.
+ **************************************************************************/
+int neorv32_uart_buffered_rx_available(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+  return (int)(drv->rx.head - drv->rx.tail);
+}
+
+
+/**********************************************************************//**
+ * Get number of free entries in the TX ring buffer.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Number of characters that can be written without blocking.
+ **************************************************************************/
+int neorv32_uart_buffered_tx_free(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+  return (int)((drv->tx.mask + 1) - (drv->tx.head - drv->tx.tail));
+}
+
+
+/**********************************************************************//**
+ * Wait until the TX ring buffer is empty. If machine-mode interrupts are globally
+ * disabled the TX ring buffer is drained by polling.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ **************************************************************************/
+void neorv32_uart_buffered_flush(neorv32_uart_t *UARTx) {
+
+  neorv32_uart_buffered_t *drv = __neorv32_uart_buffered_get(UARTx);
+
+  while (drv->tx.head != drv->tx.tail) {
+    if ((neorv32_cpu_csr_read(CSR_MSTATUS) & (1 << CSR_MSTATUS_MIE)) == 0) { // interrupts disabled
+      __neorv32_uart_buffered_tx_service(UARTx, drv);
+    }
+  }
+}
+
+
+/**********************************************************************//**
+ * Get number of RX characters that were discarded because the RX ring buffer was full.
+ *
+ * @note Use the #UART_CTRL_RX_OVER flag to check for hardware RX FIFO overflows.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Number of lost characters since neorv32_uart_buffered_setup().
+ **************************************************************************/
+uint32_t neorv32_uart_buffered_rx_lost(neorv32_uart_t *UARTx) {
+
+  return __neorv32_uart_buffered_get(UARTx)->rx_lost;
+}
+
+
+/**********************************************************************//**
+ * Private function: get buffered driver state of UART.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @return Pointer to driver state.
+ **************************************************************************/
+static neorv32_uart_buffered_t* __neorv32_uart_buffered_get(neorv32_uart_t *UARTx) {
+
+  if (((uint32_t)UARTx) == NEORV32_UART0_BASE) {
+    return &__neorv32_uart0_buffered;
+  }
+  else {
+    return &__neorv32_uart1_buffered;
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: move all received characters from the RX FIFO to the RX ring buffer.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] drv Driver state.
+ **************************************************************************/
+static void __neorv32_uart_buffered_rx_service(neorv32_uart_t *UARTx, neorv32_uart_buffered_t *drv) {
+
+  uint32_t head = drv->rx.head;
+  uint32_t ctrl;
+  char c;
+
+  while (1) {
+    ctrl = UARTx->CTRL;
+    if ((ctrl & (1 << UART_CTRL_RX_NEMPTY)) == 0) {
+      break; // RX FIFO drained
+    }
+    c = (char)(UARTx->DATA >> UART_DATA_RTX_LSB);
+    if ((head - drv->rx.tail) <= drv->rx.mask) {
+      drv->rx.buf[head & drv->rx.mask] = c;
+      head++;
+    }
+    else {
+      drv->rx_lost++; // ring buffer full
+    }
+  }
+  drv->rx.head = head; // publish data
+}
+
+
+/**********************************************************************//**
+ * Private function: fill the TX FIFO from the TX ring buffer. Disables the TX
+ * interrupt if the TX ring buffer is empty.
+ *
+ * @param[in,out] UARTx Hardware handle to UART register struct, #neorv32_uart_t.
+ * @param[in,out] drv Driver state.
+ **************************************************************************/
+static void __neorv32_uart_buffered_tx_service(neorv32_uart_t *UARTx, neorv32_uart_buffered_t *drv) {
+
+  uint32_t tail = drv->tx.tail;
+  uint32_t head = drv->tx.head;
+
+  while ((tail != head) && ((UARTx->CTRL & (1 << UART_CTRL_TX_FULL)) == 0)) {
+    UARTx->DATA = (uint32_t)drv->tx.buf[tail & drv->tx.mask] << UART_DATA_RTX_LSB;
+    tail++;
+  }
+  drv->tx.tail = tail; // release buffer space
+
+  if (tail == drv->tx.head) { // nothing left to send
+    UARTx->CTRL &= ~((uint32_t)(1 << UART_CTRL_IRQ_TX_NHALF));
+  }
+}
+
+
+/**********************************************************************//**
+ * Private function: UART0 RX interrupt handler (buffered mode).
+ **************************************************************************/
+static void __neorv32_uart0_buffered_rx_handler(void) {
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << UART0_RX_FIRQ_PENDING); // clear/ack pending FIRQ
+  __neorv32_uart_buffered_rx_service(NEORV32_UART0, &__neorv32_uart0_buffered);
+}
+
+
+/**********************************************************************//**
+ * Private function: UART0 TX interrupt handler (buffered mode).
+ **************************************************************************/
+static void __neorv32_uart0_buffered_tx_handler(void) {
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << UART0_TX_FIRQ_PENDING); // clear/ack pending FIRQ
+  __neorv32_uart_buffered_tx_service(NEORV32_UART0, &__neorv32_uart0_buffered);
+}
+
+
+/**********************************************************************//**
+ * Private function: UART1 RX interrupt handler (buffered mode).
+ **************************************************************************/
+static void __neorv32_uart1_buffered_rx_handler(void) {
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << UART1_RX_FIRQ_PENDING); // clear/ack pending FIRQ
+  __neorv32_uart_buffered_rx_service(NEORV32_UART1, &__neorv32_uart1_buffered);
+}
+
+
+/**********************************************************************//**
+ * Private function: UART1 TX interrupt handler (buffered mode).
+ **************************************************************************/
+static void __neorv32_uart1_buffered_tx_handler(void) {
+  neorv32_cpu_csr_clr(CSR_MIP, 1 << UART1_TX_FIRQ_PENDING); // clear/ack pending FIRQ
+  __neorv32_uart_buffered_tx_service(NEORV32_UART1, &__neorv32_uart1_buffered);
+}
+
+
 /**********************************************************************//**
  * Private function for 'neorv32_printf' to convert into decimal.
  *
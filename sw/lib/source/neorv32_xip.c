@@ -77,6 +77,9 @@ void neorv32_xip_setup(int prsc, int cdiv, int cpol, int cpha, uint8_t rd_cmd) {
   // reset and disable module
   NEORV32_XIP->CTRL = 0;
 
+  // default quad I/O configuration (only used if quad I/O mode is enabled via neorv32_xip_quad_setup())
+  NEORV32_XIP->QCTRL = ((uint32_t)(0xff)) << XIP_QCTRL_MODE_LSB; // mode bits = 0xFF: no continuous read mode
+
   // clear data registers
   NEORV32_XIP->DATA_LO = 0;
   NEORV32_XIP->DATA_HI = 0; // will not trigger SPI transfer since module is disabled
@@ -103,6 +106,37 @@ void neorv32_xip_setup(int prsc, int cdiv, int cpol, int cpha, uint8_t rd_cmd) {
 }
 
 
+/**********************************************************************//**
+ * Configure XIP module: use quad I/O flash reads (1-4-4) for XIP accesses.
+ *
+ * @note This function has to be called after neorv32_xip_setup() and before neorv32_xip_start().
+ * Direct SPI transfers (neorv32_xip_spi_trans()) always use single-bit SPI mode.
+ *
+ * @param[in] rd_cmd SPI flash quad I/O read byte command (e.g. 0xEB).
+ * @param[in] dummy Number of dummy clock cycles between mode bits and read data (0..15).
+ * @return 0 if configuration is OK, -1 if XIP mode is already enabled.
+ **************************************************************************/
+int neorv32_xip_quad_setup(uint8_t rd_cmd, int dummy) {
+
+  uint32_t ctrl = NEORV32_XIP->CTRL;
+
+  if (ctrl & (1 << XIP_CTRL_XIP_EN)) {
+    return -1;
+  }
+
+  // mode bits = 0xFF (no continuous read mode)
+  NEORV32_XIP->QCTRL = (((uint32_t)(dummy & 0x0f)) << XIP_QCTRL_DUMMY_LSB) |
+                       (((uint32_t)(0xff        )) << XIP_QCTRL_MODE_LSB);
+
+  ctrl &= ~(0xFF << XIP_CTRL_RD_CMD_LSB); // clear old read command
+  ctrl |= ((uint32_t)(rd_cmd & 0xff)) << XIP_CTRL_RD_CMD_LSB;
+  ctrl |= 1 << XIP_CTRL_QUAD; // only affects actual XIP accesses
+  NEORV32_XIP->CTRL = ctrl;
+
+  return 0;
+}
+
+
 /**********************************************************************//**
  * Enable XIP mode (to allow CPU to _transparently_ fetch data & instructions).
  *
@@ -122,9 +156,13 @@ int neorv32_xip_start(int abytes) {
   ctrl |= ((uint32_t)(abytes-1)) << XIP_CTRL_XIP_ABYTES_LSB; // set new configuration
 
   // total number of bytes to transfer via SPI
-  // 'abytes' address bytes + 1 command byte + 4 bytes RX data (one 32-bit word)
+  // 'abytes' address bytes + 1 command byte + 4 bytes RX data (one 32-bit word) + 1 mode byte (quad I/O mode only)
+  int nbytes = abytes + 1 + 4;
+  if (ctrl & (1 << XIP_CTRL_QUAD)) {
+    nbytes++;
+  }
   ctrl &= ~(0xF << XIP_CTRL_SPI_NBYTES_LSB); // clear old configuration
-  ctrl |= ((uint32_t)(abytes+1+4)) << XIP_CTRL_SPI_NBYTES_LSB; // set new configuration
+  ctrl |= ((uint32_t)nbytes) << XIP_CTRL_SPI_NBYTES_LSB; // set new configuration
 
   ctrl |= 1 << XIP_CTRL_XIP_EN; // enable XIP mode
 
@@ -23,6 +23,13 @@
  *
  * @warning UART0 (if available) is used to read/write console data (STDIN, STDOUT, STDERR, ...).
  *
+ * @note If UART0_ASYNC_WRITE is defined (e.g. via "USER_FLAGS += -DUART0_ASYNC_WRITE") console output
+ * is copied to a double buffer (2 x UART0_ASYNC_WRITE_BUF_SIZE bytes) and sent by the DMA in the background
+ * (see neorv32_uart_put_async()). This occupies the DMA's RTE trap handler.
+ *
+ * @note If the buffered (interrupt-driven) UART0 driver is enabled (neorv32_uart_buffered_setup()) all
+ * console data is exchanged via its RX/TX ring buffers instead.
+ *
  * @note Original source file: https://github.com/openhwgroup/cv32e40p/blob/master/example_tb/core/custom/syscalls.c
  * @note Original license: SOLDERPAD HARDWARE LICENSE version 0.51
  * @note More information was derived from: https://interrupt.memfault.com/blog/boostrapping-libc-with-newlib#implementing-newlib
@@ -35,6 +42,7 @@
 #include <newlib.h>
 #include <unistd.h>
 #include <errno.h>
+#include <string.h>
 #include <neorv32.h>
 
 #undef errno
@@ -205,6 +213,10 @@ ssize_t _read(int file, void *ptr, size_t len)
 
     // read everything (STDIN, ...) from NEORV32.UART0 (if available)
     if (neorv32_uart0_available()) {
+      if (neorv32_uart_buffered_enabled(NEORV32_UART0)) { // wait for at least one char, return all available ones
+        while ((read_cnt = neorv32_uart_buffered_read(NEORV32_UART0, (char *)ptr, (int)len)) == 0);
+        return read_cnt;
+      }
       char *char_ptr;
       char_ptr = (char *)ptr;
       while (len > 0) {
@@ -254,11 +266,84 @@ int _wait(int *status)
     return -1;
 }
 
+#ifdef UART0_ASYNC_WRITE
+#ifndef UART0_ASYNC_WRITE_BUF_SIZE
+#define UART0_ASYNC_WRITE_BUF_SIZE 256
+#endif
+
+static char async_buf[2][UART0_ASYNC_WRITE_BUF_SIZE]; // double buffer
+static volatile int async_sel = 0; // buffer that is currently being filled
+static volatile size_t async_fill = 0; // number of bytes in fill buffer
+
+// send fill buffer if the DMA is idle; has to be called with DMA interrupt disabled or from the DMA interrupt handler
+static void async_flush(int status)
+{
+    if ((async_fill != 0) && (neorv32_dma_stream_busy() == 0)) {
+      if (neorv32_uart0_put_async(async_buf[async_sel], async_fill, async_flush) == 0) {
+        async_sel ^= 1; // swap buffers
+        async_fill = 0;
+      }
+    }
+}
+
+static ssize_t async_write(const void *ptr, size_t len)
+{
+    size_t num, cnt = 0;
+
+    // interrupts globally disabled (e.g. inside a trap handler): send pending and new data in blocking mode
+    if ((neorv32_cpu_csr_read(CSR_MSTATUS) & (1 << CSR_MSTATUS_MIE)) == 0) {
+      neorv32_dma_stream_wait();
+      for (num = 0; num < async_fill; num++) {
+        neorv32_uart0_putc(async_buf[async_sel][num]);
+      }
+      async_fill = 0;
+      for (num = 0; num < len; num++) {
+        neorv32_uart0_putc(((const char *)ptr)[num]);
+      }
+      return len;
+    }
+
+    while (cnt < len) {
+      neorv32_cpu_csr_clr(CSR_MIE, 1 << DMA_FIRQ_ENABLE); // protect buffer state
+      while (async_fill >= UART0_ASYNC_WRITE_BUF_SIZE) { // wait until the DMA has swapped buffers
+        neorv32_cpu_csr_set(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+        neorv32_cpu_csr_clr(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+        async_flush(0);
+      }
+      num = UART0_ASYNC_WRITE_BUF_SIZE - async_fill;
+      if (num > (len - cnt)) {
+        num = len - cnt;
+      }
+      memcpy(&async_buf[async_sel][async_fill], ptr + cnt, num);
+      async_fill += num;
+      cnt += num;
+      async_flush(0);
+      neorv32_cpu_csr_set(CSR_MIE, 1 << DMA_FIRQ_ENABLE);
+    }
+    return len;
+}
+#endif
+
 ssize_t _write(int file, const void *ptr, size_t len)
 {
     // write everything (STDOUT, STDERR, ...) to NEORV32.UART0 (if available)
     const void *eptr = ptr + len;
     if (neorv32_uart0_available()) {
+      if (neorv32_uart_buffered_enabled(NEORV32_UART0)) { // only blocks if TX ring buffer is full
+        size_t cnt = 0;
+        while (cnt < len) {
+          cnt += neorv32_uart_buffered_write(NEORV32_UART0, (const char *)ptr + cnt, (int)(len - cnt));
+          if ((cnt < len) && ((neorv32_cpu_csr_read(CSR_MSTATUS) & (1 << CSR_MSTATUS_MIE)) == 0)) {
+            neorv32_uart_buffered_flush(NEORV32_UART0); // interrupts disabled: drain by polling
+          }
+        }
+        return len;
+      }
+#ifdef UART0_ASYNC_WRITE
+      if (neorv32_dma_available()) {
+        return async_write(ptr, len);
+      }
+#endif
       while (ptr != eptr) {
         neorv32_uart0_putc(*(char *)(ptr++));
       }